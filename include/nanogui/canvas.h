@@ -91,20 +91,104 @@ public:
     /// Return whether the widget border is drawn
     const Color &background_color() const;
 
+    /**
+     * \brief Composite the canvas through NanoVG instead of rendering it in
+     * the middle of the widget pass?
+     *
+     * By default, \ref draw() flushes all NanoVG geometry queued so far,
+     * renders the canvas contents, and then continues with the remaining
+     * widgets. With many canvases on screen, these flushes dominate the cost
+     * of drawing the user interface.
+     *
+     * In composite mode, the canvas instead renders into an offscreen
+     * texture before the NanoVG frame begins (see \ref render_offscreen()),
+     * and \ref draw() merely fills its area with an image paint that
+     * references this texture. NanoVG then submits the entire user
+     * interface at once. The offscreen color target is obtained from
+     * \ref Screen::texture_pool().
+     *
+     * Changing this setting re-creates the render pass (see
+     * \ref render_pass_changed()).
+     */
+    void set_composite(bool composite);
+
+    /// Is the canvas composited through NanoVG? (see \ref set_composite())
+    bool composite() const { return m_composite; }
+
+    /**
+     * \brief Render the canvas contents into its offscreen target
+     *
+     * Only applies in composite mode, where it is invoked by \ref Screen
+     * for all visible canvases before the NanoVG frame begins.
+     */
+    void render_offscreen();
+
+    /**
+     * \brief Skip drawing the canvas contents until a shader created in
+     * deferred mode has finished compiling
+     *
+     * While any such shader is pending, the canvas is merely cleared and
+     * \ref draw_contents() is not invoked. The shaders are polled via
+     * \ref Shader::ready() in subsequent frames.
+     */
+    void add_pending_shader(Shader *shader);
+
     /// Draw the widget contents. Override this method.
     virtual void draw_contents();
 
     /// Draw the widget
     virtual void draw(NVGcontext *ctx) override;
 
+protected:
+    virtual ~Canvas();
+
+    /// (Re-)create the render pass and its targets
+    void init_render_pass();
+
+    /**
+     * \brief Invoked after \ref set_composite() replaced the render pass
+     *
+     * Shaders are tied to the render pass they were created for. Subclasses
+     * that create shaders must override this function to re-create them.
+     */
+    virtual void render_pass_changed() { }
+
+    /// Return the size of the region rendered by \ref draw_contents() in pixels
+    Vector2i framebuffer_size() const;
+
+    /// Return the single-sample texture that \ref draw() composites
+    Texture *composite_texture();
+
+    /**
+     * \brief Poll the shaders registered via \ref add_pending_shader() and
+     * return whether all of them are ready
+     *
+     * Requests another redraw while some are still compiling.
+     */
+    bool shaders_ready();
+
 protected:
     ref<RenderPass> m_render_pass;
-#if defined(NANOGUI_USE_METAL)
+    /// Resolves multisampled output (Metal, or in composite mode)
     ref<RenderPass> m_render_pass_resolved;
-#endif
     bool m_draw_border;
     Color m_border_color;
     bool m_render_to_texture;
+
+    uint8_t m_samples;
+    bool m_has_depth_buffer;
+    bool m_has_stencil_buffer;
+    bool m_clear;
+    bool m_composite = false;
+
+    /// NanoVG image wrapping \ref composite_texture() (or -1)
+    int m_nvg_image = -1;
+    /// Texture and size that \c m_nvg_image was created for
+    const Texture *m_nvg_image_texture = nullptr;
+    Vector2i m_nvg_image_size { 0 };
+
+    /// Shaders that must finish compiling before the contents are drawn
+    std::vector<ref<Shader>> m_pending_shaders;
 };
 
 NAMESPACE_END(nanogui)
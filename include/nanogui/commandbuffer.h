@@ -0,0 +1,183 @@
+/*
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+/**
+ * \file nanogui/commandbuffer.h
+ *
+ * \brief Defines a recorded sequence of rendering commands that can be built
+ * on any thread and replayed later on the rendering thread.
+ */
+
+#pragma once
+
+#include <nanogui/shader.h>
+#include <nanogui/renderpass.h>
+#include <nanogui/texture.h>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class CommandBuffer commandbuffer.h nanogui/commandbuffer.h
+ *
+ * \brief Records render pass, shader, uniform, buffer, texture, and draw
+ * commands for later execution
+ *
+ * Commands and their arguments (including copies of uniform and buffer
+ * contents) are appended to a compact linear arena. Recording does not
+ * issue any OpenGL/GLES/Metal API calls, hence several command buffers can
+ * be recorded concurrently on worker threads, e.g. to prepare heavy \ref
+ * Canvas content using all cores. A single command buffer must only be
+ * recorded by one thread at a time.
+ *
+ * \ref replay() then executes one or more command buffers in order on the
+ * thread owning the rendering context. Redundant work is skipped on the
+ * way: uniform and texture assignments that match the current value are
+ * dropped, and an \ref end_shader() / \ref begin_shader() (or \ref
+ * end_pass() / \ref begin_pass() for passes that do not clear) pair
+ * referring to the same object is elided.
+ *
+ * Shader parameters can be referenced by name or by a handle obtained from
+ * \ref Shader::binding(). Names are resolved during replay, which is
+ * preferable on worker threads since \ref Shader::binding() may need to
+ * wait for a pending shader compilation.
+ *
+ * The recorded commands can be inspected via \ref command_count(), \ref
+ * command_type(), and \ref to_string(), which does not require a GPU.
+ */
+class NANOGUI_EXPORT CommandBuffer : public Object {
+public:
+    using PrimitiveType = Shader::PrimitiveType;
+
+    /// Types of recorded commands
+    enum class CommandType : uint32_t {
+        BeginPass,
+        EndPass,
+        BeginShader,
+        EndShader,
+        SetBuffer,
+        SetTexture,
+        DrawArray
+    };
+
+    /// Create an empty command buffer
+    CommandBuffer() = default;
+
+    /// Begin the render pass \c render_pass (see \ref RenderPass::begin())
+    void begin_pass(RenderPass *render_pass);
+
+    /// Finish the current render pass (see \ref RenderPass::end())
+    void end_pass();
+
+    /// Begin drawing using \c shader (see \ref Shader::begin())
+    void begin_shader(Shader *shader);
+
+    /// End drawing using the current shader (see \ref Shader::end())
+    void end_shader();
+
+    /// Record a call to \ref Shader::set_buffer(); the data is copied
+    void set_buffer(Shader *shader, const std::string &name, VariableType type,
+                    size_t ndim, const size_t *shape, const void *data);
+
+    /// Record a call to \ref Shader::set_buffer() with a handle obtained from \ref Shader::binding()
+    void set_buffer(Shader *shader, size_t binding, VariableType type,
+                    size_t ndim, const size_t *shape, const void *data);
+
+    /// Record a call to \ref Shader::set_uniform(); the value is copied
+    template <typename Array> void set_uniform(Shader *shader, const std::string &name,
+                                               const Array &value) {
+        size_t shape[3] = { 1, 1, 1 };
+        const void *data;
+        VariableType vtype;
+        size_t ndim = Shader::uniform_layout(value, vtype, shape, data);
+        if (ndim == (size_t) -1)
+            throw std::runtime_error("CommandBuffer::set_uniform(): invalid input array dimension!");
+        set_buffer(shader, name, vtype, ndim, shape, data);
+    }
+
+    /// Record a call to \ref Shader::set_uniform() with a handle obtained from \ref Shader::binding()
+    template <typename Array> void set_uniform(Shader *shader, size_t binding,
+                                               const Array &value) {
+        size_t shape[3] = { 1, 1, 1 };
+        const void *data;
+        VariableType vtype;
+        size_t ndim = Shader::uniform_layout(value, vtype, shape, data);
+        if (ndim == (size_t) -1)
+            throw std::runtime_error("CommandBuffer::set_uniform(): invalid input array dimension!");
+        set_buffer(shader, binding, vtype, ndim, shape, data);
+    }
+
+    /// Record a call to \ref Shader::set_texture()
+    void set_texture(Shader *shader, const std::string &name, Texture *texture);
+
+    /// Record a call to \ref Shader::set_texture() with a handle obtained from \ref Shader::binding()
+    void set_texture(Shader *shader, size_t binding, Texture *texture);
+
+    /// Record a call to \ref Shader::draw_array() using the current shader
+    void draw_array(PrimitiveType primitive_type, size_t offset, size_t count,
+                    bool indexed = false);
+
+    /// Record a call to \ref Shader::draw_array_instanced() using the current shader
+    void draw_array_instanced(PrimitiveType primitive_type, size_t offset,
+                              size_t count, size_t instance_count,
+                              bool indexed = false);
+
+    /// Remove all commands (retains the allocated memory)
+    void clear();
+
+    /// Preallocate \c size bytes of command storage
+    void reserve(size_t size) { m_arena.reserve(size); }
+
+    /// Return the number of recorded commands
+    size_t command_count() const { return m_offsets.size(); }
+
+    /// Return the type of the command with the given index
+    CommandType command_type(size_t index) const;
+
+    /// Return the number of bytes used by the recorded commands
+    size_t size() const { return m_arena.size(); }
+
+    /// Return a human-readable listing of the recorded commands
+    std::string to_string() const;
+
+    /**
+     * \brief Execute the recorded commands
+     *
+     * Must be called on the thread owning the rendering context. Render
+     * passes and shaders that are still active at the end of the command
+     * buffer are finished automatically.
+     */
+    void replay() const;
+
+    /// Execute several command buffers in order, eliding redundant state changes between them
+    static void replay(const std::vector<ref<CommandBuffer>> &buffers);
+
+protected:
+    /// Release all resources
+    virtual ~CommandBuffer() = default;
+
+    /// Append a command with a payload of \c size bytes and return the latter
+    uint8_t *append(CommandType type, size_t size);
+
+    /// Append a command referencing a shader parameter
+    uint8_t *append_binding(CommandType type, Shader *shader, size_t binding,
+                            const std::string &name, size_t size);
+
+    /// Keep \c object alive until the command buffer is cleared
+    void retain(Object *object);
+
+protected:
+    std::vector<uint8_t> m_arena;
+    std::vector<uint32_t> m_offsets;
+    std::vector<ref<Object>> m_objects;
+    RenderPass *m_render_pass = nullptr;
+    Shader *m_shader = nullptr;
+};
+
+NAMESPACE_END(nanogui)
@@ -148,8 +148,11 @@ class Canvas;
 class ColorWheel;
 class ColorPicker;
 class ComboBox;
+class CommandBuffer;
+class FrameProfiler;
 class GLFramebuffer;
 class GLShader;
+class GLState;
 class GridLayout;
 class GroupLayout;
 class ImagePanel;
@@ -162,18 +165,23 @@ class Object;
 class Popup;
 class PopupButton;
 class ProgressBar;
+class RenderDevice;
 class RenderPass;
 class Shader;
 class Screen;
 class Serializer;
 class Slider;
+class StreamingTexture;
 class TabWidgetBase;
 class TabWidget;
 class TextBox;
 class TextArea;
 class Texture;
+class TextureLoader;
+class TexturePool;
 class Theme;
 class ToolButton;
+class VertexBuffer;
 class VScrollPanel;
 class Widget;
 class Window;
@@ -199,11 +207,16 @@ extern NANOGUI_EXPORT void shutdown();
 /**
  * \brief Enter the application main loop
  *
+ * The main loop only draws screens that requested a redraw, e.g. in
+ * response to keyboard/mouse/.. events, via \ref Screen::redraw(), or
+ * because a periodic frame is due (see \ref Screen::set_target_frame_rate()).
+ * Between iterations, it sleeps until the next event arrives or the next
+ * periodic frame of any screen is due.
+ *
  * \param refresh
- *     NanoGUI issues a redraw call whenever an keyboard/mouse/.. event is
- *     received. In the absence of any external events, it enforces a redraw
- *     once every ``refresh`` milliseconds. To disable the refresh timer,
- *     specify a negative value here.
+ *     In the absence of any external events, the main loop redraws screens
+ *     without a target frame rate once every ``refresh`` milliseconds. To
+ *     disable the refresh timer, specify a negative value here.
  *
  * \param detach
  *     This parameter only exists in the Python bindings. When the active
@@ -245,7 +258,9 @@ extern NANOGUI_EXPORT bool active();
  * the application is redrawn the next time.
  *
  * NanoGUI is not thread-safe, and async() provides a mechanism
- * for queuing up UI-related state changes from other threads.
+ * for queuing up UI-related state changes from other threads. The main loop
+ * is woken up to run the function. Values that change frequently can
+ * instead be handed over without locking via \ref Published.
  */
 extern NANOGUI_EXPORT void async(const std::function<void()> &func);
 
@@ -310,6 +325,19 @@ extern NANOGUI_EXPORT std::string utf8(uint32_t c);
 extern NANOGUI_EXPORT std::vector<std::pair<int, std::string>>
     load_image_directory(NVGcontext *ctx, const std::string &path);
 
+/**
+ * \brief Asynchronous variant of \ref load_image_directory()
+ *
+ * The PNG images are decoded by the worker threads of \c loader and uploaded
+ * to the GPU within its per-frame budget. \c callback is invoked on the main
+ * thread once per image with the NanoVG image handle (\c 0 if the image
+ * could not be loaded) and the file name without extension. Returns the
+ * number of images that were enqueued.
+ */
+extern NANOGUI_EXPORT size_t load_image_directory_async(
+    NVGcontext *ctx, const std::string &path, TextureLoader *loader,
+    const std::function<void(int, const std::string &)> &callback);
+
 /// Convenience function for instanting a PNG icon from the application's data segment (via bin2c)
 #define nvgImageIcon(ctx, name) nanogui::__nanogui_get_image(ctx, #name, name##_png, name##_png_size)
 /// Helper function used by nvg_image_icon
@@ -0,0 +1,148 @@
+/*
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/**
+ * \file nanogui/frameprofiler.h
+ *
+ * \brief CPU and GPU timings of the passes that render a frame.
+ */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <nanogui/vector.h>
+
+struct NVGcontext;
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class FrameProfiler frameprofiler.h nanogui/frameprofiler.h
+ *
+ * \brief Measures the CPU and GPU time spent in the passes of each frame
+ *
+ * A \ref Screen with profiling enabled (see \ref Screen::set_profiling())
+ * records a scope for its \ref Screen::draw_contents() and NanoVG widget
+ * passes, and every \ref RenderPass adds a scope between its \ref
+ * RenderPass::begin() and \ref RenderPass::end() calls (named after its
+ * \ref RenderPass::label()).
+ *
+ * Timings are exclusive: while a scope is nested in another one (e.g. a
+ * canvas that is drawn in the middle of the widget pass), its time is only
+ * attributed to the nested scope.
+ *
+ * On OpenGL, the GPU time of each scope is measured using
+ * <tt>GL_TIME_ELAPSED</tt> queries. These are collected in a ring that
+ * holds the queries of several frames, and their results are only read
+ * once they are available, which usually happens \ref latency() frames
+ * later. \ref stats() hence refers to an earlier frame that is identified
+ * by \ref Stats::frame. Other backends only report CPU timings.
+ */
+class NANOGUI_EXPORT FrameProfiler : public Object {
+public:
+    /// Timings of a scope (in milliseconds)
+    struct Timing {
+        std::string name;
+        float cpu_time = 0.f;
+        /// GPU time, or -1 if it is unavailable
+        float gpu_time = -1.f;
+    };
+
+    /// Timings of a frame (in milliseconds)
+    struct Stats {
+        /// Index of the frame (starting at 1, or 0 if no frame was measured yet)
+        uint64_t frame = 0;
+        /// CPU time between \ref begin_frame() and \ref end_frame()
+        float cpu_time = 0.f;
+        /// Sum of the GPU time of all scopes, or -1 if it is unavailable
+        float gpu_time = -1.f;
+        /// Timings of the scopes in the order in which they were entered
+        std::vector<Timing> timings;
+    };
+
+    /**
+     * \brief Create a new frame profiler
+     *
+     * \param gpu_timers
+     *     Measure GPU timings using timer queries? Must only be \c true if
+     *     an OpenGL context is current. Ignored by other backends.
+     *
+     * \param latency
+     *     Number of frames after which the GPU timings of a frame are
+     *     expected to be available. If they are not, \ref begin_frame()
+     *     waits for them before reusing the queries of that frame.
+     */
+    FrameProfiler(bool gpu_timers, uint32_t latency = 3);
+
+    /// Are GPU timings measured?
+    bool gpu_timers() const { return m_gpu_timers; }
+
+    /// Return the number of frames after which the GPU timings are read
+    uint32_t latency() const { return (uint32_t) m_frames.size() - 1; }
+
+    /// Begin measuring a new frame
+    void begin_frame();
+
+    /// Finish the current frame and publish the timings that are available
+    void end_frame();
+
+    /// Enter a scope (nested in the current one, if any)
+    void push(const std::string &name);
+
+    /// Leave the scope entered by the last call to \ref push()
+    void pop();
+
+    /// Return the timings of the most recent frame whose measurements are complete
+    const Stats &stats() const { return m_stats; }
+
+    /// Draw \ref stats() as a table whose upper left corner is at \c pos
+    void draw_overlay(NVGcontext *ctx, const Vector2f &pos) const;
+
+    /// Return the profiler of the frame drawn by the calling thread (if any)
+    static FrameProfiler *current();
+
+    /// Set the profiler that \ref RenderPass instances on the calling thread report to
+    static void set_current(FrameProfiler *profiler);
+
+protected:
+    virtual ~FrameProfiler();
+
+    /// Measurements of a frame that are still in flight
+    struct Frame {
+        Stats stats;
+        /// Timer queries (grows as needed) and the scope measured by each
+        std::vector<uint32_t> queries;
+        std::vector<uint32_t> query_scopes;
+        /// Number of queries used by this frame
+        size_t query_count = 0;
+        /// Are there query results that were not read yet?
+        bool pending = false;
+    };
+
+    /// Close the current segment of the innermost scope
+    void end_segment();
+    /// Begin a new segment of the innermost scope
+    void begin_segment();
+    /// Read the query results of a frame (optionally waiting for them)
+    bool resolve(Frame &frame, bool wait);
+    /// Make the timings of a frame available via \ref stats()
+    void publish(Frame &frame);
+
+protected:
+    bool m_gpu_timers;
+    std::vector<Frame> m_frames;
+    size_t m_index = 0;
+    uint64_t m_frame_count = 0;
+    bool m_active = false;
+    double m_frame_start = 0.0, m_segment_start = 0.0;
+    /// Indices of the currently entered scopes in \ref Stats::timings
+    std::vector<uint32_t> m_stack;
+    Stats m_stats;
+};
+
+NAMESPACE_END(nanogui)
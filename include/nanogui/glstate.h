@@ -0,0 +1,181 @@
+/*
+    nanogui/glstate.h -- Shadow copy of frequently changed OpenGL state
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/vector.h>
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class GLState glstate.h nanogui/glstate.h
+ *
+ * \brief Shadow copy of the OpenGL state that is frequently changed by
+ * \ref RenderPass, \ref Shader, \ref Texture, and \ref Screen
+ *
+ * State changes issued through this class are skipped when the shadow copy
+ * shows that they would have no effect, and getters answer from the shadow
+ * copy instead of performing a <tt>glGet*()</tt> round trip, which stalls
+ * the pipeline on many drivers. Only values that are unknown (e.g. following
+ * a call to \ref invalidate()) are queried from OpenGL.
+ *
+ * Each \ref Screen owns an instance for its context and makes it current
+ * along with the context. The shadow copy goes stale when OpenGL state is
+ * changed by other means. NanoGUI accounts for this in the case of NanoVG,
+ * but applications that issue raw OpenGL calls (e.g. within
+ * \ref Canvas::draw_contents()) must call \ref invalidate() afterwards.
+ */
+class NANOGUI_EXPORT GLState {
+public:
+    /// Capabilities toggled via <tt>glEnable()</tt>/<tt>glDisable()</tt>
+    enum class Capability : uint8_t {
+        DepthTest = 0,
+        ScissorTest,
+        CullFace,
+        Blend,
+#if defined(NANOGUI_USE_OPENGL)
+        ProgramPointSize,
+#endif
+        Count
+    };
+
+    /// Create a shadow copy where all state is unknown
+    GLState();
+
+    /**
+     * \brief Return the state of the OpenGL context that is current on the
+     * calling thread
+     *
+     * Returns a shared fallback instance if no state was made current.
+     */
+    static GLState *current();
+
+    /// Set the state associated with the context that is current on the calling thread
+    static void set_current(GLState *state);
+
+    /// Forget all shadowed values, e.g. after OpenGL was used directly
+    void invalidate();
+
+    /**
+     * \brief Invalidate the shadow copy and establish a known baseline state
+     *
+     * All capabilities are disabled, writes to the depth buffer are enabled,
+     * no program, vertex array, or framebuffer is bound, texture unit 0 is
+     * active, and the viewport and scissor rectangle cover the framebuffer.
+     * This only issues state changes (no queries) and is used by
+     * \ref Screen at the beginning of a frame and after NanoVG has rendered.
+     */
+    void reset(const Vector2i &framebuffer_size);
+
+    /// Query whether a capability is enabled
+    bool enabled(Capability cap);
+
+    /// Enable or disable a capability
+    void set_enabled(Capability cap, bool value);
+
+    /// Query whether writes to the depth buffer are enabled
+    bool depth_mask();
+
+    /// Enable or disable writes to the depth buffer
+    void set_depth_mask(bool value);
+
+    /// Set the depth comparison function (e.g. \c GL_LESS)
+    void set_depth_func(uint32_t func);
+
+    /// Set the faces that are culled (\c GL_FRONT or \c GL_BACK)
+    void set_cull_face(uint32_t mode);
+
+    /// Set the blending factors
+    void set_blend_func(uint32_t src, uint32_t dst);
+
+    /// Return the viewport (x, y, width, height)
+    const Vector4i &viewport();
+
+    /// Set the viewport (x, y, width, height)
+    void set_viewport(const Vector4i &viewport);
+
+    /// Return the scissor rectangle (x, y, width, height)
+    const Vector4i &scissor();
+
+    /// Set the scissor rectangle (x, y, width, height)
+    void set_scissor(const Vector4i &scissor);
+
+    /// Bind a shader program
+    void use_program(uint32_t program);
+
+#if defined(NANOGUI_USE_OPENGL)
+    /// Bind a vertex array object
+    void bind_vertex_array(uint32_t vertex_array);
+#endif
+
+    /**
+     * \brief Bind a framebuffer
+     *
+     * \param target
+     *     \c GL_FRAMEBUFFER, \c GL_READ_FRAMEBUFFER, or \c GL_DRAW_FRAMEBUFFER
+     */
+    void bind_framebuffer(uint32_t target, uint32_t framebuffer);
+
+    /// Select the active texture unit (\c 0, \c 1, ..., not \c GL_TEXTURE0 + i)
+    void active_texture(uint32_t unit);
+
+    /**
+     * \brief Bind a 2D texture to the active texture unit
+     *
+     * \param force
+     *     Issue the call even if the shadow copy indicates that the texture
+     *     is already bound. Used by \ref Texture before modifying textures,
+     *     as NanoVG also binds textures when creating images.
+     */
+    void bind_texture(uint32_t texture, bool force = false);
+
+    /// Notify the shadow copy that a texture was deleted
+    void texture_deleted(uint32_t texture);
+
+    /// Notify the shadow copy that a program was deleted
+    void program_deleted(uint32_t program);
+
+#if defined(NANOGUI_USE_OPENGL)
+    /// Notify the shadow copy that a vertex array object was deleted
+    void vertex_array_deleted(uint32_t vertex_array);
+#endif
+
+    /// Notify the shadow copy that a framebuffer was deleted
+    void framebuffer_deleted(uint32_t framebuffer);
+
+protected:
+    /// Marks shadowed values that must be queried or set unconditionally
+    static constexpr uint32_t Unknown = 0xFFFFFFFFu;
+    /// Number of texture units whose bindings are shadowed
+    static constexpr uint32_t TextureUnits = 16;
+
+    int8_t m_enabled[(int) Capability::Count];
+    int8_t m_depth_mask;
+    uint32_t m_depth_func;
+    uint32_t m_cull_face;
+    uint32_t m_blend_src, m_blend_dst;
+    Vector4i m_viewport, m_scissor;
+    bool m_viewport_valid, m_scissor_valid;
+    uint32_t m_program;
+#if defined(NANOGUI_USE_OPENGL)
+    uint32_t m_vertex_array;
+#endif
+    uint32_t m_read_framebuffer, m_draw_framebuffer;
+    uint32_t m_active_texture;
+    uint32_t m_texture[TextureUnits];
+};
+
+NAMESPACE_END(nanogui)
+
+#endif
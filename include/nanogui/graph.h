@@ -13,6 +13,7 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <nanogui/published.h>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -46,16 +47,66 @@ public:
     const Color &text_color() const { return m_text_color; }
     void set_text_color(const Color &text_color) { m_text_color = text_color; }
 
-    const std::vector<float> &values() const { return m_values; }
-    std::vector<float> &values() { return m_values; }
-    void set_values(const std::vector<float> &values) { m_values = values; }
+    /// Return the plotted samples (oldest first)
+    const std::vector<float> &values() const { linearize(); return m_values; }
+    std::vector<float> &values() { linearize(); return m_values; }
+    void set_values(const std::vector<float> &values);
+
+    /**
+     * \brief Return the capacity of the streaming ring buffer
+     *
+     * A value of zero (the default) means that \ref push() appends without
+     * bound. Otherwise, pushing more than \c capacity samples overwrites the
+     * oldest ones.
+     */
+    size_t capacity() const { return m_capacity; }
+
+    /// Set the capacity of the streaming ring buffer (keeps the most recent samples)
+    void set_capacity(size_t capacity);
+
+    /// Append a single sample
+    void push(float value);
+
+    /// Append \c count samples stored contiguously at \c values
+    void push(const float *values, size_t count);
+
+    /// Append a sequence of samples
+    void push(const std::vector<float> &values) { push(values.data(), values.size()); }
+
+    /// Remove all samples
+    void clear();
+
+    /**
+     * \brief Replace the samples from a worker thread without locking
+     *
+     * The samples are picked up when the graph is drawn next (see \ref
+     * Published), where they take the place of \ref values(). Follow up
+     * with \ref Screen::redraw() to display them.
+     */
+    void publish_values(const std::vector<float> &values) { m_published_values.publish(values); }
 
     virtual Vector2i preferred_size(NVGcontext *ctx) const override;
     virtual void draw(NVGcontext *ctx) override;
+protected:
+    /// Rotate the ring buffer so that the oldest sample is stored first
+    void linearize() const;
+
+    /// Emit the graph outline, decimated to at most two vertices per pixel column
+    void draw_samples(NVGcontext *ctx) const;
+
+    /// Drop the oldest samples beyond the capacity (e.g. added via \ref values())
+    void trim_to_capacity();
+
 protected:
     std::string m_caption, m_header, m_footer;
     Color m_background_color, m_fill_color, m_stroke_color, m_text_color;
-    std::vector<float> m_values;
+    /// Sample storage; holds a ring buffer starting at \ref m_head when full
+    mutable std::vector<float> m_values;
+    /// Index of the oldest sample in \ref m_values
+    mutable size_t m_head = 0;
+    size_t m_capacity = 0;
+    /// Samples handed over by \ref publish_values()
+    Published<std::vector<float>> m_published_values;
 };
 
 NAMESPACE_END(nanogui)
@@ -13,9 +13,77 @@
 #pragma once
 
 #include <nanogui/canvas.h>
+#include <nanogui/streamingtexture.h>
+#include <nanogui/texture.h>
+#include <list>
+#include <memory>
+#include <unordered_map>
 
 NAMESPACE_BEGIN(nanogui)
 
+/**
+ * \class TiledImageSource imageview.h nanogui/imageview.h
+ *
+ * \brief Interface for very large images that are loaded tile by tile
+ *
+ * Implementations provide the tiles of a pyramid of LOD levels, where level
+ * \c k is downsampled by a factor of <tt>2^k</tt> along both axes (rounding
+ * up), and each level is partitioned into square tiles of \ref tile_size()
+ * pixels. Tiles along the right and bottom boundary may be smaller.
+ *
+ * \ref load_tile() is invoked on background threads, and potentially on
+ * several of them at the same time.
+ */
+class NANOGUI_EXPORT TiledImageSource : public Object {
+public:
+    /// Return the size of the full-resolution image (level 0)
+    virtual Vector2i size() const = 0;
+
+    /// Return the size of a tile in pixels (default: 256)
+    virtual int tile_size() const { return 256; }
+
+    /// Return the pixel format of the tiles (default: RGBA)
+    virtual Texture::PixelFormat pixel_format() const {
+        return Texture::PixelFormat::RGBA;
+    }
+
+    /// Return the component format of the tiles (default: 8 bit unsigned integer)
+    virtual Texture::ComponentFormat component_format() const {
+        return Texture::ComponentFormat::UInt8;
+    }
+
+    /**
+     * \brief Return the number of LOD levels
+     *
+     * The default implementation adds levels until the coarsest one fits
+     * into a single tile.
+     */
+    virtual int level_count() const;
+
+    /// Return the size of the given LOD level
+    Vector2i level_size(int level) const;
+
+    /**
+     * \brief Decode a tile into tightly packed pixel storage
+     *
+     * \param level
+     *     The LOD level
+     *
+     * \param tile
+     *     The tile index within the level
+     *
+     * \param size
+     *     The size of the tile in pixels
+     *
+     * \param data
+     *     Output buffer that can hold <tt>size.x() * size.y()</tt> pixels
+     *
+     * \return \c false if the tile could not be loaded
+     */
+    virtual bool load_tile(int level, const Vector2i &tile, const Vector2i &size,
+                           uint8_t *data) = 0;
+};
+
 /**
  * \class ImageView imageview.h nanogui/imageview.h
  *
@@ -26,9 +94,22 @@ class NANOGUI_EXPORT ImageView : public Canvas {
 public:
     using PixelCallback = std::function<void(const Vector2i &, char **, size_t)>;
 
+    /**
+     * \brief Callback that provides information about a rectangle of pixels
+     *
+     * The arguments specify the first pixel, the size of the rectangle, an
+     * array of <tt>4 * size.x() * size.y()</tt> output strings (four channels
+     * per pixel, stored in row-major order), and the capacity of each string.
+     */
+    using BatchPixelCallback = std::function<void(const Vector2i &, const Vector2i &,
+                                                  char **, size_t)>;
+
     /// Initialize the widget
     ImageView(Widget *parent);
 
+    /// Release all resources
+    virtual ~ImageView();
+
     /// Return the currently active image
     Texture *image() { return m_image; }
     /// Return the currently active image (const version)
@@ -36,6 +117,38 @@ public:
     /// Set the currently active image
     void set_image(Texture *image);
 
+    /**
+     * \brief Display a continuously updated image (e.g. a live video feed)
+     *
+     * The widget requests a redraw whenever a producer submits a new frame
+     * and displays the most recent frame in each redraw.
+     */
+    void set_image(StreamingTexture *image);
+
+    /// Return the currently active streaming image (if any)
+    StreamingTexture *streaming_image() { return m_stream; }
+
+    /// Return the currently active tiled image (if any)
+    TiledImageSource *tiled_image() { return m_tile_source; }
+
+    /**
+     * \brief Display a tiled image
+     *
+     * Only the tiles covering the visible region are loaded, using the LOD
+     * level that matches the current magnification. Tiles are decoded on
+     * background threads and subsequently uploaded into a cache holding up
+     * to \c cache_size tiles in GPU memory, where the least recently used
+     * tiles are evicted first. While a tile is still loading, the widget
+     * displays the closest coarser level that is available.
+     *
+     * This makes it possible to display images that exceed the maximum
+     * texture size or the amount of GPU memory.
+     */
+    void set_tiled_image(TiledImageSource *source, size_t cache_size = 512);
+
+    /// Return the size of the active image in pixels
+    Vector2i image_size() const;
+
     /// Center the image on the screen
     void center();
 
@@ -45,10 +158,35 @@ public:
     /// Set the callback that is used to acquire information about pixel components
     void set_pixel_callback(const PixelCallback &pixel_callback) {
         m_pixel_callback = pixel_callback;
+        invalidate_pixel_info();
     }
     /// Return the callback that is used to acquire information about pixel components
     const PixelCallback &pixel_callback() const { return m_pixel_callback; }
 
+    /**
+     * \brief Set a callback that acquires information about all visible
+     * pixels at once
+     *
+     * This is considerably more efficient than \ref set_pixel_callback()
+     * when the callback must e.g. download texture data from the GPU. When
+     * both callbacks are specified, the batched version takes precedence.
+     */
+    void set_batch_pixel_callback(const BatchPixelCallback &batch_pixel_callback) {
+        m_batch_pixel_callback = batch_pixel_callback;
+        invalidate_pixel_info();
+    }
+    /// Return the callback that acquires information about all visible pixels at once
+    const BatchPixelCallback &batch_pixel_callback() const { return m_batch_pixel_callback; }
+
+    /**
+     * \brief Discard cached pixel information
+     *
+     * The strings returned by the pixel callbacks are cached as long as the
+     * set of visible pixels does not change. Call this function after
+     * modifying the contents of the image.
+     */
+    void invalidate_pixel_info() { m_pixel_info_size = Vector2i(0); }
+
     /// Return the pixel offset of the zoomed image rectangle
     Vector2f offset() const { return m_offset; }
     /// Set the pixel offset of the zoomed image rectangle
@@ -71,15 +209,68 @@ public:
     virtual void draw(NVGcontext *ctx) override;
     virtual void draw_contents() override;
 
+protected:
+    struct TileLoader;
+
+    /// Create the shader used to draw the image
+    void init_shader();
+
+    /// Re-create the shader for the new render pass
+    virtual void render_pass_changed() override;
+
+    /// Is an image (regular or tiled) currently set?
+    bool has_image() const { return m_image || m_tile_source; }
+
+    /// Draw the visible tiles of a tiled image
+    void draw_tiles(const Vector2i &viewport_size);
+
+    /// Draw a single quad covering the image region [origin, origin + extent)
+    void draw_quad(Texture *texture, const Vector2f &origin, const Vector2f &extent,
+                   const Vector2i &viewport_size);
+
+    /// Stop the background threads loading tiles and clear the tile cache
+    void release_tiles();
+
+    /// Detach from the current streaming image (if any)
+    void release_stream();
+
 protected:
     nanogui::ref<Shader> m_image_shader;
+    /// Handles of frequently updated shader parameters
+    size_t m_image_binding = 0;
+    size_t m_matrix_image_binding = 0;
+    size_t m_matrix_background_binding = 0;
     nanogui::ref<Texture> m_image;
+    nanogui::ref<StreamingTexture> m_stream;
+    /// Does \ref m_stream already redraw the screen when a frame arrives?
+    bool m_stream_screen = false;
     float m_scale = 0;
     Vector2f m_offset = 0;
     bool m_draw_image_border;
     Color m_image_border_color;
     Color m_image_background_color;
     PixelCallback m_pixel_callback;
+    BatchPixelCallback m_batch_pixel_callback;
+
+    /// Query pixel information for a rectangle (unless already cached)
+    void update_pixel_info(const Vector2i &start, const Vector2i &size);
+
+    /// Cached pixel information: text storage, string pointers, and rectangle
+    std::vector<char> m_pixel_info;
+    std::vector<char *> m_pixel_info_text;
+    Vector2i m_pixel_info_start = 0, m_pixel_info_size = 0;
+
+    /* Tiled image state */
+    struct TileCacheEntry {
+        uint64_t key;
+        nanogui::ref<Texture> texture;
+    };
+    nanogui::ref<TiledImageSource> m_tile_source;
+    /// Tile cache, ordered from most to least recently used
+    std::list<TileCacheEntry> m_tile_lru;
+    std::unordered_map<uint64_t, std::list<TileCacheEntry>::iterator> m_tile_map;
+    size_t m_tile_cache_size = 0;
+    std::unique_ptr<TileLoader> m_tile_loader;
 };
 
 NAMESPACE_END(nanogui)
@@ -13,6 +13,7 @@
 
 #include <nanogui/common.h>
 #include <nanogui/metal.h>
+#include <nanogui/null.h>
 #include <nanogui/widget.h>
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
@@ -38,7 +39,18 @@
 #include <nanogui/formhelper.h>
 #include <nanogui/tabwidget.h>
 #include <nanogui/texture.h>
+#include <nanogui/textureloader.h>
+#include <nanogui/texturepool.h>
+#include <nanogui/streamingtexture.h>
+#include <nanogui/published.h>
 #include <nanogui/shader.h>
+#include <nanogui/vertexbuffer.h>
 #include <nanogui/renderpass.h>
+#include <nanogui/commandbuffer.h>
+#include <nanogui/glstate.h>
+#include <nanogui/renderdevice.h>
+#include <nanogui/frameprofiler.h>
+#include <nanogui/softwarerenderer.h>
 #include <nanogui/canvas.h>
 #include <nanogui/imageview.h>
+#include <nanogui/plotcanvas.h>
@@ -0,0 +1,97 @@
+/*
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/**
+ * \file nanogui/null.h
+ *
+ * \brief Statistics and NanoVG support of the null rendering backend.
+ */
+
+#pragma once
+
+#include <nanogui/vector.h>
+
+#if defined(NANOGUI_USE_NULL)
+
+struct NVGcontext;
+
+/// Flags accepted by \ref nanogui::null_nvg_create() (as in the GL/Metal NanoVG backends)
+enum NVGcreateFlags {
+    NVG_ANTIALIAS       = 1 << 0,
+    NVG_STENCIL_STROKES = 1 << 1,
+    NVG_DEBUG           = 1 << 2
+};
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \brief Counters maintained by the null rendering backend
+ *
+ * The null backend implements \ref Texture, \ref Shader, \ref RenderPass,
+ * \ref VertexBuffer, and NanoVG as CPU-side recorders that do not require a
+ * GPU or display. Instead of rendering, they keep track of the resources and
+ * work that a GPU backend would have been asked for, which makes it possible
+ * to run and benchmark widgets and applications on headless machines.
+ *
+ * The first group of fields describes live resources and is maintained
+ * across \ref null_reset_counters() calls. The remaining fields accumulate
+ * until they are reset.
+ */
+struct NullStats {
+    /// Number of live textures and the size of their level 0 in bytes
+    size_t textures = 0, texture_bytes = 0;
+    /// Number of live shaders
+    size_t shaders = 0;
+    /// Number of live render passes
+    size_t render_passes = 0;
+    /// Size of live shader buffers (vertex, index, and uniform data) in bytes
+    size_t buffer_bytes = 0;
+    /// Number of nonempty vertex buffers and their size in bytes
+    size_t vertex_buffers = 0, vertex_buffer_bytes = 0;
+    /// Number of live NanoVG images and their size in bytes
+    size_t nvg_images = 0, nvg_image_bytes = 0;
+
+    /// Number of texture/buffer uploads and the transferred bytes
+    size_t uploads = 0, upload_bytes = 0;
+    /// Number of texture downloads
+    size_t downloads = 0;
+    /// Number of presented frames and framebuffer clears
+    size_t frames = 0, clears = 0;
+    /// Number of render pass and shader activations
+    size_t render_pass_begins = 0, shader_begins = 0;
+    /// Number of draw calls, drawn instances, and drawn vertices/indices
+    size_t draw_calls = 0, instances = 0, elements = 0;
+    /// Number of NanoVG fill, stroke, and triangle batches
+    size_t nvg_fills = 0, nvg_strokes = 0, nvg_triangles = 0;
+    /// Number of paths and vertices submitted by NanoVG
+    size_t nvg_paths = 0, nvg_vertices = 0;
+    /// Number of NanoVG flushes (at least one per frame)
+    size_t nvg_flushes = 0;
+};
+
+/// Return the counters of the null backend (only accessed by the rendering thread)
+extern NANOGUI_EXPORT NullStats &null_stats();
+
+/// Reset the cumulative counters, keeping those of live resources
+extern NANOGUI_EXPORT void null_reset_counters();
+
+/// Create a NanoVG context that records draw calls into \ref null_stats()
+extern NANOGUI_EXPORT NVGcontext *null_nvg_create(int flags);
+
+/// Destroy a NanoVG context created by \ref null_nvg_create()
+extern NANOGUI_EXPORT void null_nvg_delete(NVGcontext *ctx);
+
+/// Wrap the texture with the given handle into a NanoVG image
+extern NANOGUI_EXPORT int null_nvg_image_from_handle(NVGcontext *ctx, uint32_t texture_handle,
+                                                     const Vector2i &size, int flags);
+
+/// Return a process-wide unique identifier for a texture, shader, or framebuffer
+extern NANOGUI_EXPORT uint32_t null_new_handle();
+
+NAMESPACE_END(nanogui)
+#endif
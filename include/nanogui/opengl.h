@@ -35,8 +35,10 @@
 #    define GLFW_INCLUDE_ES3
 #  elif defined(NANOGUI_USE_METAL)
 #  elif defined(NANOGUI_USE_DE)
+#  elif defined(NANOGUI_USE_NULL)
+#    define GLFW_INCLUDE_NONE
 #  else
-#    error You must select a backend (OpenGL/GLES2/GLES3/Metal)
+#    error You must select a backend (OpenGL/GLES2/GLES3/Metal/Null)
 #  endif
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
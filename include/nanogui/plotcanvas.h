@@ -0,0 +1,181 @@
+/*
+    nanogui/plotcanvas.h -- GPU-accelerated widget for plotting large
+    time series
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/canvas.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class PlotCanvas plotcanvas.h nanogui/plotcanvas.h
+ *
+ * \brief Oscilloscope-style widget that plots multiple high-volume time series
+ *
+ * In contrast to \ref Graph, which tessellates its plot using NanoVG, this
+ * widget keeps the samples of each channel in a fixed-capacity ring buffer
+ * that resides in GPU memory. Newly pushed samples are transferred using
+ * sub-range updates (\ref Shader::set_buffer_range()) right before the next
+ * frame is drawn.
+ *
+ * Each channel additionally maintains a pyramid of min/max envelopes, where
+ * level \c k summarizes blocks of <tt>2^k</tt> samples using two vertices.
+ * When drawing, the widget selects the coarsest level that still yields
+ * (at most) two vertices per horizontal pixel and only draws the vertices
+ * that lie within the visible range. Panning and zooming merely change a few
+ * shader uniforms. Axes and tick labels are drawn using NanoVG.
+ *
+ * Horizontal coordinates refer to the index of a sample among all samples
+ * that were ever pushed into its channel.
+ */
+class NANOGUI_EXPORT PlotCanvas : public Canvas {
+public:
+    /**
+     * Create a new plot canvas
+     *
+     * \param parent
+     *     The parent widget
+     *
+     * \param channel_count
+     *     The number of independent data series
+     *
+     * \param capacity
+     *     The number of samples that are retained per channel (this value
+     *     may be rounded up slightly to simplify the LOD pyramid)
+     */
+    PlotCanvas(Widget *parent, size_t channel_count = 1,
+               size_t capacity = 1 << 20);
+
+    /// Return the number of channels
+    size_t channel_count() const { return m_channels.size(); }
+
+    /// Return the number of samples that are retained per channel
+    size_t capacity() const { return m_capacity; }
+
+    /// Return the number of samples currently stored by the given channel
+    size_t size(size_t channel) const;
+
+    /// Return the total number of samples ever pushed into the given channel
+    size_t total(size_t channel) const;
+
+    /// Append a sample to the given channel
+    void push(size_t channel, float value) { push(channel, &value, 1); }
+
+    /// Append \c count contiguous samples to the given channel
+    void push(size_t channel, const float *values, size_t count);
+
+    /// Append a sequence of samples to the given channel
+    void push(size_t channel, const std::vector<float> &values) {
+        push(channel, values.data(), values.size());
+    }
+
+    /// Remove all samples from all channels
+    void clear();
+
+    /// Return the color of the given channel
+    const Color &channel_color(size_t channel) const;
+
+    /// Set the color of the given channel
+    void set_channel_color(size_t channel, const Color &color);
+
+    /// Return the visible horizontal range (lower bound)
+    double x_min() const { return m_x_min; }
+
+    /// Return the visible horizontal range (upper bound)
+    double x_max() const { return m_x_max; }
+
+    /// Set the visible horizontal range (disables \ref follow())
+    void set_x_range(double x_min, double x_max);
+
+    /// Return the visible vertical range
+    const Vector2f &y_range() const { return m_y_range; }
+
+    /// Set the visible vertical range
+    void set_y_range(const Vector2f &y_range) { m_y_range = y_range; }
+
+    /**
+     * \brief Should the visible range track the most recent samples?
+     *
+     * When enabled (the default), the horizontal range keeps its extent but
+     * is shifted so that it ends at the newest sample. Panning the view
+     * using the mouse disables this behavior.
+     */
+    bool follow() const { return m_follow; }
+
+    /// Specify whether the visible range should track the most recent samples
+    void set_follow(bool follow) { m_follow = follow; }
+
+    /// Return the color of the axes and tick labels
+    const Color &axis_color() const { return m_axis_color; }
+
+    /// Set the color of the axes and tick labels
+    void set_axis_color(const Color &axis_color) { m_axis_color = axis_color; }
+
+    /// Return the number of levels of the min/max LOD pyramid
+    size_t level_count() const { return m_level_offset.size(); }
+
+    virtual bool mouse_drag_event(const Vector2i &p, const Vector2i &rel,
+                                  int button, int modifiers) override;
+    virtual bool scroll_event(const Vector2i &p, const Vector2f &rel) override;
+    virtual void draw(NVGcontext *ctx) override;
+    virtual void draw_contents() override;
+
+protected:
+    struct Channel {
+        /// Raw samples (ring buffer)
+        std::vector<float> values;
+        /// Min/max envelope per LOD level (level 0 is unused)
+        std::vector<std::vector<float>> min_values, max_values;
+        /// Ring buffer slot ranges that must be uploaded to the GPU
+        std::vector<std::pair<size_t, size_t>> dirty;
+        /// Slot that will receive the next sample
+        size_t head = 0;
+        /// Number of valid samples
+        size_t size = 0;
+        /// Total number of samples pushed so far
+        size_t total = 0;
+        Color color;
+    };
+
+    /// Create the shader and allocate GPU storage for all channels
+    void init_shader();
+
+    /// Re-create the shader and re-upload all samples for the new render pass
+    virtual void render_pass_changed() override;
+
+    /// Mark a range of ring buffer slots as modified
+    void mark_dirty(Channel &channel, size_t begin, size_t end);
+
+    /// Recompute the LOD pyramid over a range of slots and upload it
+    void update_range(size_t index, size_t begin, size_t end);
+
+    /// Draw the axes and tick labels
+    void draw_axes(NVGcontext *ctx);
+
+protected:
+    ref<Shader> m_shader;
+    std::vector<Channel> m_channels;
+    /// Offset of each LOD level within the vertex range of a channel
+    std::vector<size_t> m_level_offset;
+    /// Number of vertices per channel (summed over all levels)
+    size_t m_channel_vertices = 0;
+    size_t m_capacity = 0;
+    double m_x_min = 0.0, m_x_max = 1000.0;
+    Vector2f m_y_range { -1.f, 1.f };
+    bool m_follow = true;
+    Color m_axis_color;
+    /// Scratch memory for vertex uploads
+    std::vector<float> m_staging;
+};
+
+NAMESPACE_END(nanogui)
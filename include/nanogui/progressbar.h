@@ -13,6 +13,7 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <nanogui/published.h>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -28,10 +29,20 @@ public:
     float value() { return m_value; }
     void set_value(float value) { m_value = value; }
 
+    /**
+     * \brief Set the value from a worker thread without locking
+     *
+     * The value is picked up when the progress bar is drawn next (see \ref
+     * Published). Follow up with \ref Screen::redraw() to display it.
+     */
+    void publish_value(float value) { m_published_value.publish(value); }
+
     virtual Vector2i preferred_size(NVGcontext *ctx) const override;
     virtual void draw(NVGcontext* ctx) override;
 protected:
     float m_value;
+    /// Value handed over by \ref publish_value()
+    Published<float> m_published_value;
 };
 
 NAMESPACE_END(nanogui)
@@ -0,0 +1,101 @@
+/*
+    nanogui/published.h -- Lock-free hand-over of values from a worker
+    thread to the user interface
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/common.h>
+#include <atomic>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class Published published.h nanogui/published.h
+ *
+ * \brief Snapshot of a value that one thread publishes and another thread
+ * (usually the main thread) consumes without locking
+ *
+ * Like \ref StreamingTexture, this class exchanges the value through three
+ * slots: the producer writes into one slot, the most recently published
+ * snapshot waits in the second, and the consumer reads the third. Slots
+ * change hands through a single atomic exchange, hence neither side ever
+ * waits for the other. Snapshots that are superseded before the consumer
+ * picks them up are skipped.
+ *
+ * There may be one producer thread and one consumer thread at a time.
+ * Widgets such as \ref ProgressBar and \ref Graph consume their published
+ * values when they are drawn. Call \ref Screen::redraw(), which may be
+ * invoked from any thread, to draw them promptly.
+ */
+template <typename T> class Published {
+public:
+    Published() = default;
+    explicit Published(const T &value) : m_slots { value, value, value } { }
+
+    Published(const Published &) = delete;
+    Published &operator=(const Published &) = delete;
+
+    /**
+     * \brief Return the slot written by the producer
+     *
+     * Its contents are unspecified (they hold an older snapshot). Modify
+     * it in place and call \ref publish() to hand it over.
+     */
+    T &back() { return m_slots[m_back]; }
+
+    /// Publish the contents of \ref back() (producer)
+    void publish() {
+        uint8_t prev = m_middle.exchange((uint8_t) (m_back | Fresh),
+                                         std::memory_order_acq_rel);
+        m_back = prev & IndexMask;
+    }
+
+    /// Publish a copy of the given value (producer)
+    void publish(const T &value) {
+        back() = value;
+        publish();
+    }
+
+    /**
+     * \brief Fetch the most recently published snapshot (consumer)
+     *
+     * Returns \c true if a new snapshot was published since the last call,
+     * in which case it becomes available via \ref front().
+     */
+    bool update() {
+        if (!(m_middle.load(std::memory_order_relaxed) & Fresh))
+            return false;
+        uint8_t prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = prev & IndexMask;
+        return true;
+    }
+
+    /**
+     * \brief Return the snapshot fetched by the last call to \ref update()
+     * (consumer)
+     *
+     * The consumer may move or swap its contents away.
+     */
+    T &front() { return m_slots[m_front]; }
+    const T &front() const { return m_slots[m_front]; }
+
+private:
+    static constexpr uint8_t IndexMask = 3, Fresh = 4;
+
+    T m_slots[3] { };
+    /// Slots owned by the producer and consumer
+    uint8_t m_back = 0, m_front = 1;
+    /// Slot holding the latest snapshot, plus the \c Fresh bit
+    std::atomic<uint8_t> m_middle { 2 };
+};
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,127 @@
+/*
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/**
+ * \file nanogui/renderdevice.h
+ *
+ * \brief Runtime interface between a \ref Screen and its graphics backend.
+ */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <nanogui/vector.h>
+
+struct NVGcontext;
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class RenderDevice renderdevice.h nanogui/renderdevice.h
+ *
+ * \brief Graphics backend of a \ref Screen, selected at runtime
+ *
+ * A render device creates the window surface and the NanoVG context of a
+ * screen, clears and presents its frames, and makes textures available to
+ * NanoVG. Backends are registered by name and priority. When a screen
+ * creates its window, it tries them in order of decreasing priority until
+ * a window can be created. The graphics API that NanoGUI was compiled for
+ * (e.g. <tt>"opengl"</tt>) has priority 100. Backends with a negative
+ * priority are never tried automatically: they must be selected by name
+ * using the environment variable <tt>NANOGUI_RENDER_DEVICE</tt> (which
+ * selects a single backend instead of the whole list) or passed to \ref
+ * Screen::initialize(). This applies to the CPU renderer of \ref
+ * sw_nvg_create() (<tt>"software"</tt>, priority -1), whose window remains
+ * empty and which does not support \ref Canvas or \ref ImageView unless
+ * NanoGUI was compiled for the Null backend.
+ *
+ * The methods of a render device are invoked once per frame or resize
+ * event. Fine-grained rendering goes through \ref RenderPass, \ref Shader,
+ * and \ref CommandBuffer, which remain implemented for the compiled
+ * graphics API. They are unavailable if \ref supports_shaders() is \c false.
+ *
+ * Applications that bring their own graphics engine (e.g. Diligent Engine)
+ * can implement this interface and pass the device to \ref
+ * Screen::initialize(). The screen then creates, clears, and releases its
+ * NanoVG context through the device.
+ */
+class NANOGUI_EXPORT RenderDevice : public Object {
+public:
+    /// Creates a new render device
+    using Factory = std::function<RenderDevice *()>;
+
+    /// Register a backend (replacing any previous backend with the same name)
+    static void register_backend(const std::string &name, int priority,
+                                 const Factory &factory);
+
+    /**
+     * \brief Return the names of the registered backends in order of
+     * decreasing priority
+     *
+     * Backends with a negative priority are only included if \c opt_in is
+     * \c true.
+     */
+    static std::vector<std::string> backends(bool opt_in = false);
+
+    /// Create a render device of the backend with the given name
+    static ref<RenderDevice> create(const std::string &name);
+
+    /// Return the name of the backend
+    virtual std::string name() const = 0;
+
+    /// Can \ref Texture, \ref Shader, and \ref RenderPass be used with this device?
+    virtual bool supports_shaders() const = 0;
+
+    /**
+     * \brief Set the GLFW window hints selecting the client API
+     *
+     * Called before the screen creates its window. The device may turn off
+     * the stencil or floating point buffers requested by the screen.
+     */
+    virtual void window_hints(Screen *screen, unsigned int gl_major,
+                              unsigned int gl_minor) = 0;
+
+    /// Prepare the window of a screen for rendering (called by \ref Screen::initialize())
+    virtual void init_window(Screen *screen);
+
+    /// Create the NanoVG context of a screen
+    virtual NVGcontext *create_nvg_context(Screen *screen, int flags) = 0;
+
+    /**
+     * \brief Destroy the NanoVG context created by \ref
+     * create_nvg_context() or passed to \ref Screen::initialize() along
+     * with this device
+     */
+    virtual void delete_nvg_context(Screen *screen, NVGcontext *ctx) = 0;
+
+    /// Release the per-screen state when the screen is destroyed
+    virtual void release(Screen *screen);
+
+    /// Acquire the framebuffer of the next frame
+    virtual void begin_frame(Screen *screen);
+
+    /// Clear the framebuffer using the screen's background color
+    virtual void clear(Screen *screen) = 0;
+
+    /// Present the frame
+    virtual void end_frame(Screen *screen);
+
+    /// Notify the device that the framebuffer of a screen was resized
+    virtual void resize(Screen *screen, const Vector2i &fb_size);
+
+    /// Discard cached state that NanoVG or the application may have modified
+    virtual void invalidate_state(Screen *screen);
+
+    /// Create a NanoVG image referencing a texture (used by \ref Canvas)
+    virtual int nvg_image_from_texture(NVGcontext *ctx, Texture *texture) = 0;
+
+protected:
+    virtual ~RenderDevice() = default;
+};
+
+NAMESPACE_END(nanogui)
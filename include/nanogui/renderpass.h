@@ -18,6 +18,7 @@
 
 #include <nanogui/object.h>
 #include <nanogui/vector.h>
+#include <nanogui/texturepool.h>
 #include <unordered_map>
 
 NAMESPACE_BEGIN(nanogui)
@@ -95,6 +96,15 @@ public:
     /// Finish the render pass
     void end();
 
+    /// Return the name under which the render pass is reported to the \ref FrameProfiler
+    const std::string &label() const { return m_label; }
+
+    /// Set the name under which the render pass is reported to the \ref FrameProfiler
+    void set_label(const std::string &label) { m_label = label; }
+
+    /// Does \ref begin() clear all buffers?
+    bool clear() const { return m_clear; }
+
     /// Return the clear color for a given color attachment
     const Color &clear_color(size_t index) const { return m_clear_color.at(index); }
 
@@ -139,9 +149,28 @@ public:
      */
     std::vector<ref<Object>> &targets() { return m_targets; }
 
-    /// Resize all texture targets attached to the render pass
+    /**
+     * \brief Resize all texture targets attached to the render pass
+     *
+     * When a texture pool is attached (see \ref set_texture_pool()), targets
+     * are instead exchanged for pooled textures of a suitable size class
+     * (which may be larger than \c size) whenever the current targets no
+     * longer fit (see \ref TexturePool::fits()). Rendering and blitting
+     * then only involve the upper left region of the requested size.
+     */
     void resize(const Vector2i &size);
 
+    /// Return the texture pool used by \ref resize() (if any)
+    TexturePool *texture_pool() { return m_texture_pool; }
+
+    /**
+     * \brief Obtain resized targets from the given pool
+     *
+     * The render pass releases pooled targets back to the pool when they are
+     * replaced or when the render pass is destroyed.
+     */
+    void set_texture_pool(TexturePool *texture_pool) { m_texture_pool = texture_pool; }
+
     /**
      * Blit the framebuffer to another target (which can either be another \ref
      * RenderPass instance or a \ref Screen instance).
@@ -176,15 +205,20 @@ protected:
     bool m_depth_write;
     CullMode m_cull_mode;
     ref<Object> m_blit_target;
+    ref<TexturePool> m_texture_pool;
     bool m_active;
+    std::string m_label = "RenderPass";
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
     uint32_t m_framebuffer_handle;
-    int m_viewport_backup[4], m_scissor_backup[4];
+    Vector4i m_viewport_backup, m_scissor_backup;
     bool m_depth_test_backup;
     bool m_depth_write_backup;
     bool m_scissor_test_backup;
     bool m_cull_face_backup;
     bool m_blend_backup;
+#  if defined(NANOGUI_USE_OPENGL)
+    bool m_point_size_backup;
+#  endif
 #elif defined(NANOGUI_USE_METAL)
     void *m_command_buffer;
     void *m_command_encoder;
@@ -16,6 +16,11 @@
 
 #include <nanogui/widget.h>
 #include <nanogui/texture.h>
+#include <nanogui/texturepool.h>
+#include <nanogui/glstate.h>
+#include <nanogui/renderdevice.h>
+#include <nanogui/frameprofiler.h>
+#include <atomic>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -30,6 +35,12 @@ class Texture;
 class NANOGUI_EXPORT Screen : public Widget {
     friend class Widget;
     friend class Window;
+    /* Built-in render devices (see renderdevice.cpp) */
+    friend class GLRenderDevice;
+    friend class MetalRenderDevice;
+    friend class NullRenderDevice;
+    friend class ExternalRenderDevice;
+    friend class SoftwareRenderDevice;
 public:
     /**
      * Create a new Screen instance
@@ -41,6 +52,11 @@ public:
      * \param caption
      *     Window title (in UTF-8 encoding)
      *
+     * \param context
+     *     Optional NanoVG context used to draw the widgets instead of one
+     *     created for the graphics backend, e.g. a software renderer created
+     *     by \ref sw_nvg_create(). The caller retains ownership.
+     *
      * \param resizable
      *     If creating a window, should it be resizable?
      *
@@ -110,9 +126,91 @@ public:
     /// Return the framebuffer size (potentially larger than size() on high-DPI screens)
     const Vector2i &framebuffer_size() const { return m_fbsize; }
 
-    /// Send an event that will cause the screen to be redrawn at the next event loop iteration
+    /**
+     * \brief Send an event that will cause the screen to be redrawn at the
+     * next event loop iteration
+     *
+     * May be called from any thread. Repeated calls before the next frame
+     * is drawn are coalesced into a single wake-up of the main loop.
+     */
     void redraw();
 
+    /// Will the screen be redrawn at the next event loop iteration?
+    bool redraw_pending() const { return m_redraw; }
+
+    /**
+     * \brief Redraw the screen periodically at the given number of frames
+     * per second
+     *
+     * The main loop schedules these frames in addition to the redraws
+     * requested via \ref redraw(), and sleeps until the earliest frame of
+     * all screens is due. Frames that cannot be drawn in time are skipped.
+     * The default value of 0 only redraws the screen on demand (and at the
+     * rate specified via the \c refresh parameter of \ref mainloop()).
+     */
+    void set_target_frame_rate(float fps);
+
+    /// Return the number of frames per second drawn periodically (see \ref set_target_frame_rate())
+    float target_frame_rate() const { return m_target_frame_rate; }
+
+    /**
+     * \brief Request a redraw if a periodic frame is due (called by \ref mainloop())
+     *
+     * Besides the periodic frames, this schedules the frames that fade in
+     * the tooltip of the widget under the cursor.
+     *
+     * \param now
+     *     Current time as returned by <tt>glfwGetTime()</tt>
+     *
+     * \param refresh
+     *     Refresh period in milliseconds that applies if no target frame
+     *     rate was specified (a negative value disables it)
+     *
+     * \return
+     *     The time at which the next frame is due, or infinity if the
+     *     screen is only redrawn on demand (and no tooltip is fading in)
+     */
+    double update_schedule(double now, float refresh);
+
+    /**
+     * \brief Let this screen share a single vertical synchronization with
+     * the other screens drawn in the same iteration of \ref mainloop()?
+     *
+     * Screens with this setting whose monitors share a refresh rate form a
+     * group, and only the screen of a group drawn last waits for the
+     * vertical blank (swap interval 1). The other screens of the group
+     * present their frames immediately (swap interval 0), hence they may
+     * tear. In exchange, redrawing N screens of a group takes a single
+     * refresh interval, whereas N screens that each wait for the vertical
+     * blank block for N intervals in turn and starve each other. A screen
+     * that must never tear should not use this setting and set its \ref
+     * swap_interval() to 1 instead. This is implemented by setting the \ref
+     * swap_interval() of each screen before drawing it. Disabled by
+     * default.
+     */
+    void set_shared_vsync(bool shared_vsync) { m_shared_vsync = shared_vsync; }
+
+    /// Does this screen share a vertical synchronization with other screens?
+    bool shared_vsync() const { return m_shared_vsync; }
+
+    /**
+     * \brief Set the number of vertical refreshes to wait for when
+     * presenting the next frame (OpenGL/GLES only)
+     *
+     * Managed by \ref mainloop() for screens with \ref shared_vsync()
+     * enabled.
+     */
+    void set_swap_interval(int interval) { m_swap_interval = interval; }
+
+    /// Return the number of vertical refreshes to wait for when presenting a frame
+    int swap_interval() const { return m_swap_interval; }
+
+    /**
+     * \brief Return the refresh rate (in Hz) of the monitor showing the
+     * largest part of the window, or 0 if it cannot be determined
+     */
+    int refresh_rate() const;
+
     /**
      * \brief Redraw the screen if the redraw flag is set
      *
@@ -189,6 +287,9 @@ public:
     /// Return a pointer to the underlying NanoVG draw context
     NVGcontext *nvg_context() const { return m_nvg_context; }
 
+    /// Return the graphics backend of the screen
+    RenderDevice *render_device() { return m_render_device; }
+
     /// Return the component format underlying the screen
     Texture::ComponentFormat component_format() const;
 
@@ -218,6 +319,47 @@ public:
     /// Flush all queued up NanoVG rendering commands
     void nvg_flush();
 
+    /**
+     * \brief Return the pool of render target textures associated with
+     * this screen (used by \ref Canvas)
+     */
+    TexturePool *texture_pool();
+
+    /**
+     * \brief Measure the CPU and GPU time of the passes of each frame?
+     *
+     * See \ref FrameProfiler for details. Canvases are reported as
+     * <tt>"Canvas"</tt> unless their render pass was given another label
+     * (see \ref RenderPass::set_label()).
+     */
+    void set_profiling(bool profiling);
+
+    /// Is the frame profiler enabled?
+    bool profiling() const { return m_profiler.get() != nullptr; }
+
+    /// Return the frame profiler (or \c nullptr if profiling is disabled)
+    FrameProfiler *profiler() { return m_profiler; }
+
+    /// Return the timings of the most recent frame whose measurements are complete
+    const FrameProfiler::Stats &frame_stats() const;
+
+    /// Draw \ref frame_stats() in the upper left corner? (enables profiling)
+    void set_profiler_overlay(bool overlay);
+
+    /// Are the frame statistics drawn on top of the widgets?
+    bool profiler_overlay() const { return m_profiler_overlay; }
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    /**
+     * \brief Return the shadow copy of the OpenGL state of this screen's
+     * context
+     *
+     * Call <tt>gl_state()->invalidate()</tt> after changing OpenGL state
+     * without going through NanoGUI.
+     */
+    GLState *gl_state() { return &m_gl_state; }
+#endif
+
     /// Shut down GLFW when the window is closed?
     void set_shutdown_glfw(bool v) { m_shutdown_glfw = v; }
     bool shutdown_glfw() { return m_shutdown_glfw; }
@@ -249,8 +391,25 @@ public:
      */
     Screen();
 
-    /// Initialize the \ref Screen
-    void initialize(GLFWwindow *window, bool shutdown_glfw,NVGcontext *context = nullptr);
+    /**
+     * \brief Initialize the \ref Screen
+     *
+     * \param context
+     *     Optional NanoVG context. It remains owned by the caller unless a
+     *     \c device is provided as well. A software context (\ref
+     *     sw_nvg_create()) selects the software render device.
+     *
+     * \param device
+     *     Optional render device, e.g. implemented by the application for
+     *     its own graphics engine. The device creates the NanoVG context
+     *     unless one is provided, and takes ownership of the context in
+     *     either case (see \ref RenderDevice::delete_nvg_context()). By
+     *     default, the screen keeps
+     *     the device that created its window, or uses the render device with
+     *     the highest priority if the application created the window.
+     */
+    void initialize(GLFWwindow *window, bool shutdown_glfw, NVGcontext *context = nullptr,
+                    RenderDevice *device = nullptr);
 
     /* Event handlers */
     void cursor_pos_callback_event(double x, double y);
@@ -271,6 +430,9 @@ public:
 protected:
     GLFWwindow *m_glfw_window = nullptr;
     NVGcontext *m_nvg_context = nullptr;
+    /// Was \ref m_nvg_context passed to \ref initialize() by the caller?
+    bool m_external_nvg_context = false;
+    ref<RenderDevice> m_render_device;
     GLFWcursor *m_cursors[(size_t) Cursor::CursorCount];
     Cursor m_cursor;
     std::vector<Widget *> m_focus_path;
@@ -289,8 +451,21 @@ protected:
     bool m_depth_buffer;
     bool m_stencil_buffer;
     bool m_float_buffer;
-    bool m_redraw;
+    std::atomic<bool> m_redraw;
+    float m_target_frame_rate = 0.f;
+    /// Time at which the next periodic frame is due
+    double m_next_frame = 0.0;
+    bool m_shared_vsync = false;
+    /// Requested swap interval and the one set for the context (or -1 if unknown)
+    int m_swap_interval = 0;
+    int m_active_swap_interval = -1;
     std::function<void(Vector2i)> m_resize_callback;
+    ref<TexturePool> m_texture_pool;
+    ref<FrameProfiler> m_profiler;
+    bool m_profiler_overlay = false;
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    GLState m_gl_state;
+#endif
 #if defined(NANOGUI_USE_METAL)
     void *m_metal_texture = nullptr;
     void *m_metal_drawable = nullptr;
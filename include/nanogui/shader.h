@@ -18,6 +18,7 @@
 
 #include <nanogui/object.h>
 #include <nanogui/traits.h>
+#include <nanogui/vertexbuffer.h>
 #include <unordered_map>
 
 NAMESPACE_BEGIN(nanogui)
@@ -39,6 +40,16 @@ public:
         AlphaBlend // alpha * new_color + (1 - alpha) * old_color
     };
 
+    /// Expected update frequency of a vertex or index buffer
+    enum class BufferUsage {
+        /// Uploaded once and drawn many times (e.g. static meshes)
+        Static,
+        /// Updated occasionally (the default)
+        Dynamic,
+        /// Replaced (almost) every time it is drawn
+        Stream
+    };
+
     /**
      * \brief Initialize the shader using the specified source strings.
      *
@@ -54,12 +65,42 @@ public:
      *
      * \param fragment_shader
      *     The source of the fragment shader as a string.
+     *
+     * \param deferred
+     *     Issue compilation and linking without waiting for the result. The
+     *     shader is then created in a pending state (see \ref ready()), and
+     *     drivers supporting <tt>KHR_parallel_shader_compile</tt> compile it
+     *     on background threads. Errors are reported when the shader is
+     *     finished by \ref ready() or \ref wait() instead of being thrown
+     *     by the constructor.
      */
     Shader(RenderPass *render_pass,
            const std::string &name,
            const std::string &vertex_shader,
            const std::string &fragment_shader,
-           BlendMode blend_mode = BlendMode::None);
+           BlendMode blend_mode = BlendMode::None,
+           bool deferred = false);
+
+    /**
+     * \brief Set a directory where linked shader programs are cached
+     *
+     * When set, the OpenGL and GLES backends store the binary of each linked
+     * program (obtained via <tt>glGetProgramBinary()</tt>) along with its
+     * reflected parameters in this directory. Shaders created later on with
+     * the same source code are restored from the cache, which skips
+     * compilation, linking, and reflection. Entries are keyed by the source
+     * code and the vendor, renderer, and version of the OpenGL
+     * implementation. Stale or invalid entries cause a fallback to regular
+     * compilation and are then replaced.
+     *
+     * The directory must exist. An empty string (the default) disables the
+     * cache. The Metal backend ignores this setting, as its shaders are
+     * precompiled.
+     */
+    static void set_program_cache_path(const std::string &path);
+
+    /// Return the directory where linked shader programs are cached
+    static const std::string &program_cache_path();
 
     /// Return the render pass associated with this shader
     RenderPass *render_pass() { return m_render_pass; }
@@ -70,6 +111,40 @@ public:
     /// Return the blending mode of this shader
     BlendMode blend_mode() const { return m_blend_mode; }
 
+    /**
+     * \brief Has the shader finished compiling?
+     *
+     * Always returns \c true for shaders that were not created in deferred
+     * mode. Otherwise, this function polls the driver without blocking if
+     * <tt>KHR_parallel_shader_compile</tt> is available, and finishes the
+     * shader (see \ref wait()) once compilation is complete. Without the
+     * extension, the status cannot be polled and the shader is finished
+     * right away.
+     */
+    bool ready();
+
+    /**
+     * \brief Block until a shader created in deferred mode has finished
+     * compiling, then check for errors and reflect its parameters
+     *
+     * Called implicitly by \ref begin() and \ref binding() (and hence by
+     * all functions that look up parameters by name). Throws an exception
+     * if compilation or linking failed.
+     */
+    void wait();
+
+    /**
+     * \brief Return a handle that identifies the named shader parameter
+     *
+     * The handle is a small integer that remains valid for the lifetime of
+     * the shader. Passing it to the handle-based overloads of \ref
+     * set_buffer(), \ref set_buffer_range(), \ref set_uniform(), and \ref
+     * set_texture() avoids a name lookup per call, which is worthwhile for
+     * parameters that are updated very frequently. The name \c indices
+     * refers to the index buffer.
+     */
+    size_t binding(const std::string &name);
+
     /**
      * \brief Upload a buffer (e.g. vertex positions) that will be associated
      * with a named shader parameter.
@@ -88,16 +163,118 @@ public:
         set_buffer(name, type, shape.end() - shape.begin(), shape.begin(), data);
     }
 
+    /// Upload a buffer associated with a handle obtained from \ref binding()
+    void set_buffer(size_t binding, VariableType type, size_t ndim,
+                    const size_t *shape, const void *data);
+
+    /**
+     * \brief Specify how often a vertex or index buffer will be updated
+     *
+     * The hint takes effect with the next call to \ref set_buffer(), which
+     * allocates storage accordingly:
+     *
+     * - \c Static and \c Dynamic buffers only reallocate GPU storage when
+     *   their size changes and are otherwise updated in place.
+     *
+     * - \c Stream buffers are orphaned on every update, so that the driver
+     *   can hand out fresh storage instead of waiting for pending draws to
+     *   finish. On OpenGL 4.4+ (or with <tt>ARB_buffer_storage</tt>), they
+     *   instead use a persistently mapped ring of storage segments that
+     *   are written directly and guarded by fences. On Metal, they are
+     *   written to shared memory without a blit.
+     *
+     * Buffers that are updated independently (e.g. the positions and
+     * colors of a point cloud) should be kept in separate attributes, so
+     * that updating one does not re-upload the other.
+     */
+    void set_buffer_usage(const std::string &name, BufferUsage usage);
+
+    /// Specify the usage of a buffer associated with a handle obtained from \ref binding()
+    void set_buffer_usage(size_t binding, BufferUsage usage);
+
+    /**
+     * \brief Specify the rate at which a vertex attribute advances during
+     * instanced rendering
+     *
+     * A divisor of \c 0 (the default) advances the attribute once per
+     * vertex, and a divisor of \c n once every \c n instances drawn by \ref
+     * draw_array_instanced(). Instanced attributes are not supported on
+     * OpenGL ES 2. Metal shaders instead index per-instance buffers using
+     * the <tt>[[instance_id]]</tt> attribute, hence the divisor is ignored
+     * there.
+     */
+    void set_buffer_divisor(const std::string &name, uint32_t divisor);
+
+    /// Specify the divisor of a buffer associated with a handle obtained from \ref binding()
+    void set_buffer_divisor(size_t binding, uint32_t divisor);
+
+    /**
+     * \brief Update a contiguous range of rows of a vertex or index buffer
+     *
+     * In contrast to \ref set_buffer(), this function leaves the size of the
+     * buffer unchanged and only transfers the modified rows to the GPU, which
+     * makes it suitable for streaming updates. The buffer must have been
+     * allocated using \ref set_buffer() beforehand.
+     *
+     * \param name
+     *     Name of the vertex attribute (or \c indices)
+     *
+     * \param offset
+     *     Index of the first row (i.e. vertex) to be updated
+     *
+     * \param count
+     *     Number of rows to be updated
+     *
+     * \param data
+     *     Pointer to \c count contiguous rows using the buffer's dtype
+     */
+    void set_buffer_range(const std::string &name, size_t offset,
+                          size_t count, const void *data);
+
+    /// Update rows of a buffer associated with a handle obtained from \ref binding()
+    void set_buffer_range(size_t binding, size_t offset,
+                          size_t count, const void *data);
+
     /**
      * \brief Upload a uniform variable (e.g. a vector or matrix) that will be
      * associated with a named shader parameter.
      */
     template <typename Array> void set_uniform(const std::string &name,
                                                const Array &value) {
+        set_uniform(binding(name), value);
+    }
+
+    /**
+     * \brief Upload a uniform variable associated with a handle obtained
+     * from \ref binding()
+     */
+    template <typename Array> void set_uniform(size_t binding,
+                                               const Array &value) {
         size_t shape[3] = { 1, 1, 1 };
-        size_t ndim = (size_t) -1;
         const void *data;
-        VariableType vtype = VariableType::Invalid;
+        VariableType vtype;
+        size_t ndim = uniform_layout(value, vtype, shape, data);
+
+        if (ndim == (size_t) -1)
+            throw std::runtime_error("Shader::set_uniform(): invalid input array dimension!");
+
+        set_buffer(binding, vtype, ndim, shape, data);
+    }
+
+    /**
+     * \brief Determine the type, shape, and storage of a uniform value as
+     * expected by \ref set_buffer()
+     *
+     * Returns the number of dimensions, or <tt>(size_t) -1</tt> if the
+     * type of \c value is unsupported. Used by \ref set_uniform() and \ref
+     * CommandBuffer::set_uniform().
+     */
+    template <typename Array>
+    static size_t uniform_layout(const Array &value, VariableType &vtype,
+                                 size_t shape[3], const void *&data) {
+        size_t ndim = (size_t) -1;
+        data = nullptr;
+        vtype = VariableType::Invalid;
 
         if constexpr (std::is_scalar_v<Array>) {
             data = &value;
@@ -132,12 +309,25 @@ public:
             vtype = get_type<typename Array::Scalar>();
         }
 
-        if (ndim == (size_t) -1)
-            throw std::runtime_error("Shader::set_uniform(): invalid input array dimension!");
-
-        set_buffer(name, vtype, ndim, shape, data);
+        return ndim;
     }
 
+    /**
+     * \brief Feed vertex attributes from an interleaved \ref VertexBuffer
+     *
+     * Each attribute of the buffer's layout is bound to the vertex input of
+     * the same name, replacing data previously uploaded via \ref
+     * set_buffer(). Attributes without a matching input are skipped, hence
+     * one buffer can serve several shaders that use different subsets of its
+     * attributes. The shader keeps a reference to the buffer, and later
+     * updates of its contents take effect automatically.
+     *
+     * On Metal, buffer arguments named after an attribute are bound at the
+     * attribute's byte offset, and the shader must index them using the
+     * stride of the buffer (e.g. by means of a struct matching the layout).
+     */
+    void set_vertex_buffer(nanogui::VertexBuffer *vertex_buffer);
+
     /**
      * \brief Associate a texture with a named shader parameter
      *
@@ -145,6 +335,9 @@ public:
      */
     void set_texture(const std::string &name, Texture *texture);
 
+    /// Associate a texture with a handle obtained from \ref binding()
+    void set_texture(size_t binding, Texture *texture);
+
     /**
      * \brief Begin drawing using this shader
      *
@@ -184,10 +377,30 @@ public:
                     size_t offset, size_t count,
                     bool indexed = false);
 
+    /**
+     * \brief Render several instances of geometry arrays in a single draw
+     * call
+     *
+     * Vertex attributes whose divisor is nonzero (see \ref
+     * set_buffer_divisor()) advance once per instance instead of once per
+     * vertex, e.g. to provide the position and color of each marker or
+     * particle. The other parameters have the same meaning as in \ref
+     * draw_array().
+     *
+     * \param instance_count
+     *     Number of instances to render
+     */
+    void draw_array_instanced(PrimitiveType primitive_type,
+                              size_t offset, size_t count,
+                              size_t instance_count,
+                              bool indexed = false);
+
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
     uint32_t shader_handle() const { return m_shader_handle; }
 #elif defined(NANOGUI_USE_METAL)
     void *pipeline_state() const { return m_pipeline_state; }
+#elif defined(NANOGUI_USE_NULL)
+    uint32_t shader_handle() const { return m_shader_handle; }
 #endif
 
 #if defined(NANOGUI_USE_OPENGL)
@@ -207,7 +420,13 @@ protected:
         IndexBuffer,
     };
 
+#if defined(NANOGUI_USE_OPENGL)
+    /// Number of segments of a persistently mapped ring
+    static constexpr size_t RingSegments = 3;
+#endif
+
     struct Buffer {
+        std::string name;
         void *buffer = nullptr;
         BufferType type = Unknown;
         VariableType dtype = VariableType::Invalid;
@@ -216,6 +435,33 @@ protected:
         size_t shape[3] { 0, 0, 0 };
         size_t size = 0;
         bool dirty = false;
+        BufferUsage usage = BufferUsage::Dynamic;
+        /// Number of instances per step of a vertex attribute (\c 0: per vertex)
+        uint32_t divisor = 0;
+        /// Interleaved buffer providing this vertex attribute (see \ref set_vertex_buffer())
+        ref<nanogui::VertexBuffer> vertex_buffer;
+        /// Index of the attribute within the layout of \c vertex_buffer
+        size_t vertex_attribute = 0;
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        /// Offset of the uniform's value within \c m_uniform_data
+        size_t offset = 0;
+        /// Usage with which the storage of a vertex/index buffer was allocated
+        BufferUsage storage_usage = BufferUsage::Dynamic;
+#  if defined(NANOGUI_USE_OPENGL)
+        /// Persistently mapped ring of \c RingSegments storage segments (or \c nullptr)
+        uint8_t *mapped = nullptr;
+        /// Current segment and distance between segments in bytes
+        size_t segment = 0, segment_size = 0;
+        /// Fences (\c GLsync) guarding the segments of a ring
+        void *fences[RingSegments] { };
+
+        /// Byte offset of the current contents within the buffer object
+        size_t storage_offset() const { return segment * segment_size; }
+#  endif
+#elif defined(NANOGUI_USE_METAL)
+        /// Handle of the sampler associated with a texture (or -1)
+        int sampler = -1;
+#endif
 
         std::string to_string() const;
     };
@@ -223,20 +469,76 @@ protected:
     /// Release all resources
     virtual ~Shader();
 
+    /// Append a parameter and return it (used while reflecting the shader)
+    Buffer &add_buffer(const std::string &name);
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    /// Register the attributes and uniforms of the linked program
+    void reflect();
+
+    /// Restore the program and its parameters from a program cache entry
+    bool load_program_binary(const std::string &filename, uint64_t key);
+
+    /// Write the linked program and its parameters to a program cache entry
+    void store_program_binary(const std::string &filename, uint64_t key);
+
+    /// Set up the index buffer and uniform storage after reflection
+    void init_parameters();
+#elif defined(NANOGUI_USE_NULL)
+    /// Register the attributes and uniforms declared in the GLSL sources
+    void reflect(const std::string &vertex_shader, const std::string &fragment_shader);
+#endif
+
+#if defined(NANOGUI_USE_OPENGL)
+    /// Switch a streaming buffer to the next segment of its ring, (re-)creating the ring if needed
+    void advance_ring(Buffer &buf, size_t size);
+
+    /// Release the fences of a ring (the buffer object is deleted by the caller)
+    void release_ring(Buffer &buf);
+#endif
+
+    /// Validate a handle and return the associated parameter
+    Buffer &buffer(size_t binding, const char *func) {
+        if (binding >= m_buffers.size())
+            throw std::runtime_error(std::string(func) + ": invalid binding!");
+        return m_buffers[binding];
+    }
+
 protected:
     RenderPass* m_render_pass;
     std::string m_name;
-    std::unordered_map<std::string, Buffer> m_buffers;
+    /// Shader parameters, indexed by handle
+    std::vector<Buffer> m_buffers;
+    /// Maps parameter names to handles (only consulted by \ref binding())
+    std::unordered_map<std::string, size_t> m_bindings;
+    /// Handle of the index buffer
+    size_t m_index_binding = 0;
     BlendMode m_blend_mode;
+    /// Was the shader created in deferred mode and not yet finished?
+    bool m_pending = false;
 
     #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
         uint32_t m_shader_handle = 0;
+        /// Shader objects that are kept until a deferred link was checked
+        uint32_t m_vertex_shader_handle = 0;
+        uint32_t m_fragment_shader_handle = 0;
+        /// Error encountered while finishing a deferred shader
+        std::string m_error;
+        /// Program cache entry to be written once a deferred shader is finished
+        std::string m_cache_filename;
+        uint64_t m_cache_key = 0;
+        /// Values of all uniforms, stored back to back
+        std::vector<uint8_t> m_uniform_data;
     #  if defined(NANOGUI_USE_OPENGL)
         uint32_t m_vertex_array_handle = 0;
         bool m_uses_point_size = false;
     #  endif
     #elif defined(NANOGUI_USE_METAL)
         void *m_pipeline_state;
+    #elif defined(NANOGUI_USE_NULL)
+        uint32_t m_shader_handle = 0;
+        /// Is the shader between \ref begin() and \ref end()?
+        bool m_active = false;
     #endif
 };
 
@@ -244,7 +546,7 @@ protected:
 #define NANOGUI_RESOURCE_STRING(name) std::string(name, name + name##_size)
 
 /// Access a shader stored in nanogui_resources.cpp
-#if defined(NANOGUI_USE_OPENGL)
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_NULL)
 #  define NANOGUI_SHADER(name) NANOGUI_RESOURCE_STRING(name##_gl)
 #elif defined(NANOGUI_USE_GLES)
 #  define NANOGUI_SHADER(name) NANOGUI_RESOURCE_STRING(name##_gles)
@@ -0,0 +1,71 @@
+/*
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/**
+ * \file nanogui/softwarerenderer.h
+ *
+ * \brief NanoVG renderer that rasterizes on the CPU into memory.
+ *
+ * The functions in this file create NanoVG contexts that do not require a
+ * GPU: paths are rasterized with exact area coverage (antialiased, nonzero
+ * winding), text and images are sampled bilinearly, and the result is
+ * blended into a premultiplied RGBA8 framebuffer in memory. Draw calls are
+ * recorded until NanoVG flushes the frame. The framebuffer is then split
+ * into bands of rows that are rasterized in parallel by a pool of worker
+ * threads. Every band applies all draw calls in order, hence the image does
+ * not depend on the number of threads.
+ *
+ * A software context can be passed to \ref Screen, which then renders its
+ * widgets into the framebuffer of the context. Combined with the null
+ * backend (<tt>NANOGUI_BACKEND=Null</tt>), this produces snapshots of user
+ * interfaces on machines without GPU or display. Contents rendered with
+ * shaders (e.g. by a \ref Canvas) are not visible in the framebuffer.
+ */
+
+#pragma once
+
+#include <nanogui/vector.h>
+
+struct NVGcontext;
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \brief Create a NanoVG context that renders on the CPU
+ *
+ * \param thread_count
+ *     Number of threads rasterizing a frame, including the calling thread.
+ *     The default value of 0 uses one thread per hardware thread.
+ */
+extern NANOGUI_EXPORT NVGcontext *sw_nvg_create(uint32_t thread_count = 0);
+
+/// Destroy a NanoVG context created by \ref sw_nvg_create()
+extern NANOGUI_EXPORT void sw_nvg_delete(NVGcontext *ctx);
+
+/// Was the given NanoVG context created by \ref sw_nvg_create()?
+extern NANOGUI_EXPORT bool sw_nvg_is_software(NVGcontext *ctx);
+
+/// Fill the framebuffer with a color (takes effect with the next flush of the frame)
+extern NANOGUI_EXPORT void sw_nvg_clear(NVGcontext *ctx, const Color &color);
+
+/**
+ * \brief Return the framebuffer of a software context
+ *
+ * The framebuffer stores premultiplied RGBA8 pixels in row-major order,
+ * starting with the top row. Its size (in pixels) is written to \c size and
+ * follows the viewport and pixel ratio passed to <tt>nvgBeginFrame()</tt>.
+ */
+extern NANOGUI_EXPORT const uint8_t *sw_nvg_framebuffer(NVGcontext *ctx, Vector2i *size);
+
+/// Copy the framebuffer into \c data as non-premultiplied RGBA8 pixels
+extern NANOGUI_EXPORT void sw_nvg_read_pixels(NVGcontext *ctx, uint8_t *data);
+
+/// Write the framebuffer to an (uncompressed) RGBA PNG file
+extern NANOGUI_EXPORT void sw_nvg_save_png(NVGcontext *ctx, const std::string &filename);
+
+NAMESPACE_END(nanogui)
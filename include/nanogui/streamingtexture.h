@@ -0,0 +1,150 @@
+/*
+    nanogui/streamingtexture.h -- Multi-buffered texture for continuously
+    updated content such as live video
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/texture.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class StreamingTexture streamingtexture.h nanogui/streamingtexture.h
+ *
+ * \brief Texture whose contents are continuously replaced by a producer
+ * running on an arbitrary thread (e.g. a camera feed)
+ *
+ * Frames are exchanged through three CPU-side slots (a "triple buffer"): the
+ * producer writes into one slot, the most recently completed frame waits in
+ * the second, and the third is read by the main thread during \ref update().
+ * The producer therefore never waits for the renderer; frames that are
+ * superseded before the renderer picks them up are skipped.
+ *
+ * On the GPU side, \ref update() rotates through \c buffer_count backing
+ * textures and fills them using \ref Texture::upload_async(). A texture is
+ * thus only overwritten after the preceding <tt>buffer_count - 1</tt> frames
+ * were submitted, which prevents the driver from stalling on a texture that
+ * is still being read by in-flight draw calls.
+ *
+ * Pass an instance to \ref ImageView::set_image() to display it.
+ */
+class NANOGUI_EXPORT StreamingTexture : public Object {
+public:
+    using PixelFormat = Texture::PixelFormat;
+    using ComponentFormat = Texture::ComponentFormat;
+    using InterpolationMode = Texture::InterpolationMode;
+
+    /**
+     * \brief Create a streaming texture of the given size and format
+     *
+     * \param buffer_count
+     *     Number of backing textures that are rotated on the GPU (at least 2)
+     */
+    StreamingTexture(PixelFormat pixel_format,
+                     ComponentFormat component_format,
+                     const Vector2i &size,
+                     size_t buffer_count = 3,
+                     InterpolationMode min_interpolation_mode = InterpolationMode::Bilinear,
+                     InterpolationMode mag_interpolation_mode = InterpolationMode::Nearest);
+
+    /// Return the size of the frames
+    const Vector2i &size() const { return m_size; }
+
+    /// Return the number of backing textures
+    size_t buffer_count() const { return m_textures.size(); }
+
+    /// Return the number of bytes per frame (tightly packed)
+    size_t frame_bytes() const { return m_frame_bytes; }
+
+    /**
+     * \brief Submit a new frame (may be called from any thread)
+     *
+     * \param row_stride
+     *     Distance between successive rows of \c data in bytes (\c 0:
+     *     tightly packed rows)
+     */
+    void push(const uint8_t *data, size_t row_stride = 0);
+
+    /**
+     * \brief Begin writing a frame in place, avoiding the copy performed by
+     * \ref push() (may be called from any thread)
+     *
+     * Returns a pointer to \ref frame_bytes() bytes of tightly packed pixel
+     * storage. Must be followed by a call to \ref end_frame(). Concurrent
+     * producers are serialized.
+     */
+    uint8_t *begin_frame();
+
+    /// Publish the frame started by \ref begin_frame()
+    void end_frame();
+
+    /**
+     * \brief Upload the most recent frame (if any) into the next backing
+     * texture
+     *
+     * Must be called on the main thread. Returns \c true if \ref texture()
+     * changed.
+     */
+    bool update();
+
+    /// Return the backing texture holding the most recently uploaded frame
+    Texture *texture() { return m_textures[m_current]; }
+
+    /// Return the backing texture holding the most recently uploaded frame (const version)
+    const Texture *texture() const { return m_textures[m_current].get(); }
+
+    /**
+     * \brief Set a function that is invoked (on the producer's thread)
+     * whenever a new frame has been submitted
+     *
+     * This is used by \ref ImageView to request a redraw of its screen.
+     */
+    void set_frame_callback(const std::function<void()> &callback);
+
+    /// Return the total number of frames submitted by producers
+    size_t frames_pushed() const { return m_frames_pushed; }
+
+    /// Return the number of frames that were uploaded to the GPU
+    size_t frames_uploaded() const { return m_frames_uploaded; }
+
+    /// Return the number of frames that were superseded before they could be uploaded
+    size_t frames_skipped() const { return m_frames_pushed - m_frames_uploaded; }
+
+protected:
+    virtual ~StreamingTexture();
+
+protected:
+    Vector2i m_size;
+    size_t m_frame_bytes;
+    std::vector<ref<Texture>> m_textures;
+    size_t m_current = 0;
+
+    /// CPU-side frame slots
+    std::unique_ptr<uint8_t[]> m_slots[3];
+    /// Slot indices: written by the producer, latest complete frame, read by update()
+    uint32_t m_back = 0, m_middle = 1, m_front = 2;
+    /// Does the middle slot contain a frame that has not been uploaded yet?
+    bool m_fresh = false;
+    /// Protects the slot indices, \c m_fresh, and the frame callback
+    std::mutex m_mutex;
+    /// Serializes concurrent producers
+    std::mutex m_producer_mutex;
+    std::function<void()> m_frame_callback;
+
+    std::atomic<size_t> m_frames_pushed { 0 };
+    std::atomic<size_t> m_frames_uploaded { 0 };
+};
+
+NAMESPACE_END(nanogui)
@@ -161,6 +161,117 @@ public:
     /// Download packed pixel data from the GPU to the CPU
     void download(uint8_t *data);
 
+    /**
+     * \brief Upload pixel data into a rectangular region of the texture
+     *
+     * Unlike \ref upload(), this function does not re-specify the texture
+     * storage, hence only the region's pixels are transferred.
+     *
+     * \param offset
+     *     Position of the upper left corner of the region (in pixels)
+     *
+     * \param size
+     *     Size of the region (in pixels)
+     *
+     * \param data
+     *     Pointer to the first pixel of the region
+     *
+     * \param row_stride
+     *     Distance between successive rows of \c data in bytes. The default
+     *     (\c 0) indicates tightly packed rows. This makes it possible to
+     *     upload a region directly from a larger image in CPU memory.
+     *
+     * \param level
+     *     Mip level that should be updated
+     *
+     * When the region is part of level 0 and mipmaps are generated
+     * automatically (see \ref auto_mipmaps()), the remaining levels are
+     * merely flagged as stale. They are regenerated once (no matter how
+     * many regions were updated) when the texture is next passed to
+     * \ref Shader::set_texture(), or when \ref generate_mipmaps() is called.
+     */
+    void upload_sub_region(const Vector2i &offset, const Vector2i &size,
+                           const uint8_t *data, size_t row_stride = 0,
+                           uint32_t level = 0);
+
+    /**
+     * \brief Upload packed pixel data into a specific mip level
+     *
+     * This makes it possible to supply mipmaps that were computed on the
+     * CPU. The level has size <tt>max(1, size() >> level)</tt>. Uploading a
+     * level does not trigger automatic mipmap generation.
+     */
+    void upload_level(uint32_t level, const uint8_t *data);
+
+    /// Return the number of levels of a full mipmap chain for this texture
+    uint32_t mip_levels() const;
+
+    /**
+     * \brief Regenerate mip levels <tt>1..n</tt> from level 0
+     *
+     * Only has an effect when trilinear interpolation is used.
+     */
+    void generate_mipmaps();
+
+    /// Are the mip levels out of date with respect to level 0?
+    bool mipmaps_dirty() const { return m_mipmaps_dirty; }
+
+    /**
+     * \brief Are mipmaps generated automatically?
+     *
+     * When enabled (the default), \ref upload() immediately regenerates the
+     * mip levels of trilinearly filtered textures, and \ref
+     * upload_sub_region() defers regeneration until the texture is used.
+     * When disabled, mipmaps are only updated via \ref upload_level() and
+     * \ref generate_mipmaps().
+     */
+    bool auto_mipmaps() const { return m_auto_mipmaps; }
+
+    /// Specify whether mipmaps are generated automatically
+    void set_auto_mipmaps(bool auto_mipmaps) { m_auto_mipmaps = auto_mipmaps; }
+
+    /// Callback signature of \ref download_async()
+    using DownloadCallback = std::function<void(const uint8_t *data)>;
+
+    /**
+     * \brief Upload packed pixel data from the CPU to the GPU without waiting
+     * for the transfer to complete
+     *
+     * The data is copied into a staging buffer (a pixel buffer object on
+     * OpenGL and GLES 3, a shared buffer on Metal) from which the GPU
+     * subsequently fills the texture. The memory referenced by \c data may
+     * be reused as soon as this function returns. Staging buffers are
+     * recycled once a fence indicates that the GPU no longer reads from them.
+     *
+     * Falls back to \ref upload() on GLES 2.
+     */
+    void upload_async(const uint8_t *data);
+
+    /**
+     * \brief Download packed pixel data from the GPU to the CPU without
+     * stalling the pipeline
+     *
+     * Enqueues a copy into a staging buffer and returns immediately. Once the
+     * GPU has completed the copy, \ref poll_downloads() invokes \c callback
+     * with the pixel data, which has the same layout as the output of
+     * \ref download() (render targets are flipped vertically while the data
+     * is copied out of the staging buffer). Its size is that of the
+     * texture when \c download_async() was called, even if the texture
+     * was resized in the meantime. The pointer is only valid for the
+     * duration of the callback.
+     */
+    void download_async(const DownloadCallback &callback);
+
+    /**
+     * \brief Deliver the results of completed asynchronous downloads
+     *
+     * Should be invoked regularly (e.g. once per frame) on the thread that
+     * owns the rendering context. When \c wait is \c true, the function
+     * blocks until all pending downloads have completed. Returns the number
+     * of downloads that are still in flight.
+     */
+    size_t poll_downloads(bool wait = false);
+
     /// Resize the texture (discards the current contents)
     void resize(const Vector2i &size);
 
@@ -170,9 +281,14 @@ public:
 #elif defined(NANOGUI_USE_METAL)
     void *texture_handle() const { return m_texture_handle; }
     void *sampler_state_handle() const { return m_sampler_state_handle; }
+#elif defined(NANOGUI_USE_NULL)
+    uint32_t texture_handle() const { return m_texture_handle; }
 #endif
 
 protected:
+    /// Staging buffers and fences of asynchronous transfers (backend-specific)
+    struct AsyncState;
+
     /// Initialize the texture handle
     void init();
 
@@ -188,6 +304,9 @@ protected:
     uint8_t m_samples;
     uint8_t m_flags;
     Vector2i m_size;
+    bool m_auto_mipmaps = true;
+    bool m_mipmaps_dirty = false;
+    AsyncState *m_async = nullptr;
 
     #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
         uint32_t m_texture_handle = 0;
@@ -195,6 +314,10 @@ protected:
     #elif defined(NANOGUI_USE_METAL)
         void *m_texture_handle = nullptr;
         void *m_sampler_state_handle = nullptr;
+    #elif defined(NANOGUI_USE_NULL)
+        uint32_t m_texture_handle = 0;
+        /// Contents of the texture (level 0, unless it is a multisampled target)
+        std::vector<uint8_t> m_data;
     #endif
 };
 
@@ -0,0 +1,149 @@
+/*
+    nanogui/textureloader.h -- Asynchronous image decoding and staged
+    texture upload
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/texture.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class TextureLoader textureloader.h nanogui/textureloader.h
+ *
+ * \brief Loads images in the background without stalling the user interface
+ *
+ * Image files are decoded by a pool of worker threads. Decoded images are
+ * subsequently uploaded to the GPU on the main thread, where the amount of
+ * data transferred per frame of the main loop is limited by a configurable
+ * byte budget. Once an image is available, an optional callback is invoked
+ * on the main thread.
+ *
+ * Uploads are scheduled using \ref nanogui::async(), hence the main loop
+ * (\ref nanogui::mainloop()) must be running. Applications that manage their
+ * own event loop can instead call \ref process() once per frame.
+ */
+class NANOGUI_EXPORT TextureLoader : public Object {
+public:
+    using InterpolationMode = Texture::InterpolationMode;
+    using WrapMode = Texture::WrapMode;
+
+    /// Callback signature for textures (\c success is \c false if loading failed)
+    using TextureCallback = std::function<void(Texture *texture, bool success)>;
+
+    /// Callback signature for NanoVG images (\c image is \c 0 if loading failed)
+    using ImageCallback = std::function<void(int image, const std::string &filename)>;
+
+    /**
+     * \brief Create a texture loader
+     *
+     * \param thread_count
+     *     Number of decoding threads (\c 0: choose automatically)
+     *
+     * \param upload_budget
+     *     Maximum number of bytes that will be uploaded to the GPU per frame.
+     *     At least one image is uploaded per frame, even if it exceeds the
+     *     budget.
+     */
+    TextureLoader(size_t thread_count = 0, size_t upload_budget = 32 * 1024 * 1024);
+
+    /**
+     * \brief Asynchronously load a texture from an image file
+     *
+     * Returns a 1x1 transparent RGBA placeholder texture immediately. Once
+     * the image has been decoded and uploaded, the same texture object is
+     * resized to the image dimensions and holds the image contents. Images
+     * are always converted to 8 bit RGBA.
+     */
+    ref<Texture> load(const std::string &filename,
+                      InterpolationMode min_interpolation_mode = InterpolationMode::Bilinear,
+                      InterpolationMode mag_interpolation_mode = InterpolationMode::Bilinear,
+                      WrapMode wrap_mode = WrapMode::ClampToEdge,
+                      const TextureCallback &callback = TextureCallback());
+
+    /**
+     * \brief Asynchronously load a NanoVG image from an image file
+     *
+     * The image handle is passed to \c callback once it has been created
+     * (using \c nvgCreateImageRGBA with the given \c image_flags).
+     */
+    void load_image(NVGcontext *ctx, const std::string &filename,
+                    const ImageCallback &callback, int image_flags = 0);
+
+    /// Return the maximum number of bytes uploaded to the GPU per frame
+    size_t upload_budget() const { return m_upload_budget; }
+
+    /// Set the maximum number of bytes uploaded to the GPU per frame
+    void set_upload_budget(size_t upload_budget) { m_upload_budget = upload_budget; }
+
+    /// Return the number of images that are either being decoded or awaiting upload
+    size_t pending() const;
+
+    /**
+     * \brief Upload decoded images to the GPU (within the per-frame budget)
+     * and invoke their callbacks
+     *
+     * Must be called on the main thread. Returns \c true if further decoded
+     * images are waiting to be uploaded.
+     */
+    bool process();
+
+protected:
+    struct Request {
+        std::string filename;
+        /// Target texture (texture requests)
+        ref<Texture> texture;
+        TextureCallback texture_callback;
+        /// Target context (NanoVG image requests)
+        NVGcontext *ctx = nullptr;
+        int image_flags = 0;
+        ImageCallback image_callback;
+        /// Decoded RGBA pixels (populated by the worker threads)
+        uint8_t *data = nullptr;
+        Vector2i size = 0;
+    };
+
+    /// Release all resources
+    virtual ~TextureLoader();
+
+    /// Enqueue a request for decoding
+    void enqueue(Request &&request);
+
+    /// Ensure that \ref process() runs during the next main loop iteration
+    void schedule();
+
+    /// Body of the decoding threads
+    void run();
+
+protected:
+    std::vector<std::thread> m_workers;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    /// Requests awaiting decoding
+    std::deque<Request> m_queue;
+    /// Decoded requests awaiting upload
+    std::deque<Request> m_ready;
+    /// Number of requests that are currently being decoded
+    size_t m_busy = 0;
+    size_t m_upload_budget;
+    /// Cleared upon destruction to invalidate pending calls to \ref process()
+    std::shared_ptr<bool> m_alive;
+    bool m_scheduled = false;
+    bool m_stop = false;
+};
+
+NAMESPACE_END(nanogui)
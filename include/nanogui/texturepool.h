@@ -0,0 +1,145 @@
+/*
+    nanogui/texturepool.h -- Recycles render target textures
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/texture.h>
+#include <list>
+#include <unordered_map>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class TexturePool texturepool.h nanogui/texturepool.h
+ *
+ * \brief Pool of render target textures that are recycled instead of being
+ * reallocated whenever a render pass changes its size
+ *
+ * Textures are grouped by pixel format, component format, sample count,
+ * flags, and <em>size class</em>: requested sizes are rounded up to one of
+ * four steps per power of two (see \ref size_class()), so that a texture
+ * can serve a range of slightly different sizes. Users of a pooled texture
+ * render into its upper left <tt>size</tt> pixels (e.g. by means of
+ * \ref RenderPass::resize(), which takes care of this automatically when a
+ * pool is attached via \ref RenderPass::set_texture_pool()).
+ *
+ * Released textures are kept for later reuse until the total size of idle
+ * textures exceeds \ref max_pooled_bytes(), at which point the least
+ * recently released textures are freed.
+ *
+ * Each \ref Screen owns a pool (\ref Screen::texture_pool()), since
+ * textures cannot be shared between the rendering contexts of different
+ * windows.
+ */
+class NANOGUI_EXPORT TexturePool : public Object {
+public:
+    using PixelFormat = Texture::PixelFormat;
+    using ComponentFormat = Texture::ComponentFormat;
+
+    /// Create an empty texture pool
+    TexturePool(size_t max_pooled_bytes = 256 * 1024 * 1024);
+
+    /**
+     * \brief Acquire a texture of the given format that has at least the
+     * specified size
+     *
+     * The returned texture either comes from the pool or is newly allocated,
+     * and its size equals <tt>size_class(size)</tt>. Pass it to \ref release()
+     * once it is no longer needed.
+     */
+    ref<Texture> acquire(PixelFormat pixel_format,
+                         ComponentFormat component_format,
+                         const Vector2i &size,
+                         uint8_t samples = 1,
+                         uint8_t flags = (uint8_t) Texture::TextureFlags::RenderTarget);
+
+    /**
+     * \brief Return a texture obtained from \ref acquire() to the pool
+     *
+     * Textures that were not obtained from this pool are ignored.
+     */
+    void release(Texture *texture);
+
+    /**
+     * \brief Can an acquired texture continue to be used for a new size?
+     *
+     * Returns \c true if the texture is large enough, and if it is not
+     * excessively large (i.e. if it has at most twice the area of the size
+     * class of \c size). The latter implements a hysteresis that prevents
+     * reallocation during interactive resizing, while still returning
+     * memory when a target shrinks considerably.
+     */
+    static bool fits(const Texture *texture, const Vector2i &size);
+
+    /// Round a size up to the next size class
+    static Vector2i size_class(const Vector2i &size);
+
+    /// Return the number of bytes consumed by a texture (including all samples)
+    static size_t texture_bytes(const Texture *texture);
+
+    /// Return the total size of the idle textures held by the pool
+    size_t pooled_bytes() const { return m_pooled_bytes; }
+
+    /// Return the total size of the textures that were acquired but not released
+    size_t active_bytes() const { return m_active_bytes; }
+
+    /// Return the number of idle textures held by the pool
+    size_t pooled_count() const { return m_pool.size(); }
+
+    /// Return the number of textures that were acquired but not released
+    size_t active_count() const { return m_active.size(); }
+
+    /// Return the maximum total size of the idle textures held by the pool
+    size_t max_pooled_bytes() const { return m_max_pooled_bytes; }
+
+    /// Set the maximum total size of the idle textures held by the pool
+    void set_max_pooled_bytes(size_t max_pooled_bytes);
+
+    /// Free all idle textures
+    void clear();
+
+protected:
+    struct Key {
+        PixelFormat pixel_format;
+        ComponentFormat component_format;
+        uint8_t samples;
+        uint8_t flags;
+        Vector2i size;
+
+        bool operator==(const Key &k) const {
+            return pixel_format == k.pixel_format &&
+                   component_format == k.component_format &&
+                   samples == k.samples && flags == k.flags && size == k.size;
+        }
+    };
+
+    struct Entry {
+        Key key;
+        ref<Texture> texture;
+    };
+
+    virtual ~TexturePool();
+
+    /// Free idle textures until the budget is satisfied
+    void trim();
+
+protected:
+    /// Idle textures, from most to least recently released
+    std::list<Entry> m_pool;
+    /// Acquired textures and the key under which they were requested
+    std::unordered_map<const Texture *, Key> m_active;
+    size_t m_pooled_bytes = 0;
+    size_t m_active_bytes = 0;
+    size_t m_max_pooled_bytes;
+};
+
+NAMESPACE_END(nanogui)
@@ -30,6 +30,33 @@ class NANOGUI_EXPORT Theme : public Object {
 public:
     Theme(NVGcontext *ctx);
 
+    /**
+     * \brief Rasterize commonly used glyphs into the NanoVG font atlas
+     *
+     * NanoVG rasterizes glyphs lazily, which causes a visible hitch in the
+     * first frame that uses a new font size or pixel ratio. This function
+     * renders \ref m_prewarm_characters (using the sans, bold, and monospace
+     * faces) and \ref m_prewarm_icons (using the icon face) at the standard,
+     * button, and text box font sizes into an offscreen frame that is
+     * subsequently discarded. Each face/size combination is submitted as a
+     * single string so that the atlas is updated in a handful of uploads.
+     *
+     * The function returns immediately when the font sizes, icon scale,
+     * pixel ratio, and glyph sets are unchanged since the previous call,
+     * hence it is cheap to invoke once per frame. It must not be called
+     * between ``nvgBeginFrame()`` and ``nvgEndFrame()``.
+     *
+     * \param ctx
+     *     The NanoVG context associated with this theme
+     *
+     * \param pixel_ratio
+     *     Ratio between pixel and device coordinates of the target screen
+     *
+     * \param force
+     *     Rasterize the glyphs even if nothing changed since the last call
+     */
+    void prewarm_glyphs(NVGcontext *ctx, float pixel_ratio, bool force = false);
+
     /* Fonts */
     /// The standard font face (default: ``"sans"`` from ``resources/roboto_regular.ttf``).
     int m_font_sans_regular;
@@ -221,9 +248,26 @@ public:
     /// Icon to use when a text box has a down toggle (e.g. IntBox) (default: ``FA_CHEVRON_DOWN``).
     int m_text_box_down_icon;
 
+    /* Glyph atlas pre-warming */
+    /// Characters rasterized by \ref prewarm_glyphs() (default: printable ASCII; set to ``""`` to disable).
+    std::string m_prewarm_characters;
+    /// Icons rasterized by \ref prewarm_glyphs() (default: all icons referenced by this theme).
+    std::vector<int> m_prewarm_icons;
+
 protected:
     /// Default destructor does nothing; allows for inheritance.
     virtual ~Theme() { };
+
+protected:
+    /// Configuration used by the last call to \ref prewarm_glyphs()
+    struct PrewarmState {
+        float pixel_ratio = 0.f;
+        float icon_scale = 0.f;
+        int font_size[3] { 0, 0, 0 };
+        std::string characters;
+        std::vector<int> icons;
+    };
+    PrewarmState m_prewarm_state;
 };
 
 NAMESPACE_END(nanogui)
@@ -0,0 +1,136 @@
+/*
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+/**
+ * \file nanogui/vertexbuffer.h
+ *
+ * \brief Defines an abstraction for interleaved vertex data that can be
+ * shared by several shaders and works with OpenGL, OpenGL ES, and Metal.
+ */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <nanogui/traits.h>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class VertexBuffer vertexbuffer.h nanogui/vertexbuffer.h
+ *
+ * \brief GPU buffer storing several vertex attributes in an interleaved
+ * layout
+ *
+ * Each vertex occupies \ref stride() bytes, and each attribute is located
+ * at a fixed byte offset within a vertex. Compared to uploading every
+ * attribute separately via \ref Shader::set_buffer(), this improves the
+ * locality of vertex fetches, and a single copy of a mesh can be bound to
+ * any number of shaders using \ref Shader::set_vertex_buffer().
+ *
+ * Attributes may use a narrower storage type than the shader declares,
+ * e.g. \c Float16 positions or normalized \c UInt8 colors feeding
+ * floating point shader inputs.
+ */
+class NANOGUI_EXPORT VertexBuffer : public Object {
+public:
+    /// Description of an attribute within the interleaved layout
+    struct Attribute {
+        /// Name of the shader input fed by this attribute
+        std::string name;
+
+        /// Storage type of the components
+        VariableType dtype;
+
+        /// Number of components (1-4)
+        size_t components;
+
+        /// Map integer components to [0, 1] (unsigned) or [-1, 1] (signed)?
+        bool normalized = false;
+
+        /// Byte offset within a vertex, or -1 to place it after the previous attribute
+        size_t offset = (size_t) -1;
+    };
+
+    /**
+     * \brief Create an empty vertex buffer with the given layout
+     *
+     * \param attributes
+     *     Description of the attributes. Attributes without an explicit
+     *     offset are placed right after the preceding one, aligned to four
+     *     bytes.
+     *
+     * \param stride
+     *     Distance between consecutive vertices in bytes. When zero, the
+     *     end of the last attribute is used (aligned to four bytes).
+     */
+    VertexBuffer(const std::vector<Attribute> &attributes, size_t stride = 0);
+
+    /// Return the attributes of the layout (with resolved offsets)
+    const std::vector<Attribute> &attributes() const { return m_attributes; }
+
+    /// Return the attribute with the given name, or \c nullptr
+    const Attribute *attribute(const std::string &name) const;
+
+    /// Return the distance between consecutive vertices in bytes
+    size_t stride() const { return m_stride; }
+
+    /// Return the number of vertices
+    size_t vertex_count() const { return m_vertex_count; }
+
+    /**
+     * \brief Upload the contents of the buffer
+     *
+     * \param data
+     *     Pointer to \c vertex_count vertices, each of which occupies
+     *     \ref stride() bytes
+     *
+     * GPU storage is only reallocated when the number of vertices changes.
+     */
+    void set_data(const void *data, size_t vertex_count);
+
+    /// Update a contiguous range of vertices, leaving the remainder unchanged
+    void set_data_range(size_t offset, size_t count, const void *data);
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    uint32_t buffer_handle() const { return m_buffer_handle; }
+#elif defined(NANOGUI_USE_METAL)
+    void *buffer_handle() const { return m_buffer_handle; }
+#elif defined(NANOGUI_USE_NULL)
+    const uint8_t *buffer_handle() const { return m_data.data(); }
+#endif
+
+protected:
+    /// Initialize the buffer handle
+    void init();
+
+    /// Release all resources
+    virtual ~VertexBuffer();
+
+    /// Backend-specific part of \ref set_data()
+    void upload(const void *data, size_t size, bool reallocate);
+
+    /// Backend-specific part of \ref set_data_range()
+    void upload_range(size_t offset, size_t size, const void *data);
+
+protected:
+    std::vector<Attribute> m_attributes;
+    size_t m_stride;
+    size_t m_vertex_count = 0;
+
+    #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        uint32_t m_buffer_handle = 0;
+    #elif defined(NANOGUI_USE_METAL)
+        void *m_buffer_handle = nullptr;
+    #elif defined(NANOGUI_USE_NULL)
+        std::vector<uint8_t> m_data;
+    #endif
+};
+
+NAMESPACE_END(nanogui)
@@ -84,7 +84,8 @@ void register_basics(py::module &m) {
     py::class_<ProgressBar, Widget, ref<ProgressBar>, PyProgressBar>(m, "ProgressBar", D(ProgressBar))
         .def(py::init<Widget *>(), "parent"_a, D(ProgressBar, ProgressBar))
         .def("value", &ProgressBar::value, D(ProgressBar, value))
-        .def("set_value", &ProgressBar::set_value, D(ProgressBar, set_value));
+        .def("set_value", &ProgressBar::set_value, D(ProgressBar, set_value))
+        .def("publish_value", &ProgressBar::publish_value, D(ProgressBar, publish_value));
 
     py::class_<Slider, Widget, ref<Slider>, PySlider>(m, "Slider", D(Slider))
         .def(py::init<Widget *>(), "parent"_a, D(Slider, Slider))
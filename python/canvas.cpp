@@ -22,6 +22,16 @@ public:
     }
 };
 
+class PyPlotCanvas : public PlotCanvas {
+public:
+    using PlotCanvas::PlotCanvas;
+    NANOGUI_WIDGET_OVERLOADS(PlotCanvas);
+
+    void draw_contents() override {
+        PYBIND11_OVERLOAD(void, PlotCanvas, draw_contents);
+    }
+};
+
 void register_canvas(py::module &m) {
     py::class_<Canvas, Widget, ref<Canvas>, PyCanvas>(m, "Canvas", D(Canvas))
         .def(py::init<Widget *, uint8_t, bool, bool, bool>(),
@@ -35,12 +45,18 @@ void register_canvas(py::module &m) {
         .def("set_border_color", &Canvas::set_border_color, D(Canvas, set_border_color))
         .def("background_color", &Canvas::background_color, D(Canvas, background_color))
         .def("set_background_color", &Canvas::set_background_color, D(Canvas, set_background_color))
+        .def("composite", &Canvas::composite, D(Canvas, composite))
+        .def("set_composite", &Canvas::set_composite, D(Canvas, set_composite))
+        .def("render_offscreen", &Canvas::render_offscreen, D(Canvas, render_offscreen))
+        .def("add_pending_shader", &Canvas::add_pending_shader, D(Canvas, add_pending_shader))
         .def("draw_contents", &Canvas::draw_contents, D(Canvas, draw_contents));
 
     py::class_<ImageView, Canvas, ref<ImageView>, PyImageView>(m, "ImageView", D(ImageView))
         .def(py::init<Widget *>(), D(ImageView, ImageView))
         .def("image", py::overload_cast<>(&ImageView::image, py::const_), D(ImageView, image))
-        .def("set_image", &ImageView::set_image, D(ImageView, set_image))
+        .def("set_image", py::overload_cast<Texture *>(&ImageView::set_image), D(ImageView, set_image))
+        .def("set_image", py::overload_cast<StreamingTexture *>(&ImageView::set_image), D(ImageView, set_image, 2))
+        .def("streaming_image", &ImageView::streaming_image, D(ImageView, streaming_image))
         .def("reset", &ImageView::reset, D(ImageView, reset))
         .def("center", &ImageView::center, D(ImageView, center))
         .def("offset", &ImageView::offset, D(ImageView, offset))
@@ -58,7 +74,48 @@ void register_canvas(py::module &m) {
                         strncpy(out[i], str[i].c_str(), size);
                 });
              },
-             D(ImageView, set_pixel_callback));
+             D(ImageView, set_pixel_callback))
+        .def("set_batch_pixel_callback",
+             [](ImageView &img,
+                const std::function<std::vector<std::string>(const Vector2i &, const Vector2i &)> &func) {
+                img.set_batch_pixel_callback([func](const Vector2i &start, const Vector2i &size,
+                                                    char **out, size_t out_size) {
+                    auto str = func(start, size);
+                    size_t count = std::min(str.size(), (size_t) size.x() * (size_t) size.y() * 4);
+                    for (size_t i = 0; i < count; ++i) {
+                        strncpy(out[i], str[i].c_str(), out_size - 1);
+                        out[i][out_size - 1] = '\0';
+                    }
+                });
+             },
+             D(ImageView, set_batch_pixel_callback))
+        .def("invalidate_pixel_info", &ImageView::invalidate_pixel_info,
+             D(ImageView, invalidate_pixel_info));
+
+    py::class_<PlotCanvas, Canvas, ref<PlotCanvas>, PyPlotCanvas>(m, "PlotCanvas", D(PlotCanvas))
+        .def(py::init<Widget *, size_t, size_t>(), "parent"_a,
+             "channel_count"_a = 1, "capacity"_a = 1 << 20, D(PlotCanvas, PlotCanvas))
+        .def("channel_count", &PlotCanvas::channel_count, D(PlotCanvas, channel_count))
+        .def("capacity", &PlotCanvas::capacity, D(PlotCanvas, capacity))
+        .def("size", &PlotCanvas::size, D(PlotCanvas, size), "channel"_a)
+        .def("total", &PlotCanvas::total, D(PlotCanvas, total), "channel"_a)
+        .def("push", py::overload_cast<size_t, float>(&PlotCanvas::push),
+             D(PlotCanvas, push), "channel"_a, "value"_a)
+        .def("push", py::overload_cast<size_t, const std::vector<float> &>(&PlotCanvas::push),
+             D(PlotCanvas, push_3), "channel"_a, "values"_a)
+        .def("clear", &PlotCanvas::clear, D(PlotCanvas, clear))
+        .def("channel_color", &PlotCanvas::channel_color, D(PlotCanvas, channel_color))
+        .def("set_channel_color", &PlotCanvas::set_channel_color, D(PlotCanvas, set_channel_color))
+        .def("x_min", &PlotCanvas::x_min, D(PlotCanvas, x_min))
+        .def("x_max", &PlotCanvas::x_max, D(PlotCanvas, x_max))
+        .def("set_x_range", &PlotCanvas::set_x_range, D(PlotCanvas, set_x_range))
+        .def("y_range", &PlotCanvas::y_range, D(PlotCanvas, y_range))
+        .def("set_y_range", &PlotCanvas::set_y_range, D(PlotCanvas, set_y_range))
+        .def("follow", &PlotCanvas::follow, D(PlotCanvas, follow))
+        .def("set_follow", &PlotCanvas::set_follow, D(PlotCanvas, set_follow))
+        .def("axis_color", &PlotCanvas::axis_color, D(PlotCanvas, axis_color))
+        .def("set_axis_color", &PlotCanvas::set_axis_color, D(PlotCanvas, set_axis_color))
+        .def("level_count", &PlotCanvas::level_count, D(PlotCanvas, level_count));
 }
 
 #endif
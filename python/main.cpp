@@ -125,6 +125,8 @@ PYBIND11_MODULE(nanogui, m) {
     m.attr("api") = "gles3";
 #elif defined(NANOGUI_USE_METAL)
     m.attr("api") = "metal";
+#elif defined(NANOGUI_USE_NULL)
+    m.attr("api") = "null";
 #endif
 
     py::class_<MainloopHandle>(m, "MainloopHandle")
@@ -230,6 +232,8 @@ PYBIND11_MODULE(nanogui, m) {
     #endif
     m.def("utf8", [](int c) { return std::string(utf8(c).data()); }, D(utf8));
     m.def("load_image_directory", &nanogui::load_image_directory, D(load_image_directory));
+    m.def("load_image_directory_async", &nanogui::load_image_directory_async,
+          D(load_image_directory_async), "ctx"_a, "path"_a, "loader"_a, "callback"_a);
 
     py::enum_<Cursor>(m, "Cursor", D(Cursor))
         .value("Arrow", Cursor::Arrow)
@@ -44,7 +44,13 @@ void register_misc(py::module &m) {
         .def("text_color", &Graph::text_color, D(Graph, text_color))
         .def("set_text_color", &Graph::set_text_color, D(Graph, set_text_color))
         .def("values", (std::vector<float> &(Graph::*)(void)) &Graph::values, D(Graph, values))
-        .def("set_values", &Graph::set_values, D(Graph, set_values));
+        .def("set_values", &Graph::set_values, D(Graph, set_values))
+        .def("capacity", &Graph::capacity, D(Graph, capacity))
+        .def("set_capacity", &Graph::set_capacity, D(Graph, set_capacity))
+        .def("push", (void (Graph::*)(float)) &Graph::push, D(Graph, push))
+        .def("push", (void (Graph::*)(const std::vector<float> &)) &Graph::push, D(Graph, push_3))
+        .def("clear", &Graph::clear, D(Graph, clear))
+        .def("publish_values", &Graph::publish_values, D(Graph, publish_values));
 
     py::class_<ImagePanel, Widget, ref<ImagePanel>, PyImagePanel>(m, "ImagePanel", D(ImagePanel))
         .def(py::init<Widget *>(), "parent"_a, D(ImagePanel, ImagePanel))
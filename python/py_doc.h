@@ -514,16 +514,36 @@ Parameter ``has_stencil_buffer``:
 Parameter ``clear``:
     Should the widget clear its color/depth/stencil buffer?)doc";
 
+static const char *__doc_nanogui_Canvas_add_pending_shader =
+R"doc(Skip drawing the canvas contents until a shader created in deferred
+mode has finished compiling
+
+While any such shader is pending, the canvas is merely cleared and
+draw_contents() is not invoked. The shaders are polled via
+Shader::ready() in subsequent frames.)doc";
+
 static const char *__doc_nanogui_Canvas_background_color = R"doc(Return whether the widget border is drawn)doc";
 
 static const char *__doc_nanogui_Canvas_border_color = R"doc(Return whether the widget border is drawn)doc";
 
+static const char *__doc_nanogui_Canvas_composite =
+R"doc(Is the canvas composited through NanoVG? (see set_composite()))doc";
+
+static const char *__doc_nanogui_Canvas_composite_texture =
+R"doc(Return the single-sample texture that draw() composites)doc";
+
 static const char *__doc_nanogui_Canvas_draw = R"doc(Draw the widget)doc";
 
 static const char *__doc_nanogui_Canvas_draw_border = R"doc(Return whether the widget border will be drawn)doc";
 
 static const char *__doc_nanogui_Canvas_draw_contents = R"doc(Draw the widget contents. Override this method.)doc";
 
+static const char *__doc_nanogui_Canvas_framebuffer_size =
+R"doc(Return the size of the region rendered by draw_contents() in pixels)doc";
+
+static const char *__doc_nanogui_Canvas_init_render_pass =
+R"doc((Re-)create the render pass and its targets)doc";
+
 static const char *__doc_nanogui_Canvas_m_border_color = R"doc()doc";
 
 static const char *__doc_nanogui_Canvas_m_draw_border = R"doc()doc";
@@ -534,14 +554,50 @@ static const char *__doc_nanogui_Canvas_m_render_pass_resolved = R"doc()doc";
 
 static const char *__doc_nanogui_Canvas_m_render_to_texture = R"doc()doc";
 
+static const char *__doc_nanogui_Canvas_render_offscreen =
+R"doc(Render the canvas contents into its offscreen target
+
+Only applies in composite mode, where it is invoked by Screen for all
+visible canvases before the NanoVG frame begins.)doc";
+
 static const char *__doc_nanogui_Canvas_render_pass = R"doc(Return the render pass associated with the canvas object)doc";
 
+static const char *__doc_nanogui_Canvas_render_pass_changed =
+R"doc(Invoked after set_composite() replaced the render pass
+
+Shaders are tied to the render pass they were created for. Subclasses
+that create shaders must override this function to re-create them.)doc";
+
 static const char *__doc_nanogui_Canvas_set_background_color = R"doc(Specify the widget background color)doc";
 
 static const char *__doc_nanogui_Canvas_set_border_color = R"doc(Specify the widget border color)doc";
 
+static const char *__doc_nanogui_Canvas_set_composite =
+R"doc(Composite the canvas through NanoVG instead of rendering it in the
+middle of the widget pass?
+
+By default, draw() flushes all NanoVG geometry queued so far, renders
+the canvas contents, and then continues with the remaining widgets.
+With many canvases on screen, these flushes dominate the cost of
+drawing the user interface.
+
+In composite mode, the canvas instead renders into an offscreen
+texture before the NanoVG frame begins (see render_offscreen()), and
+draw() merely fills its area with an image paint that references this
+texture. NanoVG then submits the entire user interface at once. The
+offscreen color target is obtained from Screen::texture_pool().
+
+Changing this setting re-creates the render pass (see
+render_pass_changed()).)doc";
+
 static const char *__doc_nanogui_Canvas_set_draw_border = R"doc(Specify whether to draw the widget border)doc";
 
+static const char *__doc_nanogui_Canvas_shaders_ready =
+R"doc(Poll the shaders registered via add_pending_shader() and return
+whether all of them are ready
+
+Requests another redraw while some are still compiling.)doc";
+
 static const char *__doc_nanogui_CheckBox =
 R"doc(Two-state check box widget.
 
@@ -921,6 +977,131 @@ static const char *__doc_nanogui_ComboBox_set_items_2 = R"doc(Sets the items for
 
 static const char *__doc_nanogui_ComboBox_set_selected_index = R"doc(Sets the current index this ComboBox has selected.)doc";
 
+static const char *__doc_nanogui_CommandBuffer =
+R"doc(Records render pass, shader, uniform, buffer, texture, and draw
+commands for later execution
+
+Commands and their arguments (including copies of uniform and buffer
+contents) are appended to a compact linear arena. Recording does not
+issue any OpenGL/GLES/Metal API calls, hence several command buffers
+can be recorded concurrently on worker threads, e.g. to prepare heavy
+Canvas content using all cores. A single command buffer must only be
+recorded by one thread at a time.
+
+replay() then executes one or more command buffers in order on the
+thread owning the rendering context. Redundant work is skipped on the
+way: uniform and texture assignments that match the current value are
+dropped, and an end_shader() / begin_shader() (or end_pass() /
+begin_pass() for passes that do not clear) pair referring to the same
+object is elided.
+
+Shader parameters can be referenced by name or by a handle obtained
+from Shader::binding(). Names are resolved during replay, which is
+preferable on worker threads since Shader::binding() may need to wait
+for a pending shader compilation.
+
+The recorded commands can be inspected via command_count(),
+command_type(), and to_string(), which does not require a GPU.)doc";
+
+static const char *__doc_nanogui_CommandBuffer_CommandBuffer =
+R"doc(Create an empty command buffer)doc";
+
+static const char *__doc_nanogui_CommandBuffer_CommandType =
+R"doc(Types of recorded commands)doc";
+
+static const char *__doc_nanogui_CommandBuffer_CommandType_BeginPass = R"doc()doc";
+
+static const char *__doc_nanogui_CommandBuffer_CommandType_BeginShader = R"doc()doc";
+
+static const char *__doc_nanogui_CommandBuffer_CommandType_DrawArray = R"doc()doc";
+
+static const char *__doc_nanogui_CommandBuffer_CommandType_EndPass = R"doc()doc";
+
+static const char *__doc_nanogui_CommandBuffer_CommandType_EndShader = R"doc()doc";
+
+static const char *__doc_nanogui_CommandBuffer_CommandType_SetBuffer = R"doc()doc";
+
+static const char *__doc_nanogui_CommandBuffer_CommandType_SetTexture = R"doc()doc";
+
+static const char *__doc_nanogui_CommandBuffer_append =
+R"doc(Append a command with a payload of ``size`` bytes and return the
+latter)doc";
+
+static const char *__doc_nanogui_CommandBuffer_append_binding =
+R"doc(Append a command referencing a shader parameter)doc";
+
+static const char *__doc_nanogui_CommandBuffer_begin_pass =
+R"doc(Begin the render pass ``render_pass`` (see RenderPass::begin()))doc";
+
+static const char *__doc_nanogui_CommandBuffer_begin_shader =
+R"doc(Begin drawing using ``shader`` (see Shader::begin()))doc";
+
+static const char *__doc_nanogui_CommandBuffer_clear =
+R"doc(Remove all commands (retains the allocated memory))doc";
+
+static const char *__doc_nanogui_CommandBuffer_command_count =
+R"doc(Return the number of recorded commands)doc";
+
+static const char *__doc_nanogui_CommandBuffer_command_type =
+R"doc(Return the type of the command with the given index)doc";
+
+static const char *__doc_nanogui_CommandBuffer_draw_array =
+R"doc(Record a call to Shader::draw_array() using the current shader)doc";
+
+static const char *__doc_nanogui_CommandBuffer_draw_array_instanced =
+R"doc(Record a call to Shader::draw_array_instanced() using the current
+shader)doc";
+
+static const char *__doc_nanogui_CommandBuffer_end_pass =
+R"doc(Finish the current render pass (see RenderPass::end()))doc";
+
+static const char *__doc_nanogui_CommandBuffer_end_shader =
+R"doc(End drawing using the current shader (see Shader::end()))doc";
+
+static const char *__doc_nanogui_CommandBuffer_replay =
+R"doc(Execute the recorded commands
+
+Must be called on the thread owning the rendering context. Render
+passes and shaders that are still active at the end of the command
+buffer are finished automatically.)doc";
+
+static const char *__doc_nanogui_CommandBuffer_replay_2 =
+R"doc(Execute several command buffers in order, eliding redundant state
+changes between them)doc";
+
+static const char *__doc_nanogui_CommandBuffer_reserve =
+R"doc(Preallocate ``size`` bytes of command storage)doc";
+
+static const char *__doc_nanogui_CommandBuffer_retain =
+R"doc(Keep ``object`` alive until the command buffer is cleared)doc";
+
+static const char *__doc_nanogui_CommandBuffer_set_buffer =
+R"doc(Record a call to Shader::set_buffer(); the data is copied)doc";
+
+static const char *__doc_nanogui_CommandBuffer_set_buffer_2 =
+R"doc(Record a call to Shader::set_buffer() with a handle obtained from
+Shader::binding())doc";
+
+static const char *__doc_nanogui_CommandBuffer_set_texture =
+R"doc(Record a call to Shader::set_texture())doc";
+
+static const char *__doc_nanogui_CommandBuffer_set_texture_2 =
+R"doc(Record a call to Shader::set_texture() with a handle obtained from
+Shader::binding())doc";
+
+static const char *__doc_nanogui_CommandBuffer_set_uniform =
+R"doc(Record a call to Shader::set_uniform(); the value is copied)doc";
+
+static const char *__doc_nanogui_CommandBuffer_set_uniform_2 =
+R"doc(Record a call to Shader::set_uniform() with a handle obtained from
+Shader::binding())doc";
+
+static const char *__doc_nanogui_CommandBuffer_size =
+R"doc(Return the number of bytes used by the recorded commands)doc";
+
+static const char *__doc_nanogui_CommandBuffer_to_string =
+R"doc(Return a human-readable listing of the recorded commands)doc";
+
 static const char *__doc_nanogui_Cursor =
 R"doc(Cursor shapes available to use in GLFW. Shape of actual cursor
 determined by Operating System.)doc";
@@ -1082,42 +1263,285 @@ static const char *__doc_nanogui_FormHelper_widget_font_size = R"doc(The size of
 
 static const char *__doc_nanogui_FormHelper_window = R"doc(Access the currently active Window instance)doc";
 
+static const char *__doc_nanogui_FrameProfiler =
+R"doc(Measures the CPU and GPU time spent in the passes of each frame
+
+A Screen with profiling enabled (see Screen::set_profiling()) records a
+scope for its Screen::draw_contents() and NanoVG widget passes, and
+every RenderPass adds a scope between its RenderPass::begin() and
+RenderPass::end() calls (named after its RenderPass::label()).
+
+Timings are exclusive: while a scope is nested in another one (e.g. a
+canvas that is drawn in the middle of the widget pass), its time is
+only attributed to the nested scope.
+
+On OpenGL, the GPU time of each scope is measured using
+``GL_TIME_ELAPSED`` queries. These are collected in a ring that holds
+the queries of several frames, and their results are only read once
+they are available, which usually happens latency() frames later.
+stats() hence refers to an earlier frame that is identified by
+Stats::frame. Other backends only report CPU timings.)doc";
+
+static const char *__doc_nanogui_FrameProfiler_FrameProfiler =
+R"doc(Create a new frame profiler
+
+Parameter ``gpu_timers``:
+    Measure GPU timings using timer queries? Must only be ``True`` if
+    an OpenGL context is current. Ignored by other backends.
+
+Parameter ``latency``:
+    Number of frames after which the GPU timings of a frame are
+    expected to be available. If they are not, begin_frame() waits
+    for them before reusing the queries of that frame.)doc";
+
+static const char *__doc_nanogui_FrameProfiler_Stats =
+R"doc(Timings of a frame (in milliseconds))doc";
+
+static const char *__doc_nanogui_FrameProfiler_Stats_cpu_time =
+R"doc(CPU time between begin_frame() and end_frame())doc";
+
+static const char *__doc_nanogui_FrameProfiler_Stats_frame =
+R"doc(Index of the frame (starting at 1, or 0 if no frame was measured yet))doc";
+
+static const char *__doc_nanogui_FrameProfiler_Stats_gpu_time =
+R"doc(Sum of the GPU time of all scopes, or -1 if it is unavailable)doc";
+
+static const char *__doc_nanogui_FrameProfiler_Stats_timings =
+R"doc(Timings of the scopes in the order in which they were entered)doc";
+
+static const char *__doc_nanogui_FrameProfiler_Timing =
+R"doc(Timings of a scope (in milliseconds))doc";
+
+static const char *__doc_nanogui_FrameProfiler_Timing_cpu_time = R"doc()doc";
+
+static const char *__doc_nanogui_FrameProfiler_Timing_gpu_time =
+R"doc(GPU time, or -1 if it is unavailable)doc";
+
+static const char *__doc_nanogui_FrameProfiler_Timing_name = R"doc()doc";
+
+static const char *__doc_nanogui_FrameProfiler_begin_frame =
+R"doc(Begin measuring a new frame)doc";
+
+static const char *__doc_nanogui_FrameProfiler_current =
+R"doc(Return the profiler of the frame drawn by the calling thread (if any))doc";
+
+static const char *__doc_nanogui_FrameProfiler_draw_overlay =
+R"doc(Draw stats() as a table whose upper left corner is at ``pos``)doc";
+
+static const char *__doc_nanogui_FrameProfiler_end_frame =
+R"doc(Finish the current frame and publish the timings that are available)doc";
+
+static const char *__doc_nanogui_FrameProfiler_gpu_timers =
+R"doc(Are GPU timings measured?)doc";
+
+static const char *__doc_nanogui_FrameProfiler_latency =
+R"doc(Return the number of frames after which the GPU timings are read)doc";
+
+static const char *__doc_nanogui_FrameProfiler_m_gpu_timers = R"doc()doc";
+
+static const char *__doc_nanogui_FrameProfiler_pop =
+R"doc(Leave the scope entered by the last call to push())doc";
+
+static const char *__doc_nanogui_FrameProfiler_push =
+R"doc(Enter a scope (nested in the current one, if any))doc";
+
+static const char *__doc_nanogui_FrameProfiler_set_current =
+R"doc(Set the profiler that RenderPass instances on the calling thread
+report to)doc";
+
+static const char *__doc_nanogui_FrameProfiler_stats =
+R"doc(Return the timings of the most recent frame whose measurements are
+complete)doc";
+
+static const char *__doc_nanogui_GLState =
+R"doc(Shadow copy of the OpenGL state that is frequently changed by RenderPass, Shader, Texture, and Screen
+
+State changes issued through this class are skipped when the shadow
+copy shows that they would have no effect, and getters answer from the
+shadow copy instead of performing a ``glGet*()`` round trip, which
+stalls the pipeline on many drivers. Only values that are unknown
+(e.g. following a call to invalidate()) are queried from OpenGL.
+
+Each Screen owns an instance for its context and makes it current
+along with the context. The shadow copy goes stale when OpenGL state
+is changed by other means. NanoGUI accounts for this in the case of
+NanoVG, but applications that issue raw OpenGL calls (e.g. within
+Canvas::draw_contents()) must call invalidate() afterwards.)doc";
+
+static const char *__doc_nanogui_GLState_Capability =
+R"doc(Capabilities toggled via ``glEnable()``/``glDisable()``)doc";
+
+static const char *__doc_nanogui_GLState_GLState =
+R"doc(Create a shadow copy where all state is unknown)doc";
+
+static const char *__doc_nanogui_GLState_active_texture =
+R"doc(Select the active texture unit (``0``, ``1``, ..., not ``GL_TEXTURE0``
++ i))doc";
+
+static const char *__doc_nanogui_GLState_bind_framebuffer =
+R"doc(Bind a framebuffer
+
+Parameter ``target``:
+    ``GL_FRAMEBUFFER``, ``GL_READ_FRAMEBUFFER``, or ``GL_DRAW_FRAMEBUFFER``)doc";
+
+static const char *__doc_nanogui_GLState_bind_texture =
+R"doc(Bind a 2D texture to the active texture unit
+
+Parameter ``force``:
+    Issue the call even if the shadow copy indicates that the texture
+    is already bound. Used by Texture before modifying textures, as
+    NanoVG also binds textures when creating images.)doc";
+
+static const char *__doc_nanogui_GLState_bind_vertex_array =
+R"doc(Bind a vertex array object)doc";
+
+static const char *__doc_nanogui_GLState_current =
+R"doc(Return the state of the OpenGL context that is current on the calling thread
+
+Returns a shared fallback instance if no state was made current.)doc";
+
+static const char *__doc_nanogui_GLState_depth_mask =
+R"doc(Query whether writes to the depth buffer are enabled)doc";
+
+static const char *__doc_nanogui_GLState_enabled =
+R"doc(Query whether a capability is enabled)doc";
+
+static const char *__doc_nanogui_GLState_framebuffer_deleted =
+R"doc(Notify the shadow copy that a framebuffer was deleted)doc";
+
+static const char *__doc_nanogui_GLState_invalidate =
+R"doc(Forget all shadowed values, e.g. after OpenGL was used directly)doc";
+
+static const char *__doc_nanogui_GLState_program_deleted =
+R"doc(Notify the shadow copy that a program was deleted)doc";
+
+static const char *__doc_nanogui_GLState_reset =
+R"doc(Invalidate the shadow copy and establish a known baseline state
+
+All capabilities are disabled, writes to the depth buffer are enabled,
+no program, vertex array, or framebuffer is bound, texture unit 0 is
+active, and the viewport and scissor rectangle cover the framebuffer.
+This only issues state changes (no queries) and is used by Screen at
+the beginning of a frame and after NanoVG has rendered.)doc";
+
+static const char *__doc_nanogui_GLState_scissor =
+R"doc(Return the scissor rectangle (x, y, width, height))doc";
+
+static const char *__doc_nanogui_GLState_set_blend_func =
+R"doc(Set the blending factors)doc";
+
+static const char *__doc_nanogui_GLState_set_cull_face =
+R"doc(Set the faces that are culled (``GL_FRONT`` or ``GL_BACK``))doc";
+
+static const char *__doc_nanogui_GLState_set_current =
+R"doc(Set the state associated with the context that is current on the
+calling thread)doc";
+
+static const char *__doc_nanogui_GLState_set_depth_func =
+R"doc(Set the depth comparison function (e.g. ``GL_LESS``))doc";
+
+static const char *__doc_nanogui_GLState_set_depth_mask =
+R"doc(Enable or disable writes to the depth buffer)doc";
+
+static const char *__doc_nanogui_GLState_set_enabled =
+R"doc(Enable or disable a capability)doc";
+
+static const char *__doc_nanogui_GLState_set_scissor =
+R"doc(Set the scissor rectangle (x, y, width, height))doc";
+
+static const char *__doc_nanogui_GLState_set_viewport =
+R"doc(Set the viewport (x, y, width, height))doc";
+
+static const char *__doc_nanogui_GLState_texture_deleted =
+R"doc(Notify the shadow copy that a texture was deleted)doc";
+
+static const char *__doc_nanogui_GLState_use_program = R"doc(Bind a shader program)doc";
+
+static const char *__doc_nanogui_GLState_vertex_array_deleted =
+R"doc(Notify the shadow copy that a vertex array object was deleted)doc";
+
+static const char *__doc_nanogui_GLState_viewport =
+R"doc(Return the viewport (x, y, width, height))doc";
+
 static const char *__doc_nanogui_Graph = R"doc(Simple graph widget for showing a function plot.)doc";
 
 static const char *__doc_nanogui_Graph_Graph = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_background_color = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_capacity =
+R"doc(Return the capacity of the streaming ring buffer
+
+A value of zero (the default) means that push() appends without bound.
+Otherwise, pushing more than ``capacity`` samples overwrites the oldest
+ones.)doc";
+
 static const char *__doc_nanogui_Graph_caption = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_clear = R"doc(Remove all samples)doc";
+
 static const char *__doc_nanogui_Graph_draw = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_draw_samples =
+R"doc(Emit the graph outline, decimated to at most two vertices per pixel
+column)doc";
+
 static const char *__doc_nanogui_Graph_fill_color = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_footer = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_header = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_linearize =
+R"doc(Rotate the ring buffer so that the oldest sample is stored first)doc";
+
 static const char *__doc_nanogui_Graph_m_background_color = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_m_capacity = R"doc()doc";
+
 static const char *__doc_nanogui_Graph_m_caption = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_m_fill_color = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_m_footer = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_m_head =
+R"doc(Index of the oldest sample in m_values)doc";
+
 static const char *__doc_nanogui_Graph_m_header = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_m_published_values =
+R"doc(Samples handed over by publish_values())doc";
+
 static const char *__doc_nanogui_Graph_m_stroke_color = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_m_text_color = R"doc()doc";
 
-static const char *__doc_nanogui_Graph_m_values = R"doc()doc";
+static const char *__doc_nanogui_Graph_m_values =
+R"doc(Sample storage; holds a ring buffer starting at m_head when full)doc";
 
 static const char *__doc_nanogui_Graph_preferred_size = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_publish_values =
+R"doc(Replace the samples from a worker thread without locking
+
+The samples are picked up when the graph is drawn next (see
+Published), where they take the place of values(). Follow up with
+Screen::redraw() to display them.)doc";
+
+static const char *__doc_nanogui_Graph_push = R"doc(Append a single sample)doc";
+
+static const char *__doc_nanogui_Graph_push_2 =
+R"doc(Append ``count`` samples stored contiguously at ``values``)doc";
+
+static const char *__doc_nanogui_Graph_push_3 = R"doc(Append a sequence of samples)doc";
+
 static const char *__doc_nanogui_Graph_set_background_color = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_set_capacity =
+R"doc(Set the capacity of the streaming ring buffer (keeps the most recent
+samples))doc";
+
 static const char *__doc_nanogui_Graph_set_caption = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_set_fill_color = R"doc()doc";
@@ -1136,7 +1560,11 @@ static const char *__doc_nanogui_Graph_stroke_color = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_text_color = R"doc()doc";
 
-static const char *__doc_nanogui_Graph_values = R"doc()doc";
+static const char *__doc_nanogui_Graph_trim_to_capacity =
+R"doc(Drop the oldest samples beyond the capacity (e.g. added via values()))doc";
+
+static const char *__doc_nanogui_Graph_values =
+R"doc(Return the plotted samples (oldest first))doc";
 
 static const char *__doc_nanogui_Graph_values_2 = R"doc()doc";
 
@@ -1326,24 +1754,57 @@ pixel information is shown at large magnifications.)doc";
 
 static const char *__doc_nanogui_ImageView_ImageView = R"doc(Initialize the widget)doc";
 
+static const char *__doc_nanogui_ImageView_TileCacheEntry = R"doc()doc";
+
+static const char *__doc_nanogui_ImageView_batch_pixel_callback =
+R"doc(Return the callback that acquires information about all visible pixels
+at once)doc";
+
 static const char *__doc_nanogui_ImageView_center = R"doc(Center the image on the screen)doc";
 
 static const char *__doc_nanogui_ImageView_draw = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_draw_contents = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_draw_quad =
+R"doc(Draw a single quad covering the image region [origin, origin + extent))doc";
+
+static const char *__doc_nanogui_ImageView_draw_tiles =
+R"doc(Draw the visible tiles of a tiled image)doc";
+
+static const char *__doc_nanogui_ImageView_has_image =
+R"doc(Is an image (regular or tiled) currently set?)doc";
+
 static const char *__doc_nanogui_ImageView_image = R"doc(Return the currently active image)doc";
 
 static const char *__doc_nanogui_ImageView_image_2 = R"doc(Return the currently active image (const version))doc";
 
+static const char *__doc_nanogui_ImageView_image_size =
+R"doc(Return the size of the active image in pixels)doc";
+
+static const char *__doc_nanogui_ImageView_init_shader =
+R"doc(Create the shader used to draw the image)doc";
+
+static const char *__doc_nanogui_ImageView_invalidate_pixel_info =
+R"doc(Discard cached pixel information
+
+The strings returned by the pixel callbacks are cached as long as the
+set of visible pixels does not change. Call this function after
+modifying the contents of the image.)doc";
+
 static const char *__doc_nanogui_ImageView_keyboard_event = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_m_batch_pixel_callback = R"doc()doc";
+
 static const char *__doc_nanogui_ImageView_m_draw_image_border = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_m_image = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_m_image_background_color = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_m_image_binding =
+R"doc(Handles of frequently updated shader parameters)doc";
+
 static const char *__doc_nanogui_ImageView_m_image_border_color = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_m_image_shader = R"doc()doc";
@@ -1352,8 +1813,28 @@ static const char *__doc_nanogui_ImageView_m_offset = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_m_pixel_callback = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_m_pixel_info =
+R"doc(Cached pixel information: text storage, string pointers, and rectangle)doc";
+
+static const char *__doc_nanogui_ImageView_m_pixel_info_size = R"doc()doc";
+
+static const char *__doc_nanogui_ImageView_m_pixel_info_start = R"doc()doc";
+
+static const char *__doc_nanogui_ImageView_m_pixel_info_text = R"doc()doc";
+
 static const char *__doc_nanogui_ImageView_m_scale = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_m_tile_cache_size = R"doc()doc";
+
+static const char *__doc_nanogui_ImageView_m_tile_loader = R"doc()doc";
+
+static const char *__doc_nanogui_ImageView_m_tile_lru =
+R"doc(Tile cache, ordered from most to least recently used)doc";
+
+static const char *__doc_nanogui_ImageView_m_tile_map = R"doc()doc";
+
+static const char *__doc_nanogui_ImageView_m_tile_source = R"doc()doc";
+
 static const char *__doc_nanogui_ImageView_mouse_drag_event = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_offset = R"doc(Return the pixel offset of the zoomed image rectangle)doc";
@@ -1366,14 +1847,36 @@ static const char *__doc_nanogui_ImageView_pixel_to_pos = R"doc(Convert a pixel
 
 static const char *__doc_nanogui_ImageView_pos_to_pixel = R"doc(Convert a position within the widget to a pixel position in the image)doc";
 
+static const char *__doc_nanogui_ImageView_release_stream =
+R"doc(Detach from the current streaming image (if any))doc";
+
+static const char *__doc_nanogui_ImageView_release_tiles =
+R"doc(Stop the background threads loading tiles and clear the tile cache)doc";
+
+static const char *__doc_nanogui_ImageView_render_pass_changed =
+R"doc(Re-create the shader for the new render pass)doc";
+
 static const char *__doc_nanogui_ImageView_reset = R"doc(Center the image on the screen and set the scale to 1:1)doc";
 
 static const char *__doc_nanogui_ImageView_scale = R"doc(Return the current magnification of the image)doc";
 
 static const char *__doc_nanogui_ImageView_scroll_event = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_set_batch_pixel_callback =
+R"doc(Set a callback that acquires information about all visible pixels at once
+
+This is considerably more efficient than set_pixel_callback() when the
+callback must e.g. download texture data from the GPU. When both
+callbacks are specified, the batched version takes precedence.)doc";
+
 static const char *__doc_nanogui_ImageView_set_image = R"doc(Set the currently active image)doc";
 
+static const char *__doc_nanogui_ImageView_set_image_2 =
+R"doc(Display a continuously updated image (e.g. a live video feed)
+
+The widget requests a redraw whenever a producer submits a new frame
+and displays the most recent frame in each redraw.)doc";
+
 static const char *__doc_nanogui_ImageView_set_offset = R"doc(Set the pixel offset of the zoomed image rectangle)doc";
 
 static const char *__doc_nanogui_ImageView_set_pixel_callback =
@@ -1382,6 +1885,28 @@ components)doc";
 
 static const char *__doc_nanogui_ImageView_set_scale = R"doc(Set the current magnification of the image)doc";
 
+static const char *__doc_nanogui_ImageView_set_tiled_image =
+R"doc(Display a tiled image
+
+Only the tiles covering the visible region are loaded, using the LOD
+level that matches the current magnification. Tiles are decoded on
+background threads and subsequently uploaded into a cache holding up
+to ``cache_size`` tiles in GPU memory, where the least recently used
+tiles are evicted first. While a tile is still loading, the widget
+displays the closest coarser level that is available.
+
+This makes it possible to display images that exceed the maximum
+texture size or the amount of GPU memory.)doc";
+
+static const char *__doc_nanogui_ImageView_streaming_image =
+R"doc(Return the currently active streaming image (if any))doc";
+
+static const char *__doc_nanogui_ImageView_tiled_image =
+R"doc(Return the currently active tiled image (if any))doc";
+
+static const char *__doc_nanogui_ImageView_update_pixel_info =
+R"doc(Query pixel information for a rectangle (unless already cached))doc";
+
 static const char *__doc_nanogui_IntBox =
 R"doc(A specialization of TextBox for representing integral values.
 
@@ -1501,6 +2026,93 @@ static const char *__doc_nanogui_MessageDialog_message_label_2 = R"doc()doc";
 
 static const char *__doc_nanogui_MessageDialog_set_callback = R"doc()doc";
 
+static const char *__doc_nanogui_NullStats =
+R"doc(Counters maintained by the null rendering backend
+
+The null backend implements Texture, Shader, RenderPass, VertexBuffer,
+and NanoVG as CPU-side recorders that do not require a GPU or display.
+Instead of rendering, they keep track of the resources and work that a
+GPU backend would have been asked for, which makes it possible to run
+and benchmark widgets and applications on headless machines.
+
+The first group of fields describes live resources and is maintained
+across null_reset_counters() calls. The remaining fields accumulate
+until they are reset.)doc";
+
+static const char *__doc_nanogui_NullStats_buffer_bytes =
+R"doc(Size of live shader buffers (vertex, index, and uniform data) in bytes)doc";
+
+static const char *__doc_nanogui_NullStats_clears =
+R"doc(Number of presented frames and framebuffer clears)doc";
+
+static const char *__doc_nanogui_NullStats_downloads =
+R"doc(Number of texture downloads)doc";
+
+static const char *__doc_nanogui_NullStats_draw_calls =
+R"doc(Number of draw calls, drawn instances, and drawn vertices/indices)doc";
+
+static const char *__doc_nanogui_NullStats_elements =
+R"doc(Number of draw calls, drawn instances, and drawn vertices/indices)doc";
+
+static const char *__doc_nanogui_NullStats_frames =
+R"doc(Number of presented frames and framebuffer clears)doc";
+
+static const char *__doc_nanogui_NullStats_instances =
+R"doc(Number of draw calls, drawn instances, and drawn vertices/indices)doc";
+
+static const char *__doc_nanogui_NullStats_nvg_fills =
+R"doc(Number of NanoVG fill, stroke, and triangle batches)doc";
+
+static const char *__doc_nanogui_NullStats_nvg_flushes =
+R"doc(Number of NanoVG flushes (at least one per frame))doc";
+
+static const char *__doc_nanogui_NullStats_nvg_image_bytes =
+R"doc(Number of live NanoVG images and their size in bytes)doc";
+
+static const char *__doc_nanogui_NullStats_nvg_images =
+R"doc(Number of live NanoVG images and their size in bytes)doc";
+
+static const char *__doc_nanogui_NullStats_nvg_paths =
+R"doc(Number of paths and vertices submitted by NanoVG)doc";
+
+static const char *__doc_nanogui_NullStats_nvg_strokes =
+R"doc(Number of NanoVG fill, stroke, and triangle batches)doc";
+
+static const char *__doc_nanogui_NullStats_nvg_triangles =
+R"doc(Number of NanoVG fill, stroke, and triangle batches)doc";
+
+static const char *__doc_nanogui_NullStats_nvg_vertices =
+R"doc(Number of paths and vertices submitted by NanoVG)doc";
+
+static const char *__doc_nanogui_NullStats_render_pass_begins =
+R"doc(Number of render pass and shader activations)doc";
+
+static const char *__doc_nanogui_NullStats_render_passes =
+R"doc(Number of live render passes)doc";
+
+static const char *__doc_nanogui_NullStats_shader_begins =
+R"doc(Number of render pass and shader activations)doc";
+
+static const char *__doc_nanogui_NullStats_shaders = R"doc(Number of live shaders)doc";
+
+static const char *__doc_nanogui_NullStats_texture_bytes =
+R"doc(Number of live textures and the size of their level 0 in bytes)doc";
+
+static const char *__doc_nanogui_NullStats_textures =
+R"doc(Number of live textures and the size of their level 0 in bytes)doc";
+
+static const char *__doc_nanogui_NullStats_upload_bytes =
+R"doc(Number of texture/buffer uploads and the transferred bytes)doc";
+
+static const char *__doc_nanogui_NullStats_uploads =
+R"doc(Number of texture/buffer uploads and the transferred bytes)doc";
+
+static const char *__doc_nanogui_NullStats_vertex_buffer_bytes =
+R"doc(Number of nonempty vertex buffers and their size in bytes)doc";
+
+static const char *__doc_nanogui_NullStats_vertex_buffers =
+R"doc(Number of nonempty vertex buffers and their size in bytes)doc";
+
 static const char *__doc_nanogui_Object = R"doc(Reference counted object base class.)doc";
 
 static const char *__doc_nanogui_Object_Object = R"doc(Default constructor)doc";
@@ -1525,6 +2137,125 @@ static const char *__doc_nanogui_Orientation_Horizontal = R"doc(Layout expands o
 
 static const char *__doc_nanogui_Orientation_Vertical = R"doc(Layout expands on vertical axis.)doc";
 
+static const char *__doc_nanogui_PlotCanvas =
+R"doc(Oscilloscope-style widget that plots multiple high-volume time series
+
+In contrast to Graph, which tessellates its plot using NanoVG, this
+widget keeps the samples of each channel in a fixed-capacity ring buffer
+that resides in GPU memory. Newly pushed samples are transferred using
+sub-range updates (Shader::set_buffer_range()) right before the next
+frame is drawn.
+
+Each channel additionally maintains a pyramid of min/max envelopes, where
+level ``k`` summarizes blocks of ``2^k`` samples using two vertices.
+When drawing, the widget selects the coarsest level that still yields
+(at most) two vertices per horizontal pixel and only draws the vertices
+that lie within the visible range. Panning and zooming merely change a few
+shader uniforms. Axes and tick labels are drawn using NanoVG.
+
+Horizontal coordinates refer to the index of a sample among all samples
+that were ever pushed into its channel.)doc";
+
+static const char *__doc_nanogui_PlotCanvas_PlotCanvas =
+R"doc(Create a new plot canvas
+
+Parameter ``parent``:
+    The parent widget
+
+Parameter ``channel_count``:
+    The number of independent data series
+
+Parameter ``capacity``:
+    The number of samples that are retained per channel (this value
+    may be rounded up slightly to simplify the LOD pyramid))doc";
+
+static const char *__doc_nanogui_PlotCanvas_axis_color =
+R"doc(Return the color of the axes and tick labels)doc";
+
+static const char *__doc_nanogui_PlotCanvas_capacity =
+R"doc(Return the number of samples that are retained per channel)doc";
+
+static const char *__doc_nanogui_PlotCanvas_channel_color =
+R"doc(Return the color of the given channel)doc";
+
+static const char *__doc_nanogui_PlotCanvas_channel_count =
+R"doc(Return the number of channels)doc";
+
+static const char *__doc_nanogui_PlotCanvas_clear =
+R"doc(Remove all samples from all channels)doc";
+
+static const char *__doc_nanogui_PlotCanvas_draw = R"doc()doc";
+
+static const char *__doc_nanogui_PlotCanvas_draw_axes =
+R"doc(Draw the axes and tick labels)doc";
+
+static const char *__doc_nanogui_PlotCanvas_draw_contents = R"doc()doc";
+
+static const char *__doc_nanogui_PlotCanvas_follow =
+R"doc(Should the visible range track the most recent samples?
+
+When enabled (the default), the horizontal range keeps its extent but
+is shifted so that it ends at the newest sample. Panning the view
+using the mouse disables this behavior.)doc";
+
+static const char *__doc_nanogui_PlotCanvas_init_shader =
+R"doc(Create the shader and allocate GPU storage for all channels)doc";
+
+static const char *__doc_nanogui_PlotCanvas_level_count =
+R"doc(Return the number of levels of the min/max LOD pyramid)doc";
+
+static const char *__doc_nanogui_PlotCanvas_mark_dirty =
+R"doc(Mark a range of ring buffer slots as modified)doc";
+
+static const char *__doc_nanogui_PlotCanvas_mouse_drag_event = R"doc()doc";
+
+static const char *__doc_nanogui_PlotCanvas_push =
+R"doc(Append a sample to the given channel)doc";
+
+static const char *__doc_nanogui_PlotCanvas_push_2 =
+R"doc(Append ``count`` contiguous samples to the given channel)doc";
+
+static const char *__doc_nanogui_PlotCanvas_push_3 =
+R"doc(Append a sequence of samples to the given channel)doc";
+
+static const char *__doc_nanogui_PlotCanvas_render_pass_changed =
+R"doc(Re-create the shader and re-upload all samples for the new render pass)doc";
+
+static const char *__doc_nanogui_PlotCanvas_scroll_event = R"doc()doc";
+
+static const char *__doc_nanogui_PlotCanvas_set_axis_color =
+R"doc(Set the color of the axes and tick labels)doc";
+
+static const char *__doc_nanogui_PlotCanvas_set_channel_color =
+R"doc(Set the color of the given channel)doc";
+
+static const char *__doc_nanogui_PlotCanvas_set_follow =
+R"doc(Specify whether the visible range should track the most recent samples)doc";
+
+static const char *__doc_nanogui_PlotCanvas_set_x_range =
+R"doc(Set the visible horizontal range (disables follow()))doc";
+
+static const char *__doc_nanogui_PlotCanvas_set_y_range =
+R"doc(Set the visible vertical range)doc";
+
+static const char *__doc_nanogui_PlotCanvas_size =
+R"doc(Return the number of samples currently stored by the given channel)doc";
+
+static const char *__doc_nanogui_PlotCanvas_total =
+R"doc(Return the total number of samples ever pushed into the given channel)doc";
+
+static const char *__doc_nanogui_PlotCanvas_update_range =
+R"doc(Recompute the LOD pyramid over a range of slots and upload it)doc";
+
+static const char *__doc_nanogui_PlotCanvas_x_max =
+R"doc(Return the visible horizontal range (upper bound))doc";
+
+static const char *__doc_nanogui_PlotCanvas_x_min =
+R"doc(Return the visible horizontal range (lower bound))doc";
+
+static const char *__doc_nanogui_PlotCanvas_y_range =
+R"doc(Return the visible vertical range)doc";
+
 static const char *__doc_nanogui_Popup =
 R"doc(Popup window for combo boxes, popup buttons, nested dialogs etc.
 
@@ -1626,14 +2357,136 @@ static const char *__doc_nanogui_ProgressBar_ProgressBar = R"doc()doc";
 
 static const char *__doc_nanogui_ProgressBar_draw = R"doc()doc";
 
+static const char *__doc_nanogui_ProgressBar_m_published_value =
+R"doc(Value handed over by publish_value())doc";
+
 static const char *__doc_nanogui_ProgressBar_m_value = R"doc()doc";
 
 static const char *__doc_nanogui_ProgressBar_preferred_size = R"doc()doc";
 
+static const char *__doc_nanogui_ProgressBar_publish_value =
+R"doc(Set the value from a worker thread without locking
+
+The value is picked up when the progress bar is drawn next (see
+Published). Follow up with Screen::redraw() to display it.)doc";
+
 static const char *__doc_nanogui_ProgressBar_set_value = R"doc()doc";
 
 static const char *__doc_nanogui_ProgressBar_value = R"doc()doc";
 
+static const char *__doc_nanogui_Published =
+R"doc(Snapshot of a value that one thread publishes and another thread
+(usually the main thread) consumes without locking
+
+Like StreamingTexture, this class exchanges the value through three
+slots: the producer writes into one slot, the most recently published
+snapshot waits in the second, and the consumer reads the third. Slots
+change hands through a single atomic exchange, hence neither side ever
+waits for the other. Snapshots that are superseded before the consumer
+picks them up are skipped.
+
+There may be one producer thread and one consumer thread at a time.
+Widgets such as ProgressBar and Graph consume their published values
+when they are drawn. Call Screen::redraw(), which may be invoked from
+any thread, to draw them promptly.)doc";
+
+static const char *__doc_nanogui_Published_back =
+R"doc(Return the slot written by the producer
+
+Its contents are unspecified (they hold an older snapshot). Modify it
+in place and call publish() to hand it over.)doc";
+
+static const char *__doc_nanogui_Published_front =
+R"doc(Return the snapshot fetched by the last call to update() (consumer)
+
+The consumer may move or swap its contents away.)doc";
+
+static const char *__doc_nanogui_Published_m_back =
+R"doc(Slots owned by the producer and consumer)doc";
+
+static const char *__doc_nanogui_Published_m_middle =
+R"doc(Slot holding the latest snapshot, plus the ``Fresh`` bit)doc";
+
+static const char *__doc_nanogui_Published_m_slots = R"doc()doc";
+
+static const char *__doc_nanogui_Published_publish =
+R"doc(Publish the contents of back() (producer))doc";
+
+static const char *__doc_nanogui_Published_publish_2 =
+R"doc(Publish a copy of the given value (producer))doc";
+
+static const char *__doc_nanogui_Published_update =
+R"doc(Fetch the most recently published snapshot (consumer)
+
+Returns ``True`` if a new snapshot was published since the last call,
+in which case it becomes available via front().)doc";
+
+static const char *__doc_nanogui_RenderDevice =
+R"doc(Graphics backend of a Screen, selected at runtime
+
+A render device creates the window surface and the NanoVG context of a
+screen, clears and presents its frames, and makes textures available
+to NanoVG. Backends are registered by name and priority. Backends with
+a negative priority (e.g. ``"software"``) are never tried
+automatically. The environment variable ``NANOGUI_RENDER_DEVICE``
+selects a single backend by name.)doc";
+
+static const char *__doc_nanogui_RenderDevice_backends =
+R"doc(Return the names of the registered backends in order of decreasing
+priority
+
+Backends with a negative priority are only included if ``opt_in`` is
+``True``.)doc";
+
+static const char *__doc_nanogui_RenderDevice_begin_frame =
+R"doc(Acquire the framebuffer of the next frame)doc";
+
+static const char *__doc_nanogui_RenderDevice_clear =
+R"doc(Clear the framebuffer using the screen's background color)doc";
+
+static const char *__doc_nanogui_RenderDevice_create =
+R"doc(Create a render device of the backend with the given name)doc";
+
+static const char *__doc_nanogui_RenderDevice_create_nvg_context =
+R"doc(Create the NanoVG context of a screen)doc";
+
+static const char *__doc_nanogui_RenderDevice_delete_nvg_context =
+R"doc(Destroy the NanoVG context created by create_nvg_context() or passed
+to Screen::initialize() along with this device)doc";
+
+static const char *__doc_nanogui_RenderDevice_end_frame = R"doc(Present the frame)doc";
+
+static const char *__doc_nanogui_RenderDevice_init_window =
+R"doc(Prepare the window of a screen for rendering (called by
+Screen::initialize()))doc";
+
+static const char *__doc_nanogui_RenderDevice_invalidate_state =
+R"doc(Discard cached state that NanoVG or the application may have modified)doc";
+
+static const char *__doc_nanogui_RenderDevice_name =
+R"doc(Return the name of the backend)doc";
+
+static const char *__doc_nanogui_RenderDevice_nvg_image_from_texture =
+R"doc(Create a NanoVG image referencing a texture (used by Canvas))doc";
+
+static const char *__doc_nanogui_RenderDevice_register_backend =
+R"doc(Register a backend (replacing any previous backend with the same name))doc";
+
+static const char *__doc_nanogui_RenderDevice_release =
+R"doc(Release the per-screen state when the screen is destroyed)doc";
+
+static const char *__doc_nanogui_RenderDevice_resize =
+R"doc(Notify the device that the framebuffer of a screen was resized)doc";
+
+static const char *__doc_nanogui_RenderDevice_supports_shaders =
+R"doc(Can Texture, Shader, and RenderPass be used with this device?)doc";
+
+static const char *__doc_nanogui_RenderDevice_window_hints =
+R"doc(Set the GLFW window hints selecting the client API
+
+Called before the screen creates its window. The device may turn off
+the stencil or floating point buffers requested by the screen.)doc";
+
 static const char *__doc_nanogui_RenderPass = R"doc()doc";
 
 static const char *__doc_nanogui_RenderPass_CullMode = R"doc(Culling mode)doc";
@@ -1706,6 +2559,9 @@ static const char *__doc_nanogui_RenderPass_blit_to =
 R"doc(Blit the framebuffer to another target (which can either be another
 RenderPass instance or a Screen instance).)doc";
 
+static const char *__doc_nanogui_RenderPass_clear =
+R"doc(Does begin() clear all buffers?)doc";
+
 static const char *__doc_nanogui_RenderPass_clear_color = R"doc(Return the clear color for a given color attachment)doc";
 
 static const char *__doc_nanogui_RenderPass_clear_depth = R"doc(Return the clear depth for the depth attachment)doc";
@@ -1722,6 +2578,10 @@ static const char *__doc_nanogui_RenderPass_depth_test = R"doc(Return the depth
 
 static const char *__doc_nanogui_RenderPass_end = R"doc(Finish the render pass)doc";
 
+static const char *__doc_nanogui_RenderPass_label =
+R"doc(Return the name under which the render pass is reported to the
+FrameProfiler)doc";
+
 static const char *__doc_nanogui_RenderPass_m_active = R"doc()doc";
 
 static const char *__doc_nanogui_RenderPass_m_blit_target = R"doc()doc";
@@ -1756,7 +2616,14 @@ static const char *__doc_nanogui_RenderPass_m_viewport_offset = R"doc()doc";
 
 static const char *__doc_nanogui_RenderPass_m_viewport_size = R"doc()doc";
 
-static const char *__doc_nanogui_RenderPass_resize = R"doc(Resize all texture targets attached to the render pass)doc";
+static const char *__doc_nanogui_RenderPass_resize =
+R"doc(Resize all texture targets attached to the render pass
+
+When a texture pool is attached (see set_texture_pool()), targets are
+instead exchanged for pooled textures of a suitable size class (which
+may be larger than ``size``) whenever the current targets no longer fit
+(see TexturePool::fits()). Rendering and blitting then only involve the
+upper left region of the requested size.)doc";
 
 static const char *__doc_nanogui_RenderPass_set_clear_color = R"doc(Set the clear color for a given color attachment)doc";
 
@@ -1768,12 +2635,25 @@ static const char *__doc_nanogui_RenderPass_set_cull_mode = R"doc(Specify the cu
 
 static const char *__doc_nanogui_RenderPass_set_depth_test = R"doc(Specify the depth test and depth write mask of this render pass)doc";
 
+static const char *__doc_nanogui_RenderPass_set_label =
+R"doc(Set the name under which the render pass is reported to the
+FrameProfiler)doc";
+
+static const char *__doc_nanogui_RenderPass_set_texture_pool =
+R"doc(Obtain resized targets from the given pool
+
+The render pass releases pooled targets back to the pool when they are
+replaced or when the render pass is destroyed.)doc";
+
 static const char *__doc_nanogui_RenderPass_set_viewport = R"doc(Set the pixel offset and size of the viewport region)doc";
 
 static const char *__doc_nanogui_RenderPass_targets =
 R"doc(Return the set of all render targets (including depth + stencil)
 associated with this render pass)doc";
 
+static const char *__doc_nanogui_RenderPass_texture_pool =
+R"doc(Return the texture pool used by resize() (if any))doc";
+
 static const char *__doc_nanogui_RenderPass_viewport = R"doc(Return the pixel offset and size of the viewport region)doc";
 
 static const char *__doc_nanogui_Screen =
@@ -1791,6 +2671,11 @@ Parameter ``size``:
 Parameter ``caption``:
     Window title (in UTF-8 encoding)
 
+Parameter ``context``:
+    Optional NanoVG context used to draw the widgets instead of one
+    created for the graphics backend, e.g. a software renderer created
+    by sw_nvg_create(). The caller retains ownership.
+
 Parameter ``resizable``:
     If creating a window, should it be resizable?
 
@@ -1868,10 +2753,20 @@ static const char *__doc_nanogui_Screen_drop_callback_event = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_drop_event = R"doc(Handle a file drop event)doc";
 
+static const char *__doc_nanogui_Screen_frame_stats =
+R"doc(Return the timings of the most recent frame whose measurements are
+complete)doc";
+
 static const char *__doc_nanogui_Screen_framebuffer_size =
 R"doc(Return the framebuffer size (potentially larger than size() on high-
 DPI screens))doc";
 
+static const char *__doc_nanogui_Screen_gl_state =
+R"doc(Return the shadow copy of the OpenGL state of this screen's context
+
+Call ``gl_state().invalidate()`` after changing OpenGL state without
+going through NanoGUI.)doc";
+
 static const char *__doc_nanogui_Screen_glfw_window = R"doc(Return a pointer to the underlying GLFW window data structure)doc";
 
 static const char *__doc_nanogui_Screen_has_depth_buffer = R"doc(Does the framebuffer have a depth buffer)doc";
@@ -1880,7 +2775,19 @@ static const char *__doc_nanogui_Screen_has_float_buffer = R"doc(Does the frameb
 
 static const char *__doc_nanogui_Screen_has_stencil_buffer = R"doc(Does the framebuffer have a stencil buffer)doc";
 
-static const char *__doc_nanogui_Screen_initialize = R"doc(Initialize the Screen)doc";
+static const char *__doc_nanogui_Screen_initialize =
+R"doc(Initialize a screen that draws into an existing GLFW window
+
+Parameter ``context``:
+    NanoVG context to draw into. It remains owned by the caller unless
+    a ``device`` is provided as well. If not specified, the render
+    device creates (and later destroys) the context.
+
+Parameter ``device``:
+    Render device of the window, which takes ownership of the NanoVG
+    context. If not specified, the screen keeps
+    the device that created its window, or uses the render device with
+    the highest priority if the application created the window.)doc";
 
 static const char *__doc_nanogui_Screen_key_callback_event = R"doc()doc";
 
@@ -1888,6 +2795,8 @@ static const char *__doc_nanogui_Screen_keyboard_character_event = R"doc(Text in
 
 static const char *__doc_nanogui_Screen_keyboard_event = R"doc(Default keyboard event handler)doc";
 
+static const char *__doc_nanogui_Screen_m_active_swap_interval = R"doc()doc";
+
 static const char *__doc_nanogui_Screen_m_background = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_m_caption = R"doc()doc";
@@ -1904,6 +2813,9 @@ static const char *__doc_nanogui_Screen_m_drag_active = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_m_drag_widget = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_m_external_nvg_context =
+R"doc(Was m_nvg_context passed to initialize() by the caller?)doc";
+
 static const char *__doc_nanogui_Screen_m_fbsize = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_m_float_buffer = R"doc()doc";
@@ -1924,20 +2836,37 @@ static const char *__doc_nanogui_Screen_m_mouse_pos = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_m_mouse_state = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_m_next_frame =
+R"doc(Time at which the next periodic frame is due)doc";
+
 static const char *__doc_nanogui_Screen_m_nvg_context = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_m_pixel_ratio = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_m_process_events = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_m_profiler = R"doc()doc";
+
+static const char *__doc_nanogui_Screen_m_profiler_overlay = R"doc()doc";
+
 static const char *__doc_nanogui_Screen_m_redraw = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_m_render_device = R"doc()doc";
+
 static const char *__doc_nanogui_Screen_m_resize_callback = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_m_shared_vsync = R"doc()doc";
+
 static const char *__doc_nanogui_Screen_m_shutdown_glfw = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_m_stencil_buffer = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_m_swap_interval =
+R"doc(Requested swap interval and the one set for the context (or -1 if
+unknown))doc";
+
+static const char *__doc_nanogui_Screen_m_target_frame_rate = R"doc()doc";
+
 static const char *__doc_nanogui_Screen_metal_layer = R"doc(Return the associated CAMetalLayer object)doc";
 
 static const char *__doc_nanogui_Screen_metal_texture = R"doc(Return the texure of the currently active Metal drawable (or NULL))doc";
@@ -1960,9 +2889,31 @@ static const char *__doc_nanogui_Screen_pixel_ratio =
 R"doc(Return the ratio between pixel and device coordinates (e.g. >= 2 on
 Mac Retina displays))doc";
 
+static const char *__doc_nanogui_Screen_profiler =
+R"doc(Return the frame profiler (or ``nullptr`` if profiling is disabled))doc";
+
+static const char *__doc_nanogui_Screen_profiler_overlay =
+R"doc(Are the frame statistics drawn on top of the widgets?)doc";
+
+static const char *__doc_nanogui_Screen_profiling =
+R"doc(Is the frame profiler enabled?)doc";
+
 static const char *__doc_nanogui_Screen_redraw =
 R"doc(Send an event that will cause the screen to be redrawn at the next
-event loop iteration)doc";
+event loop iteration
+
+May be called from any thread. Repeated calls before the next frame is
+drawn are coalesced into a single wake-up of the main loop.)doc";
+
+static const char *__doc_nanogui_Screen_redraw_pending =
+R"doc(Will the screen be redrawn at the next event loop iteration?)doc";
+
+static const char *__doc_nanogui_Screen_refresh_rate =
+R"doc(Return the refresh rate (in Hz) of the monitor showing the largest
+part of the window, or 0 if it cannot be determined)doc";
+
+static const char *__doc_nanogui_Screen_render_device =
+R"doc(Return the graphics backend of the screen)doc";
 
 static const char *__doc_nanogui_Screen_resize_callback = R"doc(Set the resize callback)doc";
 
@@ -1976,20 +2927,94 @@ static const char *__doc_nanogui_Screen_set_background = R"doc(Set the screen's
 
 static const char *__doc_nanogui_Screen_set_caption = R"doc(Set the window title bar caption)doc";
 
+static const char *__doc_nanogui_Screen_set_profiler_overlay =
+R"doc(Draw frame_stats() in the upper left corner? (enables profiling))doc";
+
+static const char *__doc_nanogui_Screen_set_profiling =
+R"doc(Measure the CPU and GPU time of the passes of each frame?
+
+See FrameProfiler for details. Canvases are reported as ``"Canvas"``
+unless their render pass was given another label (see
+RenderPass::set_label()).)doc";
+
 static const char *__doc_nanogui_Screen_set_resize_callback = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_set_shared_vsync =
+R"doc(Let this screen share a single vertical synchronization with the other
+screens drawn in the same iteration of mainloop()?
+
+Screens with this setting whose monitors share a refresh rate form a
+group, and only the screen of a group drawn last waits for the
+vertical blank (swap interval 1). The other screens of the group
+present their frames immediately (swap interval 0), hence they may
+tear. In exchange, redrawing N screens of a group takes a single
+refresh interval, whereas N screens that each wait for the vertical
+blank block for N intervals in turn and starve each other. A screen
+that must never tear should not use this setting and set its
+swap_interval() to 1 instead. This is implemented by setting the
+swap_interval() of each screen before drawing it. Disabled by
+default.)doc";
+
 static const char *__doc_nanogui_Screen_set_shutdown_glfw = R"doc(Shut down GLFW when the window is closed?)doc";
 
 static const char *__doc_nanogui_Screen_set_size = R"doc(Set window size)doc";
 
+static const char *__doc_nanogui_Screen_set_swap_interval =
+R"doc(Set the number of vertical refreshes to wait for when presenting the
+next frame (OpenGL/GLES only)
+
+Managed by mainloop() for screens with shared_vsync() enabled.)doc";
+
+static const char *__doc_nanogui_Screen_set_target_frame_rate =
+R"doc(Redraw the screen periodically at the given number of frames per
+second
+
+The main loop schedules these frames in addition to the redraws
+requested via redraw(), and sleeps until the earliest frame of all
+screens is due. Frames that cannot be drawn in time are skipped. The
+default value of 0 only redraws the screen on demand (and at the rate
+specified via the ``refresh`` parameter of mainloop()).)doc";
+
 static const char *__doc_nanogui_Screen_set_visible = R"doc(Set the top-level window visibility (no effect on full-screen windows))doc";
 
+static const char *__doc_nanogui_Screen_shared_vsync =
+R"doc(Does this screen share a vertical synchronization with other screens?)doc";
+
 static const char *__doc_nanogui_Screen_shutdown_glfw = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_swap_interval =
+R"doc(Return the number of vertical refreshes to wait for when presenting a
+frame)doc";
+
+static const char *__doc_nanogui_Screen_target_frame_rate =
+R"doc(Return the number of frames per second drawn periodically (see
+set_target_frame_rate()))doc";
+
+static const char *__doc_nanogui_Screen_texture_pool =
+R"doc(Return the pool of render target textures associated with this screen
+(used by Canvas))doc";
+
 static const char *__doc_nanogui_Screen_tooltip_fade_in_progress = R"doc(Is a tooltip currently fading in?)doc";
 
 static const char *__doc_nanogui_Screen_update_focus = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_update_schedule =
+R"doc(Request a redraw if a periodic frame is due (called by mainloop())
+
+Besides the periodic frames, this schedules the frames that fade in
+the tooltip of the widget under the cursor.
+
+Parameter ``now``:
+    Current time as returned by ``glfwGetTime()``
+
+Parameter ``refresh``:
+    Refresh period in milliseconds that applies if no target frame
+    rate was specified (a negative value disables it)
+
+Returns:
+    The time at which the next frame is due, or infinity if the
+    screen is only redrawn on demand (and no tooltip is fading in))doc";
+
 static const char *__doc_nanogui_Shader = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_BlendMode = R"doc(Alpha blending mode)doc";
@@ -2020,10 +3045,25 @@ static const char *__doc_nanogui_Shader_BufferType_VertexSampler = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_BufferType_VertexTexture = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_BufferUsage =
+R"doc(Expected update frequency of a vertex or index buffer)doc";
+
+static const char *__doc_nanogui_Shader_BufferUsage_Dynamic =
+R"doc(Updated occasionally (the default))doc";
+
+static const char *__doc_nanogui_Shader_BufferUsage_Static =
+R"doc(Uploaded once and drawn many times (e.g. static meshes))doc";
+
+static const char *__doc_nanogui_Shader_BufferUsage_Stream =
+R"doc(Replaced (almost) every time it is drawn)doc";
+
 static const char *__doc_nanogui_Shader_Buffer_buffer = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_Buffer_dirty = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_divisor =
+R"doc(Number of instances per step of a vertex attribute (``0``: per vertex))doc";
+
 static const char *__doc_nanogui_Shader_Buffer_dtype = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_Buffer_index = R"doc()doc";
@@ -2034,10 +3074,20 @@ static const char *__doc_nanogui_Shader_Buffer_shape = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_Buffer_size = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_storage_offset =
+R"doc(Byte offset of the current contents within the buffer object)doc";
+
 static const char *__doc_nanogui_Shader_Buffer_to_string = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_Buffer_type = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_vertex_attribute =
+R"doc(Index of the attribute within the layout of ``vertex_buffer``)doc";
+
+static const char *__doc_nanogui_Shader_Buffer_vertex_buffer =
+R"doc(Interleaved buffer providing this vertex attribute (see
+set_vertex_buffer()))doc";
+
 static const char *__doc_nanogui_Shader_PrimitiveType = R"doc(The type of geometry that should be rendered)doc";
 
 static const char *__doc_nanogui_Shader_PrimitiveType_Line = R"doc()doc";
@@ -2064,7 +3114,22 @@ Parameter ``vertex_shader``:
     The source of the vertex shader as a string.
 
 Parameter ``fragment_shader``:
-    The source of the fragment shader as a string.)doc";
+    The source of the fragment shader as a string.
+
+Parameter ``deferred``:
+    Issue compilation and linking without waiting for the result. The
+    shader is then created in a pending state (see ready()), and
+    drivers supporting ``KHR_parallel_shader_compile`` compile it on
+    background threads. Errors are reported when the shader is
+    finished by ready() or wait() instead of being thrown by the
+    constructor.)doc";
+
+static const char *__doc_nanogui_Shader_add_buffer =
+R"doc(Append a parameter and return it (used while reflecting the shader))doc";
+
+static const char *__doc_nanogui_Shader_advance_ring =
+R"doc(Switch a streaming buffer to the next segment of its ring,
+(re-)creating the ring if needed)doc";
 
 static const char *__doc_nanogui_Shader_begin =
 R"doc(Begin drawing using this shader
@@ -2076,8 +3141,20 @@ The Python bindings also include extra ``__enter__`` and ``__exit__``
 aliases so that the shader can be activated via Pythons 'with'
 statement.)doc";
 
+static const char *__doc_nanogui_Shader_binding =
+R"doc(Return a handle that identifies the named shader parameter
+
+The handle is a small integer that remains valid for the lifetime of
+the shader. Passing it to the handle-based overloads of set_buffer(),
+set_buffer_range(), set_uniform(), and set_texture() avoids a name
+lookup per call, which is worthwhile for parameters that are updated
+very frequently. The name ``indices`` refers to the index buffer.)doc";
+
 static const char *__doc_nanogui_Shader_blend_mode = R"doc(Return the blending mode of this shader)doc";
 
+static const char *__doc_nanogui_Shader_buffer =
+R"doc(Validate a handle and return the associated parameter)doc";
+
 static const char *__doc_nanogui_Shader_draw_array =
 R"doc(Render geometry arrays, either directly or using an index array.
 
@@ -2096,11 +3173,34 @@ Parameter ``indexed``:
     Render indexed geometry? In this case, an ``uint32_t`` valued
     buffer with name ``indices`` must have been uploaded using set().)doc";
 
+static const char *__doc_nanogui_Shader_draw_array_instanced =
+R"doc(Render several instances of geometry arrays in a single draw call
+
+Vertex attributes whose divisor is nonzero (see set_buffer_divisor())
+advance once per instance instead of once per vertex, e.g. to provide
+the position and color of each marker or particle. The other
+parameters have the same meaning as in draw_array().
+
+Parameter ``instance_count``:
+    Number of instances to render)doc";
+
 static const char *__doc_nanogui_Shader_end = R"doc(End drawing using this shader)doc";
 
+static const char *__doc_nanogui_Shader_init_parameters =
+R"doc(Set up the index buffer and uniform storage after reflection)doc";
+
+static const char *__doc_nanogui_Shader_load_program_binary =
+R"doc(Restore the program and its parameters from a program cache entry)doc";
+
+static const char *__doc_nanogui_Shader_m_bindings =
+R"doc(Maps parameter names to handles (only consulted by binding()))doc";
+
 static const char *__doc_nanogui_Shader_m_blend_mode = R"doc()doc";
 
-static const char *__doc_nanogui_Shader_m_buffers = R"doc()doc";
+static const char *__doc_nanogui_Shader_m_buffers = R"doc(Shader parameters, indexed by handle)doc";
+
+static const char *__doc_nanogui_Shader_m_index_binding =
+R"doc(Handle of the index buffer)doc";
 
 static const char *__doc_nanogui_Shader_m_name = R"doc()doc";
 
@@ -2108,10 +3208,32 @@ static const char *__doc_nanogui_Shader_m_pipeline_state = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_m_render_pass = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_m_uniform_data =
+R"doc(Values of all uniforms, stored back to back)doc";
+
 static const char *__doc_nanogui_Shader_name = R"doc(Return the name of this shader)doc";
 
 static const char *__doc_nanogui_Shader_pipeline_state = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_program_cache_path =
+R"doc(Return the directory where linked shader programs are cached)doc";
+
+static const char *__doc_nanogui_Shader_ready =
+R"doc(Has the shader finished compiling?
+
+Always returns ``True`` for shaders that were not created in deferred
+mode. Otherwise, this function polls the driver without blocking if
+``KHR_parallel_shader_compile`` is available, and finishes the shader
+(see wait()) once compilation is complete. Without the extension, the
+status cannot be polled and the shader is finished right away.)doc";
+
+static const char *__doc_nanogui_Shader_reflect =
+R"doc(Register the attributes and uniforms of the linked program)doc";
+
+static const char *__doc_nanogui_Shader_release_ring =
+R"doc(Release the fences of a ring (the buffer object is deleted by the
+caller))doc";
+
 static const char *__doc_nanogui_Shader_render_pass = R"doc(Return the render pass associated with this shader)doc";
 
 static const char *__doc_nanogui_Shader_set_buffer =
@@ -2125,15 +3247,138 @@ order.
 
 The buffer will be replaced if it is already present.)doc";
 
+static const char *__doc_nanogui_Shader_set_buffer_2 = R"doc()doc";
+
+static const char *__doc_nanogui_Shader_set_buffer_3 =
+R"doc(Upload a buffer associated with a handle obtained from binding())doc";
+
+static const char *__doc_nanogui_Shader_set_buffer_divisor =
+R"doc(Specify the rate at which a vertex attribute advances during instanced
+rendering
+
+A divisor of ``0`` (the default) advances the attribute once per
+vertex, and a divisor of ``n`` once every ``n`` instances drawn by
+draw_array_instanced(). Instanced attributes are not supported on
+OpenGL ES 2. Metal shaders instead index per-instance buffers using
+the ``[[instance_id]]`` attribute, hence the divisor is ignored there.)doc";
+
+static const char *__doc_nanogui_Shader_set_buffer_divisor_2 =
+R"doc(Specify the divisor of a buffer associated with a handle obtained from
+binding())doc";
+
+static const char *__doc_nanogui_Shader_set_buffer_range =
+R"doc(Update a contiguous range of rows of a vertex or index buffer
+
+In contrast to set_buffer(), this function leaves the size of the
+buffer unchanged and only transfers the modified rows to the GPU, which
+makes it suitable for streaming updates. The buffer must have been
+allocated using set_buffer() beforehand.
+
+Parameter ``name``:
+    Name of the vertex attribute (or ``indices``)
+
+Parameter ``offset``:
+    Index of the first row (i.e. vertex) to be updated
+
+Parameter ``count``:
+    Number of rows to be updated
+
+Parameter ``data``:
+    Pointer to ``count`` contiguous rows using the buffer's dtype)doc";
+
+static const char *__doc_nanogui_Shader_set_buffer_range_2 =
+R"doc(Update rows of a buffer associated with a handle obtained from
+binding())doc";
+
+static const char *__doc_nanogui_Shader_set_buffer_usage =
+R"doc(Specify how often a vertex or index buffer will be updated
+
+The hint takes effect with the next call to set_buffer(), which
+allocates storage accordingly:
+
+- ``Static`` and ``Dynamic`` buffers only reallocate GPU storage when
+their size changes and are otherwise updated in place.
+
+- ``Stream`` buffers are orphaned on every update, so that the driver
+can hand out fresh storage instead of waiting for pending draws to
+finish. On OpenGL 4.4+ (or with ``ARB_buffer_storage``), they instead
+use a persistently mapped ring of storage segments that are written
+directly and guarded by fences. On Metal, they are written to shared
+memory without a blit.
+
+Buffers that are updated independently (e.g. the positions and colors
+of a point cloud) should be kept in separate attributes, so that
+updating one does not re-upload the other.)doc";
+
+static const char *__doc_nanogui_Shader_set_buffer_usage_2 =
+R"doc(Specify the usage of a buffer associated with a handle obtained from
+binding())doc";
+
+static const char *__doc_nanogui_Shader_set_program_cache_path =
+R"doc(Set a directory where linked shader programs are cached
+
+When set, the OpenGL and GLES backends store the binary of each linked
+program (obtained via ``glGetProgramBinary()``) along with its
+reflected parameters in this directory. Shaders created later on with
+the same source code are restored from the cache, which skips
+compilation, linking, and reflection. Entries are keyed by the source
+code and the vendor, renderer, and version of the OpenGL
+implementation. Stale or invalid entries cause a fallback to regular
+compilation and are then replaced.
+
+The directory must exist. An empty string (the default) disables the
+cache. The Metal backend ignores this setting, as its shaders are
+precompiled.)doc";
+
 static const char *__doc_nanogui_Shader_set_texture =
 R"doc(Associate a texture with a named shader parameter
 
 The association will be replaced if it is already present.)doc";
 
+static const char *__doc_nanogui_Shader_set_texture_2 =
+R"doc(Associate a texture with a handle obtained from binding())doc";
+
 static const char *__doc_nanogui_Shader_set_uniform =
 R"doc(Upload a uniform variable (e.g. a vector or matrix) that will be
 associated with a named shader parameter.)doc";
 
+static const char *__doc_nanogui_Shader_set_uniform_2 =
+R"doc(Upload a uniform variable associated with a handle obtained from
+binding())doc";
+
+static const char *__doc_nanogui_Shader_set_vertex_buffer =
+R"doc(Feed vertex attributes from an interleaved VertexBuffer
+
+Each attribute of the buffer's layout is bound to the vertex input of
+the same name, replacing data previously uploaded via set_buffer().
+Attributes without a matching input are skipped, hence one buffer can
+serve several shaders that use different subsets of its attributes.
+The shader keeps a reference to the buffer, and later updates of its
+contents take effect automatically.
+
+On Metal, buffer arguments named after an attribute are bound at the
+attribute's byte offset, and the shader must index them using the
+stride of the buffer (e.g. by means of a struct matching the layout).)doc";
+
+static const char *__doc_nanogui_Shader_store_program_binary =
+R"doc(Write the linked program and its parameters to a program cache entry)doc";
+
+static const char *__doc_nanogui_Shader_uniform_layout =
+R"doc(Determine the type, shape, and storage of a uniform value as expected
+by set_buffer()
+
+Returns the number of dimensions, or <tt>(size_t) -1</tt> if the type
+of ``value`` is unsupported. Used by set_uniform() and
+CommandBuffer::set_uniform().)doc";
+
+static const char *__doc_nanogui_Shader_wait =
+R"doc(Block until a shader created in deferred mode has finished compiling,
+then check for errors and reflect its parameters
+
+Called implicitly by begin() and binding() (and hence by all functions
+that look up parameters by name). Throws an exception if compilation
+or linking failed.)doc";
+
 static const char *__doc_nanogui_Slider = R"doc(Fractional slider widget with mouse control.)doc";
 
 static const char *__doc_nanogui_Slider_Slider = R"doc()doc";
@@ -2182,6 +3427,86 @@ static const char *__doc_nanogui_Slider_set_value = R"doc()doc";
 
 static const char *__doc_nanogui_Slider_value = R"doc()doc";
 
+static const char *__doc_nanogui_StreamingTexture =
+R"doc(Texture whose contents are continuously replaced by a producer running
+on an arbitrary thread (e.g. a camera feed)
+
+Frames are exchanged through three CPU-side slots (a "triple buffer"):
+the producer writes into one slot, the most recently completed frame
+waits in the second, and the third is read by the main thread during
+update(). The producer therefore never waits for the renderer; frames
+that are superseded before the renderer picks them up are skipped.
+
+On the GPU side, update() rotates through ``buffer_count`` backing
+textures and fills them using Texture::upload_async(). A texture is thus
+only overwritten after the preceding ``buffer_count - 1`` frames were
+submitted, which prevents the driver from stalling on a texture that is
+still being read by in-flight draw calls.
+
+Pass an instance to ImageView::set_image() to display it.)doc";
+
+static const char *__doc_nanogui_StreamingTexture_StreamingTexture =
+R"doc(Create a streaming texture of the given size and format
+
+Parameter ``buffer_count``:
+    Number of backing textures that are rotated on the GPU (at least 2))doc";
+
+static const char *__doc_nanogui_StreamingTexture_begin_frame =
+R"doc(Begin writing a frame in place, avoiding the copy performed by push()
+(may be called from any thread)
+
+Returns a pointer to frame_bytes() bytes of tightly packed pixel
+storage. Must be followed by a call to end_frame(). Concurrent producers
+are serialized.)doc";
+
+static const char *__doc_nanogui_StreamingTexture_buffer_count =
+R"doc(Return the number of backing textures)doc";
+
+static const char *__doc_nanogui_StreamingTexture_end_frame =
+R"doc(Publish the frame started by begin_frame())doc";
+
+static const char *__doc_nanogui_StreamingTexture_frame_bytes =
+R"doc(Return the number of bytes per frame (tightly packed))doc";
+
+static const char *__doc_nanogui_StreamingTexture_frames_pushed =
+R"doc(Return the total number of frames submitted by producers)doc";
+
+static const char *__doc_nanogui_StreamingTexture_frames_skipped =
+R"doc(Return the number of frames that were superseded before they could
+be uploaded)doc";
+
+static const char *__doc_nanogui_StreamingTexture_frames_uploaded =
+R"doc(Return the number of frames that were uploaded to the GPU)doc";
+
+static const char *__doc_nanogui_StreamingTexture_push =
+R"doc(Submit a new frame (may be called from any thread)
+
+Parameter ``row_stride``:
+    Distance between successive rows of ``data`` in bytes (``0``:
+    tightly packed rows))doc";
+
+static const char *__doc_nanogui_StreamingTexture_set_frame_callback =
+R"doc(Set a function that is invoked (on the producer's thread) whenever a
+new frame has been submitted
+
+This is used by ImageView to request a redraw of its screen.)doc";
+
+static const char *__doc_nanogui_StreamingTexture_size =
+R"doc(Return the size of the frames)doc";
+
+static const char *__doc_nanogui_StreamingTexture_texture =
+R"doc(Return the backing texture holding the most recently uploaded frame)doc";
+
+static const char *__doc_nanogui_StreamingTexture_texture_2 =
+R"doc(Return the backing texture holding the most recently uploaded frame
+(const version))doc";
+
+static const char *__doc_nanogui_StreamingTexture_update =
+R"doc(Upload the most recent frame (if any) into the next backing texture
+
+Must be called on the main thread. Returns ``True`` if texture()
+changed.)doc";
+
 static const char *__doc_nanogui_TabWidget =
 R"doc(A wrapper around the widgets TabHeader and StackedWidget which hooks
 the two classes together.
@@ -2602,6 +3927,152 @@ static const char *__doc_nanogui_TextBox_value = R"doc()doc";
 
 static const char *__doc_nanogui_Texture = R"doc()doc";
 
+static const char *__doc_nanogui_TextureLoader =
+R"doc(Loads images in the background without stalling the user interface
+
+Image files are decoded by a pool of worker threads. Decoded images are
+subsequently uploaded to the GPU on the main thread, where the amount of
+data transferred per frame of the main loop is limited by a configurable
+byte budget. Once an image is available, an optional callback is invoked
+on the main thread.
+
+Uploads are scheduled using nanogui::async(), hence the main loop
+(nanogui::mainloop()) must be running. Applications that manage their
+own event loop can instead call process() once per frame.)doc";
+
+static const char *__doc_nanogui_TextureLoader_TextureLoader =
+R"doc(Create a texture loader
+
+Parameter ``thread_count``:
+    Number of decoding threads (0: choose automatically)
+
+Parameter ``upload_budget``:
+    Maximum number of bytes that will be uploaded to the GPU per frame.
+    At least one image is uploaded per frame, even if it exceeds the
+    budget.)doc";
+
+static const char *__doc_nanogui_TextureLoader_enqueue =
+R"doc(Enqueue a request for decoding)doc";
+
+static const char *__doc_nanogui_TextureLoader_load =
+R"doc(Asynchronously load a texture from an image file
+
+Returns a 1x1 transparent RGBA placeholder texture immediately. Once
+the image has been decoded and uploaded, the same texture object is
+resized to the image dimensions and holds the image contents. Images
+are always converted to 8 bit RGBA.)doc";
+
+static const char *__doc_nanogui_TextureLoader_load_image =
+R"doc(Asynchronously load a NanoVG image from an image file
+
+The image handle is passed to ``callback`` once it has been created
+(using ``nvgCreateImageRGBA`` with the given ``image_flags``).)doc";
+
+static const char *__doc_nanogui_TextureLoader_pending =
+R"doc(Return the number of images that are either being decoded or awaiting
+upload)doc";
+
+static const char *__doc_nanogui_TextureLoader_process =
+R"doc(Upload decoded images to the GPU (within the per-frame budget) and
+invoke their callbacks
+
+Must be called on the main thread. Returns ``True`` if further decoded
+images are waiting to be uploaded.)doc";
+
+static const char *__doc_nanogui_TextureLoader_run = R"doc(Body of the decoding threads)doc";
+
+static const char *__doc_nanogui_TextureLoader_schedule =
+R"doc(Ensure that process() runs during the next main loop iteration)doc";
+
+static const char *__doc_nanogui_TextureLoader_set_upload_budget =
+R"doc(Set the maximum number of bytes uploaded to the GPU per frame)doc";
+
+static const char *__doc_nanogui_TextureLoader_upload_budget =
+R"doc(Return the maximum number of bytes uploaded to the GPU per frame)doc";
+
+static const char *__doc_nanogui_TexturePool =
+R"doc(Pool of render target textures that are recycled instead of being
+reallocated whenever a render pass changes its size
+
+Textures are grouped by pixel format, component format, sample count,
+flags, and *size class*: requested sizes are rounded up to one of four
+steps per power of two (see size_class()), so that a texture can serve
+a range of slightly different sizes. Users of a pooled texture render
+into its upper left ``size`` pixels (e.g. by means of
+RenderPass::resize(), which takes care of this automatically when a
+pool is attached via RenderPass::set_texture_pool()).
+
+Released textures are kept for later reuse until the total size of
+idle textures exceeds max_pooled_bytes(), at which point the least
+recently released textures are freed.
+
+Each Screen owns a pool (Screen::texture_pool()), since textures cannot
+be shared between the rendering contexts of different windows.)doc";
+
+static const char *__doc_nanogui_TexturePool_Entry = R"doc()doc";
+
+static const char *__doc_nanogui_TexturePool_Key = R"doc()doc";
+
+static const char *__doc_nanogui_TexturePool_TexturePool =
+R"doc(Create an empty texture pool)doc";
+
+static const char *__doc_nanogui_TexturePool_acquire =
+R"doc(Acquire a texture of the given format that has at least the specified
+size
+
+The returned texture either comes from the pool or is newly allocated,
+and its size equals ``size_class(size)``. Pass it to release() once
+it is no longer needed.)doc";
+
+static const char *__doc_nanogui_TexturePool_active_bytes =
+R"doc(Return the total size of the textures that were acquired but not
+released)doc";
+
+static const char *__doc_nanogui_TexturePool_active_count =
+R"doc(Return the number of textures that were acquired but not released)doc";
+
+static const char *__doc_nanogui_TexturePool_clear = R"doc(Free all idle textures)doc";
+
+static const char *__doc_nanogui_TexturePool_fits =
+R"doc(Can an acquired texture continue to be used for a new size?
+
+Returns ``True`` if the texture is large enough, and if it is not
+excessively large (i.e. if it has at most twice the area of the size
+class of ``size``). The latter implements a hysteresis that prevents
+reallocation during interactive resizing, while still returning memory
+when a target shrinks considerably.)doc";
+
+static const char *__doc_nanogui_TexturePool_max_pooled_bytes =
+R"doc(Return the maximum total size of the idle textures held by the pool)doc";
+
+static const char *__doc_nanogui_TexturePool_pooled_bytes =
+R"doc(Return the total size of the idle textures held by the pool)doc";
+
+static const char *__doc_nanogui_TexturePool_pooled_count =
+R"doc(Return the number of idle textures held by the pool)doc";
+
+static const char *__doc_nanogui_TexturePool_release =
+R"doc(Return a texture obtained from acquire() to the pool
+
+Textures that were not obtained from this pool are ignored.)doc";
+
+static const char *__doc_nanogui_TexturePool_set_max_pooled_bytes =
+R"doc(Set the maximum total size of the idle textures held by the pool)doc";
+
+static const char *__doc_nanogui_TexturePool_size_class =
+R"doc(Round a size up to the next size class)doc";
+
+static const char *__doc_nanogui_TexturePool_texture_bytes =
+R"doc(Return the number of bytes consumed by a texture (including all
+samples))doc";
+
+static const char *__doc_nanogui_TexturePool_trim =
+R"doc(Free idle textures until the budget is satisfied)doc";
+
+static const char *__doc_nanogui_Texture_AsyncState =
+R"doc(Staging buffers and fences of asynchronous transfers (backend-
+specific))doc";
+
 static const char *__doc_nanogui_Texture_ComponentFormat = R"doc(Number format of pixel components)doc";
 
 static const char *__doc_nanogui_Texture_ComponentFormat_Float16 = R"doc()doc";
@@ -2672,6 +4143,14 @@ static const char *__doc_nanogui_Texture_WrapMode_MirrorRepeat = R"doc(Repeat, b
 
 static const char *__doc_nanogui_Texture_WrapMode_Repeat = R"doc(Repeat the texture)doc";
 
+static const char *__doc_nanogui_Texture_auto_mipmaps =
+R"doc(Are mipmaps generated automatically?
+
+When enabled (the default), upload() immediately regenerates the mip
+levels of trilinearly filtered textures, and upload_sub_region() defers
+regeneration until the texture is used. When disabled, mipmaps are only
+updated via upload_level() and generate_mipmaps().)doc";
+
 static const char *__doc_nanogui_Texture_bytes_per_pixel = R"doc(Return the number of bytes consumed per pixel of this texture)doc";
 
 static const char *__doc_nanogui_Texture_channels = R"doc(Return the number of channels of this texture)doc";
@@ -2680,8 +4159,25 @@ static const char *__doc_nanogui_Texture_component_format = R"doc(Return the com
 
 static const char *__doc_nanogui_Texture_download = R"doc(Download packed pixel data from the GPU to the CPU)doc";
 
+static const char *__doc_nanogui_Texture_download_async =
+R"doc(Download packed pixel data from the GPU to the CPU without stalling
+the pipeline
+
+Enqueues a copy into a staging buffer and returns immediately. Once the
+GPU has completed the copy, poll_downloads() invokes ``callback`` with
+the pixel data, which has the same layout as the output of download()
+(render targets are flipped vertically while the data is copied out of
+the staging buffer). Its size is that of the texture when
+download_async() was called, even if the texture was resized in the
+meantime. The pointer is only valid for the duration of the callback.)doc";
+
 static const char *__doc_nanogui_Texture_flags = R"doc(Return a combination of flags (from Texture::TextureFlags))doc";
 
+static const char *__doc_nanogui_Texture_generate_mipmaps =
+R"doc(Regenerate mip levels ``1..n`` from level 0
+
+Only has an effect when trilinear interpolation is used.)doc";
+
 static const char *__doc_nanogui_Texture_init = R"doc(Initialize the texture handle)doc";
 
 static const char *__doc_nanogui_Texture_m_component_format = R"doc()doc";
@@ -2708,24 +4204,92 @@ static const char *__doc_nanogui_Texture_mag_interpolation_mode = R"doc(Return t
 
 static const char *__doc_nanogui_Texture_min_interpolation_mode = R"doc(Return the interpolation mode for minimization)doc";
 
+static const char *__doc_nanogui_Texture_mip_levels =
+R"doc(Return the number of levels of a full mipmap chain for this texture)doc";
+
+static const char *__doc_nanogui_Texture_mipmaps_dirty =
+R"doc(Are the mip levels out of date with respect to level 0?)doc";
+
 static const char *__doc_nanogui_Texture_pixel_format = R"doc(Return the pixel format)doc";
 
+static const char *__doc_nanogui_Texture_poll_downloads =
+R"doc(Deliver the results of completed asynchronous downloads
+
+Should be invoked regularly (e.g. once per frame) on the thread that
+owns the rendering context. When ``wait`` is ``True``, the function
+blocks until all pending downloads have completed. Returns the number
+of downloads that are still in flight.)doc";
+
 static const char *__doc_nanogui_Texture_resize = R"doc(Resize the texture (discards the current contents))doc";
 
 static const char *__doc_nanogui_Texture_sampler_state_handle = R"doc()doc";
 
 static const char *__doc_nanogui_Texture_samples = R"doc(Return the number of samples (MSAA))doc";
 
+static const char *__doc_nanogui_Texture_set_auto_mipmaps =
+R"doc(Specify whether mipmaps are generated automatically)doc";
+
 static const char *__doc_nanogui_Texture_size = R"doc(Return the size of this texture)doc";
 
 static const char *__doc_nanogui_Texture_texture_handle = R"doc()doc";
 
 static const char *__doc_nanogui_Texture_upload = R"doc(Upload packed pixel data from the CPU to the GPU)doc";
 
+static const char *__doc_nanogui_Texture_upload_async =
+R"doc(Upload packed pixel data from the CPU to the GPU without waiting for
+the transfer to complete
+
+The data is copied into a staging buffer (a pixel buffer object on
+OpenGL and GLES 3, a shared buffer on Metal) from which the GPU
+subsequently fills the texture. The memory referenced by ``data`` may
+be reused as soon as this function returns. Staging buffers are
+recycled once a fence indicates that the GPU no longer reads from them.
+
+Falls back to upload() on GLES 2.)doc";
+
+static const char *__doc_nanogui_Texture_upload_level =
+R"doc(Upload packed pixel data into a specific mip level
+
+This makes it possible to supply mipmaps that were computed on the CPU.
+The level has size ``max(1, size() >> level)``. Uploading a level
+does not trigger automatic mipmap generation.)doc";
+
+static const char *__doc_nanogui_Texture_upload_sub_region =
+R"doc(Upload pixel data into a rectangular region of the texture
+
+Unlike upload(), this function does not re-specify the texture storage,
+hence only the region's pixels are transferred.
+
+Parameter ``offset``:
+    Position of the upper left corner of the region (in pixels)
+
+Parameter ``size``:
+    Size of the region (in pixels)
+
+Parameter ``data``:
+    Pointer to the first pixel of the region
+
+Parameter ``row_stride``:
+    Distance between successive rows of ``data`` in bytes. The default
+    (``0``) indicates tightly packed rows. This makes it possible to
+    upload a region directly from a larger image in CPU memory.
+
+Parameter ``level``:
+    Mip level that should be updated
+
+When the region is part of level 0 and mipmaps are generated
+automatically (see auto_mipmaps()), the remaining levels are merely
+flagged as stale. They are regenerated once (no matter how many regions
+were updated) when the texture is next passed to Shader::set_texture(),
+or when generate_mipmaps() is called.)doc";
+
 static const char *__doc_nanogui_Texture_wrap_mode = R"doc(Return the wrap mode)doc";
 
 static const char *__doc_nanogui_Theme = R"doc(Storage class for basic theme-related properties.)doc";
 
+static const char *__doc_nanogui_Theme_PrewarmState =
+R"doc(Configuration used by the last call to prewarm_glyphs())doc";
+
 static const char *__doc_nanogui_Theme_Theme = R"doc()doc";
 
 static const char *__doc_nanogui_Theme_m_border_dark =
@@ -2829,6 +4393,17 @@ static const char *__doc_nanogui_Theme_m_popup_chevron_right_icon =
 R"doc(Icon to use for Popup_button widgets opening to the right (default:
 ``FA_CHEVRON_RIGHT``).)doc";
 
+static const char *__doc_nanogui_Theme_m_prewarm_characters =
+R"doc(Characters rasterized by prewarm_glyphs() (default: printable ASCII;
+set to ``""`` to disable).)doc";
+
+static const char *__doc_nanogui_Theme_m_prewarm_icons =
+R"doc(Icons rasterized by prewarm_glyphs() (default: all icons referenced by
+this theme).)doc";
+
+static const char *__doc_nanogui_Theme_m_prewarm_state =
+R"doc(Configuration used by the last call to prewarm_glyphs())doc";
+
 static const char *__doc_nanogui_Theme_m_standard_font_size =
 R"doc(The font size for all widgets other than buttons and textboxes
 (default: `` 16``).)doc";
@@ -2925,6 +4500,82 @@ static const char *__doc_nanogui_Theme_m_window_title_unfocused =
 R"doc(The title color for a Window that is not in focus (default:
 intensity=``220``, alpha=``160``; see nanogui::Color::Color(int,int)).)doc";
 
+static const char *__doc_nanogui_Theme_prewarm_glyphs =
+R"doc(Rasterize commonly used glyphs into the NanoVG font atlas
+
+NanoVG rasterizes glyphs lazily, which causes a visible hitch in the
+first frame that uses a new font size or pixel ratio. This function
+renders m_prewarm_characters (using the sans, bold, and monospace
+faces) and m_prewarm_icons (using the icon face) at the standard,
+button, and text box font sizes into an offscreen frame that is
+subsequently discarded. Each face/size combination is submitted as a
+single string so that the atlas is updated in a handful of uploads.
+
+The function returns immediately when the font sizes, icon scale,
+pixel ratio, and glyph sets are unchanged since the previous call,
+hence it is cheap to invoke once per frame. It must not be called
+between ``nvgBeginFrame()`` and ``nvgEndFrame()``.
+
+Parameter ``ctx``:
+    The NanoVG context associated with this theme
+
+Parameter ``pixel_ratio``:
+    Ratio between pixel and device coordinates of the target screen
+
+Parameter ``force``:
+    Rasterize the glyphs even if nothing changed since the last call)doc";
+
+static const char *__doc_nanogui_TiledImageSource =
+R"doc(Interface for very large images that are loaded tile by tile
+
+Implementations provide the tiles of a pyramid of LOD levels, where level
+``k`` is downsampled by a factor of ``2^k`` along both axes (rounding
+up), and each level is partitioned into square tiles of tile_size()
+pixels. Tiles along the right and bottom boundary may be smaller.
+
+load_tile() is invoked on background threads, and potentially on
+several of them at the same time.)doc";
+
+static const char *__doc_nanogui_TiledImageSource_component_format =
+R"doc(Return the component format of the tiles (default: 8 bit unsigned
+integer))doc";
+
+static const char *__doc_nanogui_TiledImageSource_level_count =
+R"doc(Return the number of LOD levels
+
+The default implementation adds levels until the coarsest one fits
+into a single tile.)doc";
+
+static const char *__doc_nanogui_TiledImageSource_level_size =
+R"doc(Return the size of the given LOD level)doc";
+
+static const char *__doc_nanogui_TiledImageSource_load_tile =
+R"doc(Decode a tile into tightly packed pixel storage
+
+Parameter ``level``:
+    The LOD level
+
+Parameter ``tile``:
+    The tile index within the level
+
+Parameter ``size``:
+    The size of the tile in pixels
+
+Parameter ``data``:
+    Output buffer that can hold ``size.x() * size.y()`` pixels
+
+Returns:
+    ``false`` if the tile could not be loaded)doc";
+
+static const char *__doc_nanogui_TiledImageSource_pixel_format =
+R"doc(Return the pixel format of the tiles (default: RGBA))doc";
+
+static const char *__doc_nanogui_TiledImageSource_size =
+R"doc(Return the size of the full-resolution image (level 0))doc";
+
+static const char *__doc_nanogui_TiledImageSource_tile_size =
+R"doc(Return the size of a tile in pixels (default: 256))doc";
+
 static const char *__doc_nanogui_ToolButton = R"doc(Simple radio+toggle button with an icon.)doc";
 
 static const char *__doc_nanogui_ToolButton_ToolButton = R"doc()doc";
@@ -2961,6 +4612,82 @@ static const char *__doc_nanogui_VScrollPanel_set_scroll =
 R"doc(Set the scroll amount to a value between 0 and 1. 0 means scrolled to
 the top and 1 to the bottom.)doc";
 
+static const char *__doc_nanogui_VertexBuffer =
+R"doc(GPU buffer storing several vertex attributes in an interleaved layout
+
+Each vertex occupies stride() bytes, and each attribute is located at
+a fixed byte offset within a vertex. Compared to uploading every
+attribute separately via Shader::set_buffer(), this improves the
+locality of vertex fetches, and a single copy of a mesh can be bound
+to any number of shaders using Shader::set_vertex_buffer().
+
+Attributes may use a narrower storage type than the shader declares,
+e.g. ``Float16`` positions or normalized ``UInt8`` colors feeding
+floating point shader inputs.)doc";
+
+static const char *__doc_nanogui_VertexBuffer_Attribute =
+R"doc(Description of an attribute within the interleaved layout)doc";
+
+static const char *__doc_nanogui_VertexBuffer_Attribute_components =
+R"doc(Number of components (1-4))doc";
+
+static const char *__doc_nanogui_VertexBuffer_Attribute_dtype =
+R"doc(Storage type of the components)doc";
+
+static const char *__doc_nanogui_VertexBuffer_Attribute_name =
+R"doc(Name of the shader input fed by this attribute)doc";
+
+static const char *__doc_nanogui_VertexBuffer_Attribute_normalized =
+R"doc(Map integer components to [0, 1] (unsigned) or [-1, 1] (signed)?)doc";
+
+static const char *__doc_nanogui_VertexBuffer_Attribute_offset =
+R"doc(Byte offset within a vertex, or -1 to place it after the previous
+attribute)doc";
+
+static const char *__doc_nanogui_VertexBuffer_VertexBuffer =
+R"doc(Create an empty vertex buffer with the given layout
+
+Parameter ``attributes``:
+    Description of the attributes. Attributes without an explicit
+    offset are placed right after the preceding one, aligned to four
+    bytes.
+
+Parameter ``stride``:
+    Distance between consecutive vertices in bytes. When zero, the end
+    of the last attribute is used (aligned to four bytes).)doc";
+
+static const char *__doc_nanogui_VertexBuffer_attribute =
+R"doc(Return the attribute with the given name, or ``nullptr``)doc";
+
+static const char *__doc_nanogui_VertexBuffer_attributes =
+R"doc(Return the attributes of the layout (with resolved offsets))doc";
+
+static const char *__doc_nanogui_VertexBuffer_buffer_handle = R"doc()doc";
+
+static const char *__doc_nanogui_VertexBuffer_set_data =
+R"doc(Upload the contents of the buffer
+
+Parameter ``data``:
+    Pointer to ``vertex_count`` vertices, each of which occupies
+    stride() bytes
+
+GPU storage is only reallocated when the number of vertices changes.)doc";
+
+static const char *__doc_nanogui_VertexBuffer_set_data_range =
+R"doc(Update a contiguous range of vertices, leaving the remainder unchanged)doc";
+
+static const char *__doc_nanogui_VertexBuffer_stride =
+R"doc(Return the distance between consecutive vertices in bytes)doc";
+
+static const char *__doc_nanogui_VertexBuffer_upload =
+R"doc(Backend-specific part of set_data())doc";
+
+static const char *__doc_nanogui_VertexBuffer_upload_range =
+R"doc(Backend-specific part of set_data_range())doc";
+
+static const char *__doc_nanogui_VertexBuffer_vertex_count =
+R"doc(Return the number of vertices)doc";
+
 static const char *__doc_nanogui_Widget =
 R"doc(Base class of all widgets.
 
@@ -3277,7 +5004,9 @@ R"doc(Enqueue a function to be executed executed before the application is
 redrawn the next time.
 
 NanoGUI is not thread-safe, and async() provides a mechanism for
-queuing up UI-related state changes from other threads.)doc";
+queuing up UI-related state changes from other threads. The main loop
+is woken up to run the function. Values that change frequently can
+instead be handed over without locking via Published.)doc";
 
 static const char *__doc_nanogui_chdir_to_bundle_parent =
 R"doc(Move to the application bundle's parent directory
@@ -3361,14 +5090,29 @@ static const char *__doc_nanogui_load_image_directory =
 R"doc(Load a directory of PNG images and upload them to the GPU (suitable
 for use with ImagePanel))doc";
 
+static const char *__doc_nanogui_load_image_directory_async =
+R"doc(Asynchronous variant of load_image_directory()
+
+The PNG images are decoded by the worker threads of ``loader`` and
+uploaded to the GPU within its per-frame budget. ``callback`` is
+invoked on the main thread once per image with the NanoVG image handle
+(0 if the image could not be loaded) and the file name without
+extension. Returns the number of images that were enqueued.)doc";
+
 static const char *__doc_nanogui_mainloop =
 R"doc(Enter the application main loop
 
+The main loop only draws screens that requested a redraw, e.g. in
+response to keyboard/mouse/.. events, via Screen::redraw(), or because
+a periodic frame is due (see Screen::set_target_frame_rate()). Between
+iterations, it sleeps until the next event arrives or the next
+periodic frame of any screen is due.
+
 Parameter ``refresh``:
-    NanoGUI issues a redraw call whenever an keyboard/mouse/.. event
-    is received. In the absence of any external events, it enforces a
-    redraw once every ``refresh`` milliseconds. To disable the refresh
-    timer, specify a negative value here.
+    In the absence of any external events, the main loop redraws
+    screens without a target frame rate once every ``refresh``
+    milliseconds. To disable the refresh timer, specify a negative
+    value here.
 
 Parameter ``detach``:
     This parameter only exists in the Python bindings. When the active
@@ -3430,6 +5174,27 @@ that case'))doc";
 
 static const char *__doc_nanogui_nanogui_get_image = R"doc(Helper function used by nvg_image_icon)doc";
 
+static const char *__doc_nanogui_null_new_handle =
+R"doc(Return a process-wide unique identifier for a texture, shader, or
+framebuffer)doc";
+
+static const char *__doc_nanogui_null_nvg_create =
+R"doc(Create a NanoVG context that records draw calls into \\ref
+null_stats())doc";
+
+static const char *__doc_nanogui_null_nvg_delete =
+R"doc(Destroy a NanoVG context created by \\ref null_nvg_create())doc";
+
+static const char *__doc_nanogui_null_nvg_image_from_handle =
+R"doc(Wrap the texture with the given handle into a NanoVG image)doc";
+
+static const char *__doc_nanogui_null_reset_counters =
+R"doc(Reset the cumulative counters, keeping those of live resources)doc";
+
+static const char *__doc_nanogui_null_stats =
+R"doc(Return the counters of the null backend (only accessed by the
+rendering thread))doc";
+
 static const char *__doc_nanogui_nvg_is_font_icon =
 R"doc(Determine whether an icon ID is a font-based icon (e.g. from
 ``entypo.ttf``).
@@ -3521,6 +5286,36 @@ static const char *__doc_nanogui_ref_ref_4 = R"doc(Move constructor)doc";
 
 static const char *__doc_nanogui_shutdown = R"doc(Static shutdown; should be called before the application terminates.)doc";
 
+static const char *__doc_nanogui_sw_nvg_clear =
+R"doc(Fill the framebuffer with a color (takes effect with the next flush of
+the frame))doc";
+
+static const char *__doc_nanogui_sw_nvg_create =
+R"doc(Create a NanoVG context that renders on the CPU
+
+Parameter ``thread_count``:
+    Number of threads rasterizing a frame, including the calling
+    thread. The default value of 0 uses one thread per hardware thread.)doc";
+
+static const char *__doc_nanogui_sw_nvg_delete =
+R"doc(Destroy a NanoVG context created by sw_nvg_create())doc";
+
+static const char *__doc_nanogui_sw_nvg_framebuffer =
+R"doc(Return the framebuffer of a software context
+
+The framebuffer stores premultiplied RGBA8 pixels in row-major order,
+starting with the top row. Its size (in pixels) is written to ``size``
+and follows the viewport and pixel ratio passed to ``nvgBeginFrame()``.)doc";
+
+static const char *__doc_nanogui_sw_nvg_is_software =
+R"doc(Was the given NanoVG context created by sw_nvg_create()?)doc";
+
+static const char *__doc_nanogui_sw_nvg_read_pixels =
+R"doc(Copy the framebuffer into ``data`` as non-premultiplied RGBA8 pixels)doc";
+
+static const char *__doc_nanogui_sw_nvg_save_png =
+R"doc(Write the framebuffer to an (uncompressed) RGBA PNG file)doc";
+
 static const char *__doc_nanogui_utf8 =
 R"doc(Convert a single UTF32 character code to UTF8.
 
@@ -41,7 +41,9 @@ static VariableType dtype_to_enoki(const py::dtype &dtype) {
     return VariableType::Invalid;
 }
 
-static void shader_set_buffer(Shader &shader, const std::string &name, py::array array) {
+/// Shader parameters are identified by name or by a handle from Shader::binding()
+template <typename Key>
+static void shader_set_buffer(Shader &shader, const Key &key, py::array array) {
     if (array.ndim() > 3)
         throw py::type_error("Shader::set_buffer(): tensor rank must be < 3!");
     array = py::array::ensure(array, py::array::c_style);
@@ -57,10 +59,57 @@ static void shader_set_buffer(Shader &shader, const std::string &name, py::array
         array.ndim() > 2 ? (size_t) array.shape(2) : 1
     };
 
-    shader.set_buffer(name, dtype, array.ndim(), dim, array.data());
+    shader.set_buffer(key, dtype, array.ndim(), dim, array.data());
 }
 
-static py::array texture_download(Texture &texture) {
+template <typename Key>
+static void shader_set_buffer_range(Shader &shader, const Key &key,
+                                    size_t offset, py::array array) {
+    array = py::array::ensure(array, py::array::c_style);
+    size_t count = array.ndim() > 0 ? (size_t) array.shape(0) : 1;
+    shader.set_buffer_range(key, offset, count, array.data());
+}
+
+template <typename Key>
+static void command_buffer_set_buffer(CommandBuffer &cb, Shader *shader,
+                                      const Key &key, py::array array) {
+    if (array.ndim() > 3)
+        throw py::type_error("CommandBuffer::set_buffer(): tensor rank must be < 3!");
+    array = py::array::ensure(array, py::array::c_style);
+
+    VariableType dtype = dtype_to_enoki(array.dtype());
+
+    if (dtype == VariableType::Invalid)
+        throw py::type_error("CommandBuffer::set_buffer(): unsupported array dtype!");
+
+    size_t dim[3] {
+        array.ndim() > 0 ? (size_t) array.shape(0) : 1,
+        array.ndim() > 1 ? (size_t) array.shape(1) : 1,
+        array.ndim() > 2 ? (size_t) array.shape(2) : 1
+    };
+
+    cb.set_buffer(shader, key, dtype, array.ndim(), dim, array.data());
+}
+
+static void vertex_buffer_set_data(VertexBuffer &vb, py::array array) {
+    array = py::array::ensure(array, py::array::c_style);
+    size_t size = (size_t) array.nbytes();
+    if (size % vb.stride() != 0)
+        throw py::value_error("VertexBuffer::set_data(): array size is not a "
+                              "multiple of the vertex stride!");
+    vb.set_data(array.data(), size / vb.stride());
+}
+
+static void vertex_buffer_set_data_range(VertexBuffer &vb, size_t offset, py::array array) {
+    array = py::array::ensure(array, py::array::c_style);
+    size_t size = (size_t) array.nbytes();
+    if (size % vb.stride() != 0)
+        throw py::value_error("VertexBuffer::set_data_range(): array size is not "
+                              "a multiple of the vertex stride!");
+    vb.set_data_range(offset, size / vb.stride(), array.data());
+}
+
+static py::array texture_array(const Texture &texture) {
     const char *dtype_name;
     switch (texture.component_format()) {
         case Texture::ComponentFormat::UInt8:   dtype_name = "u1"; break;
@@ -73,18 +122,57 @@ static py::array texture_download(Texture &texture) {
         case Texture::ComponentFormat::Float32: dtype_name = "f4"; break;
     }
 
-    py::array result(
+    return py::array(
         py::dtype(dtype_name),
         std::vector<ssize_t> { texture.size().y(), texture.size().x(),
                                (ssize_t) texture.channels() },
         std::vector<ssize_t> { }
     );
+}
 
+static py::array texture_download(Texture &texture) {
+    py::array result = texture_array(texture);
     texture.download((uint8_t *) result.mutable_data());
     return result;
 }
 
-static void texture_upload(Texture &texture, py::array array) {
+static void texture_upload_sub_region(Texture &texture, const Vector2i &offset,
+                                      py::array array, uint32_t level) {
+    size_t n_channels = array.ndim() == 3 ? array.shape(2) : 1;
+    VariableType dtype         = dtype_to_enoki(array.dtype()),
+                 dtype_texture = (VariableType) texture.component_format();
+
+    if (array.ndim() != 2 && array.ndim() != 3)
+        throw std::runtime_error("Texture::upload_sub_region(): expected a 2 or 3-dimensional array!");
+    else if (n_channels != texture.channels())
+        throw std::runtime_error("Texture::upload_sub_region(): number of color "
+                                 "channels in array does not match the texture!");
+    else if (dtype != dtype_texture)
+        throw std::runtime_error("Texture::upload_sub_region(): dtype of array "
+                                 "does not match the texture!");
+    else if (array.strides(1) != (ssize_t) texture.bytes_per_pixel() ||
+             (array.ndim() == 3 && array.strides(2) != (ssize_t) array.itemsize()) ||
+             array.strides(0) <= 0)
+        throw std::runtime_error("Texture::upload_sub_region(): pixels within a "
+                                 "row must be contiguous!");
+
+    texture.upload_sub_region(offset, Vector2i((int) array.shape(1), (int) array.shape(0)),
+                              (const uint8_t *) array.data(), (size_t) array.strides(0),
+                              level);
+}
+
+static void texture_download_async(Texture &texture,
+                                   const std::function<void(py::array)> &callback) {
+    ref<Texture> self = &texture;
+    texture.download_async([self, callback](const uint8_t *data) {
+        py::gil_scoped_acquire guard;
+        py::array result = texture_array(*self);
+        memcpy(result.mutable_data(), data, result.nbytes());
+        callback(result);
+    });
+}
+
+static void texture_upload(Texture &texture, py::array array, bool async) {
     size_t n_channels = array.ndim() == 3 ? array.shape(2) : 1;
     VariableType dtype         = dtype_to_enoki(array.dtype()),
                  dtype_texture = (VariableType) texture.component_format();
@@ -105,7 +193,10 @@ static void texture_upload(Texture &texture, py::array array) {
             type_name(dtype) + ") does not match the texture (" +
             type_name(dtype_texture) + ")!");
 
-    texture.upload((const uint8_t *) array.data());
+    if (async)
+        texture.upload_async((const uint8_t *) array.data());
+    else
+        texture.upload((const uint8_t *) array.data());
 }
 
 void register_render(py::module &m) {
@@ -116,6 +207,7 @@ void register_render(py::module &m) {
     using TextureFlags      = Texture::TextureFlags;
     using PrimitiveType     = Shader::PrimitiveType;
     using BlendMode         = Shader::BlendMode;
+    using BufferUsage       = Shader::BufferUsage;
     using DepthTest         = RenderPass::DepthTest;
     using CullMode          = RenderPass::CullMode;
 
@@ -179,7 +271,28 @@ void register_render(py::module &m) {
         .def("bytes_per_pixel", &Texture::bytes_per_pixel, D(Texture, bytes_per_pixel))
         .def("channels", &Texture::channels, D(Texture, channels))
         .def("download", &texture_download, D(Texture, download))
-        .def("upload", &texture_upload, D(Texture, upload))
+        .def("upload", [](Texture &texture, py::array array) {
+                 texture_upload(texture, array, false);
+             }, D(Texture, upload))
+        .def("upload_async", [](Texture &texture, py::array array) {
+                 texture_upload(texture, array, true);
+             }, D(Texture, upload_async))
+        .def("upload_sub_region", &texture_upload_sub_region, D(Texture, upload_sub_region),
+             "offset"_a, "array"_a, "level"_a = 0)
+        .def("upload_level", [](Texture &texture, uint32_t level, py::array array) {
+                 if (!(array.flags() & py::array::c_style))
+                     throw std::runtime_error("Texture::upload_level(): expected a contiguous array!");
+                 texture.upload_level(level, (const uint8_t *) array.data());
+             }, D(Texture, upload_level), "level"_a, "array"_a)
+        .def("mip_levels", &Texture::mip_levels, D(Texture, mip_levels))
+        .def("generate_mipmaps", &Texture::generate_mipmaps, D(Texture, generate_mipmaps))
+        .def("mipmaps_dirty", &Texture::mipmaps_dirty, D(Texture, mipmaps_dirty))
+        .def("auto_mipmaps", &Texture::auto_mipmaps, D(Texture, auto_mipmaps))
+        .def("set_auto_mipmaps", &Texture::set_auto_mipmaps, D(Texture, set_auto_mipmaps))
+        .def("download_async", &texture_download_async, D(Texture, download_async),
+             "callback"_a)
+        .def("poll_downloads", &Texture::poll_downloads, D(Texture, poll_downloads),
+             "wait"_a = false)
         .def("resize", &Texture::resize, D(Texture, resize))
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
         .def("texture_handle", &Texture::texture_handle)
@@ -187,34 +300,245 @@ void register_render(py::module &m) {
 #elif defined(NANOGUI_USE_METAL)
         .def("texture_handle", &Texture::texture_handle)
         .def("sampler_state_handle", &Texture::sampler_state_handle)
+#elif defined(NANOGUI_USE_NULL)
+        .def("texture_handle", &Texture::texture_handle)
 #endif
         ;
 
+    py::class_<TexturePool, Object, ref<TexturePool>>(m, "TexturePool", D(TexturePool))
+        .def(py::init<size_t>(), D(TexturePool, TexturePool),
+             "max_pooled_bytes"_a = 256 * 1024 * 1024)
+        .def("acquire", &TexturePool::acquire, D(TexturePool, acquire),
+             "pixel_format"_a, "component_format"_a, "size"_a, "samples"_a = 1,
+             "flags"_a = (uint8_t) TextureFlags::RenderTarget)
+        .def("release", &TexturePool::release, D(TexturePool, release))
+        .def_static("fits", &TexturePool::fits, D(TexturePool, fits))
+        .def_static("size_class", &TexturePool::size_class, D(TexturePool, size_class))
+        .def("pooled_bytes", &TexturePool::pooled_bytes, D(TexturePool, pooled_bytes))
+        .def("active_bytes", &TexturePool::active_bytes, D(TexturePool, active_bytes))
+        .def("pooled_count", &TexturePool::pooled_count, D(TexturePool, pooled_count))
+        .def("active_count", &TexturePool::active_count, D(TexturePool, active_count))
+        .def("max_pooled_bytes", &TexturePool::max_pooled_bytes, D(TexturePool, max_pooled_bytes))
+        .def("set_max_pooled_bytes", &TexturePool::set_max_pooled_bytes, D(TexturePool, set_max_pooled_bytes))
+        .def("clear", &TexturePool::clear, D(TexturePool, clear));
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    py::class_<GLState>(m, "GLState", D(GLState))
+        .def_static("current", &GLState::current, D(GLState, current),
+                    py::return_value_policy::reference)
+        .def("invalidate", &GLState::invalidate, D(GLState, invalidate))
+        .def("reset", &GLState::reset, D(GLState, reset));
+#endif
+
+#if defined(NANOGUI_USE_NULL)
+    py::class_<NullStats>(m, "NullStats", D(NullStats))
+        .def_readonly("textures", &NullStats::textures, D(NullStats, textures))
+        .def_readonly("texture_bytes", &NullStats::texture_bytes, D(NullStats, texture_bytes))
+        .def_readonly("shaders", &NullStats::shaders, D(NullStats, shaders))
+        .def_readonly("render_passes", &NullStats::render_passes, D(NullStats, render_passes))
+        .def_readonly("buffer_bytes", &NullStats::buffer_bytes, D(NullStats, buffer_bytes))
+        .def_readonly("vertex_buffers", &NullStats::vertex_buffers, D(NullStats, vertex_buffers))
+        .def_readonly("vertex_buffer_bytes", &NullStats::vertex_buffer_bytes, D(NullStats, vertex_buffer_bytes))
+        .def_readonly("nvg_images", &NullStats::nvg_images, D(NullStats, nvg_images))
+        .def_readonly("nvg_image_bytes", &NullStats::nvg_image_bytes, D(NullStats, nvg_image_bytes))
+        .def_readonly("uploads", &NullStats::uploads, D(NullStats, uploads))
+        .def_readonly("upload_bytes", &NullStats::upload_bytes, D(NullStats, upload_bytes))
+        .def_readonly("downloads", &NullStats::downloads, D(NullStats, downloads))
+        .def_readonly("frames", &NullStats::frames, D(NullStats, frames))
+        .def_readonly("clears", &NullStats::clears, D(NullStats, clears))
+        .def_readonly("render_pass_begins", &NullStats::render_pass_begins, D(NullStats, render_pass_begins))
+        .def_readonly("shader_begins", &NullStats::shader_begins, D(NullStats, shader_begins))
+        .def_readonly("draw_calls", &NullStats::draw_calls, D(NullStats, draw_calls))
+        .def_readonly("instances", &NullStats::instances, D(NullStats, instances))
+        .def_readonly("elements", &NullStats::elements, D(NullStats, elements))
+        .def_readonly("nvg_fills", &NullStats::nvg_fills, D(NullStats, nvg_fills))
+        .def_readonly("nvg_strokes", &NullStats::nvg_strokes, D(NullStats, nvg_strokes))
+        .def_readonly("nvg_triangles", &NullStats::nvg_triangles, D(NullStats, nvg_triangles))
+        .def_readonly("nvg_paths", &NullStats::nvg_paths, D(NullStats, nvg_paths))
+        .def_readonly("nvg_vertices", &NullStats::nvg_vertices, D(NullStats, nvg_vertices))
+        .def_readonly("nvg_flushes", &NullStats::nvg_flushes, D(NullStats, nvg_flushes));
+
+    m.def("null_stats", &null_stats, D(null_stats), py::return_value_policy::reference);
+    m.def("null_reset_counters", &null_reset_counters, D(null_reset_counters));
+#endif
+
+    m.def("sw_nvg_is_software", &sw_nvg_is_software, D(sw_nvg_is_software));
+    m.def("sw_nvg_clear", &sw_nvg_clear, D(sw_nvg_clear));
+    m.def("sw_nvg_read_pixels", [](NVGcontext *ctx) {
+        Vector2i size;
+        sw_nvg_framebuffer(ctx, &size);
+        py::array_t<uint8_t> result({ (size_t) size.y(), (size_t) size.x(), (size_t) 4 });
+        sw_nvg_read_pixels(ctx, result.mutable_data());
+        return result;
+    }, D(sw_nvg_read_pixels));
+    m.def("sw_nvg_save_png", &sw_nvg_save_png, D(sw_nvg_save_png));
+
+    auto profiler = py::class_<FrameProfiler, Object, ref<FrameProfiler>>(m, "FrameProfiler", D(FrameProfiler))
+        .def(py::init<bool, uint32_t>(), D(FrameProfiler, FrameProfiler),
+             "gpu_timers"_a, "latency"_a = 3)
+        .def("gpu_timers", &FrameProfiler::gpu_timers, D(FrameProfiler, gpu_timers))
+        .def("latency", &FrameProfiler::latency, D(FrameProfiler, latency))
+        .def("begin_frame", &FrameProfiler::begin_frame, D(FrameProfiler, begin_frame))
+        .def("end_frame", &FrameProfiler::end_frame, D(FrameProfiler, end_frame))
+        .def("push", &FrameProfiler::push, D(FrameProfiler, push))
+        .def("pop", &FrameProfiler::pop, D(FrameProfiler, pop))
+        .def("stats", &FrameProfiler::stats, D(FrameProfiler, stats))
+        .def_static("current", &FrameProfiler::current, D(FrameProfiler, current),
+                    py::return_value_policy::reference);
+
+    py::class_<FrameProfiler::Timing>(profiler, "Timing", D(FrameProfiler, Timing))
+        .def_readonly("name", &FrameProfiler::Timing::name, D(FrameProfiler, Timing, name))
+        .def_readonly("cpu_time", &FrameProfiler::Timing::cpu_time, D(FrameProfiler, Timing, cpu_time))
+        .def_readonly("gpu_time", &FrameProfiler::Timing::gpu_time, D(FrameProfiler, Timing, gpu_time));
+
+    py::class_<FrameProfiler::Stats>(profiler, "Stats", D(FrameProfiler, Stats))
+        .def_readonly("frame", &FrameProfiler::Stats::frame, D(FrameProfiler, Stats, frame))
+        .def_readonly("cpu_time", &FrameProfiler::Stats::cpu_time, D(FrameProfiler, Stats, cpu_time))
+        .def_readonly("gpu_time", &FrameProfiler::Stats::gpu_time, D(FrameProfiler, Stats, gpu_time))
+        .def_readonly("timings", &FrameProfiler::Stats::timings, D(FrameProfiler, Stats, timings));
+
+    py::class_<RenderDevice, Object, ref<RenderDevice>>(m, "RenderDevice", D(RenderDevice))
+        .def_static("backends", &RenderDevice::backends, "opt_in"_a = false,
+                    D(RenderDevice, backends))
+        .def_static("create", &RenderDevice::create, D(RenderDevice, create))
+        .def("name", &RenderDevice::name, D(RenderDevice, name))
+        .def("supports_shaders", &RenderDevice::supports_shaders, D(RenderDevice, supports_shaders));
+
+    py::class_<StreamingTexture, Object, ref<StreamingTexture>>(m, "StreamingTexture", D(StreamingTexture))
+        .def(py::init<PixelFormat, ComponentFormat, const Vector2i &, size_t,
+                      InterpolationMode, InterpolationMode>(),
+             D(StreamingTexture, StreamingTexture), "pixel_format"_a,
+             "component_format"_a, "size"_a, "buffer_count"_a = 3,
+             "min_interpolation_mode"_a = InterpolationMode::Bilinear,
+             "mag_interpolation_mode"_a = InterpolationMode::Nearest)
+        .def("size", &StreamingTexture::size, D(StreamingTexture, size))
+        .def("buffer_count", &StreamingTexture::buffer_count, D(StreamingTexture, buffer_count))
+        .def("frame_bytes", &StreamingTexture::frame_bytes, D(StreamingTexture, frame_bytes))
+        .def("push", [](StreamingTexture &stream, py::array array) {
+                 if (!(array.flags() & py::array::c_style) ||
+                     (size_t) array.nbytes() != stream.frame_bytes())
+                     throw std::runtime_error("StreamingTexture::push(): expected a "
+                                              "contiguous array matching the frame size!");
+                 const uint8_t *data = (const uint8_t *) array.data();
+                 py::gil_scoped_release release;
+                 stream.push(data);
+             }, D(StreamingTexture, push), "array"_a)
+        .def("update", &StreamingTexture::update, D(StreamingTexture, update))
+        .def("texture", py::overload_cast<>(&StreamingTexture::texture), D(StreamingTexture, texture))
+        .def("frames_pushed", &StreamingTexture::frames_pushed, D(StreamingTexture, frames_pushed))
+        .def("frames_uploaded", &StreamingTexture::frames_uploaded, D(StreamingTexture, frames_uploaded))
+        .def("frames_skipped", &StreamingTexture::frames_skipped, D(StreamingTexture, frames_skipped));
+
+    py::class_<TextureLoader, Object, ref<TextureLoader>>(m, "TextureLoader", D(TextureLoader))
+        .def(py::init<size_t, size_t>(), D(TextureLoader, TextureLoader),
+             "thread_count"_a = 0, "upload_budget"_a = 32 * 1024 * 1024)
+        .def("load", &TextureLoader::load, D(TextureLoader, load), "filename"_a,
+             "min_interpolation_mode"_a = InterpolationMode::Bilinear,
+             "mag_interpolation_mode"_a = InterpolationMode::Bilinear,
+             "wrap_mode"_a = WrapMode::ClampToEdge,
+             "callback"_a = TextureLoader::TextureCallback())
+        .def("load_image", &TextureLoader::load_image, D(TextureLoader, load_image),
+             "ctx"_a, "filename"_a, "callback"_a, "image_flags"_a = 0)
+        .def("upload_budget", &TextureLoader::upload_budget, D(TextureLoader, upload_budget))
+        .def("set_upload_budget", &TextureLoader::set_upload_budget, D(TextureLoader, set_upload_budget))
+        .def("pending", &TextureLoader::pending, D(TextureLoader, pending))
+        .def("process", &TextureLoader::process, D(TextureLoader, process));
+
+    auto vertex_buffer = py::class_<VertexBuffer, Object, ref<VertexBuffer>>(
+        m, "VertexBuffer", D(VertexBuffer));
+
+    py::class_<VertexBuffer::Attribute>(vertex_buffer, "Attribute", D(VertexBuffer, Attribute))
+        .def(py::init([](const std::string &name, const py::dtype &dtype,
+                         size_t components, bool normalized, ssize_t offset) {
+                 VariableType vtype = dtype_to_enoki(dtype);
+                 if (vtype == VariableType::Invalid)
+                     throw py::type_error("VertexBuffer.Attribute(): unsupported dtype!");
+                 return VertexBuffer::Attribute{ name, vtype, components, normalized,
+                                                 (size_t) offset };
+             }), "name"_a, "dtype"_a, "components"_a, "normalized"_a = false,
+             "offset"_a = -1)
+        .def_readwrite("name", &VertexBuffer::Attribute::name, D(VertexBuffer, Attribute, name))
+        .def_property_readonly("dtype", [](const VertexBuffer::Attribute &a) {
+                 return std::string(type_name(a.dtype));
+             }, D(VertexBuffer, Attribute, dtype))
+        .def_readwrite("components", &VertexBuffer::Attribute::components,
+                       D(VertexBuffer, Attribute, components))
+        .def_readwrite("normalized", &VertexBuffer::Attribute::normalized,
+                       D(VertexBuffer, Attribute, normalized))
+        .def_readwrite("offset", &VertexBuffer::Attribute::offset,
+                       D(VertexBuffer, Attribute, offset));
+
+    vertex_buffer
+        .def(py::init<const std::vector<VertexBuffer::Attribute> &, size_t>(),
+             D(VertexBuffer, VertexBuffer), "attributes"_a, "stride"_a = 0)
+        .def("attributes", &VertexBuffer::attributes, D(VertexBuffer, attributes))
+        .def("stride", &VertexBuffer::stride, D(VertexBuffer, stride))
+        .def("vertex_count", &VertexBuffer::vertex_count, D(VertexBuffer, vertex_count))
+        .def("set_data", &vertex_buffer_set_data, D(VertexBuffer, set_data), "array"_a)
+        .def("set_data_range", &vertex_buffer_set_data_range,
+             D(VertexBuffer, set_data_range), "offset"_a, "array"_a)
+        .def("buffer_handle", &VertexBuffer::buffer_handle);
+
     auto shader = py::class_<Shader, Object, ref<Shader>>(m, "Shader", D(Shader));
 
     py::enum_<BlendMode>(shader, "BlendMode", D(Shader, BlendMode))
         .value("None", BlendMode::None, D(Shader, BlendMode, None))
         .value("AlphaBlend", BlendMode::AlphaBlend, D(Shader, BlendMode, AlphaBlend));
 
+    py::enum_<BufferUsage>(shader, "BufferUsage", D(Shader, BufferUsage))
+        .value("Static", BufferUsage::Static, D(Shader, BufferUsage, Static))
+        .value("Dynamic", BufferUsage::Dynamic, D(Shader, BufferUsage, Dynamic))
+        .value("Stream", BufferUsage::Stream, D(Shader, BufferUsage, Stream));
+
     shader
         .def(py::init<RenderPass *, const std::string &,
-                      const std::string &, const std::string &, Shader::BlendMode>(),
+                      const std::string &, const std::string &, Shader::BlendMode, bool>(),
              D(Shader, Shader), "render_pass"_a, "name"_a, "vertex_shader"_a,
-             "fragment_shader"_a, "blend_mode"_a = BlendMode::None)
+             "fragment_shader"_a, "blend_mode"_a = BlendMode::None,
+             "deferred"_a = false)
+        .def("ready", &Shader::ready, D(Shader, ready))
+        .def("wait", &Shader::wait, D(Shader, wait))
+        .def_static("set_program_cache_path", &Shader::set_program_cache_path,
+                    D(Shader, set_program_cache_path))
+        .def_static("program_cache_path", &Shader::program_cache_path,
+                    D(Shader, program_cache_path))
         .def("name", &Shader::name, D(Shader, name))
         .def("blend_mode", &Shader::blend_mode, D(Shader, blend_mode))
-        .def("set_buffer", &shader_set_buffer, D(Shader, set_buffer))
-        .def("set_texture", &Shader::set_texture, D(Shader, set_texture))
+        .def("binding", &Shader::binding, D(Shader, binding))
+        .def("set_buffer", &shader_set_buffer<std::string>, D(Shader, set_buffer))
+        .def("set_buffer", &shader_set_buffer<size_t>, D(Shader, set_buffer, 3))
+        .def("set_buffer_range", &shader_set_buffer_range<std::string>,
+             D(Shader, set_buffer_range), "name"_a, "offset"_a, "array"_a)
+        .def("set_buffer_range", &shader_set_buffer_range<size_t>,
+             D(Shader, set_buffer_range, 2), "binding"_a, "offset"_a, "array"_a)
+        .def("set_buffer_usage", py::overload_cast<const std::string &, BufferUsage>(&Shader::set_buffer_usage),
+             D(Shader, set_buffer_usage), "name"_a, "usage"_a)
+        .def("set_buffer_usage", py::overload_cast<size_t, BufferUsage>(&Shader::set_buffer_usage),
+             D(Shader, set_buffer_usage, 2), "binding"_a, "usage"_a)
+        .def("set_buffer_divisor", py::overload_cast<const std::string &, uint32_t>(&Shader::set_buffer_divisor),
+             D(Shader, set_buffer_divisor), "name"_a, "divisor"_a)
+        .def("set_buffer_divisor", py::overload_cast<size_t, uint32_t>(&Shader::set_buffer_divisor),
+             D(Shader, set_buffer_divisor, 2), "binding"_a, "divisor"_a)
+        .def("set_vertex_buffer", &Shader::set_vertex_buffer, D(Shader, set_vertex_buffer))
+        .def("set_texture", py::overload_cast<const std::string &, Texture *>(&Shader::set_texture),
+             D(Shader, set_texture))
+        .def("set_texture", py::overload_cast<size_t, Texture *>(&Shader::set_texture),
+             D(Shader, set_texture, 2))
         .def("begin", &Shader::begin, D(Shader, begin))
         .def("end", &Shader::end, D(Shader, end))
         .def("__enter__", &Shader::begin)
         .def("__exit__", [](Shader &s, py::handle, py::handle, py::handle) { s.end(); })
         .def("draw_array", &Shader::draw_array, D(Shader, draw_array),
              "primitive_type"_a, "offset"_a, "count"_a, "indexed"_a = false)
+        .def("draw_array_instanced", &Shader::draw_array_instanced,
+             D(Shader, draw_array_instanced), "primitive_type"_a, "offset"_a,
+             "count"_a, "instance_count"_a, "indexed"_a = false)
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
         .def("shader_handle", &Shader::shader_handle)
 #elif defined(NANOGUI_USE_METAL)
         .def("pipeline_state", &Shader::pipeline_state)
+#elif defined(NANOGUI_USE_NULL)
+        .def("shader_handle", &Shader::shader_handle)
 #endif
 #if defined(NANOGUI_USE_OPENGL)
         .def("vertex_array_handle", &Shader::vertex_array_handle)
@@ -232,6 +556,7 @@ void register_render(py::module &m) {
         .def(py::init<std::vector<Object *>, Object *, Object *, Object *, bool>(),
              D(RenderPass, RenderPass), "color_targets"_a, "depth_target"_a = nullptr,
              "stencil_target"_a = nullptr, "blit_target"_a = nullptr, "clear"_a = true)
+        .def("clear", &RenderPass::clear, D(RenderPass, clear))
         .def("set_clear_color", &RenderPass::set_clear_color, D(RenderPass, set_clear_color))
         .def("clear_color", &RenderPass::clear_color, D(RenderPass, clear_color))
         .def("set_clear_depth", &RenderPass::set_clear_depth, D(RenderPass, set_clear_depth))
@@ -247,6 +572,10 @@ void register_render(py::module &m) {
         .def("begin", &RenderPass::begin, D(RenderPass, begin))
         .def("end", &RenderPass::end, D(RenderPass, end))
         .def("resize", &RenderPass::resize, D(RenderPass, resize))
+        .def("label", &RenderPass::label, D(RenderPass, label))
+        .def("set_label", &RenderPass::set_label, D(RenderPass, set_label))
+        .def("texture_pool", &RenderPass::texture_pool, D(RenderPass, texture_pool))
+        .def("set_texture_pool", &RenderPass::set_texture_pool, D(RenderPass, set_texture_pool))
         .def("blit_to", &RenderPass::blit_to, D(RenderPass, blit_to),
              "src_offset"_a, "src_size"_a, "dst"_a, "dst_offset"_a)
         .def("__enter__", &RenderPass::begin)
@@ -272,6 +601,50 @@ void register_render(py::module &m) {
         .value("NotEqual", DepthTest::NotEqual, D(RenderPass, DepthTest, NotEqual))
         .value("GreaterEqual", DepthTest::GreaterEqual, D(RenderPass, DepthTest, GreaterEqual))
         .value("Always", DepthTest::Always, D(RenderPass, DepthTest, Always));
+
+    using CommandType = CommandBuffer::CommandType;
+
+    auto command_buffer = py::class_<CommandBuffer, Object, ref<CommandBuffer>>(
+        m, "CommandBuffer", D(CommandBuffer));
+
+    py::enum_<CommandType>(command_buffer, "CommandType", D(CommandBuffer, CommandType))
+        .value("BeginPass", CommandType::BeginPass, D(CommandBuffer, CommandType, BeginPass))
+        .value("EndPass", CommandType::EndPass, D(CommandBuffer, CommandType, EndPass))
+        .value("BeginShader", CommandType::BeginShader, D(CommandBuffer, CommandType, BeginShader))
+        .value("EndShader", CommandType::EndShader, D(CommandBuffer, CommandType, EndShader))
+        .value("SetBuffer", CommandType::SetBuffer, D(CommandBuffer, CommandType, SetBuffer))
+        .value("SetTexture", CommandType::SetTexture, D(CommandBuffer, CommandType, SetTexture))
+        .value("DrawArray", CommandType::DrawArray, D(CommandBuffer, CommandType, DrawArray));
+
+    command_buffer
+        .def(py::init<>(), D(CommandBuffer, CommandBuffer))
+        .def("begin_pass", &CommandBuffer::begin_pass, D(CommandBuffer, begin_pass))
+        .def("end_pass", &CommandBuffer::end_pass, D(CommandBuffer, end_pass))
+        .def("begin_shader", &CommandBuffer::begin_shader, D(CommandBuffer, begin_shader))
+        .def("end_shader", &CommandBuffer::end_shader, D(CommandBuffer, end_shader))
+        .def("set_buffer", &command_buffer_set_buffer<std::string>,
+             D(CommandBuffer, set_buffer), "shader"_a, "name"_a, "array"_a)
+        .def("set_buffer", &command_buffer_set_buffer<size_t>,
+             D(CommandBuffer, set_buffer, 2), "shader"_a, "binding"_a, "array"_a)
+        .def("set_texture", py::overload_cast<Shader *, const std::string &, Texture *>(
+                 &CommandBuffer::set_texture), D(CommandBuffer, set_texture))
+        .def("set_texture", py::overload_cast<Shader *, size_t, Texture *>(
+                 &CommandBuffer::set_texture), D(CommandBuffer, set_texture, 2))
+        .def("draw_array", &CommandBuffer::draw_array, D(CommandBuffer, draw_array),
+             "primitive_type"_a, "offset"_a, "count"_a, "indexed"_a = false)
+        .def("draw_array_instanced", &CommandBuffer::draw_array_instanced,
+             D(CommandBuffer, draw_array_instanced), "primitive_type"_a, "offset"_a,
+             "count"_a, "instance_count"_a, "indexed"_a = false)
+        .def("clear", &CommandBuffer::clear, D(CommandBuffer, clear))
+        .def("reserve", &CommandBuffer::reserve, D(CommandBuffer, reserve))
+        .def("command_count", &CommandBuffer::command_count, D(CommandBuffer, command_count))
+        .def("command_type", &CommandBuffer::command_type, D(CommandBuffer, command_type))
+        .def("size", &CommandBuffer::size, D(CommandBuffer, size))
+        .def("__repr__", &CommandBuffer::to_string)
+        .def("replay", py::overload_cast<>(&CommandBuffer::replay, py::const_),
+             D(CommandBuffer, replay))
+        .def_static("replay_all", py::overload_cast<const std::vector<ref<CommandBuffer>> &>(
+                        &CommandBuffer::replay), D(CommandBuffer, replay, 2), "buffers"_a);
 }
 
 #endif
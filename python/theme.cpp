@@ -61,5 +61,9 @@ void register_theme(py::module &m) {
          .def_readwrite("m_popup_chevron_right_icon", &Theme::m_popup_chevron_right_icon, D(Theme, m_popup_chevron_right_icon))
          .def_readwrite("m_popup_chevron_left_icon", &Theme::m_popup_chevron_left_icon, D(Theme, m_popup_chevron_left_icon))
          .def_readwrite("m_text_box_up_icon", &Theme::m_text_box_up_icon, D(Theme, m_text_box_up_icon))
-         .def_readwrite("m_text_box_down_icon", &Theme::m_text_box_down_icon, D(Theme, m_text_box_down_icon));
+         .def_readwrite("m_text_box_down_icon", &Theme::m_text_box_down_icon, D(Theme, m_text_box_down_icon))
+         .def_readwrite("m_prewarm_characters", &Theme::m_prewarm_characters, D(Theme, m_prewarm_characters))
+         .def_readwrite("m_prewarm_icons", &Theme::m_prewarm_icons, D(Theme, m_prewarm_icons))
+         .def("prewarm_glyphs", &Theme::prewarm_glyphs, D(Theme, prewarm_glyphs),
+              "ctx"_a, "pixel_ratio"_a, "force"_a = false);
 }
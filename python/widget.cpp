@@ -110,6 +110,14 @@ void register_widget(py::module &m) {
         .def("framebuffer_size", &Screen::framebuffer_size, D(Screen, framebuffer_size))
         .def("perform_layout", (void(Screen::*)(void)) &Screen::perform_layout, D(Screen, perform_layout))
         .def("redraw", &Screen::redraw, D(Screen, redraw))
+        .def("redraw_pending", &Screen::redraw_pending, D(Screen, redraw_pending))
+        .def("set_target_frame_rate", &Screen::set_target_frame_rate, D(Screen, set_target_frame_rate))
+        .def("target_frame_rate", &Screen::target_frame_rate, D(Screen, target_frame_rate))
+        .def("set_shared_vsync", &Screen::set_shared_vsync, D(Screen, set_shared_vsync))
+        .def("shared_vsync", &Screen::shared_vsync, D(Screen, shared_vsync))
+        .def("set_swap_interval", &Screen::set_swap_interval, D(Screen, set_swap_interval))
+        .def("swap_interval", &Screen::swap_interval, D(Screen, swap_interval))
+        .def("refresh_rate", &Screen::refresh_rate, D(Screen, refresh_rate))
         .def("clear", &Screen::clear, D(Screen, clear))
         .def("draw_all", &Screen::draw_all, D(Screen, draw_all))
         .def("draw_contents", &Screen::draw_contents, D(Screen, draw_contents))
@@ -126,9 +134,21 @@ void register_widget(py::module &m) {
                 py::return_value_policy::reference)
         .def("nvg_context", &Screen::nvg_context, D(Screen, nvg_context),
                 py::return_value_policy::reference)
+        .def("render_device", &Screen::render_device, D(Screen, render_device))
         .def("pixel_format", &Screen::pixel_format, D(Screen, pixel_format))
         .def("component_format", &Screen::component_format, D(Screen, component_format))
         .def("nvg_flush", &Screen::nvg_flush, D(Screen, nvg_flush))
+        .def("texture_pool", &Screen::texture_pool, D(Screen, texture_pool))
+        .def("set_profiling", &Screen::set_profiling, D(Screen, set_profiling))
+        .def("profiling", &Screen::profiling, D(Screen, profiling))
+        .def("profiler", &Screen::profiler, D(Screen, profiler))
+        .def("frame_stats", &Screen::frame_stats, D(Screen, frame_stats))
+        .def("set_profiler_overlay", &Screen::set_profiler_overlay, D(Screen, set_profiler_overlay))
+        .def("profiler_overlay", &Screen::profiler_overlay, D(Screen, profiler_overlay))
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        .def("gl_state", &Screen::gl_state, D(Screen, gl_state),
+                py::return_value_policy::reference_internal)
+#endif
 #if defined(NANOGUI_USE_METAL)
         .def("metal_layer", &Screen::metal_layer)
         .def("metal_texture", &Screen::metal_texture)
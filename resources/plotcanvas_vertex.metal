@@ -0,0 +1,20 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+struct VertexOut {
+    float4 position [[position]];
+};
+
+vertex VertexOut vertex_main(const device float2 *position,
+                             constant float &origin,
+                             constant float &capacity,
+                             constant float4 &transform,
+                             uint id [[vertex_id]]) {
+    float2 p = position[id];
+    float t = fmod(p.x - origin + capacity, capacity);
+    VertexOut vert;
+    vert.position = float4(t * transform.x + transform.y,
+                           p.y * transform.z + transform.w, 0.f, 1.f);
+    return vert;
+}
@@ -16,6 +16,7 @@
 #include <nanogui/canvas.h>
 #include <nanogui/texture.h>
 #include <nanogui/renderpass.h>
+#include <nanogui/shader.h>
 #include <nanogui/theme.h>
 #include <nanogui/opengl.h>
 #include "opengl_check.h"
@@ -25,31 +26,55 @@ NAMESPACE_BEGIN(nanogui)
 Canvas::Canvas(Widget *parent, uint8_t samples,
                bool has_depth_buffer, bool has_stencil_buffer,
                bool clear)
-    : Widget(parent), m_draw_border(true) {
+    : Widget(parent), m_draw_border(true), m_samples(samples),
+      m_has_depth_buffer(has_depth_buffer),
+      m_has_stencil_buffer(has_stencil_buffer), m_clear(clear) {
     m_size = Vector2i(250, 250);
     m_border_color = m_theme->m_border_light;
 
 #if defined(NANOGUI_USE_GLES)
-    samples = 1;
+    m_samples = 1;
 #endif
 
+    if (has_stencil_buffer && !has_depth_buffer)
+        throw std::runtime_error("Canvas::Canvas(): has_stencil implies has_depth!");
+
+    init_render_pass();
+}
+
+Canvas::~Canvas() {
+    if (m_nvg_image != -1) {
+        /* The screen is unavailable if it is being torn down, in which case
+           NanoVG releases the image along with its context */
+        Screen *scr = screen();
+        if (scr && scr->nvg_context())
+            nvgDeleteImage(scr->nvg_context(), m_nvg_image);
+    }
+}
+
+void Canvas::init_render_pass() {
     Screen *scr = screen();
     if (scr == nullptr)
-        throw std::runtime_error("Canvas::Canvas(): could not find parent screen!");
+        throw std::runtime_error("Canvas::init_render_pass(): could not find parent screen!");
 
-    m_render_to_texture = samples != 1
-        || (has_depth_buffer && !scr->has_depth_buffer())
-        || (has_stencil_buffer && !scr->has_stencil_buffer());
+    m_render_to_texture = m_composite || m_samples != 1
+        || (m_has_depth_buffer && !scr->has_depth_buffer())
+        || (m_has_stencil_buffer && !scr->has_stencil_buffer());
 
     Object *color_texture = nullptr,
            *depth_texture = nullptr;
+    ref<Texture> color_texture_ref, depth_texture_ref;
 
-    if (has_stencil_buffer && !has_depth_buffer)
-        throw std::runtime_error("Canvas::Canvas(): has_stencil implies has_depth!");
+    /* Composited canvases are sampled by NanoVG */
+    uint8_t color_flags = (uint8_t) Texture::TextureFlags::RenderTarget;
+    if (m_composite)
+        color_flags |= (uint8_t) Texture::TextureFlags::ShaderRead;
+
+    m_render_pass_resolved = nullptr;
 
     if (!m_render_to_texture) {
         color_texture = scr;
-        if (has_depth_buffer) {
+        if (m_has_depth_buffer) {
 #if defined(NANOGUI_USE_METAL)
             depth_texture = scr->depth_stencil_texture();
 #else
@@ -57,62 +82,81 @@ Canvas::Canvas(Widget *parent, uint8_t samples,
 #endif
         }
     } else {
-        color_texture = new Texture(
+        /* Render targets are recycled via the screen's texture pool */
+        TexturePool *pool = scr->texture_pool();
+        color_texture_ref = pool->acquire(
             scr->pixel_format(),
             scr->component_format(),
             m_size,
-            Texture::InterpolationMode::Bilinear,
-            Texture::InterpolationMode::Bilinear,
-            Texture::WrapMode::ClampToEdge,
-            samples,
-            Texture::TextureFlags::RenderTarget
+            m_samples,
+            m_samples == 1 ? color_flags : (uint8_t) Texture::TextureFlags::RenderTarget
         );
+        color_texture = color_texture_ref;
 
 #if defined(NANOGUI_USE_METAL)
-        Texture *color_texture_resolved = nullptr;
-
-        if (samples > 1) {
-            color_texture_resolved = new Texture(
+        bool resolve = m_samples > 1;
+#else
+        bool resolve = m_samples > 1 && m_composite;
+#endif
+        if (resolve) {
+            ref<Texture> color_texture_resolved = pool->acquire(
                 scr->pixel_format(),
                 scr->component_format(),
                 m_size,
-                Texture::InterpolationMode::Bilinear,
-                Texture::InterpolationMode::Bilinear,
-                Texture::WrapMode::ClampToEdge,
                 1,
-                Texture::TextureFlags::RenderTarget
+                color_flags
             );
 
             m_render_pass_resolved = new RenderPass(
-                { color_texture_resolved }
+                { color_texture_resolved.get() }
             );
+            m_render_pass_resolved->set_texture_pool(pool);
         }
-#endif
 
-        depth_texture = new Texture(
-            has_stencil_buffer ? Texture::PixelFormat::DepthStencil
-                               : Texture::PixelFormat::Depth,
+        depth_texture_ref = pool->acquire(
+            m_has_stencil_buffer ? Texture::PixelFormat::DepthStencil
+                                 : Texture::PixelFormat::Depth,
             Texture::ComponentFormat::Float32,
             m_size,
-            Texture::InterpolationMode::Bilinear,
-            Texture::InterpolationMode::Bilinear,
-            Texture::WrapMode::ClampToEdge,
-            samples,
+            m_samples,
             Texture::TextureFlags::RenderTarget
         );
+        depth_texture = depth_texture_ref;
     }
 
-    m_render_pass = new RenderPass(
+    ref<RenderPass> render_pass = new RenderPass(
         { color_texture },
         depth_texture,
-        has_stencil_buffer ? depth_texture : nullptr,
-#if defined(NANOGUI_USE_METAL)
+        m_has_stencil_buffer ? depth_texture : nullptr,
         m_render_pass_resolved,
-#else
-        nullptr,
-#endif
-        clear
+        m_clear
     );
+
+    render_pass->set_label("Canvas");
+
+    /* Carry over the drawing state when switching modes */
+    if (m_render_pass) {
+        render_pass->set_label(m_render_pass->label());
+        render_pass->set_clear_color(0, m_render_pass->clear_color(0));
+        render_pass->set_clear_depth(m_render_pass->clear_depth());
+        render_pass->set_clear_stencil(m_render_pass->clear_stencil());
+        auto depth_test = m_render_pass->depth_test();
+        render_pass->set_depth_test(depth_test.first, depth_test.second);
+        render_pass->set_cull_mode(m_render_pass->cull_mode());
+    }
+
+    if (m_render_to_texture)
+        render_pass->set_texture_pool(scr->texture_pool());
+
+    m_render_pass = render_pass;
+}
+
+void Canvas::set_composite(bool composite) {
+    if (m_composite == composite)
+        return;
+    m_composite = composite;
+    init_render_pass();
+    render_pass_changed();
 }
 
 void Canvas::set_background_color(const Color &background_color) {
@@ -125,6 +169,55 @@ const Color& Canvas::background_color() const {
 
 void Canvas::draw_contents() { /* No-op. */ }
 
+void Canvas::add_pending_shader(Shader *shader) {
+    if (!shader->ready())
+        m_pending_shaders.push_back(shader);
+}
+
+bool Canvas::shaders_ready() {
+    if (m_pending_shaders.empty())
+        return true;
+
+    m_pending_shaders.erase(
+        std::remove_if(m_pending_shaders.begin(), m_pending_shaders.end(),
+                       [](ref<Shader> &shader) { return shader->ready(); }),
+        m_pending_shaders.end());
+
+    if (m_pending_shaders.empty())
+        return true;
+
+    screen()->redraw();
+    return false;
+}
+
+Vector2i Canvas::framebuffer_size() const {
+    Vector2i fbsize = m_size;
+    if (m_draw_border)
+        fbsize -= 2;
+    return Vector2i(fbsize * screen()->pixel_ratio());
+}
+
+Texture *Canvas::composite_texture() {
+    RenderPass *rp = m_render_pass_resolved ? m_render_pass_resolved.get()
+                                            : m_render_pass.get();
+    return dynamic_cast<Texture *>(rp->targets()[2].get());
+}
+
+void Canvas::render_offscreen() {
+    if (!m_composite)
+        return;
+
+    Vector2i fbsize = framebuffer_size();
+    m_render_pass->resize(fbsize);
+    if (m_render_pass_resolved)
+        m_render_pass_resolved->resize(fbsize);
+
+    m_render_pass->begin();
+    if (shaders_ready())
+        draw_contents();
+    m_render_pass->end();
+}
+
 void Canvas::draw(NVGcontext *ctx) {
     Screen *scr = screen();
     if (scr == nullptr)
@@ -134,38 +227,75 @@ void Canvas::draw(NVGcontext *ctx) {
 
     Widget::draw(ctx);
 
-    scr->nvg_flush();
-
-    Vector2i fbsize = m_size;
-    Vector2i offset = absolute_position();
-    if (m_draw_border)
-        fbsize -= 2;
+    if (m_composite) {
+        /* The contents were already rendered by render_offscreen(), simply
+           paint them as part of the NanoVG frame */
+        Texture *texture = composite_texture();
+        Vector2i fbsize = framebuffer_size();
+
+        if (m_nvg_image == -1 || m_nvg_image_texture != texture ||
+            m_nvg_image_size != texture->size()) {
+            if (m_nvg_image != -1)
+                nvgDeleteImage(ctx, m_nvg_image);
+            m_nvg_image = scr->render_device()->nvg_image_from_texture(ctx, texture);
+            m_nvg_image_texture = texture;
+            m_nvg_image_size = texture->size();
+        }
 
+        /* Pooled textures may be larger than the canvas. The contents occupy
+           the upper left corner on Metal and the lower left corner on
+           OpenGL, which becomes the upper left corner after flipping. */
+        Vector2f pos = Vector2f(m_pos) + (m_draw_border ? 1.f : 0.f),
+                 size = Vector2f(fbsize) / pixel_ratio,
+                 image_size = Vector2f(texture->size()) / pixel_ratio;
+        float image_y = pos.y();
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
-    if (m_render_to_texture)
-        offset = Vector2i(offset.x(), scr->size().y() - offset.y() - m_size.y());
+        image_y -= image_size.y() - size.y();
 #endif
 
-    if (m_draw_border)
-        offset += Vector2i(1, 1);
+        NVGpaint paint = nvgImagePattern(ctx, pos.x(), image_y, image_size.x(),
+                                         image_size.y(), 0.f, m_nvg_image, 1.f);
+        nvgBeginPath(ctx);
+        nvgRect(ctx, pos.x(), pos.y(), size.x(), size.y());
+        nvgFillPaint(ctx, paint);
+        nvgFill(ctx);
+    } else {
+        scr->nvg_flush();
 
-    fbsize = Vector2i(fbsize * pixel_ratio);
-    offset = Vector2i(offset * pixel_ratio);
+        Vector2i fbsize = framebuffer_size();
+        Vector2i offset = absolute_position();
 
-    if (m_render_to_texture) {
-        m_render_pass->resize(fbsize);
-#if defined(NANOGUI_USE_METAL)
-        if (m_render_pass_resolved)
-            m_render_pass_resolved->resize(fbsize);
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        if (m_render_to_texture)
+            offset = Vector2i(offset.x(), scr->size().y() - offset.y() - m_size.y());
 #endif
-    } else {
-        m_render_pass->resize(scr->framebuffer_size());
-        m_render_pass->set_viewport(offset, fbsize);
-    }
 
-    m_render_pass->begin();
-    draw_contents();
-    m_render_pass->end();
+        if (m_draw_border)
+            offset += Vector2i(1, 1);
+
+        offset = Vector2i(offset * pixel_ratio);
+
+        if (m_render_to_texture) {
+            m_render_pass->resize(fbsize);
+            if (m_render_pass_resolved)
+                m_render_pass_resolved->resize(fbsize);
+        } else {
+            m_render_pass->resize(scr->framebuffer_size());
+            m_render_pass->set_viewport(offset, fbsize);
+        }
+
+        m_render_pass->begin();
+        if (shaders_ready())
+            draw_contents();
+        m_render_pass->end();
+
+        if (m_render_to_texture) {
+            RenderPass *rp = m_render_pass;
+            if (m_render_pass_resolved)
+                rp = m_render_pass_resolved;
+            rp->blit_to(Vector2i(0, 0), fbsize, scr, offset);
+        }
+    }
 
     if (m_draw_border) {
         nvgBeginPath(ctx);
@@ -176,15 +306,6 @@ void Canvas::draw(NVGcontext *ctx) {
                        m_theme->m_window_corner_radius);
         nvgStroke(ctx);
     }
-
-    if (m_render_to_texture) {
-        RenderPass *rp = m_render_pass;
-#if defined(NANOGUI_USE_METAL)
-        if (m_render_pass_resolved)
-            rp = m_render_pass_resolved;
-#endif
-        rp->blit_to(Vector2i(0, 0), fbsize, scr, offset);
-    }
 }
 
 NAMESPACE_END(nanogui)
@@ -0,0 +1,427 @@
+#include <nanogui/commandbuffer.h>
+#include <cstring>
+#include <map>
+
+NAMESPACE_BEGIN(nanogui)
+
+namespace {
+    using CommandType = CommandBuffer::CommandType;
+
+    /// Prefix of every command in the arena
+    struct Header {
+        CommandType type;
+        /// Total size of the command including this header (multiple of 8)
+        uint32_t size;
+    };
+
+    /// Prefix of commands that reference a shader parameter, followed by the name
+    struct Binding {
+        Shader *shader;
+        /// Handle from Shader::binding(), or -1 if the parameter is referenced by name
+        size_t binding;
+        size_t name_size;
+    };
+
+    struct BufferArgs {
+        VariableType dtype;
+        uint32_t ndim;
+        size_t shape[3];
+        size_t data_size;
+    };
+
+    struct DrawArgs {
+        Shader::PrimitiveType primitive_type;
+        uint32_t indexed;
+        size_t offset;
+        size_t count;
+        size_t instance_count;
+    };
+
+    inline size_t align_size(size_t size) { return (size + 7) & ~(size_t) 7; }
+
+    inline const uint8_t *binding_args(const Binding *b) {
+        return (const uint8_t *) (b + 1) + align_size(b->name_size);
+    }
+
+    inline std::string binding_name(const Binding *b) {
+        return std::string((const char *) (b + 1), b->name_size);
+    }
+
+    /// Execution state shared by all command buffers of a replay() call
+    struct Replay {
+        RenderPass *render_pass = nullptr;
+        Shader *shader = nullptr;
+        bool end_pass_pending = false;
+        bool end_shader_pending = false;
+
+        /// Most recently applied buffer contents and textures per shader parameter
+        std::map<std::pair<Shader *, size_t>, const BufferArgs *> buffers;
+        std::map<std::pair<Shader *, size_t>, Texture *> textures;
+
+        void flush_shader() {
+            if (!end_shader_pending)
+                return;
+            shader->end();
+            shader = nullptr;
+            end_shader_pending = false;
+        }
+
+        void flush_pass() {
+            flush_shader();
+            if (!end_pass_pending)
+                return;
+            render_pass->end();
+            render_pass = nullptr;
+            end_pass_pending = false;
+        }
+
+        void finish() {
+            if (shader) {
+                shader->end();
+                shader = nullptr;
+            }
+            if (render_pass) {
+                render_pass->end();
+                render_pass = nullptr;
+            }
+            end_shader_pending = end_pass_pending = false;
+        }
+
+        size_t resolve(const Binding *b) {
+            return b->binding == (size_t) -1 ? b->shader->binding(binding_name(b))
+                                             : b->binding;
+        }
+
+        void run(const std::vector<uint8_t> &arena);
+    };
+
+    void Replay::run(const std::vector<uint8_t> &arena) {
+        for (size_t offset = 0; offset < arena.size(); ) {
+            const Header *header = (const Header *) (arena.data() + offset);
+            const uint8_t *payload = (const uint8_t *) (header + 1);
+            offset += header->size;
+
+            switch (header->type) {
+                case CommandType::BeginPass: {
+                        RenderPass *rp = *(RenderPass * const *) payload;
+                        /* Continue the previous pass unless it would clear its targets */
+                        if (end_pass_pending && render_pass == rp && !rp->clear()) {
+                            end_pass_pending = false;
+                            break;
+                        }
+                        flush_pass();
+                        rp->begin();
+                        render_pass = rp;
+                    }
+                    break;
+
+                case CommandType::EndPass:
+                    end_pass_pending = true;
+                    break;
+
+                case CommandType::BeginShader: {
+                        Shader *s = *(Shader * const *) payload;
+                        if (end_pass_pending)
+                            flush_pass();
+                        if (end_shader_pending && shader == s) {
+                            end_shader_pending = false;
+                            break;
+                        }
+                        flush_shader();
+                        s->begin();
+                        shader = s;
+                    }
+                    break;
+
+                case CommandType::EndShader:
+                    end_shader_pending = true;
+                    break;
+
+                case CommandType::SetBuffer: {
+                        const Binding *b = (const Binding *) payload;
+                        const BufferArgs *args = (const BufferArgs *) binding_args(b);
+                        const uint8_t *data = (const uint8_t *) (args + 1);
+                        size_t binding = resolve(b);
+
+                        const BufferArgs *&prev = buffers[{ b->shader, binding }];
+                        if (prev && prev->dtype == args->dtype && prev->ndim == args->ndim &&
+                            memcmp(prev->shape, args->shape, sizeof(args->shape)) == 0 &&
+                            prev->data_size == args->data_size &&
+                            memcmp(prev + 1, data, args->data_size) == 0)
+                            break;
+
+                        flush_shader();
+                        b->shader->set_buffer(binding, args->dtype, args->ndim,
+                                              args->shape, data);
+                        prev = args;
+                    }
+                    break;
+
+                case CommandType::SetTexture: {
+                        const Binding *b = (const Binding *) payload;
+                        Texture *texture = *(Texture * const *) binding_args(b);
+                        size_t binding = resolve(b);
+
+                        auto it = textures.find({ b->shader, binding });
+                        if (it != textures.end() && it->second == texture)
+                            break;
+
+                        flush_shader();
+                        b->shader->set_texture(binding, texture);
+                        textures[{ b->shader, binding }] = texture;
+                    }
+                    break;
+
+                case CommandType::DrawArray: {
+                        const DrawArgs *args = (const DrawArgs *) payload;
+                        if (!shader || end_shader_pending)
+                            throw std::runtime_error("CommandBuffer::replay(): draw "
+                                                     "command without an active shader!");
+                        shader->draw_array_instanced(args->primitive_type, args->offset,
+                                                     args->count, args->instance_count,
+                                                     args->indexed != 0);
+                    }
+                    break;
+
+                default:
+                    throw std::runtime_error("CommandBuffer::replay(): invalid command!");
+            }
+        }
+    }
+}
+
+uint8_t *CommandBuffer::append(CommandType type, size_t size) {
+    size_t offset = m_arena.size(),
+           total  = sizeof(Header) + align_size(size);
+
+    if (offset + total > (size_t) UINT32_MAX)
+        throw std::runtime_error("CommandBuffer::append(): command buffer is too large!");
+
+    m_arena.resize(offset + total);
+    Header *header = (Header *) (m_arena.data() + offset);
+    header->type = type;
+    header->size = (uint32_t) total;
+    m_offsets.push_back((uint32_t) offset);
+
+    return (uint8_t *) (header + 1);
+}
+
+uint8_t *CommandBuffer::append_binding(CommandType type, Shader *shader, size_t binding,
+                                       const std::string &name, size_t size) {
+    if (!shader)
+        throw std::runtime_error("CommandBuffer::append_binding(): shader must be specified!");
+    retain(shader);
+
+    uint8_t *ptr = append(type, sizeof(Binding) + align_size(name.size()) + size);
+    Binding *b = (Binding *) ptr;
+    b->shader = shader;
+    b->binding = binding;
+    b->name_size = name.size();
+    memcpy(b + 1, name.data(), name.size());
+
+    return (uint8_t *) binding_args(b);
+}
+
+void CommandBuffer::retain(Object *object) {
+    /* Consecutive commands usually reference the same object */
+    if (object && (m_objects.empty() || m_objects.back().get() != object))
+        m_objects.push_back(object);
+}
+
+void CommandBuffer::begin_pass(RenderPass *render_pass) {
+    if (!render_pass)
+        throw std::runtime_error("CommandBuffer::begin_pass(): render pass must be specified!");
+    else if (m_render_pass)
+        throw std::runtime_error("CommandBuffer::begin_pass(): a render pass is already active!");
+    retain(render_pass);
+    *(RenderPass **) append(CommandType::BeginPass, sizeof(RenderPass *)) = render_pass;
+    m_render_pass = render_pass;
+}
+
+void CommandBuffer::end_pass() {
+    if (!m_render_pass)
+        throw std::runtime_error("CommandBuffer::end_pass(): no render pass is active!");
+    else if (m_shader)
+        throw std::runtime_error("CommandBuffer::end_pass(): shader is still active!");
+    append(CommandType::EndPass, 0);
+    m_render_pass = nullptr;
+}
+
+void CommandBuffer::begin_shader(Shader *shader) {
+    if (!shader)
+        throw std::runtime_error("CommandBuffer::begin_shader(): shader must be specified!");
+    else if (m_shader)
+        throw std::runtime_error("CommandBuffer::begin_shader(): a shader is already active!");
+    retain(shader);
+    *(Shader **) append(CommandType::BeginShader, sizeof(Shader *)) = shader;
+    m_shader = shader;
+}
+
+void CommandBuffer::end_shader() {
+    if (!m_shader)
+        throw std::runtime_error("CommandBuffer::end_shader(): no shader is active!");
+    append(CommandType::EndShader, 0);
+    m_shader = nullptr;
+}
+
+static void record_buffer(uint8_t *ptr, VariableType dtype, size_t ndim,
+                          const size_t *shape, const void *data, size_t data_size) {
+    BufferArgs *args = (BufferArgs *) ptr;
+    args->dtype = dtype;
+    args->ndim = (uint32_t) ndim;
+    for (size_t i = 0; i < 3; ++i)
+        args->shape[i] = i < ndim ? shape[i] : 1;
+    args->data_size = data_size;
+    memcpy(args + 1, data, data_size);
+}
+
+static size_t buffer_size(VariableType dtype, size_t ndim, const size_t *shape) {
+    if (ndim > 3)
+        throw std::runtime_error("CommandBuffer::set_buffer(): tensor dimension must be in the range 0..3!");
+    size_t size = type_size(dtype);
+    for (size_t i = 0; i < ndim; ++i)
+        size *= shape[i];
+    return size;
+}
+
+void CommandBuffer::set_buffer(Shader *shader, const std::string &name, VariableType dtype,
+                               size_t ndim, const size_t *shape, const void *data) {
+    size_t size = buffer_size(dtype, ndim, shape);
+    uint8_t *ptr = append_binding(CommandType::SetBuffer, shader, (size_t) -1,
+                                  name, sizeof(BufferArgs) + size);
+    record_buffer(ptr, dtype, ndim, shape, data, size);
+}
+
+void CommandBuffer::set_buffer(Shader *shader, size_t binding, VariableType dtype,
+                               size_t ndim, const size_t *shape, const void *data) {
+    size_t size = buffer_size(dtype, ndim, shape);
+    uint8_t *ptr = append_binding(CommandType::SetBuffer, shader, binding,
+                                  std::string(), sizeof(BufferArgs) + size);
+    record_buffer(ptr, dtype, ndim, shape, data, size);
+}
+
+void CommandBuffer::set_texture(Shader *shader, const std::string &name, Texture *texture) {
+    retain(texture);
+    *(Texture **) append_binding(CommandType::SetTexture, shader, (size_t) -1,
+                                 name, sizeof(Texture *)) = texture;
+}
+
+void CommandBuffer::set_texture(Shader *shader, size_t binding, Texture *texture) {
+    retain(texture);
+    *(Texture **) append_binding(CommandType::SetTexture, shader, binding,
+                                 std::string(), sizeof(Texture *)) = texture;
+}
+
+void CommandBuffer::draw_array(PrimitiveType primitive_type, size_t offset,
+                               size_t count, bool indexed) {
+    draw_array_instanced(primitive_type, offset, count, 1, indexed);
+}
+
+void CommandBuffer::draw_array_instanced(PrimitiveType primitive_type, size_t offset,
+                                         size_t count, size_t instance_count,
+                                         bool indexed) {
+    if (!m_shader)
+        throw std::runtime_error("CommandBuffer::draw_array(): no shader is active!");
+    DrawArgs *args = (DrawArgs *) append(CommandType::DrawArray, sizeof(DrawArgs));
+    args->primitive_type = primitive_type;
+    args->indexed = indexed ? 1 : 0;
+    args->offset = offset;
+    args->count = count;
+    args->instance_count = instance_count;
+}
+
+void CommandBuffer::clear() {
+    m_arena.clear();
+    m_offsets.clear();
+    m_objects.clear();
+    m_render_pass = nullptr;
+    m_shader = nullptr;
+}
+
+CommandBuffer::CommandType CommandBuffer::command_type(size_t index) const {
+    if (index >= m_offsets.size())
+        throw std::runtime_error("CommandBuffer::command_type(): index out of bounds!");
+    return ((const Header *) (m_arena.data() + m_offsets[index]))->type;
+}
+
+std::string CommandBuffer::to_string() const {
+    static const char *primitive_names[] = {
+        "point", "line", "line_strip", "triangle", "triangle_strip"
+    };
+
+    std::string result;
+    for (uint32_t offset : m_offsets) {
+        const Header *header = (const Header *) (m_arena.data() + offset);
+        const uint8_t *payload = (const uint8_t *) (header + 1);
+        const Binding *b = (const Binding *) payload;
+        std::string param;
+        if (header->type == CommandType::SetBuffer ||
+            header->type == CommandType::SetTexture)
+            param = "\"" + b->shader->name() + "\", " +
+                    (b->binding == (size_t) -1 ? "\"" + binding_name(b) + "\""
+                                               : std::to_string(b->binding));
+
+        switch (header->type) {
+            case CommandType::BeginPass:
+                result += "begin_pass()";
+                break;
+
+            case CommandType::EndPass:
+                result += "end_pass()";
+                break;
+
+            case CommandType::BeginShader:
+                result += "begin_shader(\"" + (*(Shader * const *) payload)->name() + "\")";
+                break;
+
+            case CommandType::EndShader:
+                result += "end_shader()";
+                break;
+
+            case CommandType::SetBuffer: {
+                    const BufferArgs *args = (const BufferArgs *) binding_args(b);
+                    result += "set_buffer(" + param + ", dtype=" + type_name(args->dtype) +
+                              ", shape=[";
+                    for (size_t i = 0; i < args->ndim; ++i) {
+                        result += std::to_string(args->shape[i]);
+                        if (i + 1 < args->ndim)
+                            result += ", ";
+                    }
+                    result += "])";
+                }
+                break;
+
+            case CommandType::SetTexture:
+                result += "set_texture(" + param + ")";
+                break;
+
+            case CommandType::DrawArray: {
+                    const DrawArgs *args = (const DrawArgs *) payload;
+                    result += std::string("draw_array(") +
+                              primitive_names[(int) args->primitive_type] +
+                              ", offset=" + std::to_string(args->offset) +
+                              ", count=" + std::to_string(args->count) +
+                              ", instances=" + std::to_string(args->instance_count) +
+                              ", indexed=" + (args->indexed ? "true" : "false") + ")";
+                }
+                break;
+        }
+        result += "\n";
+    }
+    return result;
+}
+
+void CommandBuffer::replay() const {
+    Replay state;
+    state.run(m_arena);
+    state.finish();
+}
+
+void CommandBuffer::replay(const std::vector<ref<CommandBuffer>> &buffers) {
+    Replay state;
+    for (const ref<CommandBuffer> &buffer : buffers)
+        state.run(buffer->m_arena);
+    state.finish();
+}
+
+NAMESPACE_END(nanogui)
@@ -10,6 +10,7 @@
 */
 
 #include <nanogui/screen.h>
+#include <nanogui/textureloader.h>
 
 #if defined(_WIN32)
 #  define NOMINMAX
@@ -19,10 +20,11 @@
 #include <nanogui/opengl.h>
 #include <nanogui/metal.h>
 #include <map>
-#include <thread>
-#include <chrono>
 #include <mutex>
+#include <atomic>
 #include <iostream>
+#include <algorithm>
+#include <limits>
 
 #if !defined(_WIN32)
 #  include <locale.h>
@@ -60,6 +62,11 @@ void init() {
         }
     );
 
+#if defined(NANOGUI_USE_NULL) && defined(GLFW_PLATFORM_NULL)
+    /* Run without a display server (requires GLFW 3.4) */
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+
     if (!glfwInit())
         throw std::runtime_error("Could not initialize GLFW!");
 
@@ -70,37 +77,60 @@ void init() {
     glfwSetTime(0);
 }
 
-static bool mainloop_active = false;
-
-#if defined(EMSCRIPTEN)
-static double emscripten_last = 0;
-static float emscripten_refresh = 0;
-#endif
+/* May be accessed by other threads via leave() and active() */
+static std::atomic<bool> mainloop_active { false };
+static float mainloop_refresh = -1.f;
 
 std::mutex m_async_mutex;
 std::vector<std::function<void()>> m_async_functions;
 
+/**
+ * \brief Draw the screens that need to be redrawn
+ *
+ * Screens with a shared vertical synchronization whose monitors share a
+ * refresh rate form a group, in which only the screen drawn last waits for
+ * the vertical blank (the others may tear). Redrawing N such screens hence
+ * takes one refresh interval instead of N.
+ */
+static void draw_screens(std::vector<Screen *> &screens) {
+    std::stable_sort(screens.begin(), screens.end(),
+        [](const Screen *a, const Screen *b) { return a->shared_vsync() < b->shared_vsync(); });
+
+    std::vector<int> refresh_rates;
+    for (Screen *screen : screens)
+        refresh_rates.push_back(screen->shared_vsync() ? screen->refresh_rate() : 0);
+
+    for (size_t i = 0; i < screens.size(); ++i) {
+        Screen *screen = screens[i];
+        if (screen->shared_vsync()) {
+            bool last = true;
+            for (size_t j = i + 1; j < screens.size(); ++j)
+                last &= refresh_rates[j] != refresh_rates[i];
+            screen->set_swap_interval(last ? 1 : 0);
+        }
+        screen->draw_all();
+    }
+}
+
 void mainloop(float refresh) {
     if (mainloop_active)
         throw std::runtime_error("Main loop is already running!");
 
     auto mainloop_iteration = []() {
         int num_screens = 0;
-
-        #if defined(EMSCRIPTEN)
-            double emscripten_now = glfwGetTime();
-            bool emscripten_redraw = false;
-            if (float((emscripten_now - emscripten_last) * 1000) > emscripten_refresh) {
-                emscripten_redraw = true;
-                emscripten_last = emscripten_now;
+        double now = glfwGetTime(),
+               deadline = std::numeric_limits<double>::infinity();
+        std::vector<Screen *> dirty;
+
+        /* Run async functions (outside of the lock, so that they may
+           in turn enqueue further functions via async()) */ {
+            std::vector<std::function<void()>> functions;
+            {
+                std::lock_guard<std::mutex> guard(m_async_mutex);
+                functions.swap(m_async_functions);
             }
-        #endif
-
-        /* Run async functions */ {
-            std::lock_guard<std::mutex> guard(m_async_mutex);
-            for (auto &f : m_async_functions)
+            for (auto &f : functions)
                 f();
-            m_async_functions.clear();
         }
 
         for (auto kv : __nanogui_screens) {
@@ -111,11 +141,10 @@ void mainloop(float refresh) {
                 screen->set_visible(false);
                 continue;
             }
-            #if defined(EMSCRIPTEN)
-                if (emscripten_redraw || screen->tooltip_fade_in_progress())
-                    screen->redraw();
-            #endif
-            screen->draw_all();
+
+            deadline = std::min(deadline, screen->update_schedule(now, mainloop_refresh));
+            if (screen->redraw_pending())
+                dirty.push_back(screen);
             num_screens++;
         }
 
@@ -125,14 +154,26 @@ void mainloop(float refresh) {
             return;
         }
 
+        draw_screens(dirty);
+
         #if !defined(EMSCRIPTEN)
-            /* Wait for mouse/keyboard or empty refresh events */
-            glfwWaitEvents();
+            /* Wait for mouse/keyboard or empty refresh events, or until the
+               next periodic frame of any screen is due */
+            if (deadline == std::numeric_limits<double>::infinity()) {
+                glfwWaitEvents();
+            } else {
+                double timeout = deadline - glfwGetTime();
+                if (timeout > 0)
+                    glfwWaitEventsTimeout(timeout);
+                else
+                    glfwPollEvents();
+            }
         #endif
     };
 
+    mainloop_refresh = refresh;
+
 #if defined(EMSCRIPTEN)
-    emscripten_refresh = refresh;
     /* The following will throw an exception and enter the main
        loop within Emscripten. This means that none of the code below
        (or in the caller, for that matter) will be executed */
@@ -141,42 +182,9 @@ void mainloop(float refresh) {
 
     mainloop_active = true;
 
-    std::thread refresh_thread;
-    std::chrono::microseconds quantum;
-    size_t quantum_count = 1;
-    if (refresh >= 0) {
-        quantum = std::chrono::microseconds((int64_t)(refresh * 1'000));
-        while (quantum.count() > 50'000) {
-            quantum /= 2;
-            quantum_count *= 2;
-        }
-    } else {
-        quantum = std::chrono::microseconds(50'000);
-        quantum_count = std::numeric_limits<size_t>::max();
-    }
-
-    /* If there are no mouse/keyboard events, try to refresh the
-       view roughly every 50 ms (default); this is to support animations
-       such as progress bars while keeping the system load
-       reasonably low */
-    refresh_thread = std::thread(
-        [quantum, quantum_count]() {
-            while (true) {
-                for (size_t i = 0; i < quantum_count; ++i) {
-                    if (!mainloop_active)
-                        return;
-                    std::this_thread::sleep_for(quantum);
-                    for (auto kv : __nanogui_screens) {
-                        if (kv.second->tooltip_fade_in_progress())
-                            kv.second->redraw();
-                    }
-                }
-                for (auto kv : __nanogui_screens)
-                    kv.second->redraw();
-            }
-        }
-    );
-
+    /* Periodic frames (see Screen::set_target_frame_rate() and the 'refresh'
+       parameter) are scheduled by the loop itself, which sleeps in
+       glfwWaitEventsTimeout() until the next one is due */
     try {
         while (mainloop_active)
             mainloop_iteration();
@@ -187,17 +195,27 @@ void mainloop(float refresh) {
         std::cerr << "Caught exception in main loop: " << e.what() << std::endl;
         leave();
     }
-
-    refresh_thread.join();
 }
 
 void async(const std::function<void()> &func) {
-    std::lock_guard<std::mutex> guard(m_async_mutex);
-    m_async_functions.push_back(func);
+    {
+        std::lock_guard<std::mutex> guard(m_async_mutex);
+        m_async_functions.push_back(func);
+    }
+#if !defined(EMSCRIPTEN)
+    /* Wake up the main loop if it is waiting for events */
+    if (mainloop_active)
+        glfwPostEmptyEvent();
+#endif
 }
 
 void leave() {
+#if !defined(EMSCRIPTEN)
+    if (mainloop_active.exchange(false))
+        glfwPostEmptyEvent();
+#else
     mainloop_active = false;
+#endif
 }
 
 bool active() {
@@ -253,9 +271,9 @@ int __nanogui_get_image(NVGcontext *ctx, const std::string &name, uint8_t *data,
     return icon_id;
 }
 
-std::vector<std::pair<int, std::string>>
-load_image_directory(NVGcontext *ctx, const std::string &path) {
-    std::vector<std::pair<int, std::string> > result;
+/// Return the full paths of all PNG images in a directory
+static std::vector<std::string> image_directory_files(const std::string &path) {
+    std::vector<std::string> result;
 #if !defined(_WIN32)
     DIR *dp = opendir(path.c_str());
     if (!dp)
@@ -274,12 +292,7 @@ load_image_directory(NVGcontext *ctx, const std::string &path) {
 #endif
         if (strstr(fname, "png") == nullptr)
             continue;
-        std::string full_name = path + "/" + std::string(fname);
-        int img = nvgCreateImage(ctx, full_name.c_str(), 0);
-        if (img == 0)
-            throw std::runtime_error("Could not open image data!");
-        result.push_back(
-            std::make_pair(img, full_name.substr(0, full_name.length() - 4)));
+        result.push_back(path + "/" + std::string(fname));
 #if !defined(_WIN32)
     }
     closedir(dp);
@@ -290,6 +303,34 @@ load_image_directory(NVGcontext *ctx, const std::string &path) {
     return result;
 }
 
+std::vector<std::pair<int, std::string>>
+load_image_directory(NVGcontext *ctx, const std::string &path) {
+    std::vector<std::pair<int, std::string> > result;
+    for (const std::string &full_name : image_directory_files(path)) {
+        int img = nvgCreateImage(ctx, full_name.c_str(), 0);
+        if (img == 0)
+            throw std::runtime_error("Could not open image data!");
+        result.push_back(
+            std::make_pair(img, full_name.substr(0, full_name.length() - 4)));
+    }
+    return result;
+}
+
+size_t load_image_directory_async(NVGcontext *ctx, const std::string &path,
+                                  TextureLoader *loader,
+                                  const std::function<void(int, const std::string &)> &callback) {
+    std::vector<std::string> files = image_directory_files(path);
+    for (const std::string &full_name : files) {
+        std::string name = full_name.substr(0, full_name.length() - 4);
+        loader->load_image(ctx, full_name,
+            [callback, name](int img, const std::string &) {
+                callback(img, name);
+            }
+        );
+    }
+    return files.size();
+}
+
 std::string file_dialog(const std::vector<std::pair<std::string, std::string>> &filetypes, bool save) {
     auto result = file_dialog(filetypes, save, false);
     return result.empty() ? "" : result.front();
@@ -450,7 +450,7 @@ public:
             /* An identifying name */
             "a_simple_shader",
 
-#if defined(NANOGUI_USE_OPENGL)
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_NULL)
             R"(/* Vertex shader */
             #version 330
             uniform mat4 mvp;
@@ -28,6 +28,8 @@
 #  endif
 #elif defined(NANOGUI_USE_GLES)
 #  define GLFW_INCLUDE_ES2
+#elif defined(NANOGUI_USE_NULL)
+#  define GLFW_INCLUDE_NONE
 #endif
 
 #include <GLFW/glfw3.h>
@@ -71,6 +73,8 @@ int main(int /* argc */, char ** /* argv */) {
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 
     metal_init();
+#elif defined(NANOGUI_USE_NULL)
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 #endif
 
     glfwWindowHint(GLFW_SAMPLES, 0);
@@ -0,0 +1,243 @@
+/*
+    src/frameprofiler.cpp -- CPU and GPU timings of the passes of a frame
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/frameprofiler.h>
+#include <nanogui/opengl.h>
+#include <chrono>
+
+#if defined(NANOGUI_USE_OPENGL)
+#  include "opengl_check.h"
+#endif
+
+NAMESPACE_BEGIN(nanogui)
+
+static thread_local FrameProfiler *current_profiler = nullptr;
+
+/// Return the time in seconds (relative to an arbitrary point in time)
+static double profiler_time() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FrameProfiler::FrameProfiler(bool gpu_timers, uint32_t latency)
+    : m_gpu_timers(gpu_timers), m_frames(latency + 1) {
+#if !defined(NANOGUI_USE_OPENGL)
+    /* Timer queries are only implemented for desktop OpenGL */
+    m_gpu_timers = false;
+#endif
+}
+
+FrameProfiler::~FrameProfiler() {
+    if (current_profiler == this)
+        current_profiler = nullptr;
+#if defined(NANOGUI_USE_OPENGL)
+    for (Frame &frame : m_frames) {
+        if (!frame.queries.empty())
+            CHK(glDeleteQueries((GLsizei) frame.queries.size(), frame.queries.data()));
+    }
+#endif
+}
+
+FrameProfiler *FrameProfiler::current() {
+    return current_profiler;
+}
+
+void FrameProfiler::set_current(FrameProfiler *profiler) {
+    current_profiler = profiler;
+}
+
+void FrameProfiler::begin_frame() {
+    if (m_active)
+        throw std::runtime_error("FrameProfiler::begin_frame(): frame is already active!");
+
+    m_index = (m_index + 1) % m_frames.size();
+    Frame &frame = m_frames[m_index];
+
+    /* The GPU has fallen behind by more than 'latency' frames */
+    if (frame.pending)
+        resolve(frame, true);
+
+    frame.stats.frame = ++m_frame_count;
+    frame.stats.cpu_time = 0.f;
+    frame.stats.gpu_time = m_gpu_timers ? 0.f : -1.f;
+    frame.stats.timings.clear();
+    frame.query_count = 0;
+
+    m_active = true;
+    m_frame_start = m_segment_start = profiler_time();
+}
+
+void FrameProfiler::end_frame() {
+    if (!m_active)
+        throw std::runtime_error("FrameProfiler::end_frame(): frame is not active!");
+    if (!m_stack.empty())
+        throw std::runtime_error("FrameProfiler::end_frame(): unbalanced push()/pop() calls!");
+
+    Frame &frame = m_frames[m_index];
+    frame.stats.cpu_time = (float) ((profiler_time() - m_frame_start) * 1000.0);
+    frame.pending = frame.query_count > 0;
+    m_active = false;
+
+    /* Publish the frames whose query results became available (oldest first) */
+    for (size_t i = 1; i <= m_frames.size(); ++i) {
+        Frame &f = m_frames[(m_index + i) % m_frames.size()];
+        if (f.pending && !resolve(f, false))
+            break;
+    }
+
+    if (!frame.pending)
+        publish(frame);
+}
+
+void FrameProfiler::push(const std::string &name) {
+    if (!m_active)
+        return;
+
+    Frame &frame = m_frames[m_index];
+    if (!m_stack.empty())
+        end_segment();
+
+    Timing timing;
+    timing.name = name;
+    timing.gpu_time = m_gpu_timers ? 0.f : -1.f;
+    m_stack.push_back((uint32_t) frame.stats.timings.size());
+    frame.stats.timings.push_back(std::move(timing));
+
+    begin_segment();
+}
+
+void FrameProfiler::pop() {
+    if (!m_active)
+        return;
+    if (m_stack.empty())
+        throw std::runtime_error("FrameProfiler::pop(): no scope is active!");
+
+    end_segment();
+    m_stack.pop_back();
+    if (!m_stack.empty())
+        begin_segment();
+}
+
+void FrameProfiler::begin_segment() {
+    m_segment_start = profiler_time();
+
+#if defined(NANOGUI_USE_OPENGL)
+    if (m_gpu_timers) {
+        Frame &frame = m_frames[m_index];
+        if (frame.query_count == frame.queries.size()) {
+            GLuint query;
+            CHK(glGenQueries(1, &query));
+            frame.queries.push_back(query);
+            frame.query_scopes.push_back(0);
+        }
+        frame.query_scopes[frame.query_count] = m_stack.back();
+        CHK(glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.query_count]));
+        frame.query_count++;
+    }
+#endif
+}
+
+void FrameProfiler::end_segment() {
+    Frame &frame = m_frames[m_index];
+    double now = profiler_time();
+    frame.stats.timings[m_stack.back()].cpu_time +=
+        (float) ((now - m_segment_start) * 1000.0);
+
+#if defined(NANOGUI_USE_OPENGL)
+    if (m_gpu_timers)
+        CHK(glEndQuery(GL_TIME_ELAPSED));
+#endif
+}
+
+bool FrameProfiler::resolve(Frame &frame, bool wait) {
+#if defined(NANOGUI_USE_OPENGL)
+    if (!wait) {
+        /* Queries complete in order, so checking the last one suffices */
+        GLuint available = 0;
+        CHK(glGetQueryObjectuiv(frame.queries[frame.query_count - 1],
+                                GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available)
+            return false;
+    }
+
+    for (size_t i = 0; i < frame.query_count; ++i) {
+        GLuint64 elapsed = 0;
+        CHK(glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &elapsed));
+        float ms = (float) (elapsed * 1e-6);
+        frame.stats.timings[frame.query_scopes[i]].gpu_time += ms;
+        frame.stats.gpu_time += ms;
+    }
+#else
+    (void) wait;
+#endif
+
+    frame.pending = false;
+    publish(frame);
+    return true;
+}
+
+void FrameProfiler::publish(Frame &frame) {
+    if (frame.stats.frame > m_stats.frame)
+        m_stats = frame.stats;
+}
+
+void FrameProfiler::draw_overlay(NVGcontext *ctx, const Vector2f &pos) const {
+    const float line_height = 16.f, name_width = 140.f,
+                column_width = 70.f, margin = 6.f;
+    float width = name_width + 2.f * column_width + 2.f * margin,
+          height = line_height * (m_stats.timings.size() + 2) + 2.f * margin;
+
+    nvgSave(ctx);
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, pos.x(), pos.y(), width, height, 3.f);
+    nvgFillColor(ctx, Color(0, 180));
+    nvgFill(ctx);
+
+    nvgFontFace(ctx, "sans");
+    nvgFontSize(ctx, 14.f);
+    nvgFillColor(ctx, Color(255, 255));
+
+    char buf[32];
+    auto format = [&buf](float ms) -> const char * {
+        if (ms < 0.f)
+            return "-";
+        snprintf(buf, sizeof(buf), "%.2f ms", ms);
+        return buf;
+    };
+
+    auto row = [&](float y, const char *name, float cpu_time, float gpu_time) {
+        float x = pos.x() + margin;
+        nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+        nvgText(ctx, x, y, name, nullptr);
+        nvgTextAlign(ctx, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP);
+        nvgText(ctx, x + name_width + column_width, y, format(cpu_time), nullptr);
+        nvgText(ctx, x + name_width + 2.f * column_width, y, format(gpu_time), nullptr);
+    };
+
+    float y = pos.y() + margin;
+    std::string title = "Frame " + std::to_string(m_stats.frame);
+    nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+    nvgText(ctx, pos.x() + margin, y, title.c_str(), nullptr);
+    nvgTextAlign(ctx, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP);
+    nvgText(ctx, pos.x() + margin + name_width + column_width, y, "CPU", nullptr);
+    nvgText(ctx, pos.x() + margin + name_width + 2.f * column_width, y, "GPU", nullptr);
+    y += line_height;
+
+    for (const Timing &timing : m_stats.timings) {
+        row(y, timing.name.c_str(), timing.cpu_time, timing.gpu_time);
+        y += line_height;
+    }
+
+    row(y, "Total", m_stats.cpu_time, m_stats.gpu_time);
+    nvgRestore(ctx);
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,260 @@
+/*
+    src/glstate.cpp -- Shadow copy of frequently changed OpenGL state
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/glstate.h>
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+
+#include <nanogui/opengl.h>
+#include "opengl_check.h"
+
+NAMESPACE_BEGIN(nanogui)
+
+static thread_local GLState *current_state = nullptr;
+
+static const GLenum capability_enum[] = {
+    GL_DEPTH_TEST,
+    GL_SCISSOR_TEST,
+    GL_CULL_FACE,
+    GL_BLEND,
+#if defined(NANOGUI_USE_OPENGL)
+    GL_PROGRAM_POINT_SIZE
+#endif
+};
+
+GLState::GLState() {
+    invalidate();
+}
+
+GLState *GLState::current() {
+    if (!current_state) {
+        static thread_local GLState fallback;
+        return &fallback;
+    }
+    return current_state;
+}
+
+void GLState::set_current(GLState *state) {
+    current_state = state;
+}
+
+void GLState::invalidate() {
+    for (int i = 0; i < (int) Capability::Count; ++i)
+        m_enabled[i] = -1;
+    m_depth_mask = -1;
+    m_depth_func = Unknown;
+    m_cull_face = Unknown;
+    m_blend_src = m_blend_dst = Unknown;
+    m_viewport_valid = m_scissor_valid = false;
+    m_program = Unknown;
+#if defined(NANOGUI_USE_OPENGL)
+    m_vertex_array = Unknown;
+#endif
+    m_read_framebuffer = m_draw_framebuffer = Unknown;
+    m_active_texture = Unknown;
+    for (uint32_t i = 0; i < TextureUnits; ++i)
+        m_texture[i] = Unknown;
+}
+
+void GLState::reset(const Vector2i &framebuffer_size) {
+    invalidate();
+    for (int i = 0; i < (int) Capability::Count; ++i)
+        set_enabled((Capability) i, false);
+    set_depth_mask(true);
+    use_program(0);
+#if defined(NANOGUI_USE_OPENGL)
+    bind_vertex_array(0);
+#endif
+    bind_framebuffer(GL_FRAMEBUFFER, 0);
+    active_texture(0);
+    Vector4i rect(0, 0, framebuffer_size.x(), framebuffer_size.y());
+    set_viewport(rect);
+    set_scissor(rect);
+}
+
+bool GLState::enabled(Capability cap) {
+    int8_t &value = m_enabled[(int) cap];
+    if (value < 0)
+        value = glIsEnabled(capability_enum[(int) cap]) ? 1 : 0;
+    return value == 1;
+}
+
+void GLState::set_enabled(Capability cap, bool value) {
+    int8_t &current = m_enabled[(int) cap];
+    if (current == (int8_t) value)
+        return;
+    if (value)
+        CHK(glEnable(capability_enum[(int) cap]));
+    else
+        CHK(glDisable(capability_enum[(int) cap]));
+    current = (int8_t) value;
+}
+
+bool GLState::depth_mask() {
+    if (m_depth_mask < 0) {
+        GLboolean value;
+        CHK(glGetBooleanv(GL_DEPTH_WRITEMASK, &value));
+        m_depth_mask = value ? 1 : 0;
+    }
+    return m_depth_mask == 1;
+}
+
+void GLState::set_depth_mask(bool value) {
+    if (m_depth_mask == (int8_t) value)
+        return;
+    CHK(glDepthMask(value ? GL_TRUE : GL_FALSE));
+    m_depth_mask = (int8_t) value;
+}
+
+void GLState::set_depth_func(uint32_t func) {
+    if (m_depth_func == func)
+        return;
+    CHK(glDepthFunc((GLenum) func));
+    m_depth_func = func;
+}
+
+void GLState::set_cull_face(uint32_t mode) {
+    if (m_cull_face == mode)
+        return;
+    CHK(glCullFace((GLenum) mode));
+    m_cull_face = mode;
+}
+
+void GLState::set_blend_func(uint32_t src, uint32_t dst) {
+    if (m_blend_src == src && m_blend_dst == dst)
+        return;
+    CHK(glBlendFunc((GLenum) src, (GLenum) dst));
+    m_blend_src = src;
+    m_blend_dst = dst;
+}
+
+const Vector4i &GLState::viewport() {
+    if (!m_viewport_valid) {
+        CHK(glGetIntegerv(GL_VIEWPORT, m_viewport.v));
+        m_viewport_valid = true;
+    }
+    return m_viewport;
+}
+
+void GLState::set_viewport(const Vector4i &viewport) {
+    if (m_viewport_valid && m_viewport == viewport)
+        return;
+    CHK(glViewport(viewport[0], viewport[1], viewport[2], viewport[3]));
+    m_viewport = viewport;
+    m_viewport_valid = true;
+}
+
+const Vector4i &GLState::scissor() {
+    if (!m_scissor_valid) {
+        CHK(glGetIntegerv(GL_SCISSOR_BOX, m_scissor.v));
+        m_scissor_valid = true;
+    }
+    return m_scissor;
+}
+
+void GLState::set_scissor(const Vector4i &scissor) {
+    if (m_scissor_valid && m_scissor == scissor)
+        return;
+    CHK(glScissor(scissor[0], scissor[1], scissor[2], scissor[3]));
+    m_scissor = scissor;
+    m_scissor_valid = true;
+}
+
+void GLState::use_program(uint32_t program) {
+    if (m_program == program)
+        return;
+    CHK(glUseProgram(program));
+    m_program = program;
+}
+
+#if defined(NANOGUI_USE_OPENGL)
+void GLState::bind_vertex_array(uint32_t vertex_array) {
+    if (m_vertex_array == vertex_array)
+        return;
+    CHK(glBindVertexArray(vertex_array));
+    m_vertex_array = vertex_array;
+}
+#endif
+
+void GLState::bind_framebuffer(uint32_t target, uint32_t framebuffer) {
+#if defined(GL_READ_FRAMEBUFFER)
+    if (target == GL_READ_FRAMEBUFFER) {
+        if (m_read_framebuffer == framebuffer)
+            return;
+        CHK(glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer));
+        m_read_framebuffer = framebuffer;
+        return;
+    } else if (target == GL_DRAW_FRAMEBUFFER) {
+        if (m_draw_framebuffer == framebuffer)
+            return;
+        CHK(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer));
+        m_draw_framebuffer = framebuffer;
+        return;
+    }
+#endif
+    if (m_read_framebuffer == framebuffer && m_draw_framebuffer == framebuffer)
+        return;
+    CHK(glBindFramebuffer((GLenum) target, framebuffer));
+    m_read_framebuffer = m_draw_framebuffer = framebuffer;
+}
+
+void GLState::active_texture(uint32_t unit) {
+    if (m_active_texture == unit)
+        return;
+    CHK(glActiveTexture(GL_TEXTURE0 + unit));
+    m_active_texture = unit;
+}
+
+void GLState::bind_texture(uint32_t texture, bool force) {
+    /* Binding to an unknown unit would invalidate all shadowed bindings */
+    if (m_active_texture == Unknown)
+        active_texture(0);
+
+    uint32_t *bound = m_active_texture < TextureUnits
+                          ? &m_texture[m_active_texture] : nullptr;
+    if (!force && bound && *bound == texture)
+        return;
+    CHK(glBindTexture(GL_TEXTURE_2D, texture));
+    if (bound)
+        *bound = texture;
+}
+
+void GLState::texture_deleted(uint32_t texture) {
+    /* OpenGL reverts the bindings of deleted objects to zero */
+    for (uint32_t i = 0; i < TextureUnits; ++i) {
+        if (m_texture[i] == texture)
+            m_texture[i] = 0;
+    }
+}
+
+void GLState::program_deleted(uint32_t program) {
+    /* A program that is in use is only flagged for deletion */
+    if (m_program == program)
+        m_program = Unknown;
+}
+
+#if defined(NANOGUI_USE_OPENGL)
+void GLState::vertex_array_deleted(uint32_t vertex_array) {
+    if (m_vertex_array == vertex_array)
+        m_vertex_array = 0;
+}
+#endif
+
+void GLState::framebuffer_deleted(uint32_t framebuffer) {
+    if (m_read_framebuffer == framebuffer)
+        m_read_framebuffer = 0;
+    if (m_draw_framebuffer == framebuffer)
+        m_draw_framebuffer = 0;
+}
+
+NAMESPACE_END(nanogui)
+
+#endif
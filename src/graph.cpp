@@ -12,6 +12,8 @@
 #include <nanogui/graph.h>
 #include <nanogui/theme.h>
 #include <nanogui/opengl.h>
+#include <algorithm>
+#include <cstring>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -27,7 +29,154 @@ Vector2i Graph::preferred_size(NVGcontext *) const {
     return Vector2i(180, 45);
 }
 
+void Graph::set_values(const std::vector<float> &values) {
+    m_head = 0;
+    if (m_capacity > 0 && values.size() > m_capacity)
+        m_values.assign(values.end() - m_capacity, values.end());
+    else
+        m_values = values;
+}
+
+void Graph::set_capacity(size_t capacity) {
+    m_capacity = capacity;
+    trim_to_capacity();
+    if (capacity > 0)
+        m_values.reserve(capacity);
+}
+
+void Graph::trim_to_capacity() {
+    if (m_capacity == 0 || m_values.size() <= m_capacity)
+        return;
+    linearize();
+    m_values.erase(m_values.begin(), m_values.end() - m_capacity);
+}
+
+void Graph::push(float value) {
+    trim_to_capacity();
+    if (m_capacity == 0 || m_values.size() < m_capacity) {
+        m_values.push_back(value);
+    } else {
+        m_values[m_head] = value;
+        if (++m_head == m_capacity)
+            m_head = 0;
+    }
+}
+
+void Graph::push(const float *values, size_t count) {
+    if (m_capacity == 0) {
+        m_values.insert(m_values.end(), values, values + count);
+        return;
+    }
+
+    /* Samples added via values() may exceed the capacity */
+    trim_to_capacity();
+
+    if (count >= m_capacity) {
+        m_values.assign(values + count - m_capacity, values + count);
+        m_head = 0;
+        return;
+    }
+
+    /* Grow the buffer until it reaches its capacity */
+    size_t fill = std::min(count, m_capacity - m_values.size());
+    m_values.insert(m_values.end(), values, values + fill);
+    values += fill;
+    count -= fill;
+
+    /* Overwrite the oldest samples (at most two contiguous copies) */
+    while (count > 0) {
+        size_t chunk = std::min(count, m_capacity - m_head);
+        memcpy(m_values.data() + m_head, values, chunk * sizeof(float));
+        m_head = (m_head + chunk) % m_capacity;
+        values += chunk;
+        count -= chunk;
+    }
+}
+
+void Graph::clear() {
+    m_values.clear();
+    m_head = 0;
+}
+
+void Graph::linearize() const {
+    if (m_head == 0)
+        return;
+    std::rotate(m_values.begin(), m_values.begin() + m_head, m_values.end());
+    m_head = 0;
+}
+
+/// Compute the range of a contiguous block of samples using independent lanes (vectorizes well)
+static void min_max(const float *data, size_t size, float &min_value, float &max_value) {
+    const size_t Lanes = 8;
+    size_t i = 0;
+
+    if (size >= Lanes) {
+        float lo[Lanes], hi[Lanes];
+        for (size_t k = 0; k < Lanes; ++k)
+            lo[k] = hi[k] = data[k];
+        for (i = Lanes; i + Lanes <= size; i += Lanes) {
+            for (size_t k = 0; k < Lanes; ++k) {
+                float v = data[i + k];
+                lo[k] = v < lo[k] ? v : lo[k];
+                hi[k] = v > hi[k] ? v : hi[k];
+            }
+        }
+        for (size_t k = 0; k < Lanes; ++k) {
+            min_value = std::min(min_value, lo[k]);
+            max_value = std::max(max_value, hi[k]);
+        }
+    }
+
+    for (; i < size; ++i) {
+        min_value = std::min(min_value, data[i]);
+        max_value = std::max(max_value, data[i]);
+    }
+}
+
+void Graph::draw_samples(NVGcontext *ctx) const {
+    size_t size = m_values.size();
+    auto sample = [&](size_t i) { return m_values[(m_head + i) % size]; };
+    auto map_y = [&](float value) { return m_pos.y() + (1 - value) * m_size.y(); };
+
+    size_t columns = (size_t) std::max(m_size.x(), 1);
+    if (size <= 2 * columns) {
+        for (size_t i = 0; i < size; i++) {
+            float vx = m_pos.x() + i * m_size.x() / (float) (size - 1);
+            nvgLineTo(ctx, vx, map_y(sample(i)));
+        }
+        return;
+    }
+
+    /* More than two samples per pixel: emit the min/max envelope of each
+       column, ordered so that the outline follows the local trend */
+    for (size_t c = 0; c < columns; ++c) {
+        size_t start = c * size / columns,
+               end   = (c + 1) * size / columns;
+
+        float min_value = sample(start), max_value = min_value;
+        size_t offset = (m_head + start) % size, remaining = end - start;
+        while (remaining > 0) {
+            size_t chunk = std::min(remaining, size - offset);
+            min_max(m_values.data() + offset, chunk, min_value, max_value);
+            offset = 0;
+            remaining -= chunk;
+        }
+
+        float vx = m_pos.x() + (c + .5f) * m_size.x() / (float) columns;
+        bool rising = sample(start) <= sample(end - 1);
+        nvgLineTo(ctx, vx, map_y(rising ? min_value : max_value));
+        nvgLineTo(ctx, vx, map_y(rising ? max_value : min_value));
+    }
+}
+
 void Graph::draw(NVGcontext *ctx) {
+    if (m_published_values.update()) {
+        /* Take over the snapshot, the producer reuses the previous storage */
+        std::swap(m_values, m_published_values.front());
+        m_head = 0;
+        trim_to_capacity();
+    }
+
     Widget::draw(ctx);
 
     nvgBeginPath(ctx);
@@ -40,12 +189,7 @@ void Graph::draw(NVGcontext *ctx) {
 
     nvgBeginPath(ctx);
     nvgMoveTo(ctx, m_pos.x(), m_pos.y()+m_size.y());
-    for (size_t i = 0; i < (size_t) m_values.size(); i++) {
-        float value = m_values[i];
-        float vx = m_pos.x() + i * m_size.x() / (float) (m_values.size() - 1);
-        float vy = m_pos.y() + (1-value) * m_size.y();
-        nvgLineTo(ctx, vx, vy);
-    }
+    draw_samples(ctx);
 
     nvgLineTo(ctx, m_pos.x() + m_size.x(), m_pos.y() + m_size.y());
     nvgStrokeColor(ctx, m_stroke_color);
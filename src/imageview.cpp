@@ -16,12 +16,49 @@
 #include <nanogui/screen.h>
 #include <nanogui/opengl.h>
 #include "nanogui_resources.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 
 NAMESPACE_BEGIN(nanogui)
 
+extern std::map<GLFWwindow *, Screen *> __nanogui_screens;
+
+/**
+ * Request a redraw of the screen owning \c window from any thread. The
+ * screen is looked up on the main thread, which is safe even if it was
+ * destroyed in the meantime.
+ */
+static void redraw_window_async(GLFWwindow *window) {
+    async([window]() {
+        auto it = __nanogui_screens.find(window);
+        if (it != __nanogui_screens.end())
+            it->second->redraw();
+    });
+}
+
+/// Let the frames of a streaming image trigger redraws of the given screen
+static void set_stream_screen(StreamingTexture *stream, Screen *screen) {
+    GLFWwindow *window = screen->glfw_window();
+    stream->set_frame_callback([window]() { redraw_window_async(window); });
+}
+
 ImageView::ImageView(Widget *parent) : Canvas(parent, 1, false, false, false) {
     render_pass()->set_clear_color(0, Color(0.3f, 0.3f, 0.32f, 1.f));
 
+    init_shader();
+    m_render_pass->set_cull_mode(RenderPass::CullMode::Disabled);
+
+    m_image_border_color = m_theme->m_border_dark;
+    m_draw_image_border = true;
+    m_image_background_color = Color(0.f, 0.f, 0.f, 0.f);
+}
+
+void ImageView::init_shader() {
     m_image_shader = new Shader(
         render_pass(),
         /* An identifying name */
@@ -38,19 +75,211 @@ ImageView::ImageView(Widget *parent) : Canvas(parent, 1, false, false, false) {
 
     m_image_shader->set_buffer("position", VariableType::Float32, { 6, 2 },
                                positions);
-    m_render_pass->set_cull_mode(RenderPass::CullMode::Disabled);
 
-    m_image_border_color = m_theme->m_border_dark;
-    m_draw_image_border = true;
-    m_image_background_color = Color(0.f, 0.f, 0.f, 0.f);
+    /* Tiled images issue one draw call per tile, avoid repeated name lookups */
+    m_image_binding             = m_image_shader->binding("image");
+    m_matrix_image_binding      = m_image_shader->binding("matrix_image");
+    m_matrix_background_binding = m_image_shader->binding("matrix_background");
+}
+
+void ImageView::render_pass_changed() {
+    /* The texture binding is refreshed by draw_quad() */
+    init_shader();
+}
+
+/// State shared between the widget and the threads that decode tiles
+struct ImageView::TileLoader {
+    ref<TiledImageSource> source;
+    /// Window of the screen that draws the tiles (set once they are first drawn)
+    GLFWwindow *window = nullptr;
+    std::mutex mutex;
+    std::condition_variable cv;
+    /// Tiles that should be decoded (most important first)
+    std::deque<uint64_t> queue;
+    /// Tiles that are currently being decoded
+    std::unordered_set<uint64_t> busy;
+    /// Tiles that could not be loaded (never requested again)
+    std::unordered_set<uint64_t> failed;
+    /// Decoded tiles awaiting upload on the main thread
+    std::vector<std::pair<uint64_t, std::vector<uint8_t>>> done;
+    std::vector<std::thread> workers;
+    bool stop = false;
+
+    void run();
+};
+
+static uint64_t tile_key(int level, const Vector2i &tile) {
+    return ((uint64_t) level << 56) | ((uint64_t) tile.y() << 28) | (uint64_t) tile.x();
+}
+
+static int tile_level(uint64_t key) { return (int) (key >> 56); }
+
+static Vector2i tile_index(uint64_t key) {
+    return Vector2i((int) (key & 0xFFFFFFF), (int) ((key >> 28) & 0xFFFFFFF));
+}
+
+/// Return the pixel size of a tile (smaller than the tile size along the boundary)
+static Vector2i tile_extent(const TiledImageSource *source, int level, const Vector2i &tile) {
+    int tile_size = source->tile_size();
+    return min(source->level_size(level) - tile * tile_size, Vector2i(tile_size));
+}
+
+static size_t tile_bytes_per_pixel(const TiledImageSource *source) {
+    size_t channels = 0;
+    switch (source->pixel_format()) {
+        case Texture::PixelFormat::R:    channels = 1; break;
+        case Texture::PixelFormat::RA:   channels = 2; break;
+        case Texture::PixelFormat::RGB:
+        case Texture::PixelFormat::BGR:  channels = 3; break;
+        case Texture::PixelFormat::RGBA:
+        case Texture::PixelFormat::BGRA: channels = 4; break;
+        default:
+            throw std::runtime_error("TiledImageSource: unsupported pixel format!");
+    }
+    return channels * type_size((VariableType) source->component_format());
+}
+
+void ImageView::TileLoader::run() {
+    size_t bytes_per_pixel = tile_bytes_per_pixel(source);
+
+    while (true) {
+        uint64_t key;
+        /* Fetch the next request */ {
+            std::unique_lock<std::mutex> guard(mutex);
+            cv.wait(guard, [&] { return stop || !queue.empty(); });
+            if (stop)
+                return;
+            key = queue.front();
+            queue.pop_front();
+            busy.insert(key);
+        }
+
+        int level = tile_level(key);
+        Vector2i tile = tile_index(key),
+                 size = tile_extent(source, level, tile);
+
+        std::vector<uint8_t> data((size_t) size.x() * (size_t) size.y() * bytes_per_pixel);
+        bool success = false;
+        try {
+            success = source->load_tile(level, tile, size, data.data());
+        } catch (const std::exception &e) {
+            fprintf(stderr, "ImageView: could not load tile: %s\n", e.what());
+        }
+
+        GLFWwindow *target;
+        /* Hand the result to the main thread */ {
+            std::lock_guard<std::mutex> guard(mutex);
+            busy.erase(key);
+            if (success)
+                done.emplace_back(key, std::move(data));
+            else
+                failed.insert(key);
+            target = window;
+        }
+
+        if (success && target)
+            redraw_window_async(target);
+    }
+}
+
+int TiledImageSource::level_count() const {
+    Vector2i s = size();
+    int levels = 1, tile = tile_size();
+    while (s.x() > tile || s.y() > tile) {
+        s = (s + 1) / 2;
+        levels++;
+    }
+    return levels;
+}
+
+Vector2i TiledImageSource::level_size(int level) const {
+    Vector2i s = size();
+    for (int i = 0; i < level; ++i)
+        s = (s + 1) / 2;
+    return s;
+}
+
+ImageView::~ImageView() {
+    release_tiles();
+    release_stream();
 }
 
 void ImageView::set_image(Texture *image) {
     if (image->mag_interpolation_mode() != Texture::InterpolationMode::Nearest)
         throw std::runtime_error(
             "ImageView::set_image(): interpolation mode must be set to 'Nearest'!");
+    release_tiles();
+    release_stream();
     m_image_shader->set_texture("image", image);
     m_image = image;
+    invalidate_pixel_info();
+}
+
+void ImageView::set_image(StreamingTexture *image) {
+    set_image(image->texture());
+    m_stream = image;
+
+    /* Otherwise deferred until the image is drawn */
+    m_stream_screen = screen() != nullptr;
+    if (m_stream_screen)
+        set_stream_screen(image, screen());
+}
+
+void ImageView::release_stream() {
+    if (m_stream) {
+        m_stream->set_frame_callback(std::function<void()>());
+        m_stream = nullptr;
+    }
+}
+
+void ImageView::set_tiled_image(TiledImageSource *source, size_t cache_size) {
+    release_tiles();
+    release_stream();
+    m_image = nullptr;
+    m_tile_source = source;
+    m_tile_cache_size = std::max(cache_size, (size_t) 1);
+    invalidate_pixel_info();
+
+    if (!source)
+        return;
+
+    if (source->level_count() > 255 || source->size().x() <= 0 || source->size().y() <= 0 ||
+        (source->size().x() - 1) / source->tile_size() >= (1 << 28) ||
+        (source->size().y() - 1) / source->tile_size() >= (1 << 28))
+        throw std::runtime_error("ImageView::set_tiled_image(): unsupported image dimensions!");
+
+    m_tile_loader = std::make_unique<TileLoader>();
+    m_tile_loader->source = source;
+
+    unsigned int worker_count =
+        std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+    for (unsigned int i = 0; i < worker_count; ++i)
+        m_tile_loader->workers.emplace_back([loader = m_tile_loader.get()] { loader->run(); });
+}
+
+void ImageView::release_tiles() {
+    if (m_tile_loader) {
+        /* Ask the workers to finish (this waits for tiles that are being decoded) */ {
+            std::lock_guard<std::mutex> guard(m_tile_loader->mutex);
+            m_tile_loader->stop = true;
+        }
+        m_tile_loader->cv.notify_all();
+        for (auto &worker : m_tile_loader->workers)
+            worker.join();
+        m_tile_loader.reset();
+    }
+    m_tile_map.clear();
+    m_tile_lru.clear();
+    m_tile_source = nullptr;
+}
+
+Vector2i ImageView::image_size() const {
+    if (m_image)
+        return m_image->size();
+    else if (m_tile_source)
+        return m_tile_source->size();
+    else
+        return Vector2i(0);
 }
 
 float ImageView::scale() const {
@@ -62,9 +291,9 @@ void ImageView::set_scale(float scale) {
 }
 
 void ImageView::center() {
-    if (!m_image)
+    if (!has_image())
         return;
-    m_offset = Vector2i(.5f * (Vector2f(m_size) * screen()->pixel_ratio() - Vector2f(m_image->size()) * scale()));
+    m_offset = Vector2i(.5f * (Vector2f(m_size) * screen()->pixel_ratio() - Vector2f(image_size()) * scale()));
 }
 
 void ImageView::reset() {
@@ -87,7 +316,7 @@ Vector2f ImageView::pixel_to_pos(const Vector2f &p) const {
 }
 
 bool ImageView::keyboard_event(int key, int /* scancode */, int action, int /* modifiers */) {
-    if (!m_enabled || !m_image)
+    if (!m_enabled || !has_image())
         return false;
 
     if (action == GLFW_PRESS) {
@@ -101,7 +330,7 @@ bool ImageView::keyboard_event(int key, int /* scancode */, int action, int /* m
 
 bool ImageView::mouse_drag_event(const Vector2i & /* p */, const Vector2i &rel,
                                  int /* button */, int /* modifiers */) {
-    if (!m_enabled || !m_image)
+    if (!m_enabled || !has_image())
         return false;
 
     m_offset += rel * screen()->pixel_ratio();
@@ -110,7 +339,7 @@ bool ImageView::mouse_drag_event(const Vector2i & /* p */, const Vector2i &rel,
 }
 
 bool ImageView::scroll_event(const Vector2i &p, const Vector2f &rel) {
-    if (!m_enabled || !m_image)
+    if (!m_enabled || !has_image())
         return false;
 
     Vector2f p1 = pos_to_pixel(p - m_pos);
@@ -118,8 +347,8 @@ bool ImageView::scroll_event(const Vector2i &p, const Vector2f &rel) {
 
     // Restrict scaling to a reasonable range
     m_scale = std::max(
-        m_scale, std::min(0.f, std::log2(40.f / std::max(m_image->size().x(),
-                                                         m_image->size().y())) * 5.f));
+        m_scale, std::min(0.f, std::log2(40.f / std::max(image_size().x(),
+                                                         image_size().y())) * 5.f));
     m_scale = std::min(m_scale, 45.f);
 
     Vector2f p2 = pos_to_pixel(p - m_pos);
@@ -128,13 +357,13 @@ bool ImageView::scroll_event(const Vector2i &p, const Vector2f &rel) {
 }
 
 void ImageView::draw(NVGcontext *ctx) {
-    if (!m_enabled || !m_image)
+    if (!m_enabled || !has_image())
         return;
 
     Canvas::draw(ctx);
 
     Vector2i top_left = Vector2i(pixel_to_pos(Vector2f(0.f, 0.f))),
-             size     = Vector2i(pixel_to_pos(Vector2f(m_image->size())) - Vector2f(top_left));
+             size     = Vector2i(pixel_to_pos(Vector2f(image_size())) - Vector2f(top_left));
 
     if (m_draw_image_border) {
         nvgBeginPath(ctx);
@@ -149,7 +378,7 @@ void ImageView::draw(NVGcontext *ctx) {
     nvgSave(ctx);
     nvgIntersectScissor(ctx, m_pos.x(), m_pos.y(), m_size.x(), m_size.y());
 
-    if (scale() > 100 && m_pixel_callback) {
+    if (scale() > 100 && (m_pixel_callback || m_batch_pixel_callback)) {
         float font_size = scale() / 10.f;
         float alpha = std::min(1.f, (scale() - 100) / 100.f);
         nvgFontSize(ctx, font_size);
@@ -157,50 +386,92 @@ void ImageView::draw(NVGcontext *ctx) {
         nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
 
         Vector2i start = max(Vector2i(0), Vector2i(pos_to_pixel(Vector2f(0.f, 0.f))) - 1),
-                 end   = min(Vector2i(pos_to_pixel(Vector2f(m_size))) + 1, m_image->size() - 1);
+                 end   = min(Vector2i(pos_to_pixel(Vector2f(m_size))) + 1, image_size() - 1);
 
-        char text_buf[80],
-            *text[4] = { text_buf, text_buf + 20, text_buf + 40, text_buf + 60 };
+        update_pixel_info(start, max(end - start + 1, Vector2i(0)));
 
-        for (int y = start.y(); y <= end.y(); ++y) {
-            for (int x = start.x(); x <= end.x(); ++x) {
-                Vector2i pos = Vector2i(pixel_to_pos(Vector2f(x + .5f, y + .5f)));
-
-                m_pixel_callback(Vector2i(x, y), text, 20);
-
-                for (int ch = 0; ch < 4; ++ch) {
-                    Color col(0.f, 0.f, 0.f, alpha);
-                    nvgFillColor(ctx, col);
-                    nvgFontBlur(ctx, 2);
-                    float xpos = m_pos.x() + pos.x(),
-                          ypos = m_pos.y() + pos.y() + (ch - 1.5f) * font_size;
-                    nvgText(ctx, xpos, ypos, text[ch], nullptr);
+        /* Two passes (blurred shadow, then colored text), each of which sets
+           the NanoVG state once per channel rather than once per string */
+        for (int pass = 0; pass < 2; ++pass) {
+            nvgFontBlur(ctx, pass == 0 ? 2.f : 0.f);
+            for (int ch = 0; ch < 4; ++ch) {
+                Color col(0.f, 0.f, 0.f, alpha);
+                if (pass == 1) {
                     col = Color(0.3f, 0.3f, 0.3f, alpha);
                     if (ch == 3)
                         col[0] = col[1] = col[2] = 1.f;
                     else
                         col[ch] = 1.f;
-                    nvgFillColor(ctx, col);
-                    nvgFontBlur(ctx, 0);
-                    nvgText(ctx, xpos, ypos, text[ch], nullptr);
+                }
+                nvgFillColor(ctx, col);
+
+                char **text = m_pixel_info_text.data() + ch;
+                for (int y = start.y(); y <= end.y(); ++y) {
+                    for (int x = start.x(); x <= end.x(); ++x) {
+                        Vector2i pos = Vector2i(pixel_to_pos(Vector2f(x + .5f, y + .5f)));
+                        float xpos = m_pos.x() + pos.x(),
+                              ypos = m_pos.y() + pos.y() + (ch - 1.5f) * font_size;
+                        nvgText(ctx, xpos, ypos, *text, nullptr);
+                        text += 4;
+                    }
                 }
             }
         }
+        nvgFontBlur(ctx, 0.f);
     }
 
     nvgRestore(ctx);
 }
 
+void ImageView::update_pixel_info(const Vector2i &start, const Vector2i &size) {
+    if (start == m_pixel_info_start && size == m_pixel_info_size)
+        return;
+
+    const size_t text_size = 20;
+    size_t count = (size_t) size.x() * (size_t) size.y() * 4;
+    m_pixel_info.resize(count * text_size);
+    m_pixel_info_text.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_pixel_info_text[i] = m_pixel_info.data() + i * text_size;
+        m_pixel_info_text[i][0] = '\0';
+    }
+
+    if (m_batch_pixel_callback) {
+        m_batch_pixel_callback(start, size, m_pixel_info_text.data(), text_size);
+    } else {
+        char **text = m_pixel_info_text.data();
+        for (int y = 0; y < size.y(); ++y) {
+            for (int x = 0; x < size.x(); ++x) {
+                m_pixel_callback(start + Vector2i(x, y), text, text_size);
+                text += 4;
+            }
+        }
+    }
+
+    m_pixel_info_start = start;
+    m_pixel_info_size = size;
+}
+
 void ImageView::draw_contents() {
-    if (!m_image)
+    if (!has_image())
         return;
 
+    if (m_stream && !m_stream_screen) {
+        set_stream_screen(m_stream, screen());
+        m_stream_screen = true;
+    }
+
+    if (m_stream && m_stream->update()) {
+        m_image = m_stream->texture();
+        invalidate_pixel_info();
+    }
+
     /* Ensure that 'offset' is a multiple of the pixel ratio */
     float pixel_ratio = screen()->pixel_ratio();
     m_offset = Vector2i(Vector2i(m_offset / pixel_ratio) * pixel_ratio);
 
     Vector2f bound1 = m_size * pixel_ratio,
-             bound2 = -Vector2f(m_image->size()) * scale();
+             bound2 = -Vector2f(image_size()) * scale();
 
     if ((m_offset.x() >= bound1.x()) != (m_offset.x() < bound2.x()))
         m_offset.x() = std::max(std::min(m_offset.x(), bound1.x()), bound2.x());
@@ -209,25 +480,164 @@ void ImageView::draw_contents() {
 
     Vector2i viewport_size = render_pass()->viewport().second;
 
+    m_image_shader->set_uniform("background_color", m_image_background_color);
+
+    if (m_tile_source)
+        draw_tiles(viewport_size);
+    else
+        draw_quad(m_image, Vector2f(0.f), Vector2f(m_image->size()), viewport_size);
+}
+
+void ImageView::draw_quad(Texture *texture, const Vector2f &origin, const Vector2f &extent,
+                          const Vector2i &viewport_size) {
     float scale = std::pow(2.f, m_scale / 5.f);
 
     Matrix4f matrix_background =
-        Matrix4f::scale(Vector3f(m_image->size().x() * scale / 20.f,
-                                 m_image->size().y() * scale / 20.f, 1.f));
+        Matrix4f::translate(Vector3f(origin.x() * scale / 20.f,
+                                     origin.y() * scale / 20.f, 0.f)) *
+        Matrix4f::scale(Vector3f(extent.x() * scale / 20.f,
+                                 extent.y() * scale / 20.f, 1.f));
 
     Matrix4f matrix_image =
         Matrix4f::ortho(0.f, viewport_size.x(), viewport_size.y(), 0.f, -1.f, 1.f) *
-        Matrix4f::translate(Vector3f(m_offset.x(), (int) m_offset.y(), 0.f)) *
-        Matrix4f::scale(Vector3f(m_image->size().x() * scale,
-                                 m_image->size().y() * scale, 1.f));
+        Matrix4f::translate(Vector3f(m_offset.x() + origin.x() * scale,
+                                     (int) m_offset.y() + origin.y() * scale, 0.f)) *
+        Matrix4f::scale(Vector3f(extent.x() * scale,
+                                 extent.y() * scale, 1.f));
 
-    m_image_shader->set_uniform("matrix_image",      Matrix4f(matrix_image));
-    m_image_shader->set_uniform("matrix_background", Matrix4f(matrix_background));
-    m_image_shader->set_uniform("background_color",  m_image_background_color);
+    m_image_shader->set_texture(m_image_binding, texture);
+    m_image_shader->set_uniform(m_matrix_image_binding,      Matrix4f(matrix_image));
+    m_image_shader->set_uniform(m_matrix_background_binding, Matrix4f(matrix_background));
 
     m_image_shader->begin();
     m_image_shader->draw_array(Shader::PrimitiveType::Triangle, 0, 6, false);
     m_image_shader->end();
 }
 
+void ImageView::draw_tiles(const Vector2i &viewport_size) {
+    TiledImageSource *source = m_tile_source;
+    TileLoader *loader = m_tile_loader.get();
+    int tile_size = source->tile_size(),
+        level_count = source->level_count();
+
+    /* Upload tiles that were decoded since the last frame */
+    std::vector<std::pair<uint64_t, std::vector<uint8_t>>> done;
+    {
+        std::lock_guard<std::mutex> guard(loader->mutex);
+        done.swap(loader->done);
+        loader->window = screen()->glfw_window();
+    }
+
+    for (auto &[key, data] : done) {
+        if (m_tile_map.find(key) != m_tile_map.end())
+            continue;
+
+        Vector2i size = tile_extent(source, tile_level(key), tile_index(key));
+        ref<Texture> texture;
+
+        if (m_tile_lru.size() >= m_tile_cache_size) {
+            /* Recycle the least recently used tile */
+            texture = m_tile_lru.back().texture;
+            m_tile_map.erase(m_tile_lru.back().key);
+            m_tile_lru.pop_back();
+            if (texture->size() != size)
+                texture->resize(size);
+        } else {
+            texture = new Texture(
+                source->pixel_format(),
+                source->component_format(),
+                size,
+                Texture::InterpolationMode::Bilinear,
+                Texture::InterpolationMode::Nearest,
+                Texture::WrapMode::ClampToEdge
+            );
+
+            if (texture->pixel_format() != source->pixel_format() ||
+                texture->component_format() != source->component_format())
+                throw std::runtime_error(
+                    "ImageView::draw_tiles(): the tile format is not supported by the GPU!");
+        }
+
+        texture->upload(data.data());
+        m_tile_lru.push_front({ key, texture });
+        m_tile_map[key] = m_tile_lru.begin();
+    }
+
+    /* Select the LOD level matching the current magnification */
+    float scale = this->scale();
+    int level = (int) std::floor(std::log2(1.f / scale));
+    level = std::max(0, std::min(level, level_count - 1));
+
+    /* Determine the visible tiles */
+    Vector2f p0 = max(-m_offset / scale, Vector2f(0.f)),
+             p1 = min((Vector2f(viewport_size) - m_offset) / scale,
+                      Vector2f(source->size()));
+    if (p1.x() <= p0.x() || p1.y() <= p0.y())
+        return;
+
+    float extent = (float) tile_size * (float) (1 << level);
+    Vector2i tile_count = (source->level_size(level) + tile_size - 1) / tile_size,
+             t0 = Vector2i((int) (p0.x() / extent), (int) (p0.y() / extent)),
+             t1 = min(Vector2i((int) std::ceil(p1.x() / extent),
+                               (int) std::ceil(p1.y() / extent)), tile_count);
+    Vector2f center = (p0 + p1) * .5f;
+
+    std::vector<uint64_t> visible, fallback;
+    std::vector<std::pair<float, uint64_t>> missing;
+
+    for (int y = t0.y(); y < t1.y(); ++y) {
+        for (int x = t0.x(); x < t1.x(); ++x) {
+            uint64_t key = tile_key(level, Vector2i(x, y));
+            if (m_tile_map.find(key) != m_tile_map.end()) {
+                visible.push_back(key);
+                continue;
+            }
+
+            Vector2f d = (Vector2f((float) x, (float) y) + .5f) * extent - center;
+            missing.emplace_back(d.x() * d.x() + d.y() * d.y(), key);
+
+            /* Substitute the closest coarser tile that is available */
+            for (int l = level + 1; l < level_count; ++l) {
+                uint64_t parent = tile_key(l, Vector2i(x >> (l - level), y >> (l - level)));
+                if (m_tile_map.find(parent) != m_tile_map.end()) {
+                    if (std::find(fallback.begin(), fallback.end(), parent) == fallback.end())
+                        fallback.push_back(parent);
+                    break;
+                }
+            }
+        }
+    }
+
+    /* Request missing tiles, starting at the center of the view */
+    std::sort(missing.begin(), missing.end());
+    {
+        std::lock_guard<std::mutex> guard(loader->mutex);
+        loader->queue.clear();
+        for (const auto &[dist, key] : missing) {
+            (void) dist;
+            if (loader->busy.find(key) == loader->busy.end() &&
+                loader->failed.find(key) == loader->failed.end())
+                loader->queue.push_back(key);
+        }
+    }
+    if (!missing.empty())
+        loader->cv.notify_all();
+
+    /* Draw coarse substitutes first, and then the tiles of the current level */
+    std::sort(fallback.begin(), fallback.end(), std::greater<uint64_t>());
+    fallback.insert(fallback.end(), visible.begin(), visible.end());
+
+    for (uint64_t key : fallback) {
+        auto it = m_tile_map[key];
+        m_tile_lru.splice(m_tile_lru.begin(), m_tile_lru, it);
+
+        Texture *texture = it->texture;
+        float level_scale = (float) (1 << tile_level(key));
+        draw_quad(texture,
+                  Vector2f(tile_index(key) * tile_size) * level_scale,
+                  Vector2f(texture->size()) * level_scale,
+                  viewport_size);
+    }
+}
+
 NAMESPACE_END(nanogui)
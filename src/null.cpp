@@ -0,0 +1,207 @@
+/*
+    src/null.cpp -- Statistics and NanoVG recorder of the null backend
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/null.h>
+
+#if defined(NANOGUI_USE_NULL)
+
+#include <nanovg.h>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+NAMESPACE_BEGIN(nanogui)
+
+static NullStats stats;
+static std::atomic<uint32_t> next_handle { 1 };
+
+NullStats &null_stats() {
+    return stats;
+}
+
+void null_reset_counters() {
+    NullStats reset;
+    reset.textures = stats.textures;
+    reset.texture_bytes = stats.texture_bytes;
+    reset.shaders = stats.shaders;
+    reset.render_passes = stats.render_passes;
+    reset.buffer_bytes = stats.buffer_bytes;
+    reset.vertex_buffers = stats.vertex_buffers;
+    reset.vertex_buffer_bytes = stats.vertex_buffer_bytes;
+    reset.nvg_images = stats.nvg_images;
+    reset.nvg_image_bytes = stats.nvg_image_bytes;
+    stats = reset;
+}
+
+uint32_t null_new_handle() {
+    return next_handle++;
+}
+
+/// Images of a NanoVG context; their contents are not retained
+struct NullNVGContext {
+    struct Image {
+        int type, width, height, flags;
+        /// Does the image wrap a texture instead of owning storage?
+        bool external;
+    };
+
+    std::unordered_map<int, Image> images;
+    int next_image = 1;
+
+    int add_image(const Image &image) {
+        int id = next_image++;
+        images[id] = image;
+        stats.nvg_images++;
+        if (!image.external)
+            stats.nvg_image_bytes += image_bytes(image);
+        return id;
+    }
+
+    static size_t image_bytes(const Image &image) {
+        return (size_t) image.width * (size_t) image.height *
+               (image.type == NVG_TEXTURE_RGBA ? 4 : 1);
+    }
+};
+
+static int null_nvg_render_create(void *) {
+    return 1;
+}
+
+static int null_nvg_render_create_texture(void *uptr, int type, int w, int h,
+                                          int image_flags, const unsigned char *data) {
+    NullNVGContext *ctx = (NullNVGContext *) uptr;
+    NullNVGContext::Image image { type, w, h, image_flags, false };
+    if (data) {
+        stats.uploads++;
+        stats.upload_bytes += NullNVGContext::image_bytes(image);
+    }
+    return ctx->add_image(image);
+}
+
+static int null_nvg_render_delete_texture(void *uptr, int id) {
+    NullNVGContext *ctx = (NullNVGContext *) uptr;
+    auto it = ctx->images.find(id);
+    if (it == ctx->images.end())
+        return 0;
+    stats.nvg_images--;
+    if (!it->second.external)
+        stats.nvg_image_bytes -= NullNVGContext::image_bytes(it->second);
+    ctx->images.erase(it);
+    return 1;
+}
+
+static int null_nvg_render_update_texture(void *uptr, int id, int, int, int w, int h,
+                                          const unsigned char *) {
+    NullNVGContext *ctx = (NullNVGContext *) uptr;
+    auto it = ctx->images.find(id);
+    if (it == ctx->images.end())
+        return 0;
+    stats.uploads++;
+    stats.upload_bytes += (size_t) w * (size_t) h *
+                          (it->second.type == NVG_TEXTURE_RGBA ? 4 : 1);
+    return 1;
+}
+
+static int null_nvg_render_get_texture_size(void *uptr, int id, int *w, int *h) {
+    NullNVGContext *ctx = (NullNVGContext *) uptr;
+    auto it = ctx->images.find(id);
+    if (it == ctx->images.end())
+        return 0;
+    *w = it->second.width;
+    *h = it->second.height;
+    return 1;
+}
+
+static void null_nvg_render_viewport(void *, float, float, float) { }
+
+static void null_nvg_render_cancel(void *) { }
+
+static void null_nvg_render_flush(void *) {
+    stats.nvg_flushes++;
+}
+
+static void count_paths(const NVGpath *paths, int npaths) {
+    stats.nvg_paths += (size_t) npaths;
+    for (int i = 0; i < npaths; ++i)
+        stats.nvg_vertices += (size_t) (paths[i].nfill + paths[i].nstroke);
+}
+
+static void null_nvg_render_fill(void *, NVGpaint *, NVGcompositeOperationState,
+                                 NVGscissor *, float, const float *,
+                                 const NVGpath *paths, int npaths) {
+    stats.nvg_fills++;
+    count_paths(paths, npaths);
+}
+
+static void null_nvg_render_stroke(void *, NVGpaint *, NVGcompositeOperationState,
+                                   NVGscissor *, float, float,
+                                   const NVGpath *paths, int npaths) {
+    stats.nvg_strokes++;
+    count_paths(paths, npaths);
+}
+
+static void null_nvg_render_triangles(void *, NVGpaint *, NVGcompositeOperationState,
+                                      NVGscissor *, const NVGvertex *, int nverts,
+                                      float) {
+    stats.nvg_triangles++;
+    stats.nvg_vertices += (size_t) nverts;
+}
+
+static void null_nvg_render_delete(void *uptr) {
+    NullNVGContext *ctx = (NullNVGContext *) uptr;
+    for (auto &kv : ctx->images) {
+        stats.nvg_images--;
+        if (!kv.second.external)
+            stats.nvg_image_bytes -= NullNVGContext::image_bytes(kv.second);
+    }
+    delete ctx;
+}
+
+NVGcontext *null_nvg_create(int flags) {
+    NVGparams params;
+    memset(&params, 0, sizeof(params));
+    params.renderCreate = null_nvg_render_create;
+    params.renderCreateTexture = null_nvg_render_create_texture;
+    params.renderDeleteTexture = null_nvg_render_delete_texture;
+    params.renderUpdateTexture = null_nvg_render_update_texture;
+    params.renderGetTextureSize = null_nvg_render_get_texture_size;
+    params.renderViewport = null_nvg_render_viewport;
+    params.renderCancel = null_nvg_render_cancel;
+    params.renderFlush = null_nvg_render_flush;
+    params.renderFill = null_nvg_render_fill;
+    params.renderStroke = null_nvg_render_stroke;
+    params.renderTriangles = null_nvg_render_triangles;
+    params.renderDelete = null_nvg_render_delete;
+    params.userPtr = new NullNVGContext();
+    params.edgeAntiAlias = flags & NVG_ANTIALIAS ? 1 : 0;
+
+    /* nvgCreateInternal() releases the user pointer via renderDelete on failure */
+    return nvgCreateInternal(&params);
+}
+
+void null_nvg_delete(NVGcontext *ctx) {
+    nvgDeleteInternal(ctx);
+}
+
+int null_nvg_image_from_handle(NVGcontext *ctx, uint32_t texture_handle,
+                               const Vector2i &size, int flags) {
+    (void) texture_handle;
+    if (nvgInternalParams(ctx)->renderCreate != null_nvg_render_create)
+        throw std::runtime_error(
+            "null_nvg_image_from_handle(): not a context created by null_nvg_create()!");
+    NullNVGContext *nctx = (NullNVGContext *) nvgInternalParams(ctx)->userPtr;
+    return nctx->add_image({ NVG_TEXTURE_RGBA, size.x(), size.y(), flags, true });
+}
+
+NAMESPACE_END(nanogui)
+
+#endif
@@ -0,0 +1,469 @@
+/*
+    nanogui/plotcanvas.cpp -- GPU-accelerated widget for plotting large
+    time series
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/plotcanvas.h>
+#include <nanogui/renderpass.h>
+#include <nanogui/shader.h>
+#include <nanogui/screen.h>
+#include <nanogui/theme.h>
+#include <nanogui/opengl.h>
+#include "nanogui_resources.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+NAMESPACE_BEGIN(nanogui)
+
+/* Stop adding LOD levels once the coarsest one has fewer blocks than this */
+static const size_t PlotMinBlockCount = 256;
+
+PlotCanvas::PlotCanvas(Widget *parent, size_t channel_count, size_t capacity)
+    : Canvas(parent, 4, false, false, true) {
+    if (channel_count == 0 || capacity < 2)
+        throw std::runtime_error("PlotCanvas::PlotCanvas(): invalid channel count or capacity!");
+
+    m_size = Vector2i(400, 200);
+    render_pass()->set_clear_color(0, Color(0.1f, 0.1f, 0.12f, 1.f));
+    m_axis_color = m_theme->m_text_color;
+
+    /* Round the capacity up so that it is divisible by the coarsest block size */
+    size_t level_count = 1;
+    while ((capacity >> level_count) >= PlotMinBlockCount)
+        ++level_count;
+    size_t block_size = (size_t) 1 << (level_count - 1);
+    m_capacity = (capacity + block_size - 1) / block_size * block_size;
+
+    /* Level 0 stores one vertex per sample, level k >= 1 two per block */
+    m_level_offset.push_back(0);
+    m_channel_vertices = m_capacity;
+    for (size_t k = 1; k < level_count; ++k) {
+        m_level_offset.push_back(m_channel_vertices);
+        m_channel_vertices += 2 * (m_capacity >> k);
+    }
+
+    const Color palette[] = {
+        Color(255, 192,   0, 255), Color(  0, 176, 255, 255),
+        Color(255,  64,  96, 255), Color( 96, 220,  96, 255),
+        Color(200, 120, 255, 255), Color(255, 128,  32, 255),
+        Color( 64, 224, 208, 255), Color(240, 240, 240, 255)
+    };
+
+    m_channels.resize(channel_count);
+    for (size_t i = 0; i < channel_count; ++i) {
+        Channel &ch = m_channels[i];
+        ch.values.resize(m_capacity, 0.f);
+        ch.min_values.resize(level_count);
+        ch.max_values.resize(level_count);
+        for (size_t k = 1; k < level_count; ++k) {
+            ch.min_values[k].resize(m_capacity >> k, 0.f);
+            ch.max_values[k].resize(m_capacity >> k, 0.f);
+        }
+        ch.color = palette[i % (sizeof(palette) / sizeof(Color))];
+    }
+
+    init_shader();
+}
+
+void PlotCanvas::init_shader() {
+    m_shader = new Shader(
+        render_pass(),
+        "plot_canvas",
+        NANOGUI_SHADER(plotcanvas_vertex),
+        NANOGUI_SHADER(plotcanvas_fragment),
+        Shader::BlendMode::AlphaBlend
+    );
+
+    /* Allocate GPU storage for all channels and LOD levels. Only the vertices
+       of valid samples are ever drawn, hence zero-initialization suffices. */
+    std::vector<float> positions(m_channels.size() * m_channel_vertices * 2, 0.f);
+    m_shader->set_buffer("position", VariableType::Float32,
+                         { m_channels.size() * m_channel_vertices, 2 },
+                         positions.data());
+}
+
+void PlotCanvas::render_pass_changed() {
+    init_shader();
+    for (Channel &ch : m_channels)
+        if (ch.size > 0)
+            mark_dirty(ch, 0, ch.size);
+}
+
+size_t PlotCanvas::size(size_t channel) const {
+    if (channel >= m_channels.size())
+        throw std::runtime_error("PlotCanvas::size(): channel index out of bounds!");
+    return m_channels[channel].size;
+}
+
+size_t PlotCanvas::total(size_t channel) const {
+    if (channel >= m_channels.size())
+        throw std::runtime_error("PlotCanvas::total(): channel index out of bounds!");
+    return m_channels[channel].total;
+}
+
+const Color &PlotCanvas::channel_color(size_t channel) const {
+    if (channel >= m_channels.size())
+        throw std::runtime_error("PlotCanvas::channel_color(): channel index out of bounds!");
+    return m_channels[channel].color;
+}
+
+void PlotCanvas::set_channel_color(size_t channel, const Color &color) {
+    if (channel >= m_channels.size())
+        throw std::runtime_error("PlotCanvas::set_channel_color(): channel index out of bounds!");
+    m_channels[channel].color = color;
+}
+
+void PlotCanvas::set_x_range(double x_min, double x_max) {
+    m_x_min = x_min;
+    m_x_max = x_max;
+    m_follow = false;
+}
+
+void PlotCanvas::push(size_t channel, const float *values, size_t count) {
+    if (channel >= m_channels.size())
+        throw std::runtime_error("PlotCanvas::push(): channel index out of bounds!");
+
+    Channel &ch = m_channels[channel];
+    ch.total += count;
+
+    /* Only the most recent 'm_capacity' samples survive */
+    if (count > m_capacity) {
+        values += count - m_capacity;
+        count = m_capacity;
+    }
+
+    while (count > 0) {
+        size_t chunk = std::min(count, m_capacity - ch.head);
+        memcpy(ch.values.data() + ch.head, values, chunk * sizeof(float));
+        mark_dirty(ch, ch.head, ch.head + chunk);
+        ch.head = (ch.head + chunk) % m_capacity;
+        ch.size = std::min(ch.size + chunk, m_capacity);
+        values += chunk;
+        count -= chunk;
+    }
+}
+
+void PlotCanvas::clear() {
+    for (Channel &ch : m_channels) {
+        ch.dirty.clear();
+        ch.head = ch.size = ch.total = 0;
+    }
+}
+
+void PlotCanvas::mark_dirty(Channel &ch, size_t begin, size_t end) {
+    for (auto &range : ch.dirty) {
+        if (begin <= range.second && end >= range.first) {
+            range.first  = std::min(range.first, begin);
+            range.second = std::max(range.second, end);
+            return;
+        }
+    }
+
+    ch.dirty.emplace_back(begin, end);
+
+    /* Avoid excessive numbers of tiny uploads */
+    if (ch.dirty.size() > 8) {
+        std::pair<size_t, size_t> hull = ch.dirty[0];
+        for (const auto &range : ch.dirty) {
+            hull.first  = std::min(hull.first, range.first);
+            hull.second = std::max(hull.second, range.second);
+        }
+        ch.dirty.assign(1, hull);
+    }
+}
+
+void PlotCanvas::update_range(size_t index, size_t begin, size_t end) {
+    Channel &ch = m_channels[index];
+    size_t base = index * m_channel_vertices;
+
+    /* Level 0: one vertex per sample */
+    m_staging.resize(2 * (end - begin));
+    float *out = m_staging.data();
+    for (size_t i = begin; i < end; ++i) {
+        *out++ = (float) i;
+        *out++ = ch.values[i];
+    }
+    m_shader->set_buffer_range("position", base + begin, end - begin,
+                               m_staging.data());
+
+    /* Level k >= 1: min/max envelope of blocks of 2^k samples, computed from
+       pairs of blocks of the next finer level. Slots beyond 'ch.size' are
+       only unused while the ring buffer has not wrapped around yet. Once it
+       has, the block containing 'ch.head' holds the newest samples (before
+       the head) and the oldest ones (from the head on). Its envelope only
+       covers the newest samples, and draw_contents() never draws it. */
+    size_t head = ch.size < m_capacity ? 0 : ch.head;
+    for (size_t k = 1; k < m_level_offset.size(); ++k) {
+        const std::vector<float> &child_min = k == 1 ? ch.values : ch.min_values[k - 1],
+                                 &child_max = k == 1 ? ch.values : ch.max_values[k - 1];
+        size_t child_size = (size_t) 1 << (k - 1),
+               block_begin = begin >> k,
+               block_end = ((end - 1) >> k) + 1;
+        float block_size = (float) ((size_t) 1 << k);
+
+        m_staging.resize(4 * (block_end - block_begin));
+        out = m_staging.data();
+
+        for (size_t b = block_begin; b < block_end; ++b) {
+            size_t c0 = 2 * b, c1 = 2 * b + 1;
+            float min_value = child_min[c0], max_value = child_max[c0];
+            bool rising = true;
+
+            if (c1 * child_size < ch.size &&
+                !(c0 * child_size < head && head <= c1 * child_size)) {
+                float min_value_1 = child_min[c1], max_value_1 = child_max[c1];
+                rising = min_value + max_value <= min_value_1 + max_value_1;
+                min_value = std::min(min_value, min_value_1);
+                max_value = std::max(max_value, max_value_1);
+            }
+
+            ch.min_values[k][b] = min_value;
+            ch.max_values[k][b] = max_value;
+
+            /* Emit the envelope in the order that follows the local trend */
+            float x = b * block_size;
+            *out++ = x + .25f * block_size;
+            *out++ = rising ? min_value : max_value;
+            *out++ = x + .75f * block_size;
+            *out++ = rising ? max_value : min_value;
+        }
+
+        m_shader->set_buffer_range("position",
+                                   base + m_level_offset[k] + 2 * block_begin,
+                                   2 * (block_end - block_begin),
+                                   m_staging.data());
+    }
+}
+
+bool PlotCanvas::mouse_drag_event(const Vector2i & /* p */, const Vector2i &rel,
+                                  int /* button */, int /* modifiers */) {
+    if (!m_enabled)
+        return false;
+
+    double dx = rel.x() * (m_x_max - m_x_min) / std::max(m_size.x(), 1);
+    float dy = rel.y() * (m_y_range.y() - m_y_range.x()) / std::max(m_size.y(), 1);
+
+    m_x_min -= dx;
+    m_x_max -= dx;
+    m_y_range += Vector2f(dy);
+
+    if (rel.x() != 0)
+        m_follow = false;
+
+    return true;
+}
+
+bool PlotCanvas::scroll_event(const Vector2i &p, const Vector2f &rel) {
+    if (!m_enabled)
+        return false;
+
+    double span = m_x_max - m_x_min,
+           new_span = span * std::pow(1.1, -rel.y());
+    new_span = std::max(std::min(new_span, (double) m_capacity), 2.0);
+
+    /* Zoom around the cursor, or around the newest sample when following */
+    double anchor = m_follow ? 1.0 : (double) (p.x() - m_pos.x()) / std::max(m_size.x(), 1),
+           x = m_x_min + anchor * span;
+
+    m_x_min = x - anchor * new_span;
+    m_x_max = m_x_min + new_span;
+    return true;
+}
+
+void PlotCanvas::draw_contents() {
+    /* Upload samples that were pushed since the last frame */
+    for (size_t i = 0; i < m_channels.size(); ++i) {
+        Channel &ch = m_channels[i];
+        for (const auto &range : ch.dirty)
+            update_range(i, range.first, range.second);
+        ch.dirty.clear();
+    }
+
+    double span = m_x_max - m_x_min;
+    float y_span = m_y_range.y() - m_y_range.x();
+    if (!(span > 0) || !(y_span > 0))
+        return;
+
+    /* Pick the coarsest LOD level that has at most 2 vertices per pixel */
+    double pixels = std::max(render_pass()->viewport().second.x(), 1);
+    size_t level = 0;
+    while (level + 1 < m_level_offset.size() &&
+           span / (double) ((size_t) 1 << level) > pixels)
+        ++level;
+
+    float sx = (float) (2.0 / span),
+          sy = 2.f / y_span,
+          ty = -1.f - m_y_range.x() * sy;
+
+    m_shader->set_uniform("capacity", (float) m_capacity);
+
+    for (size_t i = 0; i < m_channels.size(); ++i) {
+        const Channel &ch = m_channels[i];
+        if (ch.size < 2)
+            continue;
+
+        size_t oldest = ch.total - ch.size,
+               origin = ch.size < m_capacity ? 0 : ch.head;
+
+        /* Visible samples relative to the oldest one (with a one sample margin) */
+        double rel_begin = std::floor(m_x_min - (double) oldest) - 1.0,
+               rel_end   = std::ceil(m_x_max - (double) oldest) + 2.0;
+        rel_begin = std::max(std::min(rel_begin, (double) ch.size), 0.0);
+        rel_end   = std::max(std::min(rel_end,   (double) ch.size), 0.0);
+        if (rel_end - rel_begin < 2)
+            continue;
+
+        float tx = (float) (((double) oldest - m_x_min) * (2.0 / span) - 1.0);
+        m_shader->set_uniform("origin", (float) origin);
+        m_shader->set_uniform("transform", Vector4f(sx, tx, sy, ty));
+        m_shader->set_uniform("color", ch.color);
+        m_shader->begin();
+
+        /* The visible range covers at most two contiguous runs of slots */
+        size_t slot  = (origin + (size_t) rel_begin) % m_capacity,
+               count = (size_t) rel_end - (size_t) rel_begin;
+        std::pair<size_t, size_t> runs[2] = {
+            { slot, std::min(slot + count, m_capacity) },
+            { 0, slot + count > m_capacity ? slot + count - m_capacity : 0 }
+        };
+
+        auto draw_strip = [&](size_t lod, size_t first, size_t last) {
+            if (last >= first + 2)
+                m_shader->draw_array(Shader::PrimitiveType::LineStrip,
+                                     i * m_channel_vertices + m_level_offset[lod] + first,
+                                     last - first);
+        };
+
+        for (const auto &[begin, end] : runs) {
+            if (end <= begin)
+                continue;
+
+            if (level == 0) {
+                draw_strip(0, begin, end);
+                continue;
+            }
+
+            size_t block_size  = (size_t) 1 << level,
+                   block_begin = begin >> level,
+                   block_end   = ((end - 1) >> level) + 1,
+                   straddle    = origin >> level;
+
+            /* Unless 'origin' is aligned, its block mixes the newest and the
+               oldest samples. Draw the part of it that belongs to this run at
+               full resolution instead (extended by one sample to connect to
+               the adjacent block). */
+            if (origin % block_size != 0 && straddle >= block_begin && straddle < block_end) {
+                if (begin >= origin) {
+                    /* The run of the oldest samples starts in this block */
+                    draw_strip(0, begin, std::min(end, (straddle + 1) * block_size + 1));
+                    block_begin = straddle + 1;
+                } else {
+                    /* The run of the newest samples ends in this block */
+                    draw_strip(0, std::max(begin + 1, straddle * block_size) - 1, end);
+                    block_end = straddle;
+                }
+            }
+
+            if (block_end > block_begin)
+                draw_strip(level, 2 * block_begin, 2 * block_end);
+        }
+
+        m_shader->end();
+    }
+}
+
+/// Compute a 1/2/5-style spacing that yields at most 'max_ticks' ticks over 'span'
+static double tick_spacing(double span, int max_ticks) {
+    double raw = span / std::max(max_ticks, 1),
+           magnitude = std::pow(10.0, std::floor(std::log10(raw))),
+           normalized = raw / magnitude;
+
+    if (normalized <= 1.0)
+        return magnitude;
+    else if (normalized <= 2.0)
+        return 2.0 * magnitude;
+    else if (normalized <= 5.0)
+        return 5.0 * magnitude;
+    else
+        return 10.0 * magnitude;
+}
+
+void PlotCanvas::draw_axes(NVGcontext *ctx) {
+    double x_span = m_x_max - m_x_min,
+           y_span = m_y_range.y() - m_y_range.x();
+    if (!(x_span > 0) || !(y_span > 0))
+        return;
+
+    double x_step = tick_spacing(x_span, std::max(m_size.x() / 80, 2)),
+           y_step = tick_spacing(y_span, std::max(m_size.y() / 40, 2));
+    double x_first = std::ceil(m_x_min / x_step),
+           y_first = std::ceil(m_y_range.x() / y_step);
+    int x_count = (int) std::min(std::floor(m_x_max / x_step) - x_first + 1, 100.0),
+        y_count = (int) std::min(std::floor(m_y_range.y() / y_step) - y_first + 1, 100.0);
+
+    auto map_x = [&](double x) { return m_pos.x() + (float) ((x - m_x_min) / x_span * m_size.x()); };
+    auto map_y = [&](double y) { return m_pos.y() + m_size.y() - (float) ((y - m_y_range.x()) / y_span * m_size.y()); };
+
+    nvgSave(ctx);
+    nvgIntersectScissor(ctx, m_pos.x(), m_pos.y(), m_size.x(), m_size.y());
+
+    nvgBeginPath(ctx);
+    for (int i = 0; i < x_count; ++i) {
+        float px = map_x((x_first + i) * x_step);
+        nvgMoveTo(ctx, px, m_pos.y() + m_size.y());
+        nvgLineTo(ctx, px, m_pos.y() + m_size.y() - 5.f);
+    }
+    for (int i = 0; i < y_count; ++i) {
+        float py = map_y((y_first + i) * y_step);
+        nvgMoveTo(ctx, m_pos.x(), py);
+        nvgLineTo(ctx, m_pos.x() + 5.f, py);
+    }
+    nvgStrokeWidth(ctx, 1.f);
+    nvgStrokeColor(ctx, m_axis_color);
+    nvgStroke(ctx);
+
+    char buf[32];
+    nvgFontFace(ctx, "sans");
+    nvgFontSize(ctx, 12.f);
+    nvgFillColor(ctx, m_axis_color);
+
+    nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_BOTTOM);
+    for (int i = 0; i < x_count; ++i) {
+        double x = (x_first + i) * x_step;
+        snprintf(buf, sizeof(buf), "%g", x);
+        nvgText(ctx, map_x(x), m_pos.y() + m_size.y() - 6.f, buf, nullptr);
+    }
+
+    nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+    for (int i = 0; i < y_count; ++i) {
+        double y = (y_first + i) * y_step;
+        snprintf(buf, sizeof(buf), "%g", y);
+        nvgText(ctx, m_pos.x() + 7.f, map_y(y), buf, nullptr);
+    }
+
+    nvgRestore(ctx);
+}
+
+void PlotCanvas::draw(NVGcontext *ctx) {
+    if (m_follow) {
+        size_t newest = 0;
+        for (const Channel &ch : m_channels)
+            newest = std::max(newest, ch.total);
+        double span = m_x_max - m_x_min;
+        m_x_max = (double) newest;
+        m_x_min = m_x_max - span;
+    }
+
+    Canvas::draw(ctx);
+    draw_axes(ctx);
+}
+
+NAMESPACE_END(nanogui)
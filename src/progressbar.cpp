@@ -22,6 +22,9 @@ Vector2i ProgressBar::preferred_size(NVGcontext *) const {
 }
 
 void ProgressBar::draw(NVGcontext* ctx) {
+    if (m_published_value.update())
+        m_value = m_published_value.front();
+
     Widget::draw(ctx);
 
     NVGpaint paint = nvgBoxGradient(
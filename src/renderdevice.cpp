@@ -0,0 +1,417 @@
+/*
+    src/renderdevice.cpp -- Runtime interface between a Screen and its
+    graphics backend, and the built-in backends
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/renderdevice.h>
+#include <nanogui/screen.h>
+#include <nanogui/texture.h>
+#include <nanogui/opengl.h>
+#include <nanogui/metal.h>
+#include <nanogui/softwarerenderer.h>
+#include <algorithm>
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+#  if defined(NANOGUI_USE_OPENGL)
+#    define NANOVG_GL3_IMPLEMENTATION
+#  elif defined(NANOGUI_USE_GLES)
+#    define NANOVG_GLES2_IMPLEMENTATION
+#  endif
+#  include <nanovg_gl.h>
+#  include "opengl_check.h"
+#elif defined(NANOGUI_USE_METAL)
+#  include <nanovg_mtl.h>
+#  define GLFW_EXPOSE_NATIVE_COCOA 1
+#  include <GLFW/glfw3native.h>
+#elif defined(NANOGUI_USE_NULL)
+#  include <nanogui/null.h>
+#endif
+
+#if !defined(GL_RGBA_FLOAT_MODE)
+#  define GL_RGBA_FLOAT_MODE 0x8820
+#endif
+
+NAMESPACE_BEGIN(nanogui)
+
+void RenderDevice::init_window(Screen *) { }
+void RenderDevice::release(Screen *) { }
+void RenderDevice::begin_frame(Screen *) { }
+void RenderDevice::end_frame(Screen *) { }
+void RenderDevice::resize(Screen *, const Vector2i &) { }
+void RenderDevice::invalidate_state(Screen *) { }
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+#if defined(NANOGUI_GLAD)
+static bool glad_initialized = false;
+#endif
+
+class GLRenderDevice : public RenderDevice {
+public:
+    std::string name() const override {
+#if defined(NANOGUI_USE_OPENGL)
+        return "opengl";
+#else
+        return "gles";
+#endif
+    }
+
+    bool supports_shaders() const override { return true; }
+
+    void window_hints(Screen *screen, unsigned int gl_major,
+                      unsigned int gl_minor) override {
+#if defined(NANOGUI_USE_OPENGL)
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
+
+        /* Request a forward compatible OpenGL gl_major.gl_minor core profile context.
+           Default value is an OpenGL 3.3 core profile context. */
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, gl_major);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, gl_minor);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#  if defined(GLFW_FLOATBUFFER)
+        glfwWindowHint(GLFW_FLOATBUFFER, screen->m_float_buffer ? GL_TRUE : GL_FALSE);
+#  else
+        screen->m_float_buffer = false;
+#  endif
+#else
+        (void) gl_major; (void) gl_minor;
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, NANOGUI_GLES_VERSION);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+        screen->m_float_buffer = false;
+#endif
+    }
+
+    void init_window(Screen *screen) override {
+        glfwMakeContextCurrent(screen->m_glfw_window);
+        GLState::set_current(&screen->m_gl_state);
+
+#if defined(NANOGUI_GLAD)
+        if (!glad_initialized) {
+            glad_initialized = true;
+            if (!gladLoadGLLoader((GLADloadproc) glfwGetProcAddress))
+                throw std::runtime_error("Could not initialize GLAD!");
+            glGetError(); // pull and ignore unhandled errors like GL_INVALID_ENUM
+        }
+#endif
+
+#if defined(NANOGUI_USE_OPENGL)
+        if (screen->m_float_buffer) {
+            GLboolean float_mode;
+            CHK(glGetBooleanv(GL_RGBA_FLOAT_MODE, &float_mode));
+            if (!float_mode) {
+                fprintf(stderr, "Could not allocate floating point framebuffer.\n");
+                screen->m_float_buffer = false;
+            }
+        }
+#endif
+
+        if (screen->m_shutdown_glfw) {
+            /* Show a cleared window until the first frame is drawn */
+            CHK(glViewport(0, 0, screen->m_fbsize[0], screen->m_fbsize[1]));
+            clear(screen);
+            glfwSwapInterval(0);
+            screen->m_active_swap_interval = 0;
+            glfwSwapBuffers(screen->m_glfw_window);
+        }
+    }
+
+    NVGcontext *create_nvg_context(Screen *, int flags) override {
+#if defined(NANOGUI_USE_OPENGL)
+        return nvgCreateGL3(flags);
+#else
+        return nvgCreateGLES2(flags);
+#endif
+    }
+
+    void delete_nvg_context(Screen *, NVGcontext *ctx) override {
+#if defined(NANOGUI_USE_OPENGL)
+        nvgDeleteGL3(ctx);
+#else
+        nvgDeleteGLES2(ctx);
+#endif
+    }
+
+    void release(Screen *screen) override {
+        if (GLState::current() == &screen->m_gl_state)
+            GLState::set_current(nullptr);
+    }
+
+    void begin_frame(Screen *screen) override {
+        glfwMakeContextCurrent(screen->m_glfw_window);
+        GLState::set_current(&screen->m_gl_state);
+    }
+
+    void clear(Screen *screen) override {
+        const Color &c = screen->m_background;
+        CHK(glClearColor(c[0], c[1], c[2], c[3]));
+        CHK(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT));
+    }
+
+    void end_frame(Screen *screen) override {
+        /* The swap interval is context state, only change it when needed */
+        if (screen->m_swap_interval != screen->m_active_swap_interval) {
+            glfwSwapInterval(screen->m_swap_interval);
+            screen->m_active_swap_interval = screen->m_swap_interval;
+        }
+        glfwSwapBuffers(screen->m_glfw_window);
+    }
+
+    void invalidate_state(Screen *screen) override {
+        screen->m_gl_state.reset(screen->m_fbsize);
+    }
+
+    int nvg_image_from_texture(NVGcontext *ctx, Texture *texture) override {
+#if defined(NANOGUI_USE_OPENGL)
+        return nvglCreateImageFromHandleGL3(
+#else
+        return nvglCreateImageFromHandleGLES2(
+#endif
+            ctx, texture->texture_handle(), texture->size().x(),
+            texture->size().y(), NVG_IMAGE_FLIPY | NVG_IMAGE_NODELETE);
+    }
+};
+#endif
+
+#if defined(NANOGUI_USE_METAL)
+class MetalRenderDevice : public RenderDevice {
+public:
+    std::string name() const override { return "metal"; }
+
+    bool supports_shaders() const override { return true; }
+
+    void window_hints(Screen *screen, unsigned int, unsigned int) override {
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        screen->m_stencil_buffer = false;
+#if defined(GLFW_FLOATBUFFER)
+        glfwWindowHint(GLFW_FLOATBUFFER, screen->m_float_buffer ? GL_TRUE : GL_FALSE);
+#else
+        screen->m_float_buffer = false;
+#endif
+    }
+
+    void init_window(Screen *screen) override {
+        void *nswin = glfwGetCocoaWindow(screen->m_glfw_window);
+        metal_window_init(nswin, screen->m_float_buffer);
+        metal_window_set_size(nswin, screen->m_fbsize);
+
+        if (screen->m_depth_buffer && !screen->m_depth_stencil_texture) {
+            screen->m_depth_stencil_texture = new Texture(
+                screen->m_stencil_buffer ? Texture::PixelFormat::DepthStencil
+                                         : Texture::PixelFormat::Depth,
+                Texture::ComponentFormat::Float32,
+                screen->m_fbsize,
+                Texture::InterpolationMode::Bilinear,
+                Texture::InterpolationMode::Bilinear,
+                Texture::WrapMode::ClampToEdge,
+                1,
+                Texture::TextureFlags::RenderTarget
+            );
+        }
+    }
+
+    NVGcontext *create_nvg_context(Screen *screen, int flags) override {
+        return nvgCreateMTL(screen->metal_layer(), metal_command_queue(),
+                            flags | NVG_TRIPLE_BUFFER);
+    }
+
+    void delete_nvg_context(Screen *, NVGcontext *ctx) override {
+        nvgDeleteMTL(ctx);
+    }
+
+    void begin_frame(Screen *screen) override {
+        void *nswin = glfwGetCocoaWindow(screen->m_glfw_window);
+        metal_window_set_size(nswin, screen->m_fbsize);
+        screen->m_metal_drawable = metal_window_next_drawable(nswin);
+        screen->m_metal_texture = metal_drawable_texture(screen->m_metal_drawable);
+        mnvgSetColorTexture(screen->m_nvg_context, screen->m_metal_texture);
+    }
+
+    void clear(Screen *screen) override {
+        mnvgClearWithColor(screen->m_nvg_context, screen->m_background);
+    }
+
+    void end_frame(Screen *screen) override {
+        mnvgSetColorTexture(screen->m_nvg_context, nullptr);
+        metal_present_and_release_drawable(screen->m_metal_drawable);
+        screen->m_metal_texture = nullptr;
+        screen->m_metal_drawable = nullptr;
+    }
+
+    void resize(Screen *screen, const Vector2i &fb_size) override {
+        if (screen->m_depth_stencil_texture)
+            screen->m_depth_stencil_texture->resize(fb_size);
+    }
+
+    int nvg_image_from_texture(NVGcontext *ctx, Texture *texture) override {
+        return mnvgCreateImageFromHandle(ctx, texture->texture_handle(), 0);
+    }
+};
+#endif
+
+#if defined(NANOGUI_USE_NULL)
+class NullRenderDevice : public RenderDevice {
+public:
+    std::string name() const override { return "null"; }
+
+    bool supports_shaders() const override { return true; }
+
+    void window_hints(Screen *screen, unsigned int, unsigned int) override {
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        screen->m_float_buffer = false;
+    }
+
+    NVGcontext *create_nvg_context(Screen *, int flags) override {
+        return null_nvg_create(flags);
+    }
+
+    void delete_nvg_context(Screen *, NVGcontext *ctx) override {
+        null_nvg_delete(ctx);
+    }
+
+    void clear(Screen *) override { null_stats().clears++; }
+
+    void end_frame(Screen *) override { null_stats().frames++; }
+
+    int nvg_image_from_texture(NVGcontext *ctx, Texture *texture) override {
+        return null_nvg_image_from_handle(ctx, texture->texture_handle(),
+                                          texture->size(), 0);
+    }
+};
+#endif
+
+#if defined(NANOGUI_USE_DE)
+/**
+ * The application creates the NanoVG context and renders the frames. This
+ * device cannot release the context or clear the framebuffer, hence
+ * applications should pass their own device (that does both) along with
+ * the context to \ref Screen::initialize().
+ */
+class ExternalRenderDevice : public RenderDevice {
+public:
+    std::string name() const override { return "external"; }
+
+    bool supports_shaders() const override { return false; }
+
+    void window_hints(Screen *screen, unsigned int, unsigned int) override {
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        screen->m_stencil_buffer = true;
+        screen->m_float_buffer = false;
+    }
+
+    NVGcontext *create_nvg_context(Screen *, int) override {
+        throw std::runtime_error(
+            "ExternalRenderDevice::create_nvg_context(): the application must "
+            "provide a NanoVG context or a render device!");
+    }
+
+    void delete_nvg_context(Screen *, NVGcontext *) override { }
+
+    void clear(Screen *) override { }
+
+    int nvg_image_from_texture(NVGcontext *, Texture *) override { return -1; }
+};
+#endif
+
+/// Renders on the CPU using \ref sw_nvg_create() (the window remains empty)
+class SoftwareRenderDevice : public RenderDevice {
+public:
+    std::string name() const override { return "software"; }
+
+    bool supports_shaders() const override {
+#if defined(NANOGUI_USE_NULL)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void window_hints(Screen *screen, unsigned int, unsigned int) override {
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        screen->m_float_buffer = false;
+    }
+
+    NVGcontext *create_nvg_context(Screen *, int) override {
+        return sw_nvg_create();
+    }
+
+    void delete_nvg_context(Screen *, NVGcontext *ctx) override {
+        sw_nvg_delete(ctx);
+    }
+
+    void clear(Screen *screen) override {
+        sw_nvg_clear(screen->m_nvg_context, screen->m_background);
+    }
+
+    int nvg_image_from_texture(NVGcontext *ctx, Texture *texture) override {
+        /* GPU textures cannot be sampled on the CPU, draw an empty image */
+        return nvgCreateImageRGBA(ctx, texture->size().x(), texture->size().y(),
+                                  0, nullptr);
+    }
+};
+
+struct RenderBackend {
+    std::string name;
+    int priority;
+    RenderDevice::Factory factory;
+};
+
+static std::vector<RenderBackend> &render_backends() {
+    static std::vector<RenderBackend> backends = {
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+#  if defined(NANOGUI_USE_OPENGL)
+        { "opengl", 100, [] { return (RenderDevice *) new GLRenderDevice(); } },
+#  else
+        { "gles", 100, [] { return (RenderDevice *) new GLRenderDevice(); } },
+#  endif
+#elif defined(NANOGUI_USE_METAL)
+        { "metal", 100, [] { return (RenderDevice *) new MetalRenderDevice(); } },
+#elif defined(NANOGUI_USE_NULL)
+        { "null", 100, [] { return (RenderDevice *) new NullRenderDevice(); } },
+#elif defined(NANOGUI_USE_DE)
+        { "external", 100, [] { return (RenderDevice *) new ExternalRenderDevice(); } },
+#endif
+        { "software", -1, [] { return (RenderDevice *) new SoftwareRenderDevice(); } }
+    };
+    return backends;
+}
+
+void RenderDevice::register_backend(const std::string &name, int priority,
+                                    const Factory &factory) {
+    std::vector<RenderBackend> &backends = render_backends();
+    backends.erase(std::remove_if(backends.begin(), backends.end(),
+                                  [&](const RenderBackend &b) { return b.name == name; }),
+                   backends.end());
+    backends.push_back({ name, priority, factory });
+    std::stable_sort(backends.begin(), backends.end(),
+                     [](const RenderBackend &a, const RenderBackend &b) {
+                         return a.priority > b.priority;
+                     });
+}
+
+std::vector<std::string> RenderDevice::backends(bool opt_in) {
+    std::vector<std::string> result;
+    for (const RenderBackend &backend : render_backends()) {
+        if (opt_in || backend.priority >= 0)
+            result.push_back(backend.name);
+    }
+    return result;
+}
+
+ref<RenderDevice> RenderDevice::create(const std::string &name) {
+    for (const RenderBackend &backend : render_backends()) {
+        if (backend.name == name)
+            return backend.factory();
+    }
+    throw std::runtime_error("RenderDevice::create(): unknown backend \"" + name + "\"!");
+}
+
+NAMESPACE_END(nanogui)
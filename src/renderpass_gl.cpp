@@ -1,11 +1,34 @@
 #include <nanogui/renderpass.h>
+#include <nanogui/frameprofiler.h>
 #include <nanogui/screen.h>
 #include <nanogui/opengl.h>
 #include <nanogui/texture.h>
+#include <nanogui/glstate.h>
 #include "opengl_check.h"
 
 NAMESPACE_BEGIN(nanogui)
 
+/// Attach a texture to the currently bound framebuffer
+static void attach_texture(GLenum attachment_id, Texture *texture) {
+    if (texture->flags() & Texture::TextureFlags::ShaderRead) {
+        CHK(glFramebufferTexture2D(GL_FRAMEBUFFER, attachment_id, GL_TEXTURE_2D,
+                                   texture->texture_handle(), 0));
+    } else {
+        CHK(glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment_id, GL_RENDERBUFFER,
+                                      texture->renderbuffer_handle()));
+    }
+}
+
+/// Return the framebuffer attachment point associated with a target index
+static GLenum attachment_id(size_t index) {
+    if (index == 0)
+        return GL_DEPTH_ATTACHMENT;
+    else if (index == 1)
+        return GL_STENCIL_ATTACHMENT;
+    else
+        return (GLenum) (GL_COLOR_ATTACHMENT0 + index - 2);
+}
+
 RenderPass::RenderPass(std::vector<Object *> color_targets,
                        Object *depth_target,
                        Object *stencil_target,
@@ -31,8 +54,9 @@ RenderPass::RenderPass(std::vector<Object *> color_targets,
         m_depth_test = DepthTest::Always;
     }
 
+    GLState *state = GLState::current();
     CHK(glGenFramebuffers(1, &m_framebuffer_handle));
-    CHK(glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer_handle));
+    state->bind_framebuffer(GL_FRAMEBUFFER, m_framebuffer_handle);
 
 #if defined(NANOGUI_USE_OPENGL)
     std::vector<GLenum> draw_buffers;
@@ -42,14 +66,6 @@ RenderPass::RenderPass(std::vector<Object *> color_targets,
          has_screen  = false;
 
     for (size_t i = 0; i < m_targets.size(); ++i) {
-        GLenum attachment_id;
-        if (i == 0)
-            attachment_id = GL_DEPTH_ATTACHMENT;
-        else if (i == 1)
-            attachment_id = GL_STENCIL_ATTACHMENT;
-        else
-            attachment_id = (GLenum) (GL_COLOR_ATTACHMENT0 + i - 2);
-
         Screen *screen = dynamic_cast<Screen *>(m_targets[i].get());
         Texture *texture = dynamic_cast<Texture *>(m_targets[i].get());
         if (screen) {
@@ -60,16 +76,10 @@ RenderPass::RenderPass(std::vector<Object *> color_targets,
 #endif
             has_screen = true;
         } else if (texture) {
-            if (texture->flags() & Texture::TextureFlags::ShaderRead) {
-                CHK(glFramebufferTexture2D(GL_FRAMEBUFFER, attachment_id, GL_TEXTURE_2D,
-                                           texture->texture_handle(), 0));
-            } else {
-                CHK(glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment_id, GL_RENDERBUFFER,
-                                              texture->renderbuffer_handle()));
-            }
+            attach_texture(attachment_id(i), texture);
 #if defined(NANOGUI_USE_OPENGL)
             if (i >= 2)
-                draw_buffers.push_back(attachment_id);
+                draw_buffers.push_back(attachment_id(i));
 #endif
             m_framebuffer_size = max(m_framebuffer_size, texture->size());
             has_texture = true;
@@ -79,6 +89,7 @@ RenderPass::RenderPass(std::vector<Object *> color_targets,
 
     if (has_screen && !has_texture) {
         CHK(glDeleteFramebuffers(1, &m_framebuffer_handle));
+        state->framebuffer_deleted(m_framebuffer_handle);
         m_framebuffer_handle = 0;
     } else {
 #if defined(NANOGUI_USE_OPENGL)
@@ -133,11 +144,21 @@ RenderPass::RenderPass(std::vector<Object *> color_targets,
         }
     }
 
-    CHK(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    state->bind_framebuffer(GL_FRAMEBUFFER, 0);
 }
 
 RenderPass::~RenderPass() {
-    CHK(glDeleteFramebuffers(1, &m_framebuffer_handle));
+    if (m_texture_pool) {
+        for (size_t i = 0; i < m_targets.size(); ++i) {
+            Texture *texture = dynamic_cast<Texture *>(m_targets[i].get());
+            if (texture)
+                m_texture_pool->release(texture);
+        }
+    }
+    if (m_framebuffer_handle) {
+        CHK(glDeleteFramebuffers(1, &m_framebuffer_handle));
+        GLState::current()->framebuffer_deleted(m_framebuffer_handle);
+    }
 }
 
 void RenderPass::begin() {
@@ -145,20 +166,26 @@ void RenderPass::begin() {
     if (m_active)
         throw std::runtime_error("RenderPass::begin(): render pass is already active!");
 #endif
-    m_active = true;
 
-    CHK(glGetIntegerv(GL_VIEWPORT, m_viewport_backup));
-    CHK(glGetIntegerv(GL_SCISSOR_BOX, m_scissor_backup));
-    GLboolean depth_write;
-    CHK(glGetBooleanv(GL_DEPTH_WRITEMASK, &depth_write));
-    m_depth_write_backup = depth_write;
+    if (FrameProfiler *profiler = FrameProfiler::current())
+        profiler->push(m_label);
 
-    m_depth_test_backup = glIsEnabled(GL_DEPTH_TEST);
-    m_scissor_test_backup = glIsEnabled(GL_SCISSOR_TEST);
-    m_cull_face_backup = glIsEnabled(GL_CULL_FACE);
-    m_blend_backup = glIsEnabled(GL_BLEND);
+    m_active = true;
 
-    CHK(glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer_handle));
+    /* Back up the state from the shadow copy (avoids glGet*() stalls) */
+    GLState *state = GLState::current();
+    m_viewport_backup = state->viewport();
+    m_scissor_backup = state->scissor();
+    m_depth_write_backup = state->depth_mask();
+    m_depth_test_backup = state->enabled(GLState::Capability::DepthTest);
+    m_scissor_test_backup = state->enabled(GLState::Capability::ScissorTest);
+    m_cull_face_backup = state->enabled(GLState::Capability::CullFace);
+    m_blend_backup = state->enabled(GLState::Capability::Blend);
+#if defined(NANOGUI_USE_OPENGL)
+    m_point_size_backup = state->enabled(GLState::Capability::ProgramPointSize);
+#endif
+
+    state->bind_framebuffer(GL_FRAMEBUFFER, m_framebuffer_handle);
     set_viewport(m_viewport_offset, m_viewport_size);
 
     if (m_clear) {
@@ -197,8 +224,7 @@ void RenderPass::begin() {
     set_depth_test(m_depth_test, m_depth_write);
     set_cull_mode(m_cull_mode);
 
-    if (m_blend_backup)
-        CHK(glDisable(GL_BLEND));
+    state->set_enabled(GLState::Capability::Blend, false);
 }
 
 void RenderPass::end() {
@@ -207,46 +233,66 @@ void RenderPass::end() {
         throw std::runtime_error("RenderPass::end(): render pass is not active!");
 #endif
 
-    CHK(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    GLState *state = GLState::current();
+    state->bind_framebuffer(GL_FRAMEBUFFER, 0);
     if (m_blit_target)
         blit_to(Vector2i(0, 0), m_framebuffer_size, m_blit_target, Vector2i(0, 0));
 
-    CHK(glViewport(m_viewport_backup[0], m_viewport_backup[1],
-                   m_viewport_backup[2], m_viewport_backup[3]));
-    CHK(glScissor(m_scissor_backup[0], m_scissor_backup[1],
-                  m_scissor_backup[2], m_scissor_backup[3]));
-
-    if (m_depth_test_backup)
-        CHK(glEnable(GL_DEPTH_TEST));
-    else
-        CHK(glDisable(GL_DEPTH_TEST));
-
-    CHK(glDepthMask(m_depth_write_backup));
-
-    if (m_scissor_test_backup)
-        CHK(glEnable(GL_SCISSOR_TEST));
-    else
-        CHK(glDisable(GL_SCISSOR_TEST));
-
-    if (m_cull_face_backup)
-        CHK(glEnable(GL_CULL_FACE));
-    else
-        CHK(glDisable(GL_CULL_FACE));
-
-    if (m_blend_backup)
-        CHK(glEnable(GL_BLEND));
-    else
-        CHK(glDisable(GL_BLEND));
+    state->set_viewport(m_viewport_backup);
+    state->set_scissor(m_scissor_backup);
+    state->set_enabled(GLState::Capability::DepthTest, m_depth_test_backup);
+    state->set_depth_mask(m_depth_write_backup);
+    state->set_enabled(GLState::Capability::ScissorTest, m_scissor_test_backup);
+    state->set_enabled(GLState::Capability::CullFace, m_cull_face_backup);
+    state->set_enabled(GLState::Capability::Blend, m_blend_backup);
+#if defined(NANOGUI_USE_OPENGL)
+    state->set_enabled(GLState::Capability::ProgramPointSize, m_point_size_backup);
+#endif
 
     m_active = false;
+
+    if (FrameProfiler *profiler = FrameProfiler::current())
+        profiler->pop();
 }
 
 void RenderPass::resize(const Vector2i &size) {
+    bool rebind = false;
     for (size_t i = 0; i < m_targets.size(); ++i) {
         Texture *texture = dynamic_cast<Texture *>(m_targets[i].get());
-        if (texture)
+        if (!texture)
+            continue;
+
+        if (!m_texture_pool) {
             texture->resize(size);
+            continue;
+        } else if (TexturePool::fits(texture, size)) {
+            continue;
+        }
+
+        ref<Texture> replacement = m_texture_pool->acquire(
+            texture->pixel_format(), texture->component_format(), size,
+            texture->samples(), texture->flags());
+
+        if (!rebind) {
+            GLState::current()->bind_framebuffer(GL_FRAMEBUFFER, m_framebuffer_handle);
+            rebind = true;
+        }
+
+        /* Depth and stencil may share a texture */
+        for (size_t j = i; j < m_targets.size(); ++j) {
+            if (m_targets[j].get() != texture)
+                continue;
+            attach_texture(attachment_id(j), replacement);
+            if (j != i)
+                m_targets[j] = replacement;
+        }
+
+        m_texture_pool->release(texture);
+        m_targets[i] = replacement;
     }
+    if (rebind)
+        GLState::current()->bind_framebuffer(GL_FRAMEBUFFER, 0);
+
     m_framebuffer_size = size;
     m_viewport_offset = Vector2i(0, 0);
     m_viewport_size = size;
@@ -269,17 +315,15 @@ void RenderPass::set_viewport(const Vector2i &offset, const Vector2i &size) {
     m_viewport_size = size;
 
     if (m_active) {
+        GLState *state = GLState::current();
         int ypos = m_framebuffer_size.y() - m_viewport_size.y() - m_viewport_offset.y();
-        CHK(glViewport(m_viewport_offset.x(), ypos,
-                       m_viewport_size.x(), m_viewport_size.y()));
-        CHK(glScissor(m_viewport_offset.x(), ypos,
-                      m_viewport_size.x(), m_viewport_size.y()));
-
-        if (m_viewport_offset == Vector2i(0, 0) &&
-            m_viewport_size == m_framebuffer_size)
-            CHK(glDisable(GL_SCISSOR_TEST));
-        else
-            CHK(glEnable(GL_SCISSOR_TEST));
+        Vector4i rect(m_viewport_offset.x(), ypos,
+                      m_viewport_size.x(), m_viewport_size.y());
+        state->set_viewport(rect);
+        state->set_scissor(rect);
+        state->set_enabled(GLState::Capability::ScissorTest,
+                           m_viewport_offset != Vector2i(0, 0) ||
+                           m_viewport_size != m_framebuffer_size);
     }
 }
 
@@ -288,6 +332,7 @@ void RenderPass::set_depth_test(DepthTest depth_test, bool depth_write) {
     m_depth_write = depth_write;
 
     if (m_active) {
+        GLState *state = GLState::current();
         if (m_targets[0] && depth_test != DepthTest::Always) {
             GLenum func;
             switch (depth_test) {
@@ -301,12 +346,12 @@ void RenderPass::set_depth_test(DepthTest depth_test, bool depth_write) {
                 default:
                     throw std::runtime_error("Shader::set_depth_test(): invalid depth test mode!");
             }
-            CHK(glEnable(GL_DEPTH_TEST));
-            CHK(glDepthFunc(func));
+            state->set_enabled(GLState::Capability::DepthTest, true);
+            state->set_depth_func(func);
         } else {
-            CHK(glDisable(GL_DEPTH_TEST));
+            state->set_enabled(GLState::Capability::DepthTest, false);
         }
-        CHK(glDepthMask(depth_write ? GL_TRUE : GL_FALSE));
+        state->set_depth_mask(depth_write);
     }
 }
 
@@ -314,14 +359,15 @@ void RenderPass::set_cull_mode(CullMode cull_mode) {
     m_cull_mode = cull_mode;
 
     if (m_active) {
+        GLState *state = GLState::current();
         if (cull_mode == CullMode::Disabled) {
-            CHK(glDisable(GL_CULL_FACE));
+            state->set_enabled(GLState::Capability::CullFace, false);
         } else {
-            CHK(glEnable(GL_CULL_FACE));
+            state->set_enabled(GLState::Capability::CullFace, true);
             if (cull_mode == CullMode::Front)
-                CHK(glCullFace(GL_FRONT));
+                state->set_cull_face(GL_FRONT);
             else if (cull_mode == CullMode::Back)
-                CHK(glCullFace(GL_BACK));
+                state->set_cull_face(GL_BACK);
             else
                 throw std::runtime_error("Shader::set_cull_mode(): invalid cull mode!");
         }
@@ -365,8 +411,9 @@ void RenderPass::blit_to(const Vector2i &src_offset,
         what = GL_COLOR_BUFFER_BIT;
     #endif
 
-    CHK(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer_handle));
-    CHK(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target_id));
+    GLState *state = GLState::current();
+    state->bind_framebuffer(GL_READ_FRAMEBUFFER, m_framebuffer_handle);
+    state->bind_framebuffer(GL_DRAW_FRAMEBUFFER, target_id);
 
     if (target_id == 0) {
         #if defined(NANOGUI_USE_OPENGL)
@@ -386,7 +433,7 @@ void RenderPass::blit_to(const Vector2i &src_offset,
                           (GLsizei) dst_end.x(), (GLsizei) dst_end.y(),
                           what, GL_NEAREST));
 
-    CHK(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    state->bind_framebuffer(GL_FRAMEBUFFER, 0);
 #endif
 }
 
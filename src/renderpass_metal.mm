@@ -1,4 +1,5 @@
 #include <nanogui/renderpass.h>
+#include <nanogui/frameprofiler.h>
 #include <nanogui/screen.h>
 #include <nanogui/texture.h>
 #include <nanogui/shader.h>
@@ -63,6 +64,13 @@ RenderPass::RenderPass(std::vector<Object *> color_targets,
 }
 
 RenderPass::~RenderPass() {
+    if (m_texture_pool) {
+        for (size_t i = 0; i < m_targets.size(); ++i) {
+            Texture *texture = dynamic_cast<Texture *>(m_targets[i].get());
+            if (texture)
+                m_texture_pool->release(texture);
+        }
+    }
     (void) (__bridge_transfer MTLRenderPassDescriptor *) m_pass_descriptor;
 }
 
@@ -71,6 +79,10 @@ void RenderPass::begin() {
     if (m_active)
         throw std::runtime_error("RenderPass::begin(): render pass is already active!");
 #endif
+
+    if (FrameProfiler *profiler = FrameProfiler::current())
+        profiler->push(m_label);
+
     id<MTLCommandQueue> command_queue =
         (__bridge id<MTLCommandQueue>) metal_command_queue();
 
@@ -238,13 +250,37 @@ void RenderPass::end() {
     m_command_encoder = nullptr;
     m_command_buffer = nullptr;
     m_active = false;
+
+    if (FrameProfiler *profiler = FrameProfiler::current())
+        profiler->pop();
 }
 
 void RenderPass::resize(const Vector2i &size) {
     for (size_t i = 0; i < m_targets.size(); ++i) {
         Texture *texture = dynamic_cast<Texture *>(m_targets[i].get());
-        if (texture)
+        if (!texture)
+            continue;
+
+        if (!m_texture_pool) {
             texture->resize(size);
+            continue;
+        } else if (TexturePool::fits(texture, size)) {
+            continue;
+        }
+
+        /* Attachments are looked up in begin(), replacing the targets suffices */
+        ref<Texture> replacement = m_texture_pool->acquire(
+            texture->pixel_format(), texture->component_format(), size,
+            texture->samples(), texture->flags());
+
+        /* Depth and stencil may share a texture */
+        for (size_t j = i + 1; j < m_targets.size(); ++j) {
+            if (m_targets[j].get() == texture)
+                m_targets[j] = replacement;
+        }
+
+        m_texture_pool->release(texture);
+        m_targets[i] = replacement;
     }
     m_framebuffer_size = size;
     m_viewport_offset = Vector2i(0, 0);
@@ -0,0 +1,166 @@
+#include <nanogui/renderpass.h>
+#include <nanogui/frameprofiler.h>
+#include <nanogui/screen.h>
+#include <nanogui/texture.h>
+#include <nanogui/null.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+RenderPass::RenderPass(std::vector<Object *> color_targets,
+                       Object *depth_target,
+                       Object *stencil_target,
+                       Object *blit_target,
+                       bool clear)
+    : m_targets(color_targets.size() + 2), m_clear(clear),
+      m_clear_color(color_targets.size()), m_viewport_offset(0),
+      m_viewport_size(0), m_framebuffer_size(0), m_depth_test(DepthTest::Less),
+      m_depth_write(true), m_cull_mode(CullMode::Back), m_blit_target(blit_target),
+      m_active(false) {
+
+    m_targets[0] = depth_target;
+    m_targets[1] = stencil_target;
+    for (size_t i = 0; i < color_targets.size(); ++i) {
+        m_targets[i + 2] = color_targets[i];
+        m_clear_color[i] = Color(0, 0, 0, 0);
+    }
+    m_clear_stencil = 0;
+    m_clear_depth = 1.f;
+
+    if (!m_targets[0].get()) {
+        m_depth_write = false;
+        m_depth_test = DepthTest::Always;
+    }
+
+    for (size_t i = 0; i < m_targets.size(); ++i) {
+        Screen *screen = dynamic_cast<Screen *>(m_targets[i].get());
+        Texture *texture = dynamic_cast<Texture *>(m_targets[i].get());
+        if (screen) {
+            m_framebuffer_size = max(m_framebuffer_size, screen->framebuffer_size());
+        } else if (texture) {
+            if (!(texture->flags() & Texture::TextureFlags::RenderTarget))
+                throw std::runtime_error(
+                    "RenderPass::RenderPass(): framebuffer is marked as incomplete: "
+                    "incomplete attachment");
+            m_framebuffer_size = max(m_framebuffer_size, texture->size());
+        }
+    }
+    m_viewport_size = m_framebuffer_size;
+
+    null_stats().render_passes++;
+}
+
+RenderPass::~RenderPass() {
+    if (m_texture_pool) {
+        for (size_t i = 0; i < m_targets.size(); ++i) {
+            Texture *texture = dynamic_cast<Texture *>(m_targets[i].get());
+            if (texture)
+                m_texture_pool->release(texture);
+        }
+    }
+    null_stats().render_passes--;
+}
+
+void RenderPass::begin() {
+#if !defined(NDEBUG)
+    if (m_active)
+        throw std::runtime_error("RenderPass::begin(): render pass is already active!");
+#endif
+
+    if (FrameProfiler *profiler = FrameProfiler::current())
+        profiler->push(m_label);
+
+    m_active = true;
+
+    NullStats &stats = null_stats();
+    stats.render_pass_begins++;
+    if (m_clear)
+        stats.clears++;
+}
+
+void RenderPass::end() {
+#if !defined(NDEBUG)
+    if (!m_active)
+        throw std::runtime_error("RenderPass::end(): render pass is not active!");
+#endif
+
+    if (m_blit_target)
+        blit_to(Vector2i(0, 0), m_framebuffer_size, m_blit_target, Vector2i(0, 0));
+
+    m_active = false;
+
+    if (FrameProfiler *profiler = FrameProfiler::current())
+        profiler->pop();
+}
+
+void RenderPass::resize(const Vector2i &size) {
+    for (size_t i = 0; i < m_targets.size(); ++i) {
+        Texture *texture = dynamic_cast<Texture *>(m_targets[i].get());
+        if (!texture)
+            continue;
+
+        if (!m_texture_pool) {
+            texture->resize(size);
+            continue;
+        } else if (TexturePool::fits(texture, size)) {
+            continue;
+        }
+
+        ref<Texture> replacement = m_texture_pool->acquire(
+            texture->pixel_format(), texture->component_format(), size,
+            texture->samples(), texture->flags());
+
+        /* Depth and stencil may share a texture */
+        for (size_t j = i + 1; j < m_targets.size(); ++j) {
+            if (m_targets[j].get() == texture)
+                m_targets[j] = replacement;
+        }
+
+        m_texture_pool->release(texture);
+        m_targets[i] = replacement;
+    }
+
+    m_framebuffer_size = size;
+    m_viewport_offset = Vector2i(0, 0);
+    m_viewport_size = size;
+}
+
+void RenderPass::set_clear_color(size_t index, const Color &color) {
+    m_clear_color.at(index) = color;
+}
+
+void RenderPass::set_clear_depth(float depth) {
+    m_clear_depth = depth;
+}
+
+void RenderPass::set_clear_stencil(uint8_t stencil) {
+    m_clear_stencil = stencil;
+}
+
+void RenderPass::set_viewport(const Vector2i &offset, const Vector2i &size) {
+    m_viewport_offset = offset;
+    m_viewport_size = size;
+}
+
+void RenderPass::set_depth_test(DepthTest depth_test, bool depth_write) {
+    m_depth_test = depth_test;
+    m_depth_write = depth_write;
+}
+
+void RenderPass::set_cull_mode(CullMode cull_mode) {
+    if (cull_mode != CullMode::Disabled && cull_mode != CullMode::Front &&
+        cull_mode != CullMode::Back)
+        throw std::runtime_error("Shader::set_cull_mode(): invalid cull mode!");
+    m_cull_mode = cull_mode;
+}
+
+void RenderPass::blit_to(const Vector2i &src_offset,
+                         const Vector2i &src_size,
+                         Object *dst,
+                         const Vector2i &dst_offset) {
+    (void) src_offset; (void) src_size; (void) dst_offset;
+    if (!dynamic_cast<Screen *>(dst) && !dynamic_cast<RenderPass *>(dst))
+        throw std::runtime_error(
+            "RenderPass::blit_to(): 'dst' must either be a RenderPass or a Screen instance.");
+}
+
+NAMESPACE_END(nanogui)
@@ -16,8 +16,10 @@
 #include <nanogui/opengl.h>
 #include <nanogui/window.h>
 #include <nanogui/popup.h>
+#include <nanogui/canvas.h>
 #include <nanogui/metal.h>
 #include <map>
+#include <limits>
 #include <iostream>
 
 #if defined(EMSCRIPTEN)
@@ -41,13 +43,12 @@
 #  include <GLFW/glfw3native.h>
 #endif
 
-/* Allow enforcing the GL2 implementation of NanoVG */
-
+/* NanoVG headers of the compiled backend (for the context creation flags) */
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
 #  if defined(NANOGUI_USE_OPENGL)
-#    define NANOVG_GL3_IMPLEMENTATION
+#    define NANOVG_GL3
 #  elif defined(NANOGUI_USE_GLES)
-#    define NANOVG_GLES2_IMPLEMENTATION
+#    define NANOVG_GLES2
 #  endif
 #  include <nanovg_gl.h>
 #  include "opengl_check.h"
@@ -55,8 +56,12 @@
 #  include <nanovg_mtl.h>
 #elif defined(NANOGUI_USE_DE)
 #  include <nanovg_DE.hpp>
+#elif defined(NANOGUI_USE_NULL)
+#  include <nanogui/null.h>
 #endif
 
+#include <nanogui/softwarerenderer.h>
+
 #if defined(__APPLE__)
 #  define GLFW_EXPOSE_NATIVE_COCOA 1
 #  include <GLFW/glfw3native.h>
@@ -70,10 +75,6 @@ NAMESPACE_BEGIN(nanogui)
 
 std::map<GLFWwindow *, Screen *> __nanogui_screens;
 
-#if defined(NANOGUI_GLAD)
-static bool glad_initialized = false;
-#endif
-
 /* Calculate pixel ratio for hi-dpi devices. */
 static float get_pixel_ratio(GLFWwindow *window) {
 #if defined(EMSCRIPTEN)
@@ -188,95 +189,75 @@ Screen::Screen(const Vector2i &size, const std::string &caption, NVGcontext *con
       m_stencil_buffer(stencil_buffer), m_float_buffer(float_buffer), m_redraw(false) {
     memset(m_cursors, 0, sizeof(GLFWcursor *) * (int) Cursor::CursorCount);
 
-#if defined(NANOGUI_USE_OPENGL)
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
-
-    /* Request a forward compatible OpenGL gl_major.gl_minor core profile context.
-       Default value is an OpenGL 3.3 core profile context. */
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, gl_major);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, gl_minor);
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#elif defined(NANOGUI_USE_GLES)
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, NANOGUI_GLES_VERSION);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
-#elif defined(NANOGUI_USE_METAL)
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-    m_stencil_buffer = stencil_buffer = false;
-#elif defined(NANOGUI_USE_DE)
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-    m_stencil_buffer = stencil_buffer = true;
-#else
-#  error Did not select a graphics API!
-#endif
-
-    int color_bits = 8, depth_bits = 0, stencil_bits = 0;
-
     if (stencil_buffer && !depth_buffer)
         throw std::runtime_error(
             "Screen::Screen(): stencil_buffer = True requires depth_buffer = True");
-    if (depth_buffer)
-        depth_bits = 32;
-    if (stencil_buffer) {
-        depth_bits = 24;
-        stencil_bits = 8;
-    }
-    if (m_float_buffer)
-        color_bits = 16;
-
-    glfwWindowHint(GLFW_RED_BITS, color_bits);
-    glfwWindowHint(GLFW_GREEN_BITS, color_bits);
-    glfwWindowHint(GLFW_BLUE_BITS, color_bits);
-    glfwWindowHint(GLFW_ALPHA_BITS, color_bits);
-    glfwWindowHint(GLFW_STENCIL_BITS, stencil_bits);
-    glfwWindowHint(GLFW_DEPTH_BITS, depth_bits);
-
-#if (defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_METAL)) && defined(GLFW_FLOATBUFFER)
-    glfwWindowHint(GLFW_FLOATBUFFER, m_float_buffer ? GL_TRUE : GL_FALSE);
-#else
-    m_float_buffer = false;
-#endif
 
-    glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
-    glfwWindowHint(GLFW_RESIZABLE, resizable ? GL_TRUE : GL_FALSE);
+    /* Try the render devices in order of decreasing priority. Opt-in
+       devices such as the software renderer must be requested by name */
+    std::vector<std::string> backends;
+    if (const char *backend = std::getenv("NANOGUI_RENDER_DEVICE"))
+        backends.push_back(backend);
+    else
+        backends = RenderDevice::backends();
+
+    for (size_t attempt = 0; attempt < backends.size() && !m_glfw_window; ++attempt) {
+        if (attempt > 0) {
+            fprintf(stderr, "Could not create a window using the \"%s\" render "
+                    "device, trying \"%s\"..\n", backends[attempt - 1].c_str(),
+                    backends[attempt].c_str());
+            glfwDefaultWindowHints();
+        }
 
-    for (int i = 0; i < 2; ++i) {
-        if (fullscreen) {
-            GLFWmonitor *monitor = glfwGetPrimaryMonitor();
-            const GLFWvidmode *mode = glfwGetVideoMode(monitor);
-            m_glfw_window = glfwCreateWindow(mode->width, mode->height,
-                                             caption.c_str(), monitor, nullptr);
-        } else {
-            m_glfw_window = glfwCreateWindow(size.x(), size.y(),
-                                             caption.c_str(), nullptr, nullptr);
+        m_render_device = RenderDevice::create(backends[attempt]);
+        m_stencil_buffer = stencil_buffer;
+        m_float_buffer = float_buffer;
+        m_render_device->window_hints(this, gl_major, gl_minor);
+
+        int color_bits = 8, depth_bits = 0, stencil_bits = 0;
+        if (depth_buffer)
+            depth_bits = 32;
+        if (m_stencil_buffer) {
+            depth_bits = 24;
+            stencil_bits = 8;
         }
+        if (m_float_buffer)
+            color_bits = 16;
+
+        glfwWindowHint(GLFW_RED_BITS, color_bits);
+        glfwWindowHint(GLFW_GREEN_BITS, color_bits);
+        glfwWindowHint(GLFW_BLUE_BITS, color_bits);
+        glfwWindowHint(GLFW_ALPHA_BITS, color_bits);
+        glfwWindowHint(GLFW_STENCIL_BITS, stencil_bits);
+        glfwWindowHint(GLFW_DEPTH_BITS, depth_bits);
+
+        glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+        glfwWindowHint(GLFW_RESIZABLE, resizable ? GL_TRUE : GL_FALSE);
+
+        for (int i = 0; i < 2; ++i) {
+            if (fullscreen) {
+                GLFWmonitor *monitor = glfwGetPrimaryMonitor();
+                const GLFWvidmode *mode = glfwGetVideoMode(monitor);
+                m_glfw_window = glfwCreateWindow(mode->width, mode->height,
+                                                 caption.c_str(), monitor, nullptr);
+            } else {
+                m_glfw_window = glfwCreateWindow(size.x(), size.y(),
+                                                 caption.c_str(), nullptr, nullptr);
+            }
 
-        if (m_glfw_window == nullptr && m_float_buffer) {
-            m_float_buffer = false;
+            if (m_glfw_window == nullptr && m_float_buffer) {
+                m_float_buffer = false;
 #if defined(GLFW_FLOATBUFFER)
-            glfwWindowHint(GLFW_FLOATBUFFER, GL_FALSE);
+                glfwWindowHint(GLFW_FLOATBUFFER, GL_FALSE);
 #endif
-            fprintf(stderr, "Could not allocate floating point framebuffer, retrying without..\n");
-        } else {
-            break;
-        }
-    }
-
-#if defined(NANOGUI_USE_OPENGL)
-    if (m_float_buffer) {
-        GLboolean float_mode;
-        CHK(glGetBooleanv(GL_RGBA_FLOAT_MODE, &float_mode));
-        if (!float_mode) {
-            fprintf(stderr, "Could not allocate floating point framebuffer.\n");
-            m_float_buffer = false;
+                fprintf(stderr, "Could not allocate floating point framebuffer, retrying without..\n");
+            } else {
+                break;
+            }
         }
     }
-#endif
 
     if (!m_glfw_window) {
-        (void) gl_major; (void) gl_minor;
 #if defined(NANOGUI_USE_OPENGL)
         throw std::runtime_error("Could not create an OpenGL " +
                                  std::to_string(gl_major) + "." +
@@ -286,37 +267,14 @@ Screen::Screen(const Vector2i &size, const std::string &caption, NVGcontext *con
 #elif defined(NANOGUI_USE_METAL)
         throw std::runtime_error(
             "Could not create a GLFW window for rendering using Metal!");
+#else
+        throw std::runtime_error("Could not create a GLFW window!");
 #endif
     }
 
-#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
-    glfwMakeContextCurrent(m_glfw_window);
-#endif
-
     glfwSetInputMode(m_glfw_window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-
-#if defined(NANOGUI_GLAD)
-    if (!glad_initialized) {
-        glad_initialized = true;
-        if (!gladLoadGLLoader((GLADloadproc) glfwGetProcAddress))
-            throw std::runtime_error("Could not initialize GLAD!");
-        glGetError(); // pull and ignore unhandled errors like GL_INVALID_ENUM
-    }
-#endif
-
     glfwGetFramebufferSize(m_glfw_window, &m_fbsize[0], &m_fbsize[1]);
 
-#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
-    CHK(glViewport(0, 0, m_fbsize[0], m_fbsize[1]));
-    CHK(glClearColor(m_background[0], m_background[1],
-                     m_background[2], m_background[3]));
-    CHK(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT |
-                GL_STENCIL_BUFFER_BIT));
-
-    glfwSwapInterval(0);
-    glfwSwapBuffers(m_glfw_window);
-#endif
-
 #if defined(__APPLE__)
     /* Poll for events once before starting a potentially
        lengthy loading process. This is needed to be
@@ -326,13 +284,13 @@ Screen::Screen(const Vector2i &size, const std::string &caption, NVGcontext *con
     glfwPollEvents();
 #endif
 
-    /* Propagate GLFW events to the appropriate Screen instance */
+    /* Propagate GLFW events to the appropriate Screen instance (which
+       initialize() stores in the window's user pointer) */
     glfwSetCursorPosCallback(m_glfw_window,
         [](GLFWwindow *w, double x, double y) {
-            auto it = __nanogui_screens.find(w);
-            if (it == __nanogui_screens.end())
+            Screen *s = (Screen *) glfwGetWindowUserPointer(w);
+            if (!s)
                 return;
-            Screen *s = it->second;
             if (!s->m_process_events)
                 return;
             s->cursor_pos_callback_event(x, y);
@@ -341,10 +299,9 @@ Screen::Screen(const Vector2i &size, const std::string &caption, NVGcontext *con
 
     glfwSetMouseButtonCallback(m_glfw_window,
         [](GLFWwindow *w, int button, int action, int modifiers) {
-            auto it = __nanogui_screens.find(w);
-            if (it == __nanogui_screens.end())
+            Screen *s = (Screen *) glfwGetWindowUserPointer(w);
+            if (!s)
                 return;
-            Screen *s = it->second;
             if (!s->m_process_events)
                 return;
             s->mouse_button_callback_event(button, action, modifiers);
@@ -353,10 +310,9 @@ Screen::Screen(const Vector2i &size, const std::string &caption, NVGcontext *con
 
     glfwSetKeyCallback(m_glfw_window,
         [](GLFWwindow *w, int key, int scancode, int action, int mods) {
-            auto it = __nanogui_screens.find(w);
-            if (it == __nanogui_screens.end())
+            Screen *s = (Screen *) glfwGetWindowUserPointer(w);
+            if (!s)
                 return;
-            Screen *s = it->second;
             if (!s->m_process_events)
                 return;
             s->key_callback_event(key, scancode, action, mods);
@@ -365,10 +321,9 @@ Screen::Screen(const Vector2i &size, const std::string &caption, NVGcontext *con
 
     glfwSetCharCallback(m_glfw_window,
         [](GLFWwindow *w, unsigned int codepoint) {
-            auto it = __nanogui_screens.find(w);
-            if (it == __nanogui_screens.end())
+            Screen *s = (Screen *) glfwGetWindowUserPointer(w);
+            if (!s)
                 return;
-            Screen *s = it->second;
             if (!s->m_process_events)
                 return;
             s->char_callback_event(codepoint);
@@ -377,10 +332,9 @@ Screen::Screen(const Vector2i &size, const std::string &caption, NVGcontext *con
 
     glfwSetDropCallback(m_glfw_window,
         [](GLFWwindow *w, int count, const char **filenames) {
-            auto it = __nanogui_screens.find(w);
-            if (it == __nanogui_screens.end())
+            Screen *s = (Screen *) glfwGetWindowUserPointer(w);
+            if (!s)
                 return;
-            Screen *s = it->second;
             if (!s->m_process_events)
                 return;
             s->drop_callback_event(count, filenames);
@@ -389,10 +343,9 @@ Screen::Screen(const Vector2i &size, const std::string &caption, NVGcontext *con
 
     glfwSetScrollCallback(m_glfw_window,
         [](GLFWwindow *w, double x, double y) {
-            auto it = __nanogui_screens.find(w);
-            if (it == __nanogui_screens.end())
+            Screen *s = (Screen *) glfwGetWindowUserPointer(w);
+            if (!s)
                 return;
-            Screen *s = it->second;
             if (!s->m_process_events)
                 return;
             s->scroll_callback_event(x, y);
@@ -405,10 +358,9 @@ Screen::Screen(const Vector2i &size, const std::string &caption, NVGcontext *con
        screen on Mac OS X */
     glfwSetFramebufferSizeCallback(m_glfw_window,
         [](GLFWwindow* w, int width, int height) {
-            auto it = __nanogui_screens.find(w);
-            if (it == __nanogui_screens.end())
+            Screen *s = (Screen *) glfwGetWindowUserPointer(w);
+            if (!s)
                 return;
-            Screen *s = it->second;
 
             if (!s->m_process_events)
                 return;
@@ -420,35 +372,19 @@ Screen::Screen(const Vector2i &size, const std::string &caption, NVGcontext *con
     // notify when the screen has lost focus (e.g. application switch)
     glfwSetWindowFocusCallback(m_glfw_window,
         [](GLFWwindow *w, int focused) {
-            auto it = __nanogui_screens.find(w);
-            if (it == __nanogui_screens.end())
+            Screen *s = (Screen *) glfwGetWindowUserPointer(w);
+            if (!s)
                 return;
 
-            Screen *s = it->second;
             // focus_event: 0 when false, 1 when true
             s->focus_event(focused != 0);
         }
     );
-    initialize(m_glfw_window, true,context);
-
-#if defined(NANOGUI_USE_METAL)
-    if (depth_buffer) {
-        m_depth_stencil_texture = new Texture(
-            stencil_buffer ? Texture::PixelFormat::DepthStencil
-                           : Texture::PixelFormat::Depth,
-            Texture::ComponentFormat::Float32,
-            framebuffer_size(),
-            Texture::InterpolationMode::Bilinear,
-            Texture::InterpolationMode::Bilinear,
-            Texture::WrapMode::ClampToEdge,
-            1,
-            Texture::TextureFlags::RenderTarget
-        );
-    }
-#endif
+    initialize(m_glfw_window, true, context);
 }
 
-void Screen::initialize(GLFWwindow *window, bool shutdown_glfw, NVGcontext *context) {
+void Screen::initialize(GLFWwindow *window, bool shutdown_glfw, NVGcontext *context,
+                        RenderDevice *device) {
     m_glfw_window = window;
     m_shutdown_glfw = shutdown_glfw;
     glfwGetWindowSize(m_glfw_window, &m_size[0], &m_size[1]);
@@ -481,14 +417,16 @@ void Screen::initialize(GLFWwindow *window, bool shutdown_glfw, NVGcontext *cont
                                   m_size.y() * m_pixel_ratio);
 #endif
 
-#if defined(NANOGUI_GLAD)
-    if (!glad_initialized) {
-        glad_initialized = true;
-        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-            throw std::runtime_error("Could not initialize GLAD!");
-        glGetError(); // pull and ignore unhandled errors like GL_INVALID_ENUM
-    }
-#endif
+    if (device)
+        m_render_device = device;
+    else if (sw_nvg_is_software(context))
+        /* Draw into the framebuffer of the software renderer */
+        m_render_device = RenderDevice::create("software");
+    else if (!m_render_device)
+        /* The window was created by the application */
+        m_render_device = RenderDevice::create(RenderDevice::backends().front());
+
+    m_render_device->init_window(this);
 
     int flags = NVG_ANTIALIAS;
     if (m_stencil_buffer)
@@ -497,20 +435,11 @@ void Screen::initialize(GLFWwindow *window, bool shutdown_glfw, NVGcontext *cont
     flags |= NVG_DEBUG;
 #endif
 
-#if defined(NANOGUI_USE_OPENGL)
-    m_nvg_context = nvgCreateGL3(flags);
-#elif defined(NANOGUI_USE_GLES)
-    m_nvg_context = nvgCreateGLES2(flags);
-#elif defined(NANOGUI_USE_METAL)
-    void *nswin = glfwGetCocoaWindow(window);
-    metal_window_init(nswin, m_float_buffer);
-    metal_window_set_size(nswin, m_fbsize);
-    m_nvg_context = nvgCreateMTL(metal_layer(),
-                                 metal_command_queue(),
-                                 flags | NVG_TRIPLE_BUFFER);
-#elif defined(NANOGUI_USE_DE)
-    m_nvg_context=context;
-#endif
+    /* Externally created contexts are owned by the caller, unless it also
+       provides the device that releases them */
+    m_external_nvg_context = context != nullptr && !device;
+    m_nvg_context = context ? context
+                            : m_render_device->create_nvg_context(this, flags);
 
     if (!m_nvg_context)
         throw std::runtime_error("Could not initialize NanoVG!");
@@ -524,6 +453,7 @@ void Screen::initialize(GLFWwindow *window, bool shutdown_glfw, NVGcontext *cont
     m_process_events = true;
     m_redraw = true;
     __nanogui_screens[m_glfw_window] = this;
+    glfwSetWindowUserPointer(m_glfw_window, this);
 
     for (size_t i = 0; i < (size_t) Cursor::CursorCount; ++i)
         m_cursors[i] = glfwCreateStandardCursor(GLFW_ARROW_CURSOR + (int) i);
@@ -531,24 +461,29 @@ void Screen::initialize(GLFWwindow *window, bool shutdown_glfw, NVGcontext *cont
     /// Fixes retina display-related font rendering issue (#185)
     nvgBeginFrame(m_nvg_context, m_size[0], m_size[1], m_pixel_ratio);
     nvgEndFrame(m_nvg_context);
+
+    /* Rasterize common glyphs before the first frame is drawn */
+    m_theme->prewarm_glyphs(m_nvg_context, m_pixel_ratio);
 }
 
 Screen::~Screen() {
     __nanogui_screens.erase(m_glfw_window);
+    if (m_glfw_window && glfwGetWindowUserPointer(m_glfw_window) == this)
+        glfwSetWindowUserPointer(m_glfw_window, nullptr);
     for (size_t i = 0; i < (size_t) Cursor::CursorCount; ++i) {
         if (m_cursors[i])
             glfwDestroyCursor(m_cursors[i]);
     }
 
-    if (m_nvg_context) {
-#if defined(NANOGUI_USE_OPENGL)
-        nvgDeleteGL3(m_nvg_context);
-#elif defined(NANOGUI_USE_GLES)
-        nvgDeleteGLES2(m_nvg_context);
-#elif defined(NANOGUI_USE_METAL)
-        nvgDeleteMTL(m_nvg_context);
-#endif
+    /* Timer queries belong to the context of this screen */
+    m_profiler = nullptr;
+
+    if (m_render_device) {
+        if (m_nvg_context && !m_external_nvg_context)
+            m_render_device->delete_nvg_context(this, m_nvg_context);
+        m_render_device->release(this);
     }
+    m_nvg_context = nullptr;
 
     if (m_glfw_window && m_shutdown_glfw)
         glfwDestroyWindow(m_glfw_window);
@@ -584,24 +519,11 @@ void Screen::set_size(const Vector2i &size) {
 }
 
 void Screen::clear() {
-#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
-    CHK(glClearColor(m_background[0], m_background[1], m_background[2], m_background[3]));
-    CHK(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT));
-#elif defined(NANOGUI_USE_METAL)
-    mnvgClearWithColor(m_nvg_context, m_background);
-#endif
+    m_render_device->clear(this);
 }
 
 void Screen::draw_setup() {
-#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
-    glfwMakeContextCurrent(m_glfw_window);
-#elif defined(NANOGUI_USE_METAL)
-    void *nswin = glfwGetCocoaWindow(m_glfw_window);
-    metal_window_set_size(nswin, m_fbsize);
-    m_metal_drawable = metal_window_next_drawable(nswin);
-    m_metal_texture = metal_drawable_texture(m_metal_drawable);
-    mnvgSetColorTexture(m_nvg_context, m_metal_texture);
-#endif
+    m_render_device->begin_frame(this);
 
 #if !defined(EMSCRIPTEN)
     glfwGetFramebufferSize(m_glfw_window, &m_fbsize[0], &m_fbsize[1]);
@@ -620,29 +542,42 @@ void Screen::draw_setup() {
         m_pixel_ratio = (float) m_fbsize[0] / (float) m_size[0];
 #endif
 
-#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
-    CHK(glViewport(0, 0, m_fbsize[0], m_fbsize[1]));
-#endif
+    /* Application code may have changed the graphics state between frames */
+    m_render_device->invalidate_state(this);
+
+    if (m_profiler) {
+        m_profiler->begin_frame();
+        FrameProfiler::set_current(m_profiler);
+    }
 }
 
 void Screen::draw_teardown() {
-#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
-    glfwSwapBuffers(m_glfw_window);
-#elif defined(NANOGUI_USE_METAL)
-    mnvgSetColorTexture(m_nvg_context, nullptr);
-    metal_present_and_release_drawable(m_metal_drawable);
-    m_metal_texture = nullptr;
-    m_metal_drawable = nullptr;
-#endif
+    if (m_profiler) {
+        FrameProfiler::set_current(nullptr);
+        m_profiler->end_frame();
+    }
+
+    m_render_device->end_frame(this);
 }
 
 void Screen::draw_all() {
-    if (m_redraw) {
-        m_redraw = false;
+    /* Clear the flag before drawing, requests made in the meantime (e.g.
+       by worker threads) then lead to another frame */
+    if (m_redraw.exchange(false)) {
+        /* The profiler may be disabled by the application while drawing */
+        ref<FrameProfiler> profiler = m_profiler;
 
         draw_setup();
+        if (profiler)
+            profiler->push("Contents");
         draw_contents();
+        if (profiler) {
+            profiler->pop();
+            profiler->push("NanoVG");
+        }
         draw_widgets();
+        if (profiler)
+            profiler->pop();
         draw_teardown();
     }
 }
@@ -655,9 +590,67 @@ void Screen::nvg_flush() {
     NVGparams *params = nvgInternalParams(m_nvg_context);
     params->renderFlush(params->userPtr);
     params->renderViewport(params->userPtr, m_size[0], m_size[1], m_pixel_ratio);
+    m_render_device->invalidate_state(this);
+}
+
+TexturePool *Screen::texture_pool() {
+    if (!m_texture_pool)
+        m_texture_pool = new TexturePool();
+    return m_texture_pool;
+}
+
+void Screen::set_profiling(bool profiling) {
+    if (profiling == (m_profiler.get() != nullptr))
+        return;
+
+#if defined(NANOGUI_USE_OPENGL)
+    /* Timer queries are created and destroyed in the context of this screen */
+    if (m_render_device->supports_shaders())
+        glfwMakeContextCurrent(m_glfw_window);
+#endif
+
+    if (profiling) {
+        m_profiler = new FrameProfiler(m_render_device->supports_shaders());
+    } else {
+        m_profiler = nullptr;
+        m_profiler_overlay = false;
+    }
+    redraw();
+}
+
+const FrameProfiler::Stats &Screen::frame_stats() const {
+    static const FrameProfiler::Stats empty;
+    return m_profiler ? m_profiler->stats() : empty;
+}
+
+void Screen::set_profiler_overlay(bool overlay) {
+    if (overlay)
+        set_profiling(true);
+    m_profiler_overlay = overlay;
+    redraw();
+}
+
+/// Render composited canvases before the NanoVG frame begins
+static void render_offscreen(Widget *widget) {
+    for (Widget *child : widget->children()) {
+        if (!child->visible())
+            continue;
+        Canvas *canvas = dynamic_cast<Canvas *>(child);
+        if (canvas && canvas->composite())
+            canvas->render_offscreen();
+        render_offscreen(child);
+    }
 }
 
 void Screen::draw_widgets() {
+    /* No-op unless the pixel ratio or theme font sizes have changed */
+    m_theme->prewarm_glyphs(m_nvg_context, m_pixel_ratio);
+
+    /* Glyph rasterization may have bound NanoVG's font atlas */
+    m_render_device->invalidate_state(this);
+
+    render_offscreen(this);
+
     nvgBeginFrame(m_nvg_context, m_size[0], m_size[1], m_pixel_ratio);
 
     draw(m_nvg_context);
@@ -721,7 +714,11 @@ void Screen::draw_widgets() {
         }
     }
 
+    if (m_profiler_overlay && m_profiler)
+        m_profiler->draw_overlay(m_nvg_context, Vector2f(10.f, 10.f));
+
     nvgEndFrame(m_nvg_context);
+    m_render_device->invalidate_state(this);
 }
 
 bool Screen::keyboard_event(int key, int scancode, int action, int modifiers) {
@@ -752,8 +749,9 @@ bool Screen::resize_event(const Vector2i& size) {
 }
 
 void Screen::redraw() {
-    if (!m_redraw) {
-        m_redraw = true;
+    /* Only the first request since the last frame wakes up the main loop
+       (glfwPostEmptyEvent() may be called from any thread) */
+    if (!m_redraw.exchange(true)) {
         #if !defined(EMSCRIPTEN)
             glfwPostEmptyEvent();
         #endif
@@ -788,7 +786,8 @@ void Screen::cursor_pos_callback_event(double x, double y) {
             ret = mouse_motion_event(p, p - m_mouse_pos, m_mouse_state, m_modifiers);
 
         m_mouse_pos = p;
-        m_redraw |= ret;
+        if (ret)
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -821,9 +820,10 @@ void Screen::mouse_button_callback_event(int button, int action, int modifiers)
         auto drop_widget = find_widget(m_mouse_pos);
         if (m_drag_active && action == GLFW_RELEASE &&
             drop_widget != m_drag_widget) {
-            m_redraw |= m_drag_widget->mouse_button_event(
-                m_mouse_pos - m_drag_widget->parent()->absolute_position(), button,
-                false, m_modifiers);
+            if (m_drag_widget->mouse_button_event(
+                    m_mouse_pos - m_drag_widget->parent()->absolute_position(), button,
+                    false, m_modifiers))
+                m_redraw = true;
         }
 
         if (drop_widget != nullptr && drop_widget->cursor() != m_cursor) {
@@ -845,8 +845,9 @@ void Screen::mouse_button_callback_event(int button, int action, int modifiers)
             m_drag_widget = nullptr;
         }
 
-        m_redraw |= mouse_button_event(m_mouse_pos, button,
-                                       action == GLFW_PRESS, m_modifiers);
+        if (mouse_button_event(m_mouse_pos, button, action == GLFW_PRESS,
+                               m_modifiers))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -855,7 +856,8 @@ void Screen::mouse_button_callback_event(int button, int action, int modifiers)
 void Screen::key_callback_event(int key, int scancode, int action, int mods) {
     m_last_interaction = glfwGetTime();
     try {
-        m_redraw |= keyboard_event(key, scancode, action, mods);
+        if (keyboard_event(key, scancode, action, mods))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -864,7 +866,8 @@ void Screen::key_callback_event(int key, int scancode, int action, int mods) {
 void Screen::char_callback_event(unsigned int codepoint) {
     m_last_interaction = glfwGetTime();
     try {
-        m_redraw |= keyboard_character_event(codepoint);
+        if (keyboard_character_event(codepoint))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -874,7 +877,8 @@ void Screen::drop_callback_event(int count, const char **filenames) {
     std::vector<std::string> arg(count);
     for (int i = 0; i < count; ++i)
         arg[i] = filenames[i];
-    m_redraw |= drop_event(arg);
+    if (drop_event(arg))
+        m_redraw = true;
 }
 
 void Screen::scroll_callback_event(double x, double y) {
@@ -888,7 +892,8 @@ void Screen::scroll_callback_event(double x, double y) {
                     return;
             }
         }
-        m_redraw |= scroll_event(m_mouse_pos, Vector2f(x, y));
+        if (scroll_event(m_mouse_pos, Vector2f(x, y)))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -911,10 +916,7 @@ void Screen::resize_callback_event(int, int) {
 
     m_last_interaction = glfwGetTime();
 
-#if defined(NANOGUI_USE_METAL)
-    if (m_depth_stencil_texture)
-        m_depth_stencil_texture->resize(fb_size);
-#endif
+    m_render_device->resize(this, fb_size);
 
     try {
         resize_event(m_size);
@@ -983,6 +985,86 @@ void Screen::move_window_to_front(Window *window) {
     } while (changed);
 }
 
+void Screen::set_target_frame_rate(float fps) {
+    m_target_frame_rate = fps;
+    /* Start the new schedule with the next iteration of the main loop */
+    m_next_frame = 0.0;
+    redraw();
+}
+
+double Screen::update_schedule(double now, float refresh) {
+    double period = 0.0;
+    if (m_target_frame_rate > 0.f)
+        period = 1.0 / m_target_frame_rate;
+    else if (refresh > 0.f)
+        period = refresh / 1000.0;
+
+    double deadline = std::numeric_limits<double>::infinity();
+    if (period == 0.0) {
+        m_next_frame = 0.0;
+    } else {
+        if (now >= m_next_frame) {
+            /* Called by the main loop, which does not need to be woken up */
+            m_redraw = true;
+            m_next_frame += period;
+            /* Skip the frames that were missed instead of catching up */
+            if (m_next_frame <= now)
+                m_next_frame = now + period;
+        }
+        deadline = m_next_frame;
+    }
+
+    /* Fade in the tooltip of the widget under the cursor: the first frame
+       is due 0.25 s after the last interaction, followed by a frame every
+       50 ms until the fade has completed */
+    double elapsed = now - m_last_interaction;
+    if (elapsed <= 1.25) {
+        const Widget *widget = find_widget(m_mouse_pos);
+        if (widget && !widget->tooltip().empty()) {
+            double tooltip_frame = m_last_interaction + 0.25;
+            if (now >= tooltip_frame) {
+                m_redraw = true;
+                tooltip_frame = now + 0.05;
+            }
+            deadline = std::min(deadline, tooltip_frame);
+        }
+    }
+
+    return deadline;
+}
+
+int Screen::refresh_rate() const {
+    GLFWmonitor *monitor = glfwGetWindowMonitor(m_glfw_window);
+
+    if (!monitor) {
+        /* Find the monitor that shows the largest part of the window */
+        int wx, wy, ww, wh, count = 0, best_area = 0;
+        glfwGetWindowPos(m_glfw_window, &wx, &wy);
+        glfwGetWindowSize(m_glfw_window, &ww, &wh);
+        GLFWmonitor **monitors = glfwGetMonitors(&count);
+
+        for (int i = 0; i < count; ++i) {
+            const GLFWvidmode *mode = glfwGetVideoMode(monitors[i]);
+            if (!mode)
+                continue;
+            int mx, my;
+            glfwGetMonitorPos(monitors[i], &mx, &my);
+            int w = std::min(wx + ww, mx + mode->width) - std::max(wx, mx),
+                h = std::min(wy + wh, my + mode->height) - std::max(wy, my);
+            if (w > 0 && h > 0 && w * h > best_area) {
+                best_area = w * h;
+                monitor = monitors[i];
+            }
+        }
+    }
+
+    if (!monitor)
+        return 0;
+
+    const GLFWvidmode *mode = glfwGetVideoMode(monitor);
+    return mode ? mode->refreshRate : 0;
+}
+
 bool Screen::tooltip_fade_in_progress() const {
     double elapsed = glfwGetTime() - m_last_interaction;
     if (elapsed < 0.25f || elapsed > 1.25f)
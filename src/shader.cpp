@@ -2,6 +2,82 @@
 
 NAMESPACE_BEGIN(nanogui)
 
+static std::string program_cache_path_value;
+
+void Shader::set_program_cache_path(const std::string &path) {
+    program_cache_path_value = path;
+}
+
+const std::string &Shader::program_cache_path() {
+    return program_cache_path_value;
+}
+
+size_t Shader::binding(const std::string &name) {
+    if (m_pending)
+        wait();
+    auto it = m_bindings.find(name);
+    if (it == m_bindings.end())
+        throw std::runtime_error(
+            "Shader::binding(): could not find argument named \"" + name + "\"");
+    return it->second;
+}
+
+Shader::Buffer &Shader::add_buffer(const std::string &name) {
+    m_bindings[name] = m_buffers.size();
+    Buffer &buf = m_buffers.emplace_back();
+    buf.name = name;
+    return buf;
+}
+
+void Shader::set_buffer(const std::string &name, VariableType dtype,
+                        size_t ndim, const size_t *shape, const void *data) {
+    set_buffer(binding(name), dtype, ndim, shape, data);
+}
+
+void Shader::set_buffer_range(const std::string &name, size_t offset,
+                              size_t count, const void *data) {
+    set_buffer_range(binding(name), offset, count, data);
+}
+
+void Shader::set_buffer_usage(const std::string &name, BufferUsage usage) {
+    set_buffer_usage(binding(name), usage);
+}
+
+void Shader::set_buffer_usage(size_t binding, BufferUsage usage) {
+    Buffer &buf = buffer(binding, "Shader::set_buffer_usage()");
+    if (buf.type != VertexBuffer && buf.type != IndexBuffer)
+        throw std::runtime_error(
+            "Shader::set_buffer_usage(): argument named \"" + buf.name + "\" is not a vertex/index buffer!");
+    buf.usage = usage;
+}
+
+void Shader::set_buffer_divisor(const std::string &name, uint32_t divisor) {
+    set_buffer_divisor(binding(name), divisor);
+}
+
+void Shader::set_buffer_divisor(size_t binding, uint32_t divisor) {
+    Buffer &buf = buffer(binding, "Shader::set_buffer_divisor()");
+    if (buf.type != VertexBuffer)
+        throw std::runtime_error(
+            "Shader::set_buffer_divisor(): argument named \"" + buf.name + "\" is not a vertex buffer!");
+#if defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION == 2
+    if (divisor != 0)
+        throw std::runtime_error(
+            "Shader::set_buffer_divisor(): instancing is not supported by OpenGL ES 2!");
+#endif
+    buf.divisor = divisor;
+    buf.dirty = true;
+}
+
+void Shader::draw_array(PrimitiveType primitive_type, size_t offset,
+                        size_t count, bool indexed) {
+    draw_array_instanced(primitive_type, offset, count, 1, indexed);
+}
+
+void Shader::set_texture(const std::string &name, Texture *texture) {
+    set_texture(binding(name), texture);
+}
+
 std::string Shader::Buffer::to_string() const {
     std::string result = "Buffer[type=";
     switch (type) {
@@ -3,6 +3,8 @@
 #include <nanogui/screen.h>
 #include <nanogui/texture.h>
 #include <nanogui/renderpass.h>
+#include <nanogui/glstate.h>
+#include <nanogui/vertexbuffer.h>
 #include "opengl_check.h"
 
 #if !defined(GL_HALF_FLOAT)
@@ -11,9 +13,16 @@
 
 NAMESPACE_BEGIN(nanogui)
 
-static GLuint compile_gl_shader(GLenum type,
-                                const std::string &name,
-                                const std::string &shader_string) {
+/* Entry points of newer versions and extensions are resolved at runtime,
+   since the loader may only cover older versions */
+#if defined(_WIN32)
+#  define NANOGUI_GLAPIENTRY __stdcall
+#else
+#  define NANOGUI_GLAPIENTRY
+#endif
+
+/// Issue compilation of a shader without waiting for the result
+static GLuint compile_gl_shader(GLenum type, const std::string &shader_string) {
     if (shader_string.empty())
         return (GLuint) 0;
 
@@ -21,76 +30,152 @@ static GLuint compile_gl_shader(GLenum type,
     const char *shader_string_const = shader_string.c_str();
     CHK(glShaderSource(id, 1, &shader_string_const, nullptr));
     CHK(glCompileShader(id));
+    return id;
+}
+
+/// Wait for the compilation of a shader and return an error message upon failure
+static std::string check_gl_shader(GLenum type, const std::string &name, GLuint id) {
+    if (id == 0)
+        return std::string();
 
     GLint status;
     CHK(glGetShaderiv(id, GL_COMPILE_STATUS, &status));
 
-    if (status != GL_TRUE) {
-        const char *type_str = nullptr;
-        if (type == GL_VERTEX_SHADER)
-            type_str = "vertex shader";
-        else if (type == GL_FRAGMENT_SHADER)
-            type_str = "fragment shader";
+    if (status == GL_TRUE)
+        return std::string();
+
+    const char *type_str = nullptr;
+    if (type == GL_VERTEX_SHADER)
+        type_str = "vertex shader";
+    else if (type == GL_FRAGMENT_SHADER)
+        type_str = "fragment shader";
 #if defined(NANOGUI_USE_OPENGL)
-        else if (type == GL_GEOMETRY_SHADER)
-            type_str = "geometry shader";
+    else if (type == GL_GEOMETRY_SHADER)
+        type_str = "geometry shader";
 #endif
-        else
-            type_str = "unknown shader type";
+    else
+        type_str = "unknown shader type";
 
-        char error_shader[4096];
-        CHK(glGetShaderInfoLog(id, sizeof(error_shader), nullptr, error_shader));
+    char error_shader[4096];
+    CHK(glGetShaderInfoLog(id, sizeof(error_shader), nullptr, error_shader));
 
-        std::string msg = std::string("compile_gl_shader(): unable to compile ") +
-                          type_str + " \"" + name + "\":\n\n" + error_shader;
-        throw std::runtime_error(msg);
-    }
+    return std::string("compile_gl_shader(): unable to compile ") +
+           type_str + " \"" + name + "\":\n\n" + error_shader;
+}
 
-    return id;
+#if !defined(GL_COMPLETION_STATUS_KHR)
+#  define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+/// Enable KHR/ARB_parallel_shader_compile (if available) and report whether it is
+static bool parallel_compile_supported() {
+    static int supported = -1;
+    if (supported < 0) {
+        using MaxShaderCompilerThreadsProc = void (NANOGUI_GLAPIENTRY *)(GLuint);
+        MaxShaderCompilerThreadsProc max_threads = nullptr;
+        if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+            max_threads = (MaxShaderCompilerThreadsProc)
+                glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+        else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+            max_threads = (MaxShaderCompilerThreadsProc)
+                glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+
+        /* Let the driver choose the number of compiler threads */
+        if (max_threads)
+            max_threads(0xFFFFFFFFu);
+        supported = max_threads ? 1 : 0;
+    }
+    return supported == 1;
 }
 
-Shader::Shader(RenderPass *render_pass,
-               const std::string &name,
-               const std::string &vertex_shader,
-               const std::string &fragment_shader,
-               BlendMode blend_mode)
-    : m_render_pass(render_pass), m_name(name), m_blend_mode(blend_mode), m_shader_handle(0) {
+/* Program binaries require GL 4.1, GLES 3.0, or OES_get_program_binary */
+#if !defined(GL_PROGRAM_BINARY_RETRIEVABLE_HINT)
+#  define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#if !defined(GL_PROGRAM_BINARY_LENGTH)
+#  define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#if !defined(GL_NUM_PROGRAM_BINARY_FORMATS)
+#  define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
 
-    GLuint vertex_shader_handle   = compile_gl_shader(GL_VERTEX_SHADER,   name, vertex_shader),
-           fragment_shader_handle = compile_gl_shader(GL_FRAGMENT_SHADER, name, fragment_shader);
+using GetProgramBinaryProc = void (NANOGUI_GLAPIENTRY *)(GLuint, GLsizei, GLsizei *,
+                                                         GLenum *, void *);
+using ProgramBinaryProc = void (NANOGUI_GLAPIENTRY *)(GLuint, GLenum, const void *, GLsizei);
+using ProgramParameteriProc = void (NANOGUI_GLAPIENTRY *)(GLuint, GLenum, GLint);
 
-    m_shader_handle = glCreateProgram();
+static GetProgramBinaryProc gl_get_program_binary = nullptr;
+static ProgramBinaryProc gl_program_binary = nullptr;
+static ProgramParameteriProc gl_program_parameteri = nullptr;
 
-    GLint status;
-    CHK(glAttachShader(m_shader_handle, vertex_shader_handle));
-    CHK(glAttachShader(m_shader_handle, fragment_shader_handle));
-    CHK(glLinkProgram(m_shader_handle));
-    CHK(glDeleteShader(vertex_shader_handle));
-    CHK(glDeleteShader(fragment_shader_handle));
-    CHK(glGetProgramiv(m_shader_handle, GL_LINK_STATUS, &status));
+/// Version of the program cache file format
+static const uint32_t program_cache_version = 1;
 
-    if (status != GL_TRUE) {
-        char error_shader[4096];
-        CHK(glGetProgramInfoLog(m_shader_handle, sizeof(error_shader), nullptr, error_shader));
-        m_shader_handle = 0;
-        throw std::runtime_error("Shader::Shader(name=\"" + name +
-                                 "\"): unable to link shader!\n\n" + error_shader);
+static bool program_binary_supported() {
+    static int supported = -1;
+    if (supported < 0) {
+        gl_get_program_binary = (GetProgramBinaryProc) glfwGetProcAddress("glGetProgramBinary");
+        gl_program_binary = (ProgramBinaryProc) glfwGetProcAddress("glProgramBinary");
+        gl_program_parameteri = (ProgramParameteriProc) glfwGetProcAddress("glProgramParameteri");
+#if defined(NANOGUI_USE_GLES)
+        if (!gl_get_program_binary || !gl_program_binary) {
+            gl_get_program_binary = (GetProgramBinaryProc) glfwGetProcAddress("glGetProgramBinaryOES");
+            gl_program_binary = (ProgramBinaryProc) glfwGetProcAddress("glProgramBinaryOES");
+        }
+#endif
+        GLint format_count = 0;
+        if (gl_get_program_binary && gl_program_binary)
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+        while (glGetError() != GL_NO_ERROR)
+            ;
+        supported = format_count > 0 ? 1 : 0;
     }
+    return supported == 1;
+}
+
+/// 64-bit FNV-1a hash
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t size) {
+    const uint8_t *ptr = (const uint8_t *) data;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= ptr[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static uint64_t program_cache_key(const std::string &vertex_shader,
+                                  const std::string &fragment_shader) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    hash = fnv1a(hash, &program_cache_version, sizeof(uint32_t));
+
+    const GLenum strings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION,
+                               GL_SHADING_LANGUAGE_VERSION };
+    for (GLenum id : strings) {
+        const char *value = (const char *) glGetString(id);
+        if (value)
+            hash = fnv1a(hash, value, strlen(value) + 1);
+    }
+
+    hash = fnv1a(hash, vertex_shader.c_str(), vertex_shader.size() + 1);
+    hash = fnv1a(hash, fragment_shader.c_str(), fragment_shader.size() + 1);
+    return hash;
+}
 
+void Shader::reflect() {
     GLint attribute_count, uniform_count;
     CHK(glGetProgramiv(m_shader_handle, GL_ACTIVE_ATTRIBUTES, &attribute_count));
     CHK(glGetProgramiv(m_shader_handle, GL_ACTIVE_UNIFORMS, &uniform_count));
 
     auto register_buffer = [&](BufferType type, const std::string &name,
                                int index, GLenum gl_type) {
-        if (m_buffers.find(name) != m_buffers.end())
+        if (m_bindings.find(name) != m_bindings.end())
             throw std::runtime_error(
-                "Shader::Shader(): duplicate attribute/uniform name in shader code!");
+                "Shader::reflect(): duplicate attribute/uniform name in shader code!");
         else if (name == "indices")
             throw std::runtime_error(
-                "Shader::Shader(): argument name 'indices' is reserved!");
+                "Shader::reflect(): argument name 'indices' is reserved!");
 
-        Buffer &buf = m_buffers[name];
+        Buffer &buf = add_buffer(name);
         for (int i = 0; i < 3; ++i)
             buf.shape[i] = 1;
         buf.ndim = 1;
@@ -205,7 +290,7 @@ Shader::Shader(RenderPass *render_pass,
                 break;
 
             default:
-                throw std::runtime_error("Shader::Shader(): unsupported "
+                throw std::runtime_error("Shader::reflect(): unsupported "
                                          "uniform/attribute type!");
         };
 
@@ -237,8 +322,250 @@ Shader::Shader(RenderPass *render_pass,
         GLint index = glGetUniformLocation(m_shader_handle, uniform_name);
         register_buffer(UniformBuffer, uniform_name, index, type);
     }
+}
+
+bool Shader::load_program_binary(const std::string &filename, uint64_t key) {
+    FILE *f = fopen(filename.c_str(), "rb");
+    if (!f)
+        return false;
+
+    std::vector<uint8_t> data;
+    uint8_t chunk[16384];
+    size_t count;
+    while ((count = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        data.insert(data.end(), chunk, chunk + count);
+    fclose(f);
+
+    size_t pos = 0;
+    auto read = [&](void *value, size_t size) {
+        if (pos + size > data.size())
+            return false;
+        memcpy(value, data.data() + pos, size);
+        pos += size;
+        return true;
+    };
+
+    char magic[4];
+    uint32_t version = 0, format = 0, binary_size = 0, buffer_count = 0;
+    uint64_t stored_key = 0;
+    if (!read(magic, 4) || memcmp(magic, "NGPB", 4) != 0 ||
+        !read(&version, sizeof(uint32_t)) || version != program_cache_version ||
+        !read(&stored_key, sizeof(uint64_t)) || stored_key != key ||
+        !read(&format, sizeof(uint32_t)) || !read(&binary_size, sizeof(uint32_t)) ||
+        !read(&buffer_count, sizeof(uint32_t)))
+        return false;
+
+    std::vector<Buffer> buffers(buffer_count);
+    for (Buffer &buf : buffers) {
+        uint32_t name_size = 0, fields[7];
+        if (!read(&name_size, sizeof(uint32_t)) || pos + name_size > data.size())
+            return false;
+        buf.name.assign((const char *) data.data() + pos, name_size);
+        pos += name_size;
+        if (!read(fields, sizeof(fields)))
+            return false;
+        buf.type  = (BufferType) fields[0];
+        buf.dtype = (VariableType) fields[1];
+        buf.index = (int) fields[2];
+        buf.ndim  = fields[3];
+        for (int i = 0; i < 3; ++i)
+            buf.shape[i] = fields[4 + i];
+    }
+
+    if (pos + binary_size != data.size())
+        return false;
+
+    m_shader_handle = glCreateProgram();
+    gl_program_binary(m_shader_handle, (GLenum) format, data.data() + pos,
+                      (GLsizei) binary_size);
+
+    /* Binaries are rejected e.g. following a driver update */
+    GLint status = GL_FALSE;
+    glGetProgramiv(m_shader_handle, GL_LINK_STATUS, &status);
+    while (glGetError() != GL_NO_ERROR)
+        ;
+    if (status != GL_TRUE) {
+        CHK(glDeleteProgram(m_shader_handle));
+        m_shader_handle = 0;
+        return false;
+    }
+
+    for (Buffer &buf : buffers)
+        add_buffer(buf.name) = std::move(buf);
+
+    return true;
+}
+
+void Shader::store_program_binary(const std::string &filename, uint64_t key) {
+    GLint binary_size = 0;
+    CHK(glGetProgramiv(m_shader_handle, GL_PROGRAM_BINARY_LENGTH, &binary_size));
+    if (binary_size <= 0)
+        return;
+
+    std::vector<uint8_t> binary((size_t) binary_size);
+    GLenum format = 0;
+    GLsizei length = 0;
+    CHK(gl_get_program_binary(m_shader_handle, binary_size, &length, &format,
+                              binary.data()));
+    if (length <= 0)
+        return;
+
+    std::vector<uint8_t> data;
+    auto write = [&](const void *value, size_t size) {
+        const uint8_t *ptr = (const uint8_t *) value;
+        data.insert(data.end(), ptr, ptr + size);
+    };
+
+    uint32_t format_u32 = (uint32_t) format,
+             length_u32 = (uint32_t) length,
+             buffer_count = (uint32_t) m_buffers.size();
+    write("NGPB", 4);
+    write(&program_cache_version, sizeof(uint32_t));
+    write(&key, sizeof(uint64_t));
+    write(&format_u32, sizeof(uint32_t));
+    write(&length_u32, sizeof(uint32_t));
+    write(&buffer_count, sizeof(uint32_t));
+
+    for (const Buffer &buf : m_buffers) {
+        uint32_t name_size = (uint32_t) buf.name.size();
+        uint32_t fields[7] = {
+            (uint32_t) buf.type, (uint32_t) buf.dtype, (uint32_t) buf.index,
+            (uint32_t) buf.ndim, (uint32_t) buf.shape[0],
+            (uint32_t) buf.shape[1], (uint32_t) buf.shape[2]
+        };
+        write(&name_size, sizeof(uint32_t));
+        write(buf.name.data(), name_size);
+        write(fields, sizeof(fields));
+    }
+    write(binary.data(), (size_t) length);
+
+    /* Write to a temporary file first so that concurrently running
+       applications never observe a partially written entry */
+    std::string temp_filename = filename + ".tmp";
+    FILE *f = fopen(temp_filename.c_str(), "wb");
+    if (!f)
+        return;
+    bool success = fwrite(data.data(), 1, data.size(), f) == data.size();
+    success &= fclose(f) == 0;
+    if (success) {
+        remove(filename.c_str());
+        success = rename(temp_filename.c_str(), filename.c_str()) == 0;
+    }
+    if (!success)
+        remove(temp_filename.c_str());
+}
+
+Shader::Shader(RenderPass *render_pass,
+               const std::string &name,
+               const std::string &vertex_shader,
+               const std::string &fragment_shader,
+               BlendMode blend_mode,
+               bool deferred)
+    : m_render_pass(render_pass), m_name(name), m_blend_mode(blend_mode), m_shader_handle(0) {
+
+    const std::string &cache_path = program_cache_path();
+    bool cache = !cache_path.empty() && program_binary_supported();
+
+    if (cache) {
+        m_cache_key = program_cache_key(vertex_shader, fragment_shader);
+        char key_str[17];
+        snprintf(key_str, sizeof(key_str), "%016llx", (unsigned long long) m_cache_key);
+        m_cache_filename = cache_path + "/" + key_str + ".glprog";
+    }
+
+    if (cache && load_program_binary(m_cache_filename, m_cache_key)) {
+        m_cache_filename.clear();
+        init_parameters();
+    } else {
+        if (deferred)
+            parallel_compile_supported();
+
+        m_vertex_shader_handle   = compile_gl_shader(GL_VERTEX_SHADER,   vertex_shader);
+        m_fragment_shader_handle = compile_gl_shader(GL_FRAGMENT_SHADER, fragment_shader);
+
+        m_shader_handle = glCreateProgram();
+
+        CHK(glAttachShader(m_shader_handle, m_vertex_shader_handle));
+        CHK(glAttachShader(m_shader_handle, m_fragment_shader_handle));
+        if (cache && gl_program_parameteri)
+            CHK(gl_program_parameteri(m_shader_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+        CHK(glLinkProgram(m_shader_handle));
+
+        /* Status checks block until the driver has finished */
+        m_pending = true;
+        if (!deferred)
+            wait();
+    }
+
+#if defined(NANOGUI_USE_OPENGL)
+    CHK(glGenVertexArrays(1, &m_vertex_array_handle));
+
+    m_uses_point_size = vertex_shader.find("gl_PointSize") != std::string::npos;
+#endif
+}
+
+bool Shader::ready() {
+    if (!m_pending || !m_error.empty())
+        return true;
+
+    if (parallel_compile_supported()) {
+        GLint completed = GL_FALSE;
+        CHK(glGetProgramiv(m_shader_handle, GL_COMPLETION_STATUS_KHR, &completed));
+        if (completed != GL_TRUE)
+            return false;
+    }
+
+    wait();
+    return true;
+}
+
+void Shader::wait() {
+    if (!m_pending)
+        return;
+    else if (!m_error.empty())
+        throw std::runtime_error(m_error);
+
+    std::string error = check_gl_shader(GL_VERTEX_SHADER, m_name, m_vertex_shader_handle);
+    if (error.empty())
+        error = check_gl_shader(GL_FRAGMENT_SHADER, m_name, m_fragment_shader_handle);
+
+    if (error.empty()) {
+        GLint status;
+        CHK(glGetProgramiv(m_shader_handle, GL_LINK_STATUS, &status));
+
+        if (status != GL_TRUE) {
+            char error_shader[4096];
+            CHK(glGetProgramInfoLog(m_shader_handle, sizeof(error_shader), nullptr, error_shader));
+            error = "Shader::Shader(name=\"" + m_name +
+                    "\"): unable to link shader!\n\n" + error_shader;
+        }
+    }
+
+    CHK(glDeleteShader(m_vertex_shader_handle));
+    CHK(glDeleteShader(m_fragment_shader_handle));
+    m_vertex_shader_handle = m_fragment_shader_handle = 0;
 
-    Buffer &buf = m_buffers["indices"];
+    if (!error.empty()) {
+        GLState::current()->program_deleted(m_shader_handle);
+        CHK(glDeleteProgram(m_shader_handle));
+        m_shader_handle = 0;
+        m_error = error;
+        throw std::runtime_error(m_error);
+    }
+
+    m_pending = false;
+    reflect();
+    init_parameters();
+
+    if (!m_cache_filename.empty()) {
+        store_program_binary(m_cache_filename, m_cache_key);
+        m_cache_filename.clear();
+    }
+}
+
+void Shader::init_parameters() {
+    m_index_binding = m_buffers.size();
+    Buffer &buf = add_buffer("indices");
     buf.index = -1;
     buf.ndim = 1;
     buf.shape[0] = 0;
@@ -246,31 +573,133 @@ Shader::Shader(RenderPass *render_pass,
     buf.type = IndexBuffer;
     buf.dtype = VariableType::UInt32;
 
-#if defined(NANOGUI_USE_OPENGL)
-    CHK(glGenVertexArrays(1, &m_vertex_array_handle));
+    /* Reserve flat storage for the values of all uniforms */
+    size_t uniform_size = 0;
+    for (Buffer &b : m_buffers) {
+        if (b.type != UniformBuffer)
+            continue;
+        b.offset = uniform_size;
+        size_t size = type_size(b.dtype) * b.shape[0] * b.shape[1] * b.shape[2];
+        uniform_size += (size + 15) / 16 * 16;
+    }
+    m_uniform_data.resize(uniform_size);
+}
 
-    m_uses_point_size = vertex_shader.find("gl_PointSize") != std::string::npos;
+#if defined(NANOGUI_USE_OPENGL)
+/* Persistently mapped buffers require GL 4.4 or ARB_buffer_storage */
+#if !defined(GL_MAP_PERSISTENT_BIT)
+#  define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#if !defined(GL_MAP_COHERENT_BIT)
+#  define GL_MAP_COHERENT_BIT 0x0080
 #endif
+#if !defined(GL_DYNAMIC_STORAGE_BIT)
+#  define GL_DYNAMIC_STORAGE_BIT 0x0100
+#endif
+
+using BufferStorageProc = void (NANOGUI_GLAPIENTRY *)(GLenum, GLsizeiptr, const void *, GLbitfield);
+static BufferStorageProc gl_buffer_storage = nullptr;
+
+static bool buffer_storage_supported() {
+    static int supported = -1;
+    if (supported < 0) {
+        GLint major = 0, minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        if (major > 4 || (major == 4 && minor >= 4) ||
+            glfwExtensionSupported("GL_ARB_buffer_storage"))
+            gl_buffer_storage = (BufferStorageProc) glfwGetProcAddress("glBufferStorage");
+        supported = gl_buffer_storage ? 1 : 0;
+    }
+    return supported == 1;
+}
+
+void Shader::advance_ring(Buffer &buf, size_t size) {
+    if (buf.mapped && size <= buf.segment_size) {
+        buf.segment = (buf.segment + 1) % RingSegments;
+
+        /* Wait until the GPU has finished reading the segment */
+        GLsync fence = (GLsync) buf.fences[buf.segment];
+        if (fence) {
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                    1000000000) == GL_TIMEOUT_EXPIRED)
+                ;
+            CHK(glDeleteSync(fence));
+            buf.fences[buf.segment] = nullptr;
+        }
+        return;
+    }
+
+    /* Immutable storage cannot be resized, create a new ring */
+    if (buf.buffer) {
+        GLuint buffer_id = (GLuint) ((uintptr_t) buf.buffer);
+        release_ring(buf);
+        CHK(glDeleteBuffers(1, &buffer_id));
+    }
+
+    GLenum buf_type = buf.type == IndexBuffer
+        ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+    GLuint buffer_id = 0;
+    CHK(glGenBuffers(1, &buffer_id));
+    buf.buffer = (void *) ((uintptr_t) buffer_id);
+
+    /* Keep segment offsets aligned for all vertex formats */
+    buf.segment_size = std::max((size + 255) / 256 * 256, (size_t) 256);
+    buf.segment = 0;
+
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    CHK(glBindBuffer(buf_type, buffer_id));
+    CHK(gl_buffer_storage(buf_type, (GLsizeiptr) (buf.segment_size * RingSegments),
+                          nullptr, flags | GL_DYNAMIC_STORAGE_BIT));
+    buf.mapped = (uint8_t *) glMapBufferRange(
+        buf_type, 0, (GLsizeiptr) (buf.segment_size * RingSegments), flags);
+    if (!buf.mapped)
+        throw std::runtime_error("Shader::set_buffer(): unable to map buffer \"" +
+                                 buf.name + "\"!");
+    buf.storage_usage = BufferUsage::Stream;
 }
 
+void Shader::release_ring(Buffer &buf) {
+    for (size_t i = 0; i < RingSegments; ++i) {
+        if (buf.fences[i]) {
+            CHK(glDeleteSync((GLsync) buf.fences[i]));
+            buf.fences[i] = nullptr;
+        }
+    }
+    buf.mapped = nullptr;
+    buf.segment = buf.segment_size = 0;
+}
+#endif
+
 Shader::~Shader() {
+    GLState *state = GLState::current();
+    if (m_vertex_shader_handle)
+        CHK(glDeleteShader(m_vertex_shader_handle));
+    if (m_fragment_shader_handle)
+        CHK(glDeleteShader(m_fragment_shader_handle));
+    for (Buffer &buf : m_buffers) {
+        if ((buf.type != VertexBuffer && buf.type != IndexBuffer) || !buf.buffer)
+            continue;
+#if defined(NANOGUI_USE_OPENGL)
+        release_ring(buf);
+#endif
+        GLuint buffer_id = (GLuint) ((uintptr_t) buf.buffer);
+        CHK(glDeleteBuffers(1, &buffer_id));
+    }
     CHK(glDeleteProgram(m_shader_handle));
+    state->program_deleted(m_shader_handle);
 #if defined(NANOGUI_USE_OPENGL)
     CHK(glDeleteVertexArrays(1, &m_vertex_array_handle));
+    state->vertex_array_deleted(m_vertex_array_handle);
 #endif
 }
 
-void Shader::set_buffer(const std::string &name,
+void Shader::set_buffer(size_t binding,
                         VariableType dtype,
                         size_t ndim,
                         const size_t *shape,
                         const void *data) {
-    auto it = m_buffers.find(name);
-    if (it == m_buffers.end())
-        throw std::runtime_error(
-            "Shader::set_buffer(): could not find argument named \"" + name + "\"");
-
-    Buffer &buf = m_buffers[name];
+    Buffer &buf = buffer(binding, "Shader::set_buffer()");
 
     bool mismatch = ndim != buf.ndim || dtype != buf.dtype;
     for (size_t i = (buf.type == UniformBuffer ? 0 : 1); i < ndim; ++i)
@@ -283,7 +712,7 @@ void Shader::set_buffer(const std::string &name,
         for (size_t i = 0; i < 3; ++i)
             arg.shape[i] = i < arg.ndim ? shape[i] : 1;
         arg.dtype = dtype;
-        throw std::runtime_error("Buffer::set_buffer(\"" + name +
+        throw std::runtime_error("Buffer::set_buffer(\"" + buf.name +
                                  "\"): shape/dtype mismatch: expected " + buf.to_string() +
                                  ", got " + arg.to_string());
     }
@@ -295,25 +724,54 @@ void Shader::set_buffer(const std::string &name,
     }
 
     if (buf.type == UniformBuffer) {
-        if (buf.buffer && buf.size != size) {
-            delete[] (uint8_t *) buf.buffer;
-            buf.buffer = nullptr;
-        }
-        if (!buf.buffer)
-            buf.buffer = new uint8_t[size];
+        /* The shape was validated above, hence the value fits */
+        buf.buffer = m_uniform_data.data() + buf.offset;
         memcpy(buf.buffer, data, size);
     } else {
-        GLuint buffer_id = 0;
-        if (buf.buffer) {
-            buffer_id = (GLuint) ((uintptr_t) buf.buffer);
-        } else {
-            CHK(glGenBuffers(1, &buffer_id));
-            buf.buffer = (void *) ((uintptr_t) buffer_id);
+        /* Replace data previously provided by a VertexBuffer */
+        buf.vertex_buffer = nullptr;
+
+#if defined(NANOGUI_USE_OPENGL)
+        if (buf.usage == BufferUsage::Stream && buffer_storage_supported()) {
+            advance_ring(buf, size);
+            memcpy(buf.mapped + buf.storage_offset(), data, size);
+        } else
+#endif
+        {
+            GLuint buffer_id = (GLuint) ((uintptr_t) buf.buffer);
+            bool reallocate = buffer_id == 0 || size != buf.size ||
+                              buf.usage != buf.storage_usage;
+#if defined(NANOGUI_USE_OPENGL)
+            if (buf.mapped) {
+                /* The buffer was previously part of a ring */
+                release_ring(buf);
+                CHK(glDeleteBuffers(1, &buffer_id));
+                buffer_id = 0;
+                reallocate = true;
+            }
+#endif
+            if (buffer_id == 0) {
+                CHK(glGenBuffers(1, &buffer_id));
+                buf.buffer = (void *) ((uintptr_t) buffer_id);
+            }
+            GLenum buf_type = buf.type == IndexBuffer
+                ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+            CHK(glBindBuffer(buf_type, buffer_id));
+
+            if (buf.usage == BufferUsage::Stream) {
+                /* Orphan the old storage instead of waiting for draw
+                   calls that still read from it */
+                CHK(glBufferData(buf_type, size, nullptr, GL_STREAM_DRAW));
+                CHK(glBufferSubData(buf_type, 0, size, data));
+            } else if (reallocate) {
+                CHK(glBufferData(buf_type, size, data,
+                                 buf.usage == BufferUsage::Static ? GL_STATIC_DRAW
+                                                                  : GL_DYNAMIC_DRAW));
+            } else {
+                CHK(glBufferSubData(buf_type, 0, size, data));
+            }
+            buf.storage_usage = buf.usage;
         }
-        GLenum buf_type = (name == "indices")
-            ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
-        CHK(glBindBuffer(buf_type, buffer_id));
-        CHK(glBufferData(buf_type, size, data, GL_DYNAMIC_DRAW));
     }
 
     buf.dtype = dtype;
@@ -322,42 +780,150 @@ void Shader::set_buffer(const std::string &name,
     buf.dirty = true;
 }
 
-void Shader::set_texture(const std::string &name, Texture *texture) {
-    auto it = m_buffers.find(name);
-    if (it == m_buffers.end())
+void Shader::set_buffer_range(size_t binding, size_t offset,
+                              size_t count, const void *data) {
+    Buffer &buf = buffer(binding, "Shader::set_buffer_range()");
+    if (buf.type != VertexBuffer && buf.type != IndexBuffer)
+        throw std::runtime_error(
+            "Shader::set_buffer_range(): argument named \"" + buf.name + "\" is not a vertex/index buffer!");
+    else if (buf.vertex_buffer)
         throw std::runtime_error(
-            "Shader::set_texture(): could not find argument named \"" + name + "\"");
-    Buffer &buf = m_buffers[name];
+            "Shader::set_buffer_range(): argument named \"" + buf.name +
+            "\" is provided by a VertexBuffer, update it instead!");
+    else if (!buf.buffer)
+        throw std::runtime_error(
+            "Shader::set_buffer_range(): argument named \"" + buf.name +
+            "\" must be initialized using set_buffer() first!");
+    else if (offset + count > buf.shape[0])
+        throw std::runtime_error(
+            "Shader::set_buffer_range(): range exceeds the size of \"" + buf.name + "\"!");
+
+    if (count == 0)
+        return;
+
+    size_t row_size = buf.size / buf.shape[0];
+    GLuint buffer_id = (GLuint) ((uintptr_t) buf.buffer);
+
+#if defined(NANOGUI_USE_OPENGL)
+    if (buf.mapped) {
+        /* Segments may still be read by the GPU: carry the contents over to
+           the next segment and update them there. Both steps are ordered
+           GL commands, unlike writes to the mapping. */
+        size_t previous = buf.storage_offset();
+        advance_ring(buf, buf.size);
+        CHK(glBindBuffer(GL_COPY_READ_BUFFER, buffer_id));
+        CHK(glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_id));
+        CHK(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                                (GLintptr) previous, (GLintptr) buf.storage_offset(),
+                                (GLsizeiptr) buf.size));
+        CHK(glBufferSubData(GL_COPY_WRITE_BUFFER,
+                            (GLintptr) (buf.storage_offset() + offset * row_size),
+                            (GLsizeiptr) (count * row_size), data));
+        buf.dirty = true;
+        return;
+    }
+#endif
+
+    GLenum buf_type = buf.type == IndexBuffer
+        ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+    CHK(glBindBuffer(buf_type, buffer_id));
+    CHK(glBufferSubData(buf_type, (GLintptr) (offset * row_size),
+                        (GLsizeiptr) (count * row_size), data));
+}
+
+void Shader::set_vertex_buffer(nanogui::VertexBuffer *vertex_buffer) {
+    if (m_pending)
+        wait();
+
+    const std::vector<nanogui::VertexBuffer::Attribute> &attributes = vertex_buffer->attributes();
+    for (size_t i = 0; i < attributes.size(); ++i) {
+        const nanogui::VertexBuffer::Attribute &attr = attributes[i];
+        auto it = m_bindings.find(attr.name);
+        if (it == m_bindings.end())
+            continue;
+
+        Buffer &buf = m_buffers[it->second];
+        if (buf.type != VertexBuffer)
+            throw std::runtime_error(
+                "Shader::set_vertex_buffer(): argument named \"" + buf.name + "\" is not a vertex buffer!");
+        else if (attr.components != buf.shape[1])
+            throw std::runtime_error(
+                "Shader::set_vertex_buffer(): attribute \"" + buf.name + "\" has " +
+                std::to_string(attr.components) + " components, expected " +
+                std::to_string(buf.shape[1]) + "!");
+
+        /* Release storage previously allocated by set_buffer() */
+        if (buf.buffer) {
+            GLuint buffer_id = (GLuint) ((uintptr_t) buf.buffer);
+#if defined(NANOGUI_USE_OPENGL)
+            release_ring(buf);
+#endif
+            CHK(glDeleteBuffers(1, &buffer_id));
+            buf.buffer = nullptr;
+        }
+
+        buf.vertex_buffer = vertex_buffer;
+        buf.vertex_attribute = i;
+        buf.dirty = true;
+    }
+}
+
+void Shader::set_texture(size_t binding, Texture *texture) {
+    Buffer &buf = buffer(binding, "Shader::set_texture()");
     if (!(buf.type == VertexTexture || buf.type == FragmentTexture))
         throw std::runtime_error(
-            "Shader::set_texture(): argument named \"" + name + "\" is not a texture!");
+            "Shader::set_texture(): argument named \"" + buf.name + "\" is not a texture!");
+
+    /* Regenerate mipmaps that went stale due to sub-region updates */
+    if (texture->auto_mipmaps() && texture->mipmaps_dirty())
+        texture->generate_mipmaps();
 
     buf.buffer = (void *) ((uintptr_t) texture->texture_handle());
     buf.dirty  = true;
 }
 
+/// Return the OpenGL type of vertex attribute components
+static GLenum gl_vertex_type(VariableType dtype) {
+    switch (dtype) {
+        case VariableType::Int8:    return GL_BYTE;
+        case VariableType::UInt8:   return GL_UNSIGNED_BYTE;
+        case VariableType::Int16:   return GL_SHORT;
+        case VariableType::UInt16:  return GL_UNSIGNED_SHORT;
+        case VariableType::Int32:   return GL_INT;
+        case VariableType::UInt32:  return GL_UNSIGNED_INT;
+        case VariableType::Float16: return GL_HALF_FLOAT;
+        case VariableType::Float32: return GL_FLOAT;
+        default:
+            throw std::runtime_error(
+                "Shader::begin(): unsupported vertex buffer type!");
+    }
+}
+
 void Shader::begin() {
+    if (m_pending)
+        wait();
+
     int texture_unit = 0;
+    GLState *state = GLState::current();
 
-    CHK(glUseProgram(m_shader_handle));
+    state->use_program(m_shader_handle);
 
 #if defined(NANOGUI_USE_OPENGL)
-    CHK(glBindVertexArray(m_vertex_array_handle));
+    state->bind_vertex_array(m_vertex_array_handle);
 #endif
 
-    for (auto &[key, buf] : m_buffers) {
-        bool indices = key == "indices";
-        if (!buf.buffer) {
+    for (Buffer &buf : m_buffers) {
+        bool indices = buf.type == IndexBuffer;
+        if (!buf.buffer && !buf.vertex_buffer) {
             if (!indices)
                 fprintf(stderr,
                         "Shader::begin(): shader \"%s\" has an unbound "
                         "argument \"%s\"!\n",
-                        m_name.c_str(), key.c_str());
+                        m_name.c_str(), buf.name.c_str());
             continue;
         }
 
         GLuint buffer_id = (GLuint) ((uintptr_t) buf.buffer);
-        GLenum gl_type = 0;
 
 #if defined(NANOGUI_USE_OPENGL)
         if (!buf.dirty && buf.type != VertexTexture && buf.type != FragmentTexture)
@@ -371,36 +937,47 @@ void Shader::begin() {
                 break;
 
             case VertexBuffer:
+                if (buf.vertex_buffer) {
+                    const nanogui::VertexBuffer::Attribute &attr =
+                        buf.vertex_buffer->attributes()[buf.vertex_attribute];
+                    CHK(glBindBuffer(GL_ARRAY_BUFFER, buf.vertex_buffer->buffer_handle()));
+                    CHK(glEnableVertexAttribArray(buf.index));
+                    CHK(glVertexAttribPointer(buf.index, (GLint) attr.components,
+                                              gl_vertex_type(attr.dtype),
+                                              attr.normalized ? GL_TRUE : GL_FALSE,
+                                              (GLsizei) buf.vertex_buffer->stride(),
+                                              (const void *) attr.offset));
+#if !defined(NANOGUI_USE_GLES) || NANOGUI_GLES_VERSION != 2
+                    CHK(glVertexAttribDivisor(buf.index, buf.divisor));
+#endif
+                    break;
+                }
+
                 CHK(glBindBuffer(GL_ARRAY_BUFFER, buffer_id));
                 CHK(glEnableVertexAttribArray(buf.index));
 
-                switch (buf.dtype) {
-                    case VariableType::Int8:    gl_type = GL_BYTE;           break;
-                    case VariableType::UInt8:   gl_type = GL_UNSIGNED_BYTE;  break;
-                    case VariableType::Int16:   gl_type = GL_SHORT;          break;
-                    case VariableType::UInt16:  gl_type = GL_UNSIGNED_SHORT; break;
-                    case VariableType::Int32:   gl_type = GL_INT;            break;
-                    case VariableType::UInt32:  gl_type = GL_UNSIGNED_INT;   break;
-                    case VariableType::Float16: gl_type = GL_HALF_FLOAT;     break;
-                    case VariableType::Float32: gl_type = GL_FLOAT;          break;
-                    default:
-                        throw std::runtime_error(
-                            "Shader::begin(): unsupported vertex buffer type!");
-                }
-
                 if (buf.ndim != 2)
-                    throw std::runtime_error("\"" + m_name + "\": vertex attribute \"" + key +
+                    throw std::runtime_error("\"" + m_name + "\": vertex attribute \"" + buf.name +
                                              "\" has an invalid shapeension (expected ndim=2, got " +
                                              std::to_string(buf.ndim) + ")");
 
+#if defined(NANOGUI_USE_OPENGL)
+                CHK(glVertexAttribPointer(buf.index, (GLint) buf.shape[1],
+                                          gl_vertex_type(buf.dtype), GL_FALSE, 0,
+                                          (const void *) buf.storage_offset()));
+#else
                 CHK(glVertexAttribPointer(buf.index, (GLint) buf.shape[1],
-                                          gl_type, GL_FALSE, 0, nullptr));
+                                          gl_vertex_type(buf.dtype), GL_FALSE, 0, nullptr));
+#endif
+#if !defined(NANOGUI_USE_GLES) || NANOGUI_GLES_VERSION != 2
+                CHK(glVertexAttribDivisor(buf.index, buf.divisor));
+#endif
                 break;
 
             case VertexTexture:
             case FragmentTexture:
-                CHK(glActiveTexture(GL_TEXTURE0 + texture_unit));
-                CHK(glBindTexture(GL_TEXTURE_2D, (GLuint) ((uintptr_t) buf.buffer)));
+                state->active_texture(texture_unit);
+                state->bind_texture((GLuint) ((uintptr_t) buf.buffer));
                 if (buf.dirty)
                     CHK(glUniform1i(buf.index, texture_unit));
                 texture_unit++;
@@ -408,7 +985,7 @@ void Shader::begin() {
 
             case UniformBuffer:
                 if (buf.ndim > 2)
-                    throw std::runtime_error("\"" + m_name + "\": uniform attribute \"" + key +
+                    throw std::runtime_error("\"" + m_name + "\": uniform attribute \"" + buf.name +
                                              "\" has an invalid shapeension (expected ndim=0/1/2, got " +
                                              std::to_string(buf.ndim) + ")");
                 switch (buf.dtype) {
@@ -494,49 +1071,55 @@ void Shader::begin() {
                 }
 
                 if (uniform_error)
-                    throw std::runtime_error("\"" + m_name + "\": uniform attribute \"" + key +
+                    throw std::runtime_error("\"" + m_name + "\": uniform attribute \"" + buf.name +
                                              "\" has an unsupported dtype/shape configuration: " + buf.to_string());
                 break;
 
             default:
-                throw std::runtime_error("\"" + m_name + "\": uniform attribute \"" + key +
+                throw std::runtime_error("\"" + m_name + "\": uniform attribute \"" + buf.name +
                                          "\" has an unsupported dtype/shape configuration:" + buf.to_string());
         }
 
         buf.dirty = false;
     }
 
-    if (m_blend_mode == BlendMode::AlphaBlend) {
-        CHK(glEnable(GL_BLEND));
-        CHK(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-    }
+    /* Blending and point size state is set explicitly by every shader and
+       restored when the render pass ends, hence end() need not reset it */
+    state->set_enabled(GLState::Capability::Blend,
+                       m_blend_mode == BlendMode::AlphaBlend);
+    if (m_blend_mode == BlendMode::AlphaBlend)
+        state->set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 #if defined(NANOGUI_USE_OPENGL)
-    if (m_uses_point_size)
-        CHK(glEnable(GL_PROGRAM_POINT_SIZE));
+    state->set_enabled(GLState::Capability::ProgramPointSize, m_uses_point_size);
 #endif
 }
 
 void Shader::end() {
-    if (m_blend_mode == BlendMode::AlphaBlend)
-        CHK(glDisable(GL_BLEND));
 #if defined(NANOGUI_USE_OPENGL)
-    if (m_uses_point_size)
-        CHK(glDisable(GL_PROGRAM_POINT_SIZE));
-    CHK(glBindVertexArray(0));
+    /* Unbind the vertex array so that later index buffer updates (which are
+       part of the vertex array state) cannot affect it. The program stays
+       bound, which lets consecutive draws with the same shader skip the
+       switch. */
+    GLState::current()->bind_vertex_array(0);
 #else
-    for (const auto &[key, buf] : m_buffers) {
+    for (const Buffer &buf : m_buffers) {
         if (buf.type != VertexBuffer)
             continue;
         CHK(glDisableVertexAttribArray(buf.index));
+#if NANOGUI_GLES_VERSION != 2
+        /* Divisors are global state in the absence of vertex array objects */
+        if (buf.divisor != 0)
+            CHK(glVertexAttribDivisor(buf.index, 0));
+#endif
     }
 #endif
-    CHK(glUseProgram(0));
 }
 
-void Shader::draw_array(PrimitiveType primitive_type,
-                        size_t offset, size_t count,
-                        bool indexed) {
+void Shader::draw_array_instanced(PrimitiveType primitive_type,
+                                  size_t offset, size_t count,
+                                  size_t instance_count,
+                                  bool indexed) {
     GLenum primitive_type_gl;
     switch (primitive_type) {
         case PrimitiveType::Point:         primitive_type_gl = GL_POINTS;         break;
@@ -547,11 +1130,45 @@ void Shader::draw_array(PrimitiveType primitive_type,
         default: throw std::runtime_error("Shader::draw_array(): invalid primitive type!");
     }
 
-    if (!indexed)
-        CHK(glDrawArrays(primitive_type_gl, (GLint) offset, (GLsizei) count));
-    else
-        CHK(glDrawElements(primitive_type_gl, (GLsizei) count, GL_UNSIGNED_INT,
-                           (const void *) (offset * sizeof(uint32_t))));
+    size_t index_offset = offset * sizeof(uint32_t);
+#if defined(NANOGUI_USE_OPENGL)
+    index_offset += m_buffers[m_index_binding].storage_offset();
+#endif
+
+    if (instance_count == 0)
+        return;
+
+    if (instance_count == 1) {
+        if (!indexed)
+            CHK(glDrawArrays(primitive_type_gl, (GLint) offset, (GLsizei) count));
+        else
+            CHK(glDrawElements(primitive_type_gl, (GLsizei) count, GL_UNSIGNED_INT,
+                               (const void *) index_offset));
+    } else {
+#if defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION == 2
+        throw std::runtime_error("Shader::draw_array_instanced(): instancing "
+                                 "is not supported by OpenGL ES 2!");
+#else
+        if (!indexed)
+            CHK(glDrawArraysInstanced(primitive_type_gl, (GLint) offset,
+                                      (GLsizei) count, (GLsizei) instance_count));
+        else
+            CHK(glDrawElementsInstanced(primitive_type_gl, (GLsizei) count,
+                                        GL_UNSIGNED_INT, (const void *) index_offset,
+                                        (GLsizei) instance_count));
+#endif
+    }
+
+#if defined(NANOGUI_USE_OPENGL)
+    /* Guard the ring segments read by this draw call */
+    for (Buffer &buf : m_buffers) {
+        if (!buf.mapped)
+            continue;
+        if (buf.fences[buf.segment])
+            CHK(glDeleteSync((GLsync) buf.fences[buf.segment]));
+        buf.fences[buf.segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+#endif
 }
 
 NAMESPACE_END(nanogui)
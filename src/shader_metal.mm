@@ -58,7 +58,8 @@ Shader::Shader(RenderPass *render_pass,
                const std::string &name,
                const std::string &vertex_shader,
                const std::string &fragment_shader,
-               BlendMode blend_mode)
+               BlendMode blend_mode,
+               bool /* deferred */)
     : m_render_pass(render_pass), m_name(name), m_blend_mode(blend_mode), m_pipeline_state(nullptr) {
     id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
     id<MTLFunction> vertex_func   = compile_metal_shader(device, name, "vertex", vertex_shader),
@@ -140,7 +141,7 @@ Shader::Shader(RenderPass *render_pass,
 
     for (MTLArgument *arg in [reflection vertexArguments]) {
         std::string name = [arg.name UTF8String];
-        if (m_buffers.find(name) != m_buffers.end())
+        if (m_bindings.find(name) != m_bindings.end())
             throw std::runtime_error(
                 "Shader::Shader(): \"" + name +
                 "\": duplicate argument name in shader code!");
@@ -148,7 +149,7 @@ Shader::Shader(RenderPass *render_pass,
             throw std::runtime_error(
                 "Shader::Shader(): argument name 'indices' is reserved!");
 
-        Buffer &buf = m_buffers[name];
+        Buffer &buf = add_buffer(name);
         buf.index = arg.index;
         if (arg.type == MTLArgumentTypeBuffer)
             buf.type = VertexBuffer;
@@ -163,7 +164,7 @@ Shader::Shader(RenderPass *render_pass,
 
     for (MTLArgument *arg in [reflection fragmentArguments]) {
         std::string name = [arg.name UTF8String];
-        if (m_buffers.find(name) != m_buffers.end())
+        if (m_bindings.find(name) != m_bindings.end())
             throw std::runtime_error(
                 "Shader::Shader(): \"" + name +
                 "\": duplicate argument name in shader code!");
@@ -171,7 +172,7 @@ Shader::Shader(RenderPass *render_pass,
             throw std::runtime_error(
                 "Shader::Shader(): argument name 'indices' is reserved!");
 
-        Buffer &buf = m_buffers[name];
+        Buffer &buf = add_buffer(name);
         buf.index = arg.index;
         if (arg.type == MTLArgumentTypeBuffer)
             buf.type = FragmentBuffer;
@@ -184,13 +185,34 @@ Shader::Shader(RenderPass *render_pass,
                                      "\": unsupported argument type!");
     }
 
-    Buffer &buf = m_buffers["indices"];
+    m_index_binding = m_buffers.size();
+    Buffer &buf = add_buffer("indices");
     buf.index = -1;
     buf.type = IndexBuffer;
+
+    /* Resolve the sampler states associated with textures */
+    for (Buffer &b : m_buffers) {
+        if (b.type != VertexTexture && b.type != FragmentTexture)
+            continue;
+
+        std::string sampler_name;
+        if (b.name.length() > 8 && b.name.compare(b.name.length() - 8, 8, "_texture") == 0)
+            sampler_name = b.name.substr(0, b.name.length()-8) + "_sampler";
+        else
+            sampler_name = b.name + "_sampler";
+
+        auto it = m_bindings.find(sampler_name);
+        if (it != m_bindings.end())
+            b.sampler = (int) it->second;
+    }
 }
 
+bool Shader::ready() { return true; }
+
+void Shader::wait() { }
+
 Shader::~Shader() {
-    for (const auto &[key, buf] : m_buffers) {
+    for (const Buffer &buf : m_buffers) {
         if (!buf.buffer)
             continue;
         if (buf.type == VertexBuffer ||
@@ -213,21 +235,20 @@ Shader::~Shader() {
     (void) (__bridge_transfer id<MTLRenderPipelineState>) m_pipeline_state;
 }
 
-void Shader::set_buffer(const std::string &name,
+void Shader::set_buffer(size_t binding,
                         VariableType dtype,
                         size_t ndim,
                         const size_t *shape,
                         const void *data) {
-    auto it = m_buffers.find(name);
-    if (it == m_buffers.end())
-        throw std::runtime_error(
-            "Shader::set_buffer(): could not find argument named \"" + name + "\"");
-    Buffer &buf = m_buffers[name];
+    Buffer &buf = buffer(binding, "Shader::set_buffer()");
     if (!(buf.type == VertexBuffer ||
           buf.type == FragmentBuffer ||
           buf.type == IndexBuffer))
         throw std::runtime_error(
-            "Shader::set_buffer(): argument named \"" + name + "\" is not a buffer!");
+            "Shader::set_buffer(): argument named \"" + buf.name + "\" is not a buffer!");
+
+    /* Replace data previously provided by a VertexBuffer */
+    buf.vertex_buffer = nullptr;
 
     for (size_t i = 0; i < 3; ++i)
         buf.shape[i] = i < ndim ? shape[i] : 1;
@@ -241,10 +262,21 @@ void Shader::set_buffer(const std::string &name,
         buf.buffer = nullptr;
     }
 
-    if (size <= NANOGUI_BUFFER_THRESHOLD && name != "indices") {
+    if (size <= NANOGUI_BUFFER_THRESHOLD && buf.type != IndexBuffer) {
         if (!buf.buffer)
             buf.buffer = new uint8_t[size];
         memcpy(buf.buffer, data, size);
+    } else if (buf.usage == BufferUsage::Stream) {
+        /* Write streaming data to a fresh shared buffer, which avoids the
+           blit and lets command buffers in flight retain the old one */
+        id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+        if (buf.buffer)
+            (void) (__bridge_transfer id<MTLBuffer>) buf.buffer;
+        id<MTLBuffer> mtl_buffer =
+            [device newBufferWithBytes: data
+                                length: size
+                               options: MTLResourceStorageModeShared];
+        buf.buffer = (__bridge_retained void *) mtl_buffer;
     } else {
         /* Procedure recommended by Apple: create a temporary shared buffer and
            blit into a private GPU-only buffer */
@@ -287,15 +319,97 @@ void Shader::set_buffer(const std::string &name,
     buf.size  = size;
 }
 
-void Shader::set_texture(const std::string &name, Texture *texture) {
-    auto it = m_buffers.find(name);
-    if (it == m_buffers.end())
+void Shader::set_buffer_range(size_t binding, size_t offset,
+                              size_t count, const void *data) {
+    Buffer &buf = buffer(binding, "Shader::set_buffer_range()");
+    if (buf.type != VertexBuffer && buf.type != IndexBuffer)
+        throw std::runtime_error(
+            "Shader::set_buffer_range(): argument named \"" + buf.name + "\" is not a vertex/index buffer!");
+    else if (buf.vertex_buffer)
+        throw std::runtime_error(
+            "Shader::set_buffer_range(): argument named \"" + buf.name +
+            "\" is provided by a VertexBuffer, update it instead!");
+    else if (!buf.buffer)
         throw std::runtime_error(
-            "Shader::set_texture(): could not find argument named \"" + name + "\"");
-    Buffer &buf = m_buffers[name];
+            "Shader::set_buffer_range(): argument named \"" + buf.name +
+            "\" must be initialized using set_buffer() first!");
+    else if (offset + count > buf.shape[0])
+        throw std::runtime_error(
+            "Shader::set_buffer_range(): range exceeds the size of \"" + buf.name + "\"!");
+
+    if (count == 0)
+        return;
+
+    size_t row_size = buf.size / buf.shape[0];
+
+    if (buf.size <= NANOGUI_BUFFER_THRESHOLD && buf.type != IndexBuffer) {
+        memcpy((uint8_t *) buf.buffer + offset * row_size, data, count * row_size);
+    } else {
+        id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+        id<MTLBuffer> mtl_buffer = (__bridge id<MTLBuffer>) buf.buffer;
+
+        id<MTLBuffer> temp_buffer =
+            [device newBufferWithBytes: data
+                                length: count * row_size
+                               options: MTLResourceStorageModeShared];
+
+        id<MTLCommandQueue> command_queue =
+            (__bridge id<MTLCommandQueue>) metal_command_queue();
+        id<MTLCommandBuffer> command_buffer = [command_queue commandBuffer];
+        id<MTLBlitCommandEncoder> blit_encoder =
+            [command_buffer blitCommandEncoder];
+
+        [blit_encoder copyFromBuffer: temp_buffer
+                        sourceOffset: 0
+                            toBuffer: mtl_buffer
+                   destinationOffset: offset * row_size
+                                size: count * row_size];
+
+        /* No need to wait: command buffers of the queue execute in the order
+           in which they are committed, hence the blit is ordered after
+           frames in flight that read the old contents and before frames
+           that are committed later. The command buffer retains the staging
+           buffer until then. */
+        [blit_encoder endEncoding];
+        [command_buffer commit];
+    }
+}
+
+void Shader::set_vertex_buffer(nanogui::VertexBuffer *vertex_buffer) {
+    const std::vector<nanogui::VertexBuffer::Attribute> &attributes = vertex_buffer->attributes();
+    for (size_t i = 0; i < attributes.size(); ++i) {
+        auto it = m_bindings.find(attributes[i].name);
+        if (it == m_bindings.end())
+            continue;
+
+        Buffer &buf = m_buffers[it->second];
+        if (buf.type != VertexBuffer)
+            throw std::runtime_error(
+                "Shader::set_vertex_buffer(): argument named \"" + buf.name + "\" is not a vertex buffer!");
+
+        /* Release storage previously allocated by set_buffer() */
+        if (buf.buffer) {
+            if (buf.size <= NANOGUI_BUFFER_THRESHOLD)
+                delete[] (uint8_t *) buf.buffer;
+            else
+                (void) (__bridge_transfer id<MTLBuffer>) buf.buffer;
+            buf.buffer = nullptr;
+        }
+
+        buf.vertex_buffer = vertex_buffer;
+        buf.vertex_attribute = i;
+    }
+}
+
+void Shader::set_texture(size_t binding, Texture *texture) {
+    Buffer &buf = buffer(binding, "Shader::set_texture()");
     if (!(buf.type == VertexTexture || buf.type == FragmentTexture))
         throw std::runtime_error(
-            "Shader::set_texture(): argument named \"" + name + "\" is not a texture!");
+            "Shader::set_texture(): argument named \"" + buf.name + "\" is not a texture!");
+
+    /* Regenerate mipmaps that went stale due to sub-region updates */
+    if (texture->auto_mipmaps() && texture->mipmaps_dirty())
+        texture->generate_mipmaps();
 
     if (buf.buffer) {
         (void) (__bridge_transfer id<MTLTexture>) buf.buffer;
@@ -305,15 +419,9 @@ void Shader::set_texture(const std::string &name, Texture *texture) {
     buf.buffer = (__bridge_retained void *) ((__bridge id<MTLTexture>)
                                                  texture->texture_handle());
 
-    std::string sampler_name;
-    if (name.length() > 8 && name.compare(name.length() - 8, 8, "_texture") == 0)
-        sampler_name = name.substr(0, name.length()-8) + "_sampler";
-    else
-        sampler_name = name + "_sampler";
-
-    if (m_buffers.find(sampler_name) != m_buffers.end()) {
+    if (buf.sampler >= 0) {
         /* Also set the sampler state */
-        Buffer &buf2 = m_buffers[sampler_name];
+        Buffer &buf2 = m_buffers[buf.sampler];
 
         if (buf2.buffer) {
             (void) (__bridge_transfer id<MTLTexture>) buf2.buffer;
@@ -334,14 +442,14 @@ void Shader::begin() {
 
     [command_enc setRenderPipelineState: pipeline_state];
 
-    for (const auto &[key, buf] : m_buffers) {
+    for (const Buffer &buf : m_buffers) {
         bool indices = buf.type == IndexBuffer;
-        if (!buf.buffer) {
+        if (!buf.buffer && !buf.vertex_buffer) {
             if (!indices)
                 fprintf(stderr,
                         "Shader::begin(): shader \"%s\" has an unbound "
                         "argument \"%s\"!\n",
-                        m_name.c_str(), key.c_str());
+                        m_name.c_str(), buf.name.c_str());
             continue;
         }
 
@@ -371,7 +479,15 @@ void Shader::begin() {
                 break;
 
             default:
-                if (buf.size <= NANOGUI_BUFFER_THRESHOLD && !indices) {
+                if (buf.vertex_buffer) {
+                    const nanogui::VertexBuffer::Attribute &attr =
+                        buf.vertex_buffer->attributes()[buf.vertex_attribute];
+                    id<MTLBuffer> buffer =
+                        (__bridge id<MTLBuffer>) buf.vertex_buffer->buffer_handle();
+                    [command_enc setVertexBuffer: buffer
+                                          offset: attr.offset
+                                         atIndex: buf.index];
+                } else if (buf.size <= NANOGUI_BUFFER_THRESHOLD && !indices) {
                     if (buf.type == VertexBuffer)
                         [command_enc setVertexBytes: buf.buffer
                                              length: buf.size
@@ -402,9 +518,10 @@ void Shader::end() {
     /* No-op */
 }
 
-void Shader::draw_array(PrimitiveType primitive_type,
-                        size_t offset, size_t count,
-                        bool indexed) {
+void Shader::draw_array_instanced(PrimitiveType primitive_type,
+                                  size_t offset, size_t count,
+                                  size_t instance_count,
+                                  bool indexed) {
     MTLPrimitiveType primitive_type_mtl;
     switch (primitive_type) {
         case PrimitiveType::Point:         primitive_type_mtl = MTLPrimitiveTypePoint;         break;
@@ -418,18 +535,23 @@ void Shader::draw_array(PrimitiveType primitive_type,
     id<MTLRenderCommandEncoder> command_enc =
         (__bridge id<MTLRenderCommandEncoder>) m_render_pass->command_encoder();
 
+    if (instance_count == 0)
+        return;
+
     if (!indexed) {
         [command_enc drawPrimitives: primitive_type_mtl
                         vertexStart: offset
-                        vertexCount: count];
+                        vertexCount: count
+                      instanceCount: instance_count];
     } else {
         id<MTLBuffer> index_buffer =
-            (__bridge id<MTLBuffer>) m_buffers["indices"].buffer;
+            (__bridge id<MTLBuffer>) m_buffers[m_index_binding].buffer;
         [command_enc drawIndexedPrimitives: primitive_type_mtl
                                 indexCount: count
                                  indexType: MTLIndexTypeUInt32
                                indexBuffer: index_buffer
-                         indexBufferOffset: offset * 4];
+                         indexBufferOffset: offset * 4
+                             instanceCount: instance_count];
     }
 }
 
@@ -0,0 +1,366 @@
+#include <nanogui/shader.h>
+#include <nanogui/texture.h>
+#include <nanogui/null.h>
+#include <regex>
+#include <cstring>
+
+NAMESPACE_BEGIN(nanogui)
+
+/// Remove comments and preprocessor directives from GLSL code
+static std::string strip_glsl(const std::string &source) {
+    std::string result;
+    result.reserve(source.size());
+    bool line_start = true;
+    for (size_t i = 0; i < source.size(); ++i) {
+        char c = source[i];
+        if (c == '/' && i + 1 < source.size() && source[i + 1] == '/') {
+            while (i < source.size() && source[i] != '\n')
+                ++i;
+            c = '\n';
+        } else if (c == '/' && i + 1 < source.size() && source[i + 1] == '*') {
+            size_t end = source.find("*/", i + 2);
+            i = end == std::string::npos ? source.size() : end + 1;
+            c = ' ';
+        } else if (c == '#' && line_start) {
+            while (i < source.size() && source[i] != '\n')
+                ++i;
+            c = '\n';
+        }
+        if (c == '\n')
+            line_start = true;
+        else if (c != ' ' && c != '\t')
+            line_start = false;
+        result += c;
+    }
+    return result;
+}
+
+void Shader::reflect(const std::string &vertex_shader, const std::string &fragment_shader) {
+    auto register_buffer = [&](BufferType type, const std::string &name,
+                               int index, const std::string &glsl_type) {
+        auto it = m_bindings.find(name);
+        if (it != m_bindings.end()) {
+            /* Uniforms may be declared by both stages */
+            if (type != VertexBuffer && m_buffers[it->second].type != VertexBuffer)
+                return;
+            throw std::runtime_error(
+                "Shader::reflect(): duplicate attribute/uniform name in shader code!");
+        } else if (name == "indices") {
+            throw std::runtime_error(
+                "Shader::reflect(): argument name 'indices' is reserved!");
+        }
+
+        Buffer &buf = add_buffer(name);
+        for (int i = 0; i < 3; ++i)
+            buf.shape[i] = 1;
+        buf.ndim = 1;
+        buf.index = index;
+        buf.type = type;
+
+        /* Same conventions as the reflection of linked OpenGL programs */
+        std::string base = glsl_type;
+        char prefix = 'f';
+        if (base.size() == 5 && base.compare(1, 3, "vec") == 0) {
+            prefix = base[0];
+            base = base.substr(1);
+        }
+
+        if (base == "float" || base == "int" || base == "uint" || base == "bool") {
+            prefix = base[0];
+            buf.ndim = 0;
+        } else if (base.size() == 4 && base.compare(0, 3, "vec") == 0) {
+            buf.shape[0] = (size_t) (base[3] - '0');
+        } else if (base.size() == 4 && base.compare(0, 3, "mat") == 0) {
+            buf.shape[0] = buf.shape[1] = (size_t) (base[3] - '0');
+            buf.ndim = 2;
+        } else if (base == "sampler2D") {
+            buf.ndim = 0;
+            buf.type = FragmentTexture;
+        } else {
+            prefix = '\0';
+        }
+
+        switch (prefix) {
+            case 'f': buf.dtype = VariableType::Float32; break;
+            case 'i': buf.dtype = VariableType::Int32;   break;
+            case 'u': buf.dtype = VariableType::UInt32;  break;
+            case 'b': buf.dtype = VariableType::Bool;    break;
+            default:  buf.dtype = VariableType::Invalid; break;
+        }
+        if (buf.type == FragmentTexture)
+            buf.dtype = VariableType::Invalid;
+
+        bool valid = buf.type == FragmentTexture || buf.ndim == 0 ||
+                     (buf.shape[0] >= 2 && buf.shape[0] <= 4);
+        if (!valid || (buf.type != FragmentTexture && buf.dtype == VariableType::Invalid) ||
+            (buf.ndim == 2 && buf.dtype != VariableType::Float32))
+            throw std::runtime_error("Shader::reflect(): unsupported "
+                                     "uniform/attribute type!");
+
+        if (type == VertexBuffer) {
+            for (int i = (int) buf.ndim - 1; i >= 0; --i) {
+                buf.shape[i + 1] = buf.shape[i];
+            }
+            buf.shape[0] = 0;
+            buf.ndim++;
+        }
+    };
+
+    std::regex declaration(
+        "\\s*(?:layout\\s*\\([^)]*\\)\\s*)?(in|attribute|uniform)\\s+"
+        "(?:(?:lowp|mediump|highp)\\s+)?(\\w+)\\s+(\\w+)\\s*");
+    int attribute_index = 0, uniform_index = 0;
+
+    for (int stage = 0; stage < 2; ++stage) {
+        std::string source = strip_glsl(stage == 0 ? vertex_shader : fragment_shader);
+        size_t start = 0;
+        while (start < source.size()) {
+            size_t end = source.find_first_of(";{}", start);
+            if (end == std::string::npos)
+                end = source.size();
+            std::string statement = source.substr(start, end - start);
+            start = end + 1;
+
+            std::smatch match;
+            if (!std::regex_match(statement, match, declaration))
+                continue;
+
+            std::string qualifier = match[1];
+            if (qualifier == "uniform")
+                register_buffer(UniformBuffer, match[3], uniform_index++, match[2]);
+            else if (stage == 0)
+                register_buffer(VertexBuffer, match[3], attribute_index++, match[2]);
+        }
+    }
+}
+
+Shader::Shader(RenderPass *render_pass,
+               const std::string &name,
+               const std::string &vertex_shader,
+               const std::string &fragment_shader,
+               BlendMode blend_mode,
+               bool /* deferred */)
+    : m_render_pass(render_pass), m_name(name), m_blend_mode(blend_mode) {
+
+    reflect(vertex_shader, fragment_shader);
+
+    m_index_binding = m_buffers.size();
+    Buffer &buf = add_buffer("indices");
+    buf.index = -1;
+    buf.ndim = 1;
+    buf.shape[0] = 0;
+    buf.shape[1] = buf.shape[2] = 1;
+    buf.type = IndexBuffer;
+    buf.dtype = VariableType::UInt32;
+
+    m_shader_handle = null_new_handle();
+    null_stats().shaders++;
+}
+
+bool Shader::ready() {
+    return true;
+}
+
+void Shader::wait() { }
+
+Shader::~Shader() {
+    NullStats &stats = null_stats();
+    for (Buffer &buf : m_buffers) {
+        if (buf.type == VertexTexture || buf.type == FragmentTexture || !buf.buffer)
+            continue;
+        free(buf.buffer);
+        stats.buffer_bytes -= buf.size;
+    }
+    stats.shaders--;
+}
+
+void Shader::set_buffer(size_t binding,
+                        VariableType dtype,
+                        size_t ndim,
+                        const size_t *shape,
+                        const void *data) {
+    Buffer &buf = buffer(binding, "Shader::set_buffer()");
+
+    bool mismatch = ndim != buf.ndim || dtype != buf.dtype;
+    for (size_t i = (buf.type == UniformBuffer ? 0 : 1); i < ndim; ++i)
+        mismatch |= shape[i] != buf.shape[i];
+
+    if (mismatch) {
+        Buffer arg;
+        arg.type = buf.type;
+        arg.ndim = ndim;
+        for (size_t i = 0; i < 3; ++i)
+            arg.shape[i] = i < arg.ndim ? shape[i] : 1;
+        arg.dtype = dtype;
+        throw std::runtime_error("Buffer::set_buffer(\"" + buf.name +
+                                 "\"): shape/dtype mismatch: expected " + buf.to_string() +
+                                 ", got " + arg.to_string());
+    }
+
+    size_t size = type_size(dtype);
+    for (size_t i = 0; i < 3; ++i) {
+        buf.shape[i] = i < ndim ? shape[i] : 1;
+        size *= buf.shape[i];
+    }
+
+    NullStats &stats = null_stats();
+    if (size != buf.size || !buf.buffer) {
+        stats.buffer_bytes -= buf.size;
+        free(buf.buffer);
+        buf.size = 0;
+        buf.buffer = malloc(std::max(size, (size_t) 1));
+        if (!buf.buffer)
+            throw std::runtime_error("Shader::set_buffer(): out of memory!");
+        stats.buffer_bytes += size;
+    }
+    memcpy(buf.buffer, data, size);
+
+    if (buf.type != UniformBuffer) {
+        /* Replace data previously provided by a VertexBuffer */
+        buf.vertex_buffer = nullptr;
+        stats.uploads++;
+        stats.upload_bytes += size;
+    }
+
+    buf.dtype = dtype;
+    buf.ndim  = ndim;
+    buf.size  = size;
+    buf.dirty = true;
+}
+
+void Shader::set_buffer_range(size_t binding, size_t offset,
+                              size_t count, const void *data) {
+    Buffer &buf = buffer(binding, "Shader::set_buffer_range()");
+    if (buf.type != VertexBuffer && buf.type != IndexBuffer)
+        throw std::runtime_error(
+            "Shader::set_buffer_range(): argument named \"" + buf.name + "\" is not a vertex/index buffer!");
+    else if (buf.vertex_buffer)
+        throw std::runtime_error(
+            "Shader::set_buffer_range(): argument named \"" + buf.name +
+            "\" is provided by a VertexBuffer, update it instead!");
+    else if (!buf.buffer)
+        throw std::runtime_error(
+            "Shader::set_buffer_range(): argument named \"" + buf.name +
+            "\" must be initialized using set_buffer() first!");
+    else if (offset + count > buf.shape[0])
+        throw std::runtime_error(
+            "Shader::set_buffer_range(): range exceeds the size of \"" + buf.name + "\"!");
+
+    if (count == 0)
+        return;
+
+    size_t row_size = buf.size / buf.shape[0];
+    memcpy((uint8_t *) buf.buffer + offset * row_size, data, count * row_size);
+
+    NullStats &stats = null_stats();
+    stats.uploads++;
+    stats.upload_bytes += count * row_size;
+}
+
+void Shader::set_vertex_buffer(nanogui::VertexBuffer *vertex_buffer) {
+    const std::vector<nanogui::VertexBuffer::Attribute> &attributes = vertex_buffer->attributes();
+    for (size_t i = 0; i < attributes.size(); ++i) {
+        const nanogui::VertexBuffer::Attribute &attr = attributes[i];
+        auto it = m_bindings.find(attr.name);
+        if (it == m_bindings.end())
+            continue;
+
+        Buffer &buf = m_buffers[it->second];
+        if (buf.type != VertexBuffer)
+            throw std::runtime_error(
+                "Shader::set_vertex_buffer(): argument named \"" + buf.name + "\" is not a vertex buffer!");
+        else if (attr.components != buf.shape[1])
+            throw std::runtime_error(
+                "Shader::set_vertex_buffer(): attribute \"" + buf.name + "\" has " +
+                std::to_string(attr.components) + " components, expected " +
+                std::to_string(buf.shape[1]) + "!");
+
+        /* Release storage previously allocated by set_buffer() */
+        if (buf.buffer) {
+            free(buf.buffer);
+            null_stats().buffer_bytes -= buf.size;
+            buf.buffer = nullptr;
+            buf.size = 0;
+        }
+
+        buf.vertex_buffer = vertex_buffer;
+        buf.vertex_attribute = i;
+        buf.dirty = true;
+    }
+}
+
+void Shader::set_texture(size_t binding, Texture *texture) {
+    Buffer &buf = buffer(binding, "Shader::set_texture()");
+    if (!(buf.type == VertexTexture || buf.type == FragmentTexture))
+        throw std::runtime_error(
+            "Shader::set_texture(): argument named \"" + buf.name + "\" is not a texture!");
+
+    /* Regenerate mipmaps that went stale due to sub-region updates */
+    if (texture->auto_mipmaps() && texture->mipmaps_dirty())
+        texture->generate_mipmaps();
+
+    buf.buffer = (void *) ((uintptr_t) texture->texture_handle());
+    buf.dirty  = true;
+}
+
+void Shader::begin() {
+    for (Buffer &buf : m_buffers) {
+        if (!buf.buffer && !buf.vertex_buffer) {
+            if (buf.type != IndexBuffer)
+                fprintf(stderr,
+                        "Shader::begin(): shader \"%s\" has an unbound "
+                        "argument \"%s\"!\n",
+                        m_name.c_str(), buf.name.c_str());
+            continue;
+        }
+
+        if (buf.type == VertexBuffer && !buf.vertex_buffer && buf.ndim != 2)
+            throw std::runtime_error("\"" + m_name + "\": vertex attribute \"" + buf.name +
+                                     "\" has an invalid shapeension (expected ndim=2, got " +
+                                     std::to_string(buf.ndim) + ")");
+        else if (buf.type == UniformBuffer && buf.ndim > 2)
+            throw std::runtime_error("\"" + m_name + "\": uniform attribute \"" + buf.name +
+                                     "\" has an invalid shapeension (expected ndim=0/1/2, got " +
+                                     std::to_string(buf.ndim) + ")");
+
+        buf.dirty = false;
+    }
+
+    m_active = true;
+    null_stats().shader_begins++;
+}
+
+void Shader::end() {
+    m_active = false;
+}
+
+void Shader::draw_array_instanced(PrimitiveType primitive_type,
+                                  size_t offset, size_t count,
+                                  size_t instance_count,
+                                  bool indexed) {
+    switch (primitive_type) {
+        case PrimitiveType::Point:
+        case PrimitiveType::Line:
+        case PrimitiveType::LineStrip:
+        case PrimitiveType::Triangle:
+        case PrimitiveType::TriangleStrip:
+            break;
+        default: throw std::runtime_error("Shader::draw_array(): invalid primitive type!");
+    }
+
+    if (!m_active)
+        throw std::runtime_error("Shader::draw_array(): shader \"" + m_name +
+                                 "\" is not active, call begin() first!");
+    else if (indexed && offset + count > m_buffers[m_index_binding].shape[0])
+        throw std::runtime_error("Shader::draw_array(): range exceeds the size of the index buffer!");
+
+    if (instance_count == 0)
+        return;
+
+    NullStats &stats = null_stats();
+    stats.draw_calls++;
+    stats.instances += instance_count;
+    stats.elements += count * instance_count;
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,941 @@
+/*
+    src/softwarerenderer.cpp -- NanoVG renderer that rasterizes on the CPU
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/softwarerenderer.h>
+#include <nanovg.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+NAMESPACE_BEGIN(nanogui)
+
+/// Number of framebuffer rows rasterized by a worker at a time
+static const int SWTileHeight = 32;
+
+struct SWImage {
+    int type, width, height, flags;
+    std::vector<uint8_t> data;
+};
+
+/// Paint, scissor, and blend state of a draw call (converted as in nanovg_gl.h)
+struct SWPaint {
+    /// Inverse paint transform, extent, corner radius, and feather of gradients
+    float paint_mat[6], extent[2], radius, feather;
+    /// Premultiplied inner and outer colors
+    float inner[4], outer[4];
+    /// Inverse scissor transform, half extent, and edge scale
+    float scissor_mat[6], scissor_ext[2], scissor_scale[2];
+    /// Image (if any) and how to interpret its texels (as in nanovg_gl.h)
+    std::shared_ptr<SWImage> image;
+    int tex_type;
+    /// Does the paint evaluate to the same color everywhere?
+    bool solid;
+    bool scissor;
+    NVGcompositeOperationState blend;
+    /// Is \c blend the default premultiplied source-over operation?
+    bool source_over;
+};
+
+struct SWCall {
+    enum class Type { Fill, Triangles, Clear } type;
+    SWPaint paint;
+    /// Pixel bounds of the draw call (exclusive upper bounds)
+    int x0, y0, x1, y1;
+    /// Range of edges (Fill) or vertices (Triangles)
+    size_t offset, count;
+};
+
+/// Directed edge of a polygon in framebuffer coordinates
+struct SWEdge { float x0, y0, x1, y1; };
+
+/// Vertex of a textured triangle in framebuffer coordinates
+struct SWVertex { float x, y, u, v; };
+
+struct SWContext {
+    std::unordered_map<int, std::shared_ptr<SWImage>> images;
+    int next_image = 1;
+
+    std::vector<SWCall> calls;
+    std::vector<SWEdge> edges;
+    std::vector<SWVertex> vertices;
+
+    Vector2i size { 0, 0 };
+    float pixel_ratio = 1.f;
+    std::vector<uint8_t> framebuffer;
+
+    /* Worker threads (the thread flushing a frame participates as well) */
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable work_cv, done_cv;
+    uint64_t generation = 0;
+    uint32_t busy = 0;
+    bool stop = false;
+    std::atomic<int> next_tile { 0 };
+    int tile_count = 0;
+    /// Coverage accumulation buffers (one per thread)
+    std::vector<std::vector<float>> scratch;
+};
+
+static float sw_clamp01(float value) {
+    return std::min(std::max(value, 0.f), 1.f);
+}
+
+// ----------------------------------------------------------------------------
+//  Paint evaluation
+// ----------------------------------------------------------------------------
+
+static void sw_premultiply(const NVGcolor &c, float out[4]) {
+    out[0] = c.r * c.a;
+    out[1] = c.g * c.a;
+    out[2] = c.b * c.a;
+    out[3] = c.a;
+}
+
+static void sw_convert_paint(SWContext *ctx, SWPaint &out, const NVGpaint *paint,
+                             NVGcompositeOperationState op, const NVGscissor *scissor,
+                             float fringe) {
+    sw_premultiply(paint->innerColor, out.inner);
+    sw_premultiply(paint->outerColor, out.outer);
+
+    if (scissor->extent[0] < -0.5f || scissor->extent[1] < -0.5f) {
+        out.scissor = false;
+    } else {
+        out.scissor = true;
+        nvgTransformInverse(out.scissor_mat, scissor->xform);
+        out.scissor_ext[0] = scissor->extent[0];
+        out.scissor_ext[1] = scissor->extent[1];
+        out.scissor_scale[0] = std::sqrt(scissor->xform[0] * scissor->xform[0] +
+                                         scissor->xform[2] * scissor->xform[2]) / fringe;
+        out.scissor_scale[1] = std::sqrt(scissor->xform[1] * scissor->xform[1] +
+                                         scissor->xform[3] * scissor->xform[3]) / fringe;
+    }
+
+    out.extent[0] = paint->extent[0];
+    out.extent[1] = paint->extent[1];
+    out.radius = paint->radius;
+    out.feather = std::max(paint->feather, 1e-6f);
+    nvgTransformInverse(out.paint_mat, paint->xform);
+
+    out.image = nullptr;
+    out.tex_type = 0;
+    if (paint->image != 0) {
+        auto it = ctx->images.find(paint->image);
+        if (it != ctx->images.end()) {
+            out.image = it->second;
+            if (out.image->type == NVG_TEXTURE_RGBA)
+                out.tex_type = (out.image->flags & NVG_IMAGE_PREMULTIPLIED) ? 0 : 1;
+            else
+                out.tex_type = 2;
+        }
+    }
+
+    out.solid = !out.image && memcmp(out.inner, out.outer, sizeof(float) * 4) == 0;
+    out.blend = op;
+    out.source_over = op.srcRGB == NVG_ONE && op.dstRGB == NVG_ONE_MINUS_SRC_ALPHA &&
+                      op.srcAlpha == NVG_ONE && op.dstAlpha == NVG_ONE_MINUS_SRC_ALPHA;
+}
+
+static float sw_scissor_mask(const SWPaint &p, float x, float y) {
+    if (!p.scissor)
+        return 1.f;
+    const float *m = p.scissor_mat;
+    float sx = std::abs(m[0] * x + m[2] * y + m[4]) - p.scissor_ext[0],
+          sy = std::abs(m[1] * x + m[3] * y + m[5]) - p.scissor_ext[1];
+    return sw_clamp01(0.5f - sx * p.scissor_scale[0]) *
+           sw_clamp01(0.5f - sy * p.scissor_scale[1]);
+}
+
+static void sw_fetch(const SWImage &img, int x, int y, float out[4]) {
+    if (img.flags & NVG_IMAGE_REPEATX)
+        x = ((x % img.width) + img.width) % img.width;
+    else
+        x = std::min(std::max(x, 0), img.width - 1);
+    if (img.flags & NVG_IMAGE_REPEATY)
+        y = ((y % img.height) + img.height) % img.height;
+    else
+        y = std::min(std::max(y, 0), img.height - 1);
+
+    size_t index = (size_t) y * img.width + x;
+    if (img.type == NVG_TEXTURE_RGBA) {
+        const uint8_t *texel = img.data.data() + index * 4;
+        for (int i = 0; i < 4; ++i)
+            out[i] = texel[i] * (1.f / 255.f);
+    } else {
+        out[0] = out[1] = out[2] = out[3] = img.data[index] * (1.f / 255.f);
+    }
+}
+
+/// Sample an image at normalized coordinates and convert to premultiplied RGBA
+static void sw_sample(const SWPaint &p, float u, float v, float out[4]) {
+    const SWImage &img = *p.image;
+    if (img.width <= 0 || img.height <= 0) {
+        out[0] = out[1] = out[2] = out[3] = 0.f;
+        return;
+    }
+    if (img.flags & NVG_IMAGE_FLIPY)
+        v = 1.f - v;
+
+    float fx = u * img.width - 0.5f, fy = v * img.height - 0.5f;
+    if (img.flags & NVG_IMAGE_NEAREST) {
+        sw_fetch(img, (int) std::floor(fx + 0.5f), (int) std::floor(fy + 0.5f), out);
+    } else {
+        float x0f = std::floor(fx), y0f = std::floor(fy),
+              tx = fx - x0f, ty = fy - y0f;
+        int x0 = (int) x0f, y0 = (int) y0f;
+        float t00[4], t10[4], t01[4], t11[4];
+        sw_fetch(img, x0, y0, t00);
+        sw_fetch(img, x0 + 1, y0, t10);
+        sw_fetch(img, x0, y0 + 1, t01);
+        sw_fetch(img, x0 + 1, y0 + 1, t11);
+        for (int i = 0; i < 4; ++i)
+            out[i] = (t00[i] * (1.f - tx) + t10[i] * tx) * (1.f - ty) +
+                     (t01[i] * (1.f - tx) + t11[i] * tx) * ty;
+    }
+
+    if (p.tex_type == 1) {
+        out[0] *= out[3];
+        out[1] *= out[3];
+        out[2] *= out[3];
+    }
+}
+
+static float sw_sdroundrect(float x, float y, float ex, float ey, float radius) {
+    float dx = std::abs(x) - (ex - radius),
+          dy = std::abs(y) - (ey - radius),
+          mx = std::max(dx, 0.f), my = std::max(dy, 0.f);
+    return std::min(std::max(dx, dy), 0.f) + std::sqrt(mx * mx + my * my) - radius;
+}
+
+/// Evaluate the paint of a fill or stroke at a point (in NanoVG coordinates)
+static void sw_paint_color(const SWPaint &p, float x, float y, float out[4]) {
+    if (p.solid) {
+        memcpy(out, p.inner, sizeof(float) * 4);
+    } else {
+        const float *m = p.paint_mat;
+        float px = m[0] * x + m[2] * y + m[4],
+              py = m[1] * x + m[3] * y + m[5];
+        if (p.image) {
+            sw_sample(p, px / p.extent[0], py / p.extent[1], out);
+            for (int i = 0; i < 4; ++i)
+                out[i] *= p.inner[i];
+        } else {
+            float d = sw_clamp01((sw_sdroundrect(px, py, p.extent[0], p.extent[1], p.radius) +
+                                  p.feather * 0.5f) / p.feather);
+            for (int i = 0; i < 4; ++i)
+                out[i] = p.inner[i] * (1.f - d) + p.outer[i] * d;
+        }
+    }
+
+    float mask = sw_scissor_mask(p, x, y);
+    for (int i = 0; i < 4; ++i)
+        out[i] *= mask;
+}
+
+// ----------------------------------------------------------------------------
+//  Blending
+// ----------------------------------------------------------------------------
+
+static float sw_blend_factor(int factor, const float src[4], const float dst[4], int channel) {
+    switch (factor) {
+        case NVG_ZERO: return 0.f;
+        case NVG_ONE: return 1.f;
+        case NVG_SRC_COLOR: return src[channel];
+        case NVG_ONE_MINUS_SRC_COLOR: return 1.f - src[channel];
+        case NVG_DST_COLOR: return dst[channel];
+        case NVG_ONE_MINUS_DST_COLOR: return 1.f - dst[channel];
+        case NVG_SRC_ALPHA: return src[3];
+        case NVG_ONE_MINUS_SRC_ALPHA: return 1.f - src[3];
+        case NVG_DST_ALPHA: return dst[3];
+        case NVG_ONE_MINUS_DST_ALPHA: return 1.f - dst[3];
+        case NVG_SRC_ALPHA_SATURATE:
+            return channel == 3 ? 1.f : std::min(src[3], 1.f - dst[3]);
+        default: return 0.f;
+    }
+}
+
+/// Blend a premultiplied color (in [0, 1]) into a framebuffer pixel
+static void sw_blend(const SWPaint &p, const float src[4], uint8_t *pixel) {
+    if (p.source_over) {
+        float t = 1.f - src[3];
+        for (int i = 0; i < 4; ++i)
+            pixel[i] = (uint8_t) (src[i] * 255.f + pixel[i] * t + 0.5f);
+        return;
+    }
+
+    float dst[4];
+    for (int i = 0; i < 4; ++i)
+        dst[i] = pixel[i] * (1.f / 255.f);
+    for (int i = 0; i < 4; ++i) {
+        bool alpha = i == 3;
+        float fs = sw_blend_factor(alpha ? p.blend.srcAlpha : p.blend.srcRGB, src, dst, i),
+              fd = sw_blend_factor(alpha ? p.blend.dstAlpha : p.blend.dstRGB, src, dst, i);
+        pixel[i] = (uint8_t) (sw_clamp01(src[i] * fs + dst[i] * fd) * 255.f + 0.5f);
+    }
+}
+
+/// Blend a span of pixels with the given coverage values into row \c y
+static void sw_blend_span(SWContext *ctx, const SWPaint &p, int x0, int y,
+                          const float *coverage, int width) {
+    uint8_t *dst = ctx->framebuffer.data() + ((size_t) y * ctx->size.x() + x0) * 4;
+
+    if (p.solid && !p.scissor && p.source_over) {
+        /* Fast path for solid colors: branch-free so that it vectorizes */
+        const float r = p.inner[0] * 255.f, g = p.inner[1] * 255.f,
+                    b = p.inner[2] * 255.f, a = p.inner[3] * 255.f,
+                    alpha = p.inner[3];
+        for (int x = 0; x < width; ++x) {
+            float c = coverage[x], t = 1.f - alpha * c;
+            uint8_t *pixel = dst + x * 4;
+            pixel[0] = (uint8_t) (r * c + pixel[0] * t + 0.5f);
+            pixel[1] = (uint8_t) (g * c + pixel[1] * t + 0.5f);
+            pixel[2] = (uint8_t) (b * c + pixel[2] * t + 0.5f);
+            pixel[3] = (uint8_t) (a * c + pixel[3] * t + 0.5f);
+        }
+        return;
+    }
+
+    float inv_ratio = 1.f / ctx->pixel_ratio,
+          py = (y + 0.5f) * inv_ratio;
+    for (int x = 0; x < width; ++x) {
+        float c = coverage[x];
+        if (c <= 0.f)
+            continue;
+        float color[4];
+        sw_paint_color(p, (x0 + x + 0.5f) * inv_ratio, py, color);
+        for (int i = 0; i < 4; ++i)
+            color[i] *= c;
+        sw_blend(p, color, dst + x * 4);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//  Rasterization
+// ----------------------------------------------------------------------------
+
+/**
+ * Accumulate the signed area that a directed edge contributes to the pixels
+ * of a region with \c width columns and \c height rows. The prefix sum of
+ * every row then yields the winding-weighted coverage of each pixel. Each
+ * row has two padding entries, and x coordinates are clamped to the region
+ * (parts left of it still affect the whole row, parts right of it nothing).
+ */
+static void sw_accumulate(float *acc, int width, int height,
+                          float x0, float y0, float x1, float y1) {
+    if (y0 == y1)
+        return;
+
+    float dir = 1.f;
+    if (y0 > y1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        dir = -1.f;
+    }
+    if (y1 <= 0.f || y0 >= (float) height)
+        return;
+
+    float dxdy = (x1 - x0) / (y1 - y0), w = (float) width;
+    int ys = std::max(0, (int) std::floor(y0)),
+        ye = std::min(height, (int) std::ceil(y1));
+    float x = x0 + (std::max(y0, (float) ys) - y0) * dxdy;
+
+    for (int y = ys; y < ye; ++y) {
+        float *row = acc + (size_t) y * (width + 2);
+        float dy = std::min((float) (y + 1), y1) - std::max((float) y, y0),
+              x_next = x + dxdy * dy,
+              d = dy * dir,
+              xa = std::min(std::max(std::min(x, x_next), 0.f), w),
+              xb = std::min(std::max(std::max(x, x_next), 0.f), w);
+        float xa_floor = std::floor(xa);
+        int xa_i = (int) xa_floor, xb_i = (int) std::ceil(xb);
+
+        if (xb_i <= xa_i + 1) {
+            /* The edge touches a single pixel of this row */
+            float xm = 0.5f * (xa + xb) - xa_floor;
+            row[xa_i] += d - d * xm;
+            row[xa_i + 1] += d * xm;
+        } else {
+            float s = 1.f / (xb - xa),
+                  x0f = xa - xa_floor,
+                  a0 = 0.5f * s * (1.f - x0f) * (1.f - x0f),
+                  x1f = xb - std::ceil(xb) + 1.f,
+                  am = 0.5f * s * x1f * x1f;
+            row[xa_i] += d * a0;
+            if (xb_i == xa_i + 2) {
+                row[xa_i + 1] += d * (1.f - a0 - am);
+            } else {
+                float a1 = s * (1.5f - x0f);
+                row[xa_i + 1] += d * (a1 - a0);
+                for (int xi = xa_i + 2; xi < xb_i - 1; ++xi)
+                    row[xi] += d * s;
+                float a2 = a1 + (xb_i - xa_i - 3) * s;
+                row[xb_i - 1] += d * (1.f - a2 - am);
+            }
+            row[xb_i] += d * am;
+        }
+        x = x_next;
+    }
+}
+
+/// Rasterize the polygons of a fill or stroke call within rows [y0, y1)
+static void sw_render_fill(SWContext *ctx, const SWCall &call, int y0, int y1,
+                           std::vector<float> &acc) {
+    int x0 = call.x0, width = std::min(call.x1, ctx->size.x()) - x0,
+        height = y1 - y0, stride = width + 2;
+    if (width <= 0)
+        return;
+
+    acc.assign((size_t) stride * height, 0.f);
+    const SWEdge *edges = ctx->edges.data() + call.offset;
+    for (size_t i = 0; i < call.count; ++i) {
+        const SWEdge &e = edges[i];
+        if (std::max(e.y0, e.y1) <= (float) y0 || std::min(e.y0, e.y1) >= (float) y1)
+            continue;
+        sw_accumulate(acc.data(), width, height, e.x0 - x0, e.y0 - y0,
+                      e.x1 - x0, e.y1 - y0);
+    }
+
+    for (int y = 0; y < height; ++y) {
+        float *row = acc.data() + (size_t) y * stride, sum = 0.f;
+        for (int x = 0; x < width; ++x) {
+            sum += row[x];
+            row[x] = std::min(std::abs(sum), 1.f);
+        }
+        sw_blend_span(ctx, call.paint, x0, y0 + y, row, width);
+    }
+}
+
+static float sw_edge_function(const SWVertex &a, const SWVertex &b, float x, float y) {
+    return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+}
+
+/// Does a pixel center on an edge belong to the triangle? (top-left rule)
+static bool sw_top_left(const SWVertex &a, const SWVertex &b) {
+    float dx = b.x - a.x, dy = b.y - a.y;
+    return dy < 0.f || (dy == 0.f && dx > 0.f);
+}
+
+/// Rasterize the textured triangles of a call (e.g. text) within rows [y0, y1)
+static void sw_render_triangles(SWContext *ctx, const SWCall &call, int y0, int y1) {
+    const SWPaint &p = call.paint;
+    float inv_ratio = 1.f / ctx->pixel_ratio;
+    int fb_width = std::min(call.x1, ctx->size.x());
+
+    for (size_t i = 0; i + 2 < call.count; i += 3) {
+        SWVertex a = ctx->vertices[call.offset + i],
+                 b = ctx->vertices[call.offset + i + 1],
+                 c = ctx->vertices[call.offset + i + 2];
+        float area = sw_edge_function(a, b, c.x, c.y);
+        if (area == 0.f)
+            continue;
+        if (area < 0.f) {
+            std::swap(b, c);
+            area = -area;
+        }
+
+        int tx0 = std::max(call.x0, (int) std::floor(std::min({ a.x, b.x, c.x }))),
+            tx1 = std::min(fb_width, (int) std::ceil(std::max({ a.x, b.x, c.x }))),
+            ty0 = std::max(y0, (int) std::floor(std::min({ a.y, b.y, c.y }))),
+            ty1 = std::min(y1, (int) std::ceil(std::max({ a.y, b.y, c.y })));
+        bool tl0 = sw_top_left(b, c), tl1 = sw_top_left(c, a), tl2 = sw_top_left(a, b);
+        float inv_area = 1.f / area;
+
+        for (int y = ty0; y < ty1; ++y) {
+            uint8_t *dst = ctx->framebuffer.data() + (size_t) y * ctx->size.x() * 4;
+            float py = y + 0.5f;
+            for (int x = tx0; x < tx1; ++x) {
+                float px = x + 0.5f,
+                      w0 = sw_edge_function(b, c, px, py),
+                      w1 = sw_edge_function(c, a, px, py),
+                      w2 = sw_edge_function(a, b, px, py);
+                if (w0 < 0.f || w1 < 0.f || w2 < 0.f ||
+                    (w0 == 0.f && !tl0) || (w1 == 0.f && !tl1) || (w2 == 0.f && !tl2))
+                    continue;
+                w0 *= inv_area; w1 *= inv_area; w2 *= inv_area;
+
+                float color[4];
+                if (p.image) {
+                    sw_sample(p, w0 * a.u + w1 * b.u + w2 * c.u,
+                                 w0 * a.v + w1 * b.v + w2 * c.v, color);
+                    for (int k = 0; k < 4; ++k)
+                        color[k] *= p.inner[k];
+                } else {
+                    memcpy(color, p.inner, sizeof(float) * 4);
+                }
+
+                float mask = sw_scissor_mask(p, px * inv_ratio, py * inv_ratio);
+                if (color[3] * mask <= 0.f && p.source_over)
+                    continue;
+                for (int k = 0; k < 4; ++k)
+                    color[k] *= mask;
+                sw_blend(p, color, dst + x * 4);
+            }
+        }
+    }
+}
+
+static void sw_render_clear(SWContext *ctx, const SWCall &call, int y0, int y1) {
+    uint8_t value[4];
+    for (int i = 0; i < 4; ++i)
+        value[i] = (uint8_t) (sw_clamp01(call.paint.inner[i]) * 255.f + 0.5f);
+    uint8_t *dst = ctx->framebuffer.data() + (size_t) y0 * ctx->size.x() * 4;
+    size_t count = (size_t) (y1 - y0) * ctx->size.x();
+    for (size_t i = 0; i < count; ++i)
+        memcpy(dst + i * 4, value, 4);
+}
+
+/// Rasterize tiles until all of them have been claimed
+static void sw_render_tiles(SWContext *ctx, uint32_t index) {
+    std::vector<float> &acc = ctx->scratch[index];
+    int tile;
+    while ((tile = ctx->next_tile++) < ctx->tile_count) {
+        int y0 = tile * SWTileHeight,
+            y1 = std::min(y0 + SWTileHeight, ctx->size.y());
+
+        for (const SWCall &call : ctx->calls) {
+            int cy0 = std::max(call.y0, y0), cy1 = std::min(call.y1, y1);
+            if (cy0 >= cy1)
+                continue;
+            switch (call.type) {
+                case SWCall::Type::Fill: sw_render_fill(ctx, call, cy0, cy1, acc); break;
+                case SWCall::Type::Triangles: sw_render_triangles(ctx, call, cy0, cy1); break;
+                case SWCall::Type::Clear: sw_render_clear(ctx, call, cy0, cy1); break;
+            }
+        }
+    }
+}
+
+static void sw_worker(SWContext *ctx, uint32_t index) {
+    uint64_t generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(ctx->mutex);
+            ctx->work_cv.wait(guard, [&] {
+                return ctx->stop || ctx->generation != generation;
+            });
+            if (ctx->stop)
+                return;
+            generation = ctx->generation;
+        }
+
+        sw_render_tiles(ctx, index);
+
+        std::lock_guard<std::mutex> guard(ctx->mutex);
+        if (--ctx->busy == 0)
+            ctx->done_cv.notify_one();
+    }
+}
+
+// ----------------------------------------------------------------------------
+//  NanoVG backend interface
+// ----------------------------------------------------------------------------
+
+static int sw_nvg_render_create(void *) {
+    return 1;
+}
+
+static int sw_nvg_render_create_texture(void *uptr, int type, int w, int h,
+                                        int image_flags, const unsigned char *data) {
+    SWContext *ctx = (SWContext *) uptr;
+    auto image = std::make_shared<SWImage>();
+    image->type = type;
+    image->width = w;
+    image->height = h;
+    image->flags = image_flags;
+
+    size_t size = (size_t) w * (size_t) h * (type == NVG_TEXTURE_RGBA ? 4 : 1);
+    if (data)
+        image->data.assign(data, data + size);
+    else
+        image->data.assign(size, 0);
+
+    int id = ctx->next_image++;
+    ctx->images[id] = std::move(image);
+    return id;
+}
+
+static int sw_nvg_render_delete_texture(void *uptr, int id) {
+    /* Pending draw calls keep a reference to the image data */
+    return ((SWContext *) uptr)->images.erase(id) ? 1 : 0;
+}
+
+static int sw_nvg_render_update_texture(void *uptr, int id, int x, int y, int w, int h,
+                                        const unsigned char *data) {
+    SWContext *ctx = (SWContext *) uptr;
+    auto it = ctx->images.find(id);
+    if (it == ctx->images.end())
+        return 0;
+
+    /* 'data' points to the full image, as with GL_UNPACK_ROW_LENGTH in nanovg_gl.h */
+    SWImage &image = *it->second;
+    size_t bpp = image.type == NVG_TEXTURE_RGBA ? 4 : 1,
+           stride = (size_t) image.width * bpp;
+    for (int row = y; row < y + h; ++row) {
+        size_t offset = row * stride + x * bpp;
+        memcpy(image.data.data() + offset, data + offset, w * bpp);
+    }
+    return 1;
+}
+
+static int sw_nvg_render_get_texture_size(void *uptr, int id, int *w, int *h) {
+    SWContext *ctx = (SWContext *) uptr;
+    auto it = ctx->images.find(id);
+    if (it == ctx->images.end())
+        return 0;
+    *w = it->second->width;
+    *h = it->second->height;
+    return 1;
+}
+
+static void sw_nvg_render_viewport(void *uptr, float width, float height, float pixel_ratio) {
+    SWContext *ctx = (SWContext *) uptr;
+    Vector2i size((int) std::lround(width * pixel_ratio),
+                  (int) std::lround(height * pixel_ratio));
+    size = max(size, Vector2i(0));
+    if (size != ctx->size) {
+        ctx->size = size;
+        ctx->framebuffer.assign((size_t) size.x() * (size_t) size.y() * 4, 0);
+    }
+    ctx->pixel_ratio = pixel_ratio;
+}
+
+static void sw_nvg_render_cancel(void *uptr) {
+    SWContext *ctx = (SWContext *) uptr;
+    ctx->calls.clear();
+    ctx->edges.clear();
+    ctx->vertices.clear();
+}
+
+static void sw_nvg_render_flush(void *uptr) {
+    SWContext *ctx = (SWContext *) uptr;
+    if (!ctx->calls.empty() && ctx->size.x() > 0 && ctx->size.y() > 0) {
+        ctx->tile_count = (ctx->size.y() + SWTileHeight - 1) / SWTileHeight;
+        ctx->next_tile = 0;
+
+        bool parallel = !ctx->threads.empty() && ctx->tile_count > 1;
+        if (parallel) {
+            {
+                std::lock_guard<std::mutex> guard(ctx->mutex);
+                ctx->busy = (uint32_t) ctx->threads.size();
+                ctx->generation++;
+            }
+            ctx->work_cv.notify_all();
+        }
+
+        sw_render_tiles(ctx, 0);
+
+        if (parallel) {
+            std::unique_lock<std::mutex> guard(ctx->mutex);
+            ctx->done_cv.wait(guard, [&] { return ctx->busy == 0; });
+        }
+    }
+
+    sw_nvg_render_cancel(uptr);
+}
+
+/// Compute the (clipped) pixel bounds of a draw call
+static bool sw_set_bounds(SWContext *ctx, SWCall &call, float x0, float y0,
+                          float x1, float y1) {
+    call.x0 = std::max(0, (int) std::floor(x0));
+    call.y0 = std::max(0, (int) std::floor(y0));
+    call.x1 = std::min(ctx->size.x(), (int) std::ceil(x1));
+    call.y1 = std::min(ctx->size.y(), (int) std::ceil(y1));
+    return call.x0 < call.x1 && call.y0 < call.y1;
+}
+
+static void sw_nvg_render_fill(void *uptr, NVGpaint *paint, NVGcompositeOperationState op,
+                               NVGscissor *scissor, float fringe, const float *bounds,
+                               const NVGpath *paths, int npaths) {
+    SWContext *ctx = (SWContext *) uptr;
+    float ratio = ctx->pixel_ratio;
+
+    SWCall call;
+    call.type = SWCall::Type::Fill;
+    if (!sw_set_bounds(ctx, call, bounds[0] * ratio, bounds[1] * ratio,
+                       bounds[2] * ratio, bounds[3] * ratio))
+        return;
+    sw_convert_paint(ctx, call.paint, paint, op, scissor, fringe);
+
+    /* The fill vertices of each path form a closed polygon */
+    call.offset = ctx->edges.size();
+    for (int i = 0; i < npaths; ++i) {
+        const NVGvertex *v = paths[i].fill;
+        int n = paths[i].nfill;
+        for (int j = 0; j < n; ++j) {
+            const NVGvertex &a = v[j], &b = v[j + 1 < n ? j + 1 : 0];
+            ctx->edges.push_back({ a.x * ratio, a.y * ratio, b.x * ratio, b.y * ratio });
+        }
+    }
+    call.count = ctx->edges.size() - call.offset;
+    ctx->calls.push_back(std::move(call));
+}
+
+static void sw_nvg_render_stroke(void *uptr, NVGpaint *paint, NVGcompositeOperationState op,
+                                 NVGscissor *scissor, float fringe, float,
+                                 const NVGpath *paths, int npaths) {
+    SWContext *ctx = (SWContext *) uptr;
+    float ratio = ctx->pixel_ratio,
+          x0 = INFINITY, y0 = INFINITY, x1 = -INFINITY, y1 = -INFINITY;
+
+    SWCall call;
+    call.type = SWCall::Type::Fill;
+    call.offset = ctx->edges.size();
+
+    /* Each triangle of the strips is added as a positively oriented polygon,
+       hence overlapping parts of the stroke are only covered once */
+    for (int i = 0; i < npaths; ++i) {
+        const NVGvertex *v = paths[i].stroke;
+        for (int j = 0; j + 2 < paths[i].nstroke; ++j) {
+            float ax = v[j].x * ratio,     ay = v[j].y * ratio,
+                  bx = v[j + 1].x * ratio, by = v[j + 1].y * ratio,
+                  cx = v[j + 2].x * ratio, cy = v[j + 2].y * ratio,
+                  area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+            if (area == 0.f)
+                continue;
+            if (area < 0.f) {
+                std::swap(bx, cx);
+                std::swap(by, cy);
+            }
+            ctx->edges.push_back({ ax, ay, bx, by });
+            ctx->edges.push_back({ bx, by, cx, cy });
+            ctx->edges.push_back({ cx, cy, ax, ay });
+            x0 = std::min({ x0, ax, bx, cx }); x1 = std::max({ x1, ax, bx, cx });
+            y0 = std::min({ y0, ay, by, cy }); y1 = std::max({ y1, ay, by, cy });
+        }
+    }
+
+    call.count = ctx->edges.size() - call.offset;
+    if (call.count == 0 || !sw_set_bounds(ctx, call, x0, y0, x1, y1)) {
+        ctx->edges.resize(call.offset);
+        return;
+    }
+    sw_convert_paint(ctx, call.paint, paint, op, scissor, fringe);
+    ctx->calls.push_back(std::move(call));
+}
+
+static void sw_nvg_render_triangles(void *uptr, NVGpaint *paint, NVGcompositeOperationState op,
+                                    NVGscissor *scissor, const NVGvertex *verts, int nverts,
+                                    float fringe) {
+    SWContext *ctx = (SWContext *) uptr;
+    float ratio = ctx->pixel_ratio,
+          x0 = INFINITY, y0 = INFINITY, x1 = -INFINITY, y1 = -INFINITY;
+
+    SWCall call;
+    call.type = SWCall::Type::Triangles;
+    call.offset = ctx->vertices.size();
+    call.count = (size_t) nverts;
+    for (int i = 0; i < nverts; ++i) {
+        SWVertex v { verts[i].x * ratio, verts[i].y * ratio, verts[i].u, verts[i].v };
+        x0 = std::min(x0, v.x); x1 = std::max(x1, v.x);
+        y0 = std::min(y0, v.y); y1 = std::max(y1, v.y);
+        ctx->vertices.push_back(v);
+    }
+
+    if (nverts < 3 || !sw_set_bounds(ctx, call, x0, y0, x1, y1)) {
+        ctx->vertices.resize(call.offset);
+        return;
+    }
+    sw_convert_paint(ctx, call.paint, paint, op, scissor, fringe);
+    ctx->calls.push_back(std::move(call));
+}
+
+static void sw_nvg_render_delete(void *uptr) {
+    SWContext *ctx = (SWContext *) uptr;
+    {
+        std::lock_guard<std::mutex> guard(ctx->mutex);
+        ctx->stop = true;
+    }
+    ctx->work_cv.notify_all();
+    for (std::thread &thread : ctx->threads)
+        thread.join();
+    delete ctx;
+}
+
+// ----------------------------------------------------------------------------
+//  Public interface
+// ----------------------------------------------------------------------------
+
+NVGcontext *sw_nvg_create(uint32_t thread_count) {
+    if (thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    SWContext *ctx = new SWContext();
+    ctx->scratch.resize(thread_count);
+    for (uint32_t i = 1; i < thread_count; ++i)
+        ctx->threads.emplace_back(sw_worker, ctx, i);
+
+    NVGparams params;
+    memset(&params, 0, sizeof(params));
+    params.renderCreate = sw_nvg_render_create;
+    params.renderCreateTexture = sw_nvg_render_create_texture;
+    params.renderDeleteTexture = sw_nvg_render_delete_texture;
+    params.renderUpdateTexture = sw_nvg_render_update_texture;
+    params.renderGetTextureSize = sw_nvg_render_get_texture_size;
+    params.renderViewport = sw_nvg_render_viewport;
+    params.renderCancel = sw_nvg_render_cancel;
+    params.renderFlush = sw_nvg_render_flush;
+    params.renderFill = sw_nvg_render_fill;
+    params.renderStroke = sw_nvg_render_stroke;
+    params.renderTriangles = sw_nvg_render_triangles;
+    params.renderDelete = sw_nvg_render_delete;
+    params.userPtr = ctx;
+    /* Edges are antialiased using exact area coverage, NanoVG's fringes
+       (designed for GPU rasterization) are not needed */
+    params.edgeAntiAlias = 0;
+
+    /* nvgCreateInternal() releases the user pointer via renderDelete on failure */
+    return nvgCreateInternal(&params);
+}
+
+void sw_nvg_delete(NVGcontext *ctx) {
+    nvgDeleteInternal(ctx);
+}
+
+bool sw_nvg_is_software(NVGcontext *ctx) {
+    return ctx && nvgInternalParams(ctx)->renderCreate == sw_nvg_render_create;
+}
+
+static SWContext *sw_context(NVGcontext *ctx, const char *func) {
+    if (!sw_nvg_is_software(ctx))
+        throw std::runtime_error(std::string(func) +
+                                 "(): not a software rendering context!");
+    return (SWContext *) nvgInternalParams(ctx)->userPtr;
+}
+
+void sw_nvg_clear(NVGcontext *ctx_, const Color &color) {
+    SWContext *ctx = sw_context(ctx_, "sw_nvg_clear");
+
+    /* Clears cover the framebuffer size at the time of the flush */
+    SWCall call;
+    call.type = SWCall::Type::Clear;
+    call.x0 = call.y0 = 0;
+    call.x1 = call.y1 = std::numeric_limits<int>::max();
+    call.offset = call.count = 0;
+    for (int i = 0; i < 3; ++i)
+        call.paint.inner[i] = color[i] * color.a();
+    call.paint.inner[3] = color.a();
+    ctx->calls.push_back(std::move(call));
+}
+
+const uint8_t *sw_nvg_framebuffer(NVGcontext *ctx_, Vector2i *size) {
+    SWContext *ctx = sw_context(ctx_, "sw_nvg_framebuffer");
+    if (size)
+        *size = ctx->size;
+    return ctx->framebuffer.data();
+}
+
+void sw_nvg_read_pixels(NVGcontext *ctx_, uint8_t *data) {
+    SWContext *ctx = sw_context(ctx_, "sw_nvg_read_pixels");
+    size_t count = (size_t) ctx->size.x() * (size_t) ctx->size.y();
+    const uint8_t *src = ctx->framebuffer.data();
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t *in = src + i * 4;
+        uint8_t *out = data + i * 4;
+        uint32_t alpha = in[3];
+        for (int k = 0; k < 3; ++k)
+            out[k] = alpha == 0 ? 0 : (uint8_t) std::min(
+                255u, (in[k] * 255u + alpha / 2u) / alpha);
+        out[3] = (uint8_t) alpha;
+    }
+}
+
+static uint32_t sw_crc32(const uint8_t *data, size_t size, uint32_t crc = 0) {
+    static uint32_t table[256] = { 0 };
+    static std::once_flag table_flag;
+    std::call_once(table_flag, [] {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+    });
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void sw_put_u32(std::vector<uint8_t> &out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8)
+        out.push_back((uint8_t) (value >> shift));
+}
+
+static void sw_put_chunk(std::ofstream &os, const char *type, const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> chunk;
+    sw_put_u32(chunk, (uint32_t) data.size());
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    sw_put_u32(chunk, sw_crc32(chunk.data() + 4, chunk.size() - 4));
+    os.write((const char *) chunk.data(), (std::streamsize) chunk.size());
+}
+
+void sw_nvg_save_png(NVGcontext *ctx_, const std::string &filename) {
+    SWContext *ctx = sw_context(ctx_, "sw_nvg_save_png");
+    size_t width = (size_t) ctx->size.x(), height = (size_t) ctx->size.y(),
+           row_size = width * 4 + 1;
+
+    /* Rows prefixed by their filter type (0: none) */
+    std::vector<uint8_t> pixels(width * height * 4), raw(row_size * height);
+    sw_nvg_read_pixels(ctx_, pixels.data());
+    for (size_t y = 0; y < height; ++y) {
+        raw[y * row_size] = 0;
+        memcpy(raw.data() + y * row_size + 1, pixels.data() + y * width * 4, width * 4);
+    }
+
+    /* zlib stream consisting of uncompressed deflate blocks */
+    std::vector<uint8_t> idat = { 0x78, 0x01 };
+    size_t pos = 0;
+    do {
+        size_t block = std::min(raw.size() - pos, (size_t) 65535);
+        idat.push_back(pos + block == raw.size() ? 1 : 0);
+        idat.push_back((uint8_t) block);
+        idat.push_back((uint8_t) (block >> 8));
+        idat.push_back((uint8_t) ~block);
+        idat.push_back((uint8_t) (~block >> 8));
+        idat.insert(idat.end(), raw.begin() + pos, raw.begin() + pos + block);
+        pos += block;
+    } while (pos < raw.size());
+
+    uint32_t s1 = 1, s2 = 0;
+    for (uint8_t value : raw) {
+        s1 = (s1 + value) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+    sw_put_u32(idat, (s2 << 16) | s1);
+
+    std::vector<uint8_t> ihdr;
+    sw_put_u32(ihdr, (uint32_t) width);
+    sw_put_u32(ihdr, (uint32_t) height);
+    ihdr.insert(ihdr.end(), { 8, 6, 0, 0, 0 }); // 8 bit RGBA, no interlacing
+
+    std::ofstream os(filename, std::ios::binary);
+    if (!os)
+        throw std::runtime_error("sw_nvg_save_png(): could not open \"" + filename + "\"!");
+    const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    os.write((const char *) signature, 8);
+    sw_put_chunk(os, "IHDR", ihdr);
+    sw_put_chunk(os, "IDAT", idat);
+    sw_put_chunk(os, "IEND", { });
+    if (!os)
+        throw std::runtime_error("sw_nvg_save_png(): could not write \"" + filename + "\"!");
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,105 @@
+/*
+    src/streamingtexture.cpp -- Multi-buffered texture for continuously
+    updated content such as live video
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/streamingtexture.h>
+#include <cstring>
+
+NAMESPACE_BEGIN(nanogui)
+
+StreamingTexture::StreamingTexture(PixelFormat pixel_format,
+                                   ComponentFormat component_format,
+                                   const Vector2i &size,
+                                   size_t buffer_count,
+                                   InterpolationMode min_interpolation_mode,
+                                   InterpolationMode mag_interpolation_mode)
+    : m_size(size) {
+    if (buffer_count < 2)
+        throw std::runtime_error("StreamingTexture::StreamingTexture(): "
+                                 "at least two buffers are required!");
+
+    for (size_t i = 0; i < buffer_count; ++i) {
+        ref<Texture> texture = new Texture(pixel_format, component_format, size,
+                                           min_interpolation_mode,
+                                           mag_interpolation_mode);
+        if (texture->pixel_format() != pixel_format ||
+            texture->component_format() != component_format)
+            throw std::runtime_error("StreamingTexture::StreamingTexture(): "
+                                     "format not supported by the hardware!");
+        m_textures.push_back(texture);
+    }
+
+    m_frame_bytes = m_textures[0]->bytes_per_pixel() * (size_t) size.x() * (size_t) size.y();
+    for (int i = 0; i < 3; ++i)
+        m_slots[i].reset(new uint8_t[m_frame_bytes]);
+}
+
+StreamingTexture::~StreamingTexture() { }
+
+void StreamingTexture::push(const uint8_t *data, size_t row_stride) {
+    size_t packed_stride = m_frame_bytes / m_size.y();
+    if (row_stride == 0)
+        row_stride = packed_stride;
+    else if (row_stride < packed_stride)
+        throw std::runtime_error("StreamingTexture::push(): invalid row stride!");
+
+    uint8_t *target = begin_frame();
+    if (row_stride == packed_stride) {
+        memcpy(target, data, m_frame_bytes);
+    } else {
+        for (int y = 0; y < m_size.y(); ++y)
+            memcpy(target + y * packed_stride, data + y * row_stride, packed_stride);
+    }
+    end_frame();
+}
+
+uint8_t *StreamingTexture::begin_frame() {
+    m_producer_mutex.lock();
+    /* The back slot is owned by the producer, no further locking needed */
+    return m_slots[m_back].get();
+}
+
+void StreamingTexture::end_frame() {
+    std::function<void()> callback;
+    /* Publish the frame by swapping the back and middle slots */ {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        std::swap(m_back, m_middle);
+        m_fresh = true;
+        callback = m_frame_callback;
+    }
+    m_frames_pushed++;
+    m_producer_mutex.unlock();
+
+    if (callback)
+        callback();
+}
+
+bool StreamingTexture::update() {
+    /* Fetch the latest frame by swapping the middle and front slots */ {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (!m_fresh)
+            return false;
+        std::swap(m_middle, m_front);
+        m_fresh = false;
+    }
+
+    m_current = (m_current + 1) % m_textures.size();
+    m_textures[m_current]->upload_async(m_slots[m_front].get());
+    m_frames_uploaded++;
+    return true;
+}
+
+void StreamingTexture::set_frame_callback(const std::function<void()> &callback) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_frame_callback = callback;
+}
+
+NAMESPACE_END(nanogui)
@@ -74,6 +74,13 @@ size_t Texture::bytes_per_pixel() const {
     return result * channels();
 }
 
+uint32_t Texture::mip_levels() const {
+    uint32_t levels = 1;
+    for (int size = std::max(m_size.x(), m_size.y()); size > 1; size >>= 1)
+        levels++;
+    return levels;
+}
+
 size_t Texture::channels() const {
     size_t result = 1;
     switch (m_pixel_format) {
@@ -1,6 +1,9 @@
 #include <nanogui/texture.h>
 #include <nanogui/opengl.h>
+#include <nanogui/glstate.h>
 #include "opengl_check.h"
+#include <algorithm>
+#include <deque>
 #include <memory>
 
 #if !defined(GL_HALF_FLOAT)
@@ -50,6 +53,71 @@
 
 NAMESPACE_BEGIN(nanogui)
 
+#if defined(NANOGUI_USE_OPENGL) || NANOGUI_GLES_VERSION == 3
+#  define NANOGUI_HAS_PBO 1
+#endif
+
+#if defined(NANOGUI_HAS_PBO)
+struct Texture::AsyncState {
+    struct Transfer {
+        GLuint buffer = 0;
+        size_t size = 0;
+        /// Number of rows of a readback (the texture may be resized meanwhile)
+        int rows = 0;
+        GLsync fence = nullptr;
+        DownloadCallback callback;
+    };
+
+    /// Pixel unpack buffers (in flight if 'fence' is set)
+    std::vector<Transfer> uploads;
+    /// Pixel pack buffers with pending readbacks (in submission order)
+    std::deque<Transfer> downloads;
+    /// Idle pixel pack buffers
+    std::vector<Transfer> idle_downloads;
+    /// Destination of vertically flipped readbacks
+    std::unique_ptr<uint8_t[]> flip_buffer;
+    size_t flip_buffer_size = 0;
+
+    /// Has the GPU passed the given fence? (releases it if so)
+    static bool signaled(GLsync &fence, bool wait) {
+        if (!fence)
+            return true;
+        GLenum rv = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                     wait ? GL_TIMEOUT_IGNORED : 0);
+        if (rv == GL_TIMEOUT_EXPIRED)
+            return false;
+        glDeleteSync(fence);
+        fence = nullptr;
+        return true;
+    }
+
+    ~AsyncState() {
+        for (auto *list : { &uploads, &idle_downloads }) {
+            for (Transfer &t : *list) {
+                if (t.fence)
+                    glDeleteSync(t.fence);
+                glDeleteBuffers(1, &t.buffer);
+            }
+        }
+        for (Transfer &t : downloads) {
+            if (t.fence)
+                glDeleteSync(t.fence);
+            glDeleteBuffers(1, &t.buffer);
+        }
+    }
+};
+#else
+struct Texture::AsyncState { };
+#endif
+
+/// Bind a texture prior to modifying it (NanoVG may have changed the binding)
+static void bind_texture(GLenum tex_mode, GLuint texture_handle) {
+    if (tex_mode == GL_TEXTURE_2D)
+        GLState::current()->bind_texture(texture_handle, true);
+    else
+        CHK(glBindTexture(tex_mode, texture_handle));
+}
+
 static void gl_map_texture_format(Texture::PixelFormat &pixel_format,
                                   Texture::ComponentFormat &component_format,
                                   GLenum &pixel_format_gl,
@@ -105,7 +173,7 @@ void Texture::init() {
 
     if (m_flags & (uint8_t) TextureFlags::ShaderRead) {
         CHK(glGenTextures(1, &m_texture_handle));
-        CHK(glBindTexture(tex_mode, m_texture_handle));
+        bind_texture(tex_mode, m_texture_handle);
         CHK(glTexParameteri(tex_mode, GL_TEXTURE_MIN_FILTER, interpolation_mode_gl[0]));
         CHK(glTexParameteri(tex_mode, GL_TEXTURE_MAG_FILTER, interpolation_mode_gl[1]));
         CHK(glTexParameteri(tex_mode, GL_TEXTURE_WRAP_S, wrap_mode_gl));
@@ -134,7 +202,9 @@ void Texture::init() {
 }
 
 Texture::~Texture() {
+    delete m_async;
     CHK(glDeleteTextures(1, &m_texture_handle));
+    GLState::current()->texture_deleted(m_texture_handle);
     CHK(glDeleteRenderbuffers(1, &m_renderbuffer_handle));
 }
 
@@ -154,7 +224,7 @@ void Texture::upload(const uint8_t *data) {
 
     if (m_texture_handle != 0) {
         GLenum tex_mode = m_samples > 1 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
-        CHK(glBindTexture(tex_mode, m_texture_handle));
+        bind_texture(tex_mode, m_texture_handle);
 
         if (data)
             CHK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
@@ -178,8 +248,11 @@ void Texture::upload(const uint8_t *data) {
 #endif
 
         if (m_min_interpolation_mode == InterpolationMode::Trilinear ||
-            m_mag_interpolation_mode == InterpolationMode::Trilinear)
-            CHK(glGenerateMipmap(tex_mode));
+            m_mag_interpolation_mode == InterpolationMode::Trilinear) {
+            if (m_auto_mipmaps)
+                CHK(glGenerateMipmap(tex_mode));
+            m_mipmaps_dirty = !m_auto_mipmaps;
+        }
     } else {
 #if defined(NANOGUI_USE_OPENGL)
         CHK(glBindRenderbuffer(GL_RENDERBUFFER, m_renderbuffer_handle));
@@ -217,22 +290,324 @@ void Texture::download(uint8_t *data) {
                           internal_format_gl);
 
     (void) internal_format_gl;
-    CHK(glBindTexture(GL_TEXTURE_2D, m_texture_handle));
+    bind_texture(GL_TEXTURE_2D, m_texture_handle);
     CHK(glGetTexImage(GL_TEXTURE_2D, 0, pixel_format_gl, component_format_gl, data));
 
     if (m_flags & (uint8_t) TextureFlags::RenderTarget) {
+        /* Flip in place, swapping rows without a temporary buffer
+           (std::swap_ranges vectorizes well on byte arrays) */
         size_t stride = bytes_per_pixel() * m_size.x();
-        std::unique_ptr<uint8_t[]> temp(new uint8_t[stride]);
 
         uint8_t *low = (uint8_t *) data,
                 *high = low + (m_size.y() - 1) * stride;
 
-        for (; low < high; low += stride, high -= stride) {
-            memcpy(temp.get(), low, stride);
-            memcpy(low, high, stride);
-            memcpy(high, temp.get(), stride);
+        for (; low < high; low += stride, high -= stride)
+            std::swap_ranges(low, low + stride, high);
+    }
+#endif
+}
+
+void Texture::upload_sub_region(const Vector2i &offset, const Vector2i &size,
+                                const uint8_t *data, size_t row_stride,
+                                uint32_t level) {
+    if (m_texture_handle == 0)
+        throw std::runtime_error("Texture::upload_sub_region(): no texture handle!");
+    else if (m_samples > 1)
+        throw std::runtime_error("Texture::upload_sub_region(): only implemented for samples=1!");
+
+    Vector2i level_size = max(Vector2i(m_size.x() >> level, m_size.y() >> level), Vector2i(1));
+    if (offset.x() < 0 || offset.y() < 0 || size.x() < 0 || size.y() < 0 ||
+        offset.x() + size.x() > level_size.x() ||
+        offset.y() + size.y() > level_size.y())
+        throw std::runtime_error("Texture::upload_sub_region(): region out of bounds!");
+
+    size_t pixel_bytes = bytes_per_pixel(),
+           packed_stride = pixel_bytes * size.x();
+    if (row_stride == 0)
+        row_stride = packed_stride;
+    else if (row_stride < packed_stride || row_stride % pixel_bytes != 0)
+        throw std::runtime_error("Texture::upload_sub_region(): invalid row stride!");
+
+    if (size.x() == 0 || size.y() == 0)
+        return;
+
+    GLenum pixel_format_gl,
+           component_format_gl,
+           internal_format_gl;
+
+    gl_map_texture_format(m_pixel_format,
+                          m_component_format,
+                          pixel_format_gl,
+                          component_format_gl,
+                          internal_format_gl);
+    (void) internal_format_gl;
+
+    bind_texture(GL_TEXTURE_2D, m_texture_handle);
+    CHK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+#if defined(NANOGUI_USE_OPENGL) || NANOGUI_GLES_VERSION == 3
+    CHK(glPixelStorei(GL_UNPACK_ROW_LENGTH, (GLint) (row_stride / pixel_bytes)));
+    CHK(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+    CHK(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+    CHK(glTexSubImage2D(GL_TEXTURE_2D, (GLint) level, offset.x(), offset.y(),
+                        (GLsizei) size.x(), (GLsizei) size.y(), pixel_format_gl,
+                        component_format_gl, data));
+    CHK(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#else
+    /* GLES 2 lacks GL_UNPACK_ROW_LENGTH: upload row by row if needed */
+    if (row_stride == packed_stride) {
+        CHK(glTexSubImage2D(GL_TEXTURE_2D, (GLint) level, offset.x(), offset.y(),
+                            (GLsizei) size.x(), (GLsizei) size.y(), pixel_format_gl,
+                            component_format_gl, data));
+    } else {
+        for (int y = 0; y < size.y(); ++y)
+            CHK(glTexSubImage2D(GL_TEXTURE_2D, (GLint) level, offset.x(), offset.y() + y,
+                                (GLsizei) size.x(), 1, pixel_format_gl,
+                                component_format_gl, data + y * row_stride));
+    }
+#endif
+
+    if (level == 0 &&
+        (m_min_interpolation_mode == InterpolationMode::Trilinear ||
+         m_mag_interpolation_mode == InterpolationMode::Trilinear))
+        m_mipmaps_dirty = true;
+}
+
+void Texture::upload_level(uint32_t level, const uint8_t *data) {
+    if (level == 0) {
+        bool auto_mipmaps = m_auto_mipmaps;
+        m_auto_mipmaps = false;
+        upload(data);
+        m_auto_mipmaps = auto_mipmaps;
+        m_mipmaps_dirty = false;
+        return;
+    }
+
+    if (m_texture_handle == 0)
+        throw std::runtime_error("Texture::upload_level(): no texture handle!");
+    else if (m_samples > 1)
+        throw std::runtime_error("Texture::upload_level(): only implemented for samples=1!");
+    else if (level >= mip_levels())
+        throw std::runtime_error("Texture::upload_level(): level out of bounds!");
+
+    GLenum pixel_format_gl,
+           component_format_gl,
+           internal_format_gl;
+
+    gl_map_texture_format(m_pixel_format,
+                          m_component_format,
+                          pixel_format_gl,
+                          component_format_gl,
+                          internal_format_gl);
+
+    Vector2i level_size = max(Vector2i(m_size.x() >> level, m_size.y() >> level), Vector2i(1));
+
+    bind_texture(GL_TEXTURE_2D, m_texture_handle);
+    CHK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+#if defined(NANOGUI_USE_OPENGL) || NANOGUI_GLES_VERSION == 3
+    CHK(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+    CHK(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+    CHK(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+#endif
+    CHK(glTexImage2D(GL_TEXTURE_2D, (GLint) level, internal_format_gl,
+                     (GLsizei) level_size.x(), (GLsizei) level_size.y(), 0,
+                     pixel_format_gl, component_format_gl, data));
+}
+
+void Texture::generate_mipmaps() {
+    if (m_min_interpolation_mode != InterpolationMode::Trilinear &&
+        m_mag_interpolation_mode != InterpolationMode::Trilinear)
+        return;
+    if (m_texture_handle == 0)
+        throw std::runtime_error("Texture::generate_mipmaps(): no texture handle!");
+
+    bind_texture(GL_TEXTURE_2D, m_texture_handle);
+    CHK(glGenerateMipmap(GL_TEXTURE_2D));
+    m_mipmaps_dirty = false;
+}
+
+void Texture::upload_async(const uint8_t *data) {
+#if !defined(NANOGUI_HAS_PBO)
+    upload(data);
+#else
+    if (m_texture_handle == 0)
+        throw std::runtime_error("Texture::upload_async(): no texture handle!");
+    else if (m_samples > 1)
+        throw std::runtime_error("Texture::upload_async(): only implemented for samples=1!");
+
+    GLenum pixel_format_gl,
+           component_format_gl,
+           internal_format_gl;
+
+    gl_map_texture_format(m_pixel_format,
+                          m_component_format,
+                          pixel_format_gl,
+                          component_format_gl,
+                          internal_format_gl);
+    (void) internal_format_gl;
+
+    if (!m_async)
+        m_async = new AsyncState();
+
+    /* Find a staging buffer that the GPU no longer reads from. Keep at most
+       three of them in flight and otherwise wait for the oldest one. */
+    using Transfer = AsyncState::Transfer;
+    Transfer *transfer = nullptr;
+    for (Transfer &t : m_async->uploads) {
+        if (AsyncState::signaled(t.fence, false)) {
+            transfer = &t;
+            break;
+        }
+    }
+    if (!transfer) {
+        if (m_async->uploads.size() < 3) {
+            m_async->uploads.emplace_back();
+            transfer = &m_async->uploads.back();
+            CHK(glGenBuffers(1, &transfer->buffer));
+        } else {
+            transfer = &m_async->uploads.front();
+            AsyncState::signaled(transfer->fence, true);
         }
     }
+
+    size_t size = bytes_per_pixel() * m_size.x() * m_size.y();
+    CHK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, transfer->buffer));
+    if (transfer->size != size) {
+        CHK(glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) size, nullptr, GL_STREAM_DRAW));
+        transfer->size = size;
+    }
+
+    void *ptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT |
+                                 GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!ptr)
+        throw std::runtime_error("Texture::upload_async(): could not map staging buffer!");
+    memcpy(ptr, data, size);
+    CHK(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+    bind_texture(GL_TEXTURE_2D, m_texture_handle);
+    CHK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    CHK(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+    CHK(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+    CHK(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+    /* Update the existing storage instead of re-specifying level 0, which
+       would make the driver reallocate the texture */
+    CHK(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, (GLsizei) m_size.x(),
+                        (GLsizei) m_size.y(), pixel_format_gl, component_format_gl,
+                        nullptr));
+    CHK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+    if (m_min_interpolation_mode == InterpolationMode::Trilinear ||
+        m_mag_interpolation_mode == InterpolationMode::Trilinear) {
+        if (m_auto_mipmaps)
+            CHK(glGenerateMipmap(GL_TEXTURE_2D));
+        m_mipmaps_dirty = !m_auto_mipmaps;
+    }
+
+    transfer->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+}
+
+void Texture::download_async(const DownloadCallback &callback) {
+#if !defined(NANOGUI_USE_OPENGL)
+    (void) callback;
+    throw std::runtime_error("Texture::download_async(): not supported on GLES!");
+#else
+    if (m_texture_handle == 0)
+        throw std::runtime_error("Texture::download_async(): no texture handle!");
+    else if (m_samples > 1)
+        throw std::runtime_error("Texture::download_async(): only implemented for samples=1!");
+
+    GLenum pixel_format_gl,
+           component_format_gl,
+           internal_format_gl;
+
+    gl_map_texture_format(m_pixel_format,
+                          m_component_format,
+                          pixel_format_gl,
+                          component_format_gl,
+                          internal_format_gl);
+    (void) internal_format_gl;
+
+    if (!m_async)
+        m_async = new AsyncState();
+
+    AsyncState::Transfer transfer;
+    if (!m_async->idle_downloads.empty()) {
+        transfer = std::move(m_async->idle_downloads.back());
+        m_async->idle_downloads.pop_back();
+    } else {
+        CHK(glGenBuffers(1, &transfer.buffer));
+    }
+
+    size_t size = bytes_per_pixel() * m_size.x() * m_size.y();
+    CHK(glBindBuffer(GL_PIXEL_PACK_BUFFER, transfer.buffer));
+    if (transfer.size != size) {
+        CHK(glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr) size, nullptr, GL_STREAM_READ));
+        transfer.size = size;
+    }
+    transfer.rows = m_size.y();
+
+    CHK(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+    bind_texture(GL_TEXTURE_2D, m_texture_handle);
+    CHK(glGetTexImage(GL_TEXTURE_2D, 0, pixel_format_gl, component_format_gl, nullptr));
+    CHK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    transfer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    transfer.callback = callback;
+    m_async->downloads.push_back(std::move(transfer));
+#endif
+}
+
+size_t Texture::poll_downloads(bool wait) {
+#if !defined(NANOGUI_USE_OPENGL)
+    (void) wait;
+    return 0;
+#else
+    if (!m_async)
+        return 0;
+
+    while (!m_async->downloads.empty()) {
+        if (!AsyncState::signaled(m_async->downloads.front().fence, wait))
+            break;
+        AsyncState::Transfer transfer = std::move(m_async->downloads.front());
+        m_async->downloads.pop_front();
+
+        CHK(glBindBuffer(GL_PIXEL_PACK_BUFFER, transfer.buffer));
+        const uint8_t *ptr = (const uint8_t *) glMapBufferRange(
+            GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr) transfer.size, GL_MAP_READ_BIT);
+        if (!ptr)
+            throw std::runtime_error("Texture::poll_downloads(): could not map staging buffer!");
+
+        if (m_flags & (uint8_t) TextureFlags::RenderTarget) {
+            /* Flip vertically while copying out of the staging buffer */
+            if (m_async->flip_buffer_size < transfer.size) {
+                m_async->flip_buffer.reset(new uint8_t[transfer.size]);
+                m_async->flip_buffer_size = transfer.size;
+            }
+            size_t stride = transfer.size / transfer.rows;
+            const uint8_t *src = ptr + transfer.size - stride;
+            uint8_t *dst = m_async->flip_buffer.get();
+            for (int i = 0; i < transfer.rows; ++i, src -= stride, dst += stride)
+                memcpy(dst, src, stride);
+            ptr = m_async->flip_buffer.get();
+        }
+
+        try {
+            transfer.callback(ptr);
+        } catch (...) {
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            throw;
+        }
+
+        CHK(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+        CHK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+        transfer.callback = DownloadCallback();
+        m_async->idle_downloads.push_back(std::move(transfer));
+    }
+
+    return m_async->downloads.size();
 #endif
 }
 
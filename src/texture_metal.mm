@@ -1,9 +1,33 @@
 #include <nanogui/texture.h>
 #include <nanogui/metal.h>
 #import <Metal/Metal.h>
+#include <deque>
 
 NAMESPACE_BEGIN(nanogui)
 
+struct Texture::AsyncState {
+    struct Transfer {
+        void *command_buffer = nullptr;
+        void *buffer = nullptr;
+        size_t size = 0;
+        DownloadCallback callback;
+    };
+
+    /// Readbacks in submission order
+    std::deque<Transfer> downloads;
+
+    static void release(Transfer &t) {
+        (void) (__bridge_transfer id<MTLCommandBuffer>) t.command_buffer;
+        (void) (__bridge_transfer id<MTLBuffer>) t.buffer;
+        t.command_buffer = t.buffer = nullptr;
+    }
+
+    ~AsyncState() {
+        for (Transfer &t : downloads)
+            release(t);
+    }
+};
+
 void Texture::init() {
     Vector2i size = m_size;
     m_size = 0;
@@ -43,6 +67,7 @@ void Texture::init() {
 }
 
 Texture::~Texture() {
+    delete m_async;
     (void) (__bridge_transfer id<MTLTexture>) m_texture_handle;
     (void) (__bridge_transfer id<MTLSamplerState>) m_sampler_state_handle;
 }
@@ -78,8 +103,11 @@ void Texture::upload(const uint8_t *data) {
                 destinationLevel: 0
                destinationOrigin: MTLOriginMake(0, 0, 0)];
 
-    if (m_min_interpolation_mode == InterpolationMode::Trilinear)
-        [command_encoder generateMipmapsForTexture: texture];
+    if (m_min_interpolation_mode == InterpolationMode::Trilinear) {
+        if (m_auto_mipmaps)
+            [command_encoder generateMipmapsForTexture: texture];
+        m_mipmaps_dirty = !m_auto_mipmaps;
+    }
 
     [command_encoder endEncoding];
     [command_buffer commit];
@@ -119,6 +147,190 @@ void Texture::download(uint8_t *data) {
     memcpy(data, buffer.contents, img_bytes);
 }
 
+void Texture::upload_sub_region(const Vector2i &offset, const Vector2i &size,
+                                const uint8_t *data, size_t row_stride,
+                                uint32_t level) {
+    Vector2i level_size = max(Vector2i(m_size.x() >> level, m_size.y() >> level), Vector2i(1));
+    if (offset.x() < 0 || offset.y() < 0 || size.x() < 0 || size.y() < 0 ||
+        offset.x() + size.x() > level_size.x() ||
+        offset.y() + size.y() > level_size.y())
+        throw std::runtime_error("Texture::upload_sub_region(): region out of bounds!");
+
+    size_t packed_stride = bytes_per_pixel() * size.x();
+    if (row_stride == 0)
+        row_stride = packed_stride;
+    else if (row_stride < packed_stride)
+        throw std::runtime_error("Texture::upload_sub_region(): invalid row stride!");
+
+    if (size.x() == 0 || size.y() == 0)
+        return;
+
+    id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+    id<MTLTexture> texture = (__bridge id<MTLTexture>) m_texture_handle;
+    size_t buffer_size = row_stride * (size.y() - 1) + packed_stride;
+    id<MTLBuffer> buffer =
+        [device newBufferWithBytes: data
+                            length: buffer_size
+                           options: MTLResourceStorageModeShared];
+
+    id<MTLCommandQueue> command_queue =
+        (__bridge id<MTLCommandQueue>) metal_command_queue();
+    id<MTLCommandBuffer> command_buffer = [command_queue commandBuffer];
+    id<MTLBlitCommandEncoder> command_encoder =
+        [command_buffer blitCommandEncoder];
+
+    [command_encoder
+                 copyFromBuffer: buffer
+                   sourceOffset: 0
+              sourceBytesPerRow: row_stride
+            sourceBytesPerImage: buffer_size
+                     sourceSize: MTLSizeMake((NSUInteger) size.x(), (NSUInteger) size.y(), 1)
+                      toTexture: texture
+               destinationSlice: 0
+               destinationLevel: level
+              destinationOrigin: MTLOriginMake((NSUInteger) offset.x(), (NSUInteger) offset.y(), 0)];
+
+    [command_encoder endEncoding];
+    [command_buffer commit];
+
+    if (level == 0 && m_min_interpolation_mode == InterpolationMode::Trilinear)
+        m_mipmaps_dirty = true;
+}
+
+void Texture::upload_level(uint32_t level, const uint8_t *data) {
+    if (level >= mip_levels())
+        throw std::runtime_error("Texture::upload_level(): level out of bounds!");
+    Vector2i level_size = max(Vector2i(m_size.x() >> level, m_size.y() >> level), Vector2i(1));
+    upload_sub_region(0, level_size, data, 0, level);
+    if (level == 0)
+        m_mipmaps_dirty = false;
+}
+
+void Texture::generate_mipmaps() {
+    if (m_min_interpolation_mode != InterpolationMode::Trilinear)
+        return;
+
+    id<MTLTexture> texture = (__bridge id<MTLTexture>) m_texture_handle;
+    id<MTLCommandQueue> command_queue =
+        (__bridge id<MTLCommandQueue>) metal_command_queue();
+    id<MTLCommandBuffer> command_buffer = [command_queue commandBuffer];
+    id<MTLBlitCommandEncoder> command_encoder =
+        [command_buffer blitCommandEncoder];
+    [command_encoder generateMipmapsForTexture: texture];
+    [command_encoder endEncoding];
+    [command_buffer commit];
+    m_mipmaps_dirty = false;
+}
+
+void Texture::upload_async(const uint8_t *data) {
+    size_t row_bytes = bytes_per_pixel() * m_size.x(),
+           img_bytes = row_bytes * m_size.y();
+
+    id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+    id<MTLTexture> texture = (__bridge id<MTLTexture>) m_texture_handle;
+    id<MTLBuffer> buffer =
+        [device newBufferWithBytes: data
+                            length: img_bytes
+                           options: MTLResourceStorageModeShared];
+
+    id<MTLCommandQueue> command_queue =
+        (__bridge id<MTLCommandQueue>) metal_command_queue();
+    id<MTLCommandBuffer> command_buffer = [command_queue commandBuffer];
+    id<MTLBlitCommandEncoder> command_encoder =
+        [command_buffer blitCommandEncoder];
+
+    /* The command buffer retains the staging buffer until it has completed */
+    [command_encoder
+                 copyFromBuffer: buffer
+                   sourceOffset: 0
+              sourceBytesPerRow: row_bytes
+            sourceBytesPerImage: img_bytes
+                     sourceSize: MTLSizeMake((NSUInteger) m_size.x(), (NSUInteger) m_size.y(), 1)
+                      toTexture: texture
+               destinationSlice: 0
+               destinationLevel: 0
+              destinationOrigin: MTLOriginMake(0, 0, 0)];
+
+    if (m_min_interpolation_mode == InterpolationMode::Trilinear) {
+        if (m_auto_mipmaps)
+            [command_encoder generateMipmapsForTexture: texture];
+        m_mipmaps_dirty = !m_auto_mipmaps;
+    }
+
+    [command_encoder endEncoding];
+    [command_buffer commit];
+}
+
+void Texture::download_async(const DownloadCallback &callback) {
+    size_t row_bytes = bytes_per_pixel() * m_size.x(),
+           img_bytes = row_bytes * m_size.y();
+
+    id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+    id<MTLTexture> texture = (__bridge id<MTLTexture>) m_texture_handle;
+    id<MTLBuffer> buffer =
+        [device newBufferWithLength: img_bytes
+                            options: MTLResourceStorageModeShared];
+
+    id<MTLCommandQueue> command_queue =
+        (__bridge id<MTLCommandQueue>) metal_command_queue();
+    id<MTLCommandBuffer> command_buffer = [command_queue commandBuffer];
+    id<MTLBlitCommandEncoder> command_encoder =
+        [command_buffer blitCommandEncoder];
+
+    [command_encoder
+                 copyFromTexture: texture
+                     sourceSlice: 0
+                     sourceLevel: 0
+                    sourceOrigin: MTLOriginMake(0, 0, 0)
+                      sourceSize: MTLSizeMake(texture.width, texture.height, 1)
+                        toBuffer: buffer
+               destinationOffset: 0
+          destinationBytesPerRow: row_bytes
+        destinationBytesPerImage: img_bytes];
+
+    [command_encoder endEncoding];
+    [command_buffer commit];
+
+    if (!m_async)
+        m_async = new AsyncState();
+
+    AsyncState::Transfer transfer;
+    transfer.command_buffer = (__bridge_retained void *) command_buffer;
+    transfer.buffer = (__bridge_retained void *) buffer;
+    transfer.size = img_bytes;
+    transfer.callback = callback;
+    m_async->downloads.push_back(std::move(transfer));
+}
+
+size_t Texture::poll_downloads(bool wait) {
+    if (!m_async)
+        return 0;
+
+    while (!m_async->downloads.empty()) {
+        AsyncState::Transfer &front = m_async->downloads.front();
+        id<MTLCommandBuffer> command_buffer =
+            (__bridge id<MTLCommandBuffer>) front.command_buffer;
+        if (wait)
+            [command_buffer waitUntilCompleted];
+        else if (command_buffer.status < MTLCommandBufferStatusCompleted)
+            break;
+
+        AsyncState::Transfer transfer = std::move(front);
+        m_async->downloads.pop_front();
+        id<MTLBuffer> buffer = (__bridge id<MTLBuffer>) transfer.buffer;
+
+        try {
+            transfer.callback((const uint8_t *) buffer.contents);
+        } catch (...) {
+            AsyncState::release(transfer);
+            throw;
+        }
+        AsyncState::release(transfer);
+    }
+
+    return m_async->downloads.size();
+}
+
 void Texture::resize(const Vector2i &size) {
     if (m_size == size)
         return;
@@ -0,0 +1,182 @@
+#include <nanogui/texture.h>
+#include <nanogui/null.h>
+#include <cstring>
+
+NAMESPACE_BEGIN(nanogui)
+
+/* Transfers complete immediately, but download callbacks are still only
+   invoked by poll_downloads() to match the other backends */
+struct Texture::AsyncState {
+    struct Download {
+        std::vector<uint8_t> data;
+        DownloadCallback callback;
+    };
+    std::vector<Download> downloads;
+};
+
+void Texture::init() {
+    if (!(m_flags & ((uint8_t) TextureFlags::ShaderRead |
+                     (uint8_t) TextureFlags::RenderTarget)))
+        throw std::runtime_error(
+            "Texture::Texture(): flags must either specify ShaderRead, RenderTarget, or both!");
+
+    switch (m_min_interpolation_mode) {
+        case InterpolationMode::Nearest:
+        case InterpolationMode::Bilinear:
+        case InterpolationMode::Trilinear:
+            break;
+        default: throw std::runtime_error("Texture::Texture(): invalid interpolation mode!");
+    }
+
+    m_texture_handle = null_new_handle();
+    null_stats().textures++;
+    upload(nullptr);
+}
+
+Texture::~Texture() {
+    delete m_async;
+    NullStats &stats = null_stats();
+    stats.textures--;
+    stats.texture_bytes -= m_data.size();
+}
+
+void Texture::upload(const uint8_t *data) {
+    if (m_samples > 1 && data != nullptr)
+        throw std::runtime_error("Texture::upload(): only implemented for samples=1!");
+
+    NullStats &stats = null_stats();
+    size_t size = bytes_per_pixel() * (size_t) m_size.x() * (size_t) m_size.y();
+    stats.texture_bytes -= m_data.size();
+    stats.texture_bytes += size;
+
+    if (data) {
+        m_data.assign(data, data + size);
+        stats.uploads++;
+        stats.upload_bytes += size;
+    } else {
+        m_data.assign(size, 0);
+    }
+
+    if (m_min_interpolation_mode == InterpolationMode::Trilinear ||
+        m_mag_interpolation_mode == InterpolationMode::Trilinear)
+        m_mipmaps_dirty = !m_auto_mipmaps;
+}
+
+void Texture::download(uint8_t *data) {
+    if (m_samples > 1)
+        throw std::runtime_error("Texture::download(): only implemented for samples=1!");
+
+    memcpy(data, m_data.data(), m_data.size());
+    null_stats().downloads++;
+}
+
+void Texture::upload_sub_region(const Vector2i &offset, const Vector2i &size,
+                                const uint8_t *data, size_t row_stride,
+                                uint32_t level) {
+    if (m_samples > 1)
+        throw std::runtime_error("Texture::upload_sub_region(): only implemented for samples=1!");
+
+    Vector2i level_size = max(Vector2i(m_size.x() >> level, m_size.y() >> level), Vector2i(1));
+    if (offset.x() < 0 || offset.y() < 0 || size.x() < 0 || size.y() < 0 ||
+        offset.x() + size.x() > level_size.x() ||
+        offset.y() + size.y() > level_size.y())
+        throw std::runtime_error("Texture::upload_sub_region(): region out of bounds!");
+
+    size_t pixel_bytes = bytes_per_pixel(),
+           packed_stride = pixel_bytes * size.x();
+    if (row_stride == 0)
+        row_stride = packed_stride;
+    else if (row_stride < packed_stride || row_stride % pixel_bytes != 0)
+        throw std::runtime_error("Texture::upload_sub_region(): invalid row stride!");
+
+    if (size.x() == 0 || size.y() == 0)
+        return;
+
+    NullStats &stats = null_stats();
+    stats.uploads++;
+    stats.upload_bytes += packed_stride * size.y();
+
+    if (level == 0) {
+        size_t stride = pixel_bytes * m_size.x();
+        uint8_t *dst = m_data.data() + offset.y() * stride + offset.x() * pixel_bytes;
+        for (int y = 0; y < size.y(); ++y)
+            memcpy(dst + y * stride, data + y * row_stride, packed_stride);
+
+        if (m_min_interpolation_mode == InterpolationMode::Trilinear ||
+            m_mag_interpolation_mode == InterpolationMode::Trilinear)
+            m_mipmaps_dirty = true;
+    }
+}
+
+void Texture::upload_level(uint32_t level, const uint8_t *data) {
+    if (level == 0) {
+        bool auto_mipmaps = m_auto_mipmaps;
+        m_auto_mipmaps = false;
+        upload(data);
+        m_auto_mipmaps = auto_mipmaps;
+        m_mipmaps_dirty = false;
+        return;
+    }
+
+    if (m_samples > 1)
+        throw std::runtime_error("Texture::upload_level(): only implemented for samples=1!");
+    else if (level >= mip_levels())
+        throw std::runtime_error("Texture::upload_level(): level out of bounds!");
+
+    Vector2i level_size = max(Vector2i(m_size.x() >> level, m_size.y() >> level), Vector2i(1));
+    NullStats &stats = null_stats();
+    stats.uploads++;
+    stats.upload_bytes += bytes_per_pixel() * level_size.x() * level_size.y();
+}
+
+void Texture::generate_mipmaps() {
+    if (m_min_interpolation_mode != InterpolationMode::Trilinear &&
+        m_mag_interpolation_mode != InterpolationMode::Trilinear)
+        return;
+    m_mipmaps_dirty = false;
+}
+
+void Texture::upload_async(const uint8_t *data) {
+    upload(data);
+}
+
+void Texture::download_async(const DownloadCallback &callback) {
+    if (m_samples > 1)
+        throw std::runtime_error("Texture::download_async(): only implemented for samples=1!");
+
+    if (!m_async)
+        m_async = new AsyncState();
+
+    null_stats().downloads++;
+    m_async->downloads.push_back({ m_data, callback });
+}
+
+size_t Texture::poll_downloads(bool) {
+    if (!m_async)
+        return 0;
+
+    std::vector<AsyncState::Download> downloads;
+    downloads.swap(m_async->downloads);
+    for (size_t i = 0; i < downloads.size(); ++i) {
+        try {
+            downloads[i].callback(downloads[i].data.data());
+        } catch (...) {
+            /* Keep the remaining downloads queued */
+            m_async->downloads.insert(m_async->downloads.begin(),
+                                      std::make_move_iterator(downloads.begin() + i + 1),
+                                      std::make_move_iterator(downloads.end()));
+            throw;
+        }
+    }
+
+    return 0;
+}
+
+void Texture::resize(const Vector2i &size) {
+    if (m_size == size)
+        return;
+    m_size = size;
+    upload(nullptr);
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,186 @@
+/*
+    src/textureloader.cpp -- Asynchronous image decoding and staged
+    texture upload
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/textureloader.h>
+#include <nanogui/screen.h>
+#include <nanogui/opengl.h>
+#include <stb_image.h>
+#include <map>
+
+NAMESPACE_BEGIN(nanogui)
+
+extern std::map<GLFWwindow *, Screen *> __nanogui_screens;
+
+TextureLoader::TextureLoader(size_t thread_count, size_t upload_budget)
+    : m_upload_budget(upload_budget), m_alive(std::make_shared<bool>(true)) {
+    if (thread_count == 0)
+        thread_count =
+            std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+    for (size_t i = 0; i < thread_count; ++i)
+        m_workers.emplace_back([this]() { run(); });
+}
+
+TextureLoader::~TextureLoader() {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stop = true;
+        *m_alive = false;
+        m_queue.clear();
+    }
+    m_cv.notify_all();
+    for (std::thread &worker : m_workers)
+        worker.join();
+    for (Request &request : m_ready)
+        stbi_image_free(request.data);
+}
+
+ref<Texture> TextureLoader::load(const std::string &filename,
+                                 InterpolationMode min_interpolation_mode,
+                                 InterpolationMode mag_interpolation_mode,
+                                 WrapMode wrap_mode,
+                                 const TextureCallback &callback) {
+    ref<Texture> texture = new Texture(
+        Texture::PixelFormat::RGBA, Texture::ComponentFormat::UInt8,
+        Vector2i(1, 1), min_interpolation_mode, mag_interpolation_mode,
+        wrap_mode);
+    if (texture->pixel_format() != Texture::PixelFormat::RGBA)
+        throw std::runtime_error("TextureLoader::load(): pixel format not "
+                                 "supported by the hardware!");
+    uint8_t placeholder[4] = { 0, 0, 0, 0 };
+    texture->upload(placeholder);
+
+    Request request;
+    request.filename = filename;
+    request.texture = texture;
+    request.texture_callback = callback;
+    enqueue(std::move(request));
+    return texture;
+}
+
+void TextureLoader::load_image(NVGcontext *ctx, const std::string &filename,
+                               const ImageCallback &callback, int image_flags) {
+    Request request;
+    request.filename = filename;
+    request.ctx = ctx;
+    request.image_flags = image_flags;
+    request.image_callback = callback;
+    enqueue(std::move(request));
+}
+
+size_t TextureLoader::pending() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_queue.size() + m_busy + m_ready.size();
+}
+
+void TextureLoader::enqueue(Request &&request) {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_queue.push_back(std::move(request));
+    }
+    m_cv.notify_one();
+}
+
+void TextureLoader::schedule() {
+    /* Must be called while holding 'm_mutex' */
+    if (m_scheduled || m_stop)
+        return;
+    m_scheduled = true;
+    std::shared_ptr<bool> alive = m_alive;
+    async([this, alive]() {
+        if (*alive)
+            process();
+    });
+    glfwPostEmptyEvent();
+}
+
+void TextureLoader::run() {
+    while (true) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> guard(m_mutex);
+            m_cv.wait(guard, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_stop)
+                return;
+            request = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_busy++;
+        }
+
+        int n = 0;
+        request.data = stbi_load(request.filename.c_str(), &request.size.x(),
+                                 &request.size.y(), &n, 4);
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_busy--;
+        if (m_stop) {
+            stbi_image_free(request.data);
+            return;
+        }
+        m_ready.push_back(std::move(request));
+        schedule();
+    }
+}
+
+bool TextureLoader::process() {
+    std::vector<Request> batch;
+
+    /* Dequeue decoded images until the upload budget is exhausted */ {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_scheduled = false;
+        size_t bytes = 0;
+        while (!m_ready.empty()) {
+            const Request &request = m_ready.front();
+            size_t size = (size_t) request.size.x() * (size_t) request.size.y() * 4;
+            if (!batch.empty() && bytes + size > m_upload_budget)
+                break;
+            bytes += size;
+            batch.push_back(std::move(m_ready.front()));
+            m_ready.pop_front();
+        }
+    }
+
+    for (Request &request : batch) {
+        using Holder = std::unique_ptr<uint8_t[], void(*)(void*)>;
+        Holder data(request.data, stbi_image_free);
+        bool success = data != nullptr;
+
+        if (request.texture) {
+            if (success) {
+                request.texture->resize(request.size);
+                request.texture->upload(data.get());
+            }
+            if (request.texture_callback)
+                request.texture_callback(request.texture.get(), success);
+        } else {
+            int image = 0;
+            if (success)
+                image = nvgCreateImageRGBA(request.ctx, request.size.x(),
+                                           request.size.y(), request.image_flags,
+                                           data.get());
+            if (request.image_callback)
+                request.image_callback(image, request.filename);
+        }
+    }
+
+    if (!batch.empty()) {
+        for (auto kv : __nanogui_screens)
+            kv.second->redraw();
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    bool remaining = !m_ready.empty();
+    if (remaining)
+        schedule();
+    return remaining;
+}
+
+NAMESPACE_END(nanogui)
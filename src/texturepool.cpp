@@ -0,0 +1,111 @@
+/*
+    src/texturepool.cpp -- Recycles render target textures
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/texturepool.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+TexturePool::TexturePool(size_t max_pooled_bytes)
+    : m_max_pooled_bytes(max_pooled_bytes) { }
+
+TexturePool::~TexturePool() { }
+
+ref<Texture> TexturePool::acquire(PixelFormat pixel_format,
+                                  ComponentFormat component_format,
+                                  const Vector2i &size, uint8_t samples,
+                                  uint8_t flags) {
+    Key key { pixel_format, component_format, samples, flags, size_class(size) };
+
+    ref<Texture> texture;
+    for (auto it = m_pool.begin(); it != m_pool.end(); ++it) {
+        if (it->key == key) {
+            texture = it->texture;
+            m_pooled_bytes -= texture_bytes(texture);
+            m_pool.erase(it);
+            break;
+        }
+    }
+
+    if (!texture)
+        texture = new Texture(pixel_format, component_format, key.size,
+                              Texture::InterpolationMode::Bilinear,
+                              Texture::InterpolationMode::Bilinear,
+                              Texture::WrapMode::ClampToEdge, samples, flags);
+
+    m_active[texture.get()] = key;
+    m_active_bytes += texture_bytes(texture);
+    return texture;
+}
+
+void TexturePool::release(Texture *texture) {
+    auto it = m_active.find(texture);
+    if (it == m_active.end())
+        return;
+
+    size_t bytes = texture_bytes(texture);
+    m_active_bytes -= bytes;
+    m_pool.push_front(Entry { it->second, texture });
+    m_pooled_bytes += bytes;
+    m_active.erase(it);
+    trim();
+}
+
+bool TexturePool::fits(const Texture *texture, const Vector2i &size) {
+    const Vector2i &tsize = texture->size();
+    if (size.x() > tsize.x() || size.y() > tsize.y())
+        return false;
+    Vector2i cls = size_class(size);
+    return (size_t) tsize.x() * (size_t) tsize.y() <=
+           2 * (size_t) cls.x() * (size_t) cls.y();
+}
+
+Vector2i TexturePool::size_class(const Vector2i &size) {
+    Vector2i result;
+    for (int i = 0; i < 2; ++i) {
+        int value = std::max(size[i], 1);
+        if (value <= 64) {
+            result[i] = 64;
+            continue;
+        }
+        /* Four steps per power of two: round up to a multiple of 2^(k-2),
+           where 2^k <= value < 2^(k+1) */
+        int k = 0;
+        while ((value >> (k + 1)) != 0)
+            k++;
+        int step = 1 << (k - 2);
+        result[i] = (value + step - 1) / step * step;
+    }
+    return result;
+}
+
+size_t TexturePool::texture_bytes(const Texture *texture) {
+    return texture->bytes_per_pixel() * (size_t) texture->size().x() *
+           (size_t) texture->size().y() * (size_t) texture->samples();
+}
+
+void TexturePool::set_max_pooled_bytes(size_t max_pooled_bytes) {
+    m_max_pooled_bytes = max_pooled_bytes;
+    trim();
+}
+
+void TexturePool::clear() {
+    m_pool.clear();
+    m_pooled_bytes = 0;
+}
+
+void TexturePool::trim() {
+    while (m_pooled_bytes > m_max_pooled_bytes && !m_pool.empty()) {
+        m_pooled_bytes -= texture_bytes(m_pool.back().texture);
+        m_pool.pop_back();
+    }
+}
+
+NAMESPACE_END(nanogui)
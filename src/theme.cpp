@@ -15,6 +15,7 @@
 #include <nanogui/opengl.h>
 #include <nanogui/icons.h>
 #include "nanogui_resources.h"
+#include <algorithm>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -78,6 +79,16 @@ Theme::Theme(NVGcontext *ctx) {
     m_text_box_up_icon                  = FA_CHEVRON_UP;
     m_text_box_down_icon                = FA_CHEVRON_DOWN;
 
+    for (char c = 32; c < 127; ++c)
+        m_prewarm_characters.push_back(c);
+
+    m_prewarm_icons = {
+        m_check_box_icon, m_message_information_icon, m_message_question_icon,
+        m_message_warning_icon, m_message_alt_button_icon,
+        m_message_primary_button_icon, m_popup_chevron_right_icon,
+        m_popup_chevron_left_icon, m_text_box_up_icon, m_text_box_down_icon
+    };
+
     m_font_sans_regular = nvgCreateFontMem(ctx, "sans", (uint8_t *) roboto_regular_ttf,
                                            roboto_regular_ttf_size, 0);
     m_font_sans_bold = nvgCreateFontMem(ctx, "sans-bold", (uint8_t *) roboto_bold_ttf,
@@ -92,4 +103,60 @@ Theme::Theme(NVGcontext *ctx) {
         throw std::runtime_error("Could not load fonts!");
 }
 
+void Theme::prewarm_glyphs(NVGcontext *ctx, float pixel_ratio, bool force) {
+    int font_size[3] = { m_standard_font_size, m_button_font_size,
+                         m_text_box_font_size };
+
+    PrewarmState &state = m_prewarm_state;
+    if (!force && state.pixel_ratio == pixel_ratio &&
+        state.icon_scale == m_icon_scale &&
+        std::equal(font_size, font_size + 3, state.font_size) &&
+        state.characters == m_prewarm_characters &&
+        state.icons == m_prewarm_icons)
+        return;
+
+    state.pixel_ratio = pixel_ratio;
+    state.icon_scale = m_icon_scale;
+    std::copy(font_size, font_size + 3, state.font_size);
+    state.characters = m_prewarm_characters;
+    state.icons = m_prewarm_icons;
+
+    std::string icons;
+    for (int icon : m_prewarm_icons) {
+        if (nvg_is_font_icon(icon))
+            icons += utf8(icon);
+    }
+
+    if (m_prewarm_characters.empty() && icons.empty())
+        return;
+
+    /* Glyphs are rasterized (and the atlas is uploaded) while the text
+       is being laid out, so the resulting geometry can simply be dropped */
+    nvgBeginFrame(ctx, 1.f, 1.f, pixel_ratio);
+    nvgFontBlur(ctx, 0.f);
+    nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+
+    for (int i = 0; i < 3; ++i) {
+        if (std::find(font_size, font_size + i, font_size[i]) != font_size + i)
+            continue; /* Already handled this size */
+
+        if (!m_prewarm_characters.empty()) {
+            nvgFontSize(ctx, (float) font_size[i]);
+            for (int font : { m_font_sans_regular, m_font_sans_bold,
+                              m_font_mono_regular }) {
+                nvgFontFaceId(ctx, font);
+                nvgText(ctx, 0.f, 0.f, m_prewarm_characters.c_str(), nullptr);
+            }
+        }
+
+        if (!icons.empty()) {
+            nvgFontSize(ctx, font_size[i] * m_icon_scale);
+            nvgFontFaceId(ctx, m_font_icons);
+            nvgText(ctx, 0.f, 0.f, icons.c_str(), nullptr);
+        }
+    }
+
+    nvgCancelFrame(ctx);
+}
+
 NAMESPACE_END(nanogui)
@@ -0,0 +1,57 @@
+#include <nanogui/vertexbuffer.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+VertexBuffer::VertexBuffer(const std::vector<Attribute> &attributes, size_t stride)
+    : m_attributes(attributes), m_stride(stride) {
+    size_t end = 0;
+    for (Attribute &attr : m_attributes) {
+        if (attr.components < 1 || attr.components > 4)
+            throw std::runtime_error("VertexBuffer::VertexBuffer(): attribute \"" +
+                                     attr.name + "\" must have 1-4 components!");
+        else if (attr.dtype == VariableType::Invalid ||
+                 attr.dtype == VariableType::Bool ||
+                 attr.dtype == VariableType::Int64 ||
+                 attr.dtype == VariableType::UInt64 ||
+                 attr.dtype == VariableType::Float64)
+            throw std::runtime_error("VertexBuffer::VertexBuffer(): attribute \"" +
+                                     attr.name + "\" has an unsupported type!");
+
+        if (attr.offset == (size_t) -1)
+            attr.offset = (end + 3) / 4 * 4;
+        end = std::max(end, attr.offset + type_size(attr.dtype) * attr.components);
+    }
+
+    if (m_stride == 0)
+        m_stride = (end + 3) / 4 * 4;
+    else if (m_stride < end)
+        throw std::runtime_error("VertexBuffer::VertexBuffer(): stride is too small "
+                                 "for the specified attributes!");
+
+    init();
+}
+
+const VertexBuffer::Attribute *VertexBuffer::attribute(const std::string &name) const {
+    for (const Attribute &attr : m_attributes) {
+        if (attr.name == name)
+            return &attr;
+    }
+    return nullptr;
+}
+
+void VertexBuffer::set_data(const void *data, size_t vertex_count) {
+    bool reallocate = vertex_count != m_vertex_count;
+    m_vertex_count = vertex_count;
+    upload(data, vertex_count * m_stride, reallocate);
+}
+
+void VertexBuffer::set_data_range(size_t offset, size_t count, const void *data) {
+    if (offset + count > m_vertex_count)
+        throw std::runtime_error("VertexBuffer::set_data_range(): range exceeds "
+                                 "the size of the buffer!");
+    if (count == 0)
+        return;
+    upload_range(offset * m_stride, count * m_stride, data);
+}
+
+NAMESPACE_END(nanogui)
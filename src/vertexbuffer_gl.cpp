@@ -0,0 +1,31 @@
+#include <nanogui/vertexbuffer.h>
+#include <nanogui/opengl.h>
+#include "opengl_check.h"
+
+NAMESPACE_BEGIN(nanogui)
+
+void VertexBuffer::init() {
+    /* Create the handle right away: a shader may record it in its vertex
+       array object before any data is uploaded */
+    CHK(glGenBuffers(1, &m_buffer_handle));
+}
+
+VertexBuffer::~VertexBuffer() {
+    if (m_buffer_handle)
+        CHK(glDeleteBuffers(1, &m_buffer_handle));
+}
+
+void VertexBuffer::upload(const void *data, size_t size, bool reallocate) {
+    CHK(glBindBuffer(GL_ARRAY_BUFFER, m_buffer_handle));
+    if (reallocate)
+        CHK(glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) size, data, GL_DYNAMIC_DRAW));
+    else
+        CHK(glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr) size, data));
+}
+
+void VertexBuffer::upload_range(size_t offset, size_t size, const void *data) {
+    CHK(glBindBuffer(GL_ARRAY_BUFFER, m_buffer_handle));
+    CHK(glBufferSubData(GL_ARRAY_BUFFER, (GLintptr) offset, (GLsizeiptr) size, data));
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,62 @@
+#include <nanogui/vertexbuffer.h>
+#include <nanogui/metal.h>
+#import <Metal/Metal.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+void VertexBuffer::init() { }
+
+VertexBuffer::~VertexBuffer() {
+    (void) (__bridge_transfer id<MTLBuffer>) m_buffer_handle;
+}
+
+void VertexBuffer::upload(const void *data, size_t size, bool reallocate) {
+    id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+
+    if (reallocate && m_buffer_handle) {
+        (void) (__bridge_transfer id<MTLBuffer>) m_buffer_handle;
+        m_buffer_handle = nullptr;
+    }
+
+    if (!m_buffer_handle) {
+        id<MTLBuffer> buffer =
+            [device newBufferWithLength: std::max(size, (size_t) 1)
+                                options: MTLResourceStorageModePrivate];
+        m_buffer_handle = (__bridge_retained void *) buffer;
+    }
+
+    upload_range(0, size, data);
+}
+
+void VertexBuffer::upload_range(size_t offset, size_t size, const void *data) {
+    if (size == 0)
+        return;
+
+    /* Procedure recommended by Apple: create a temporary shared buffer and
+       blit into a private GPU-only buffer */
+    id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+    id<MTLBuffer> buffer = (__bridge id<MTLBuffer>) m_buffer_handle;
+
+    id<MTLBuffer> temp_buffer =
+        [device newBufferWithBytes: data
+                            length: size
+                           options: MTLResourceStorageModeShared];
+
+    id<MTLCommandQueue> command_queue =
+        (__bridge id<MTLCommandQueue>) metal_command_queue();
+    id<MTLCommandBuffer> command_buffer = [command_queue commandBuffer];
+    id<MTLBlitCommandEncoder> blit_encoder =
+        [command_buffer blitCommandEncoder];
+
+    [blit_encoder copyFromBuffer: temp_buffer
+                    sourceOffset: 0
+                        toBuffer: buffer
+               destinationOffset: offset
+                            size: size];
+
+    [blit_encoder endEncoding];
+    [command_buffer commit];
+    [command_buffer waitUntilCompleted];
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,43 @@
+#include <nanogui/vertexbuffer.h>
+#include <nanogui/null.h>
+#include <cstring>
+
+NAMESPACE_BEGIN(nanogui)
+
+void VertexBuffer::init() { }
+
+VertexBuffer::~VertexBuffer() {
+    NullStats &stats = null_stats();
+    if (!m_data.empty())
+        stats.vertex_buffers--;
+    stats.vertex_buffer_bytes -= m_data.size();
+}
+
+void VertexBuffer::upload(const void *data, size_t size, bool reallocate) {
+    NullStats &stats = null_stats();
+    if (reallocate || m_data.size() != size) {
+        if (m_data.empty() && size > 0)
+            stats.vertex_buffers++;
+        else if (!m_data.empty() && size == 0)
+            stats.vertex_buffers--;
+        stats.vertex_buffer_bytes -= m_data.size();
+        stats.vertex_buffer_bytes += size;
+        m_data.resize(size);
+        m_data.shrink_to_fit();
+    }
+
+    upload_range(0, size, data);
+}
+
+void VertexBuffer::upload_range(size_t offset, size_t size, const void *data) {
+    if (size == 0)
+        return;
+
+    memcpy(m_data.data() + offset, data, size);
+
+    NullStats &stats = null_stats();
+    stats.uploads++;
+    stats.upload_bytes += size;
+}
+
+NAMESPACE_END(nanogui)